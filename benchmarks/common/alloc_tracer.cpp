@@ -0,0 +1,493 @@
+/**
+ * @file alloc_tracer.cpp
+ * @brief Replacement operator new/delete (and optionally malloc) for alloc_tracer.hpp
+ *
+ * Only link this into benchmark executables: the replacements apply to
+ * the whole program. Every counter lives in static storage with constant
+ * initialization, so allocations made before main() are recorded too.
+ */
+
+#include "alloc_tracer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <new>
+#include <ostream>
+
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define HPC_ALLOC_TRACER_BACKTRACE 1
+#endif
+
+#ifdef HPC_ALLOC_TRACER_MALLOC
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+#endif
+
+namespace hpc::bench::alloc_tracer {
+
+namespace {
+
+// ============================================================================
+// Counters
+// ============================================================================
+
+struct alignas(64) Slot {
+    std::atomic<bool> in_use{false};
+    std::atomic<uint32_t> thread_index{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytes_allocated{0};
+    std::array<std::atomic<uint64_t>, SIZE_CLASSES> size_classes{};
+
+    Stats snapshot() const noexcept {
+        Stats stats;
+        stats.allocations = allocations.load(std::memory_order_relaxed);
+        stats.deallocations = deallocations.load(std::memory_order_relaxed);
+        stats.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < SIZE_CLASSES; ++i) {
+            stats.size_classes[i] = size_classes[i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    void add(const Stats& stats) noexcept {
+        allocations.fetch_add(stats.allocations, std::memory_order_relaxed);
+        deallocations.fetch_add(stats.deallocations, std::memory_order_relaxed);
+        bytes_allocated.fetch_add(stats.bytes_allocated, std::memory_order_relaxed);
+        for (size_t i = 0; i < SIZE_CLASSES; ++i) {
+            size_classes[i].fetch_add(stats.size_classes[i], std::memory_order_relaxed);
+        }
+    }
+
+    void reset() noexcept {
+        allocations.store(0, std::memory_order_relaxed);
+        deallocations.store(0, std::memory_order_relaxed);
+        bytes_allocated.store(0, std::memory_order_relaxed);
+        for (auto& count : size_classes) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+Slot g_slots[MAX_THREADS];
+Slot g_shared;  // Threads beyond MAX_THREADS, plus the totals of exited threads
+
+std::atomic<uint32_t> g_next_thread_index{0};
+std::atomic<bool> g_enabled{true};
+
+thread_local Slot* t_slot = nullptr;
+thread_local bool t_busy = false;  // Inside the tracer: nested allocations are not recorded
+
+/// Hands the slot back when its thread exits
+struct SlotOwner {
+    Slot* slot = nullptr;
+
+    ~SlotOwner() {
+        if (slot) {
+            g_shared.add(slot->snapshot());
+            slot->reset();
+            slot->in_use.store(false, std::memory_order_release);
+        }
+        t_slot = &g_shared;  // Later thread_local destructors may still free memory
+    }
+};
+
+thread_local SlotOwner t_owner;
+
+Slot* current_slot() noexcept {
+    if (t_slot) [[likely]] {
+        return t_slot;
+    }
+    Slot* slot = &g_shared;
+    for (auto& candidate : g_slots) {
+        if (!candidate.in_use.load(std::memory_order_relaxed) &&
+            !candidate.in_use.exchange(true, std::memory_order_acquire)) {
+            candidate.thread_index.store(g_next_thread_index.fetch_add(1, std::memory_order_relaxed),
+                                         std::memory_order_relaxed);
+            slot = &candidate;
+            break;
+        }
+    }
+    t_slot = slot;
+    t_owner.slot = slot == &g_shared ? nullptr : slot;  // Registers the exit hook
+    return slot;
+}
+
+/// Single-writer increment for private slots, atomic add for the shared one
+void bump(std::atomic<uint64_t>& counter, uint64_t value, bool shared) noexcept {
+    if (shared) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    } else {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// Large-allocation sampling
+// ============================================================================
+
+std::atomic<size_t> g_large_threshold{size_t{1} << 20};
+std::atomic<uint32_t> g_sample_every{1};
+std::atomic<uint64_t> g_large_seen{0};
+
+LargeAllocation g_samples[MAX_LARGE_SAMPLES];
+uint64_t g_samples_written = 0;  // Guarded by g_samples_lock
+std::atomic_flag g_samples_lock;
+
+void lock_samples() noexcept {
+    while (g_samples_lock.test_and_set(std::memory_order_acquire)) {
+        while (g_samples_lock.test(std::memory_order_relaxed)) {
+        }
+    }
+}
+
+void unlock_samples() noexcept {
+    g_samples_lock.clear(std::memory_order_release);
+}
+
+void sample_large(size_t bytes, const Slot* slot) noexcept {
+    const uint32_t every = g_sample_every.load(std::memory_order_relaxed);
+    if (every == 0 || g_large_seen.fetch_add(1, std::memory_order_relaxed) % every != 0) {
+        return;
+    }
+    LargeAllocation sample{};
+    sample.bytes = bytes;
+    sample.thread_index = slot == &g_shared ? SHARED_THREAD_INDEX
+                                            : slot->thread_index.load(std::memory_order_relaxed);
+#ifdef HPC_ALLOC_TRACER_BACKTRACE
+    const int depth = ::backtrace(sample.frames.data(), static_cast<int>(MAX_FRAMES));
+    sample.depth = static_cast<uint32_t>(std::max(depth, 0));
+#endif
+    lock_samples();
+    g_samples[g_samples_written++ % MAX_LARGE_SAMPLES] = sample;
+    unlock_samples();
+}
+
+#ifdef HPC_ALLOC_TRACER_BACKTRACE
+// The first backtrace() loads libgcc_s; do it before anything is measured
+[[maybe_unused]] const bool g_backtrace_ready = [] {
+    void* frame = nullptr;
+    return ::backtrace(&frame, 1) >= 0;
+}();
+#endif
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+void record_allocation(size_t bytes) noexcept {
+    if (t_busy || !g_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    t_busy = true;
+    Slot* slot = current_slot();
+    const bool shared = slot == &g_shared;
+    bump(slot->allocations, 1, shared);
+    bump(slot->bytes_allocated, bytes, shared);
+    bump(slot->size_classes[size_class(bytes)], 1, shared);
+    if (bytes >= g_large_threshold.load(std::memory_order_relaxed)) {
+        sample_large(bytes, slot);
+    }
+    t_busy = false;
+}
+
+void record_deallocation() noexcept {
+    if (t_busy || !g_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    t_busy = true;
+    Slot* slot = current_slot();
+    bump(slot->deallocations, 1, slot == &g_shared);
+    t_busy = false;
+}
+
+// ============================================================================
+// Raw allocation
+// ============================================================================
+
+#ifdef HPC_ALLOC_TRACER_MALLOC
+// malloc itself is traced: go underneath it so operator new counts once
+void* raw_malloc(size_t size) noexcept { return __libc_malloc(size); }
+void* raw_aligned(size_t alignment, size_t size) noexcept { return __libc_memalign(alignment, size); }
+void raw_free(void* ptr) noexcept { __libc_free(ptr); }
+#else
+void* raw_malloc(size_t size) noexcept { return std::malloc(size); }
+void* raw_aligned(size_t alignment, size_t size) noexcept {
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+}
+void raw_free(void* ptr) noexcept { std::free(ptr); }
+#endif
+
+void* allocate(size_t size, size_t alignment) {
+    const size_t request = size == 0 ? 1 : size;
+    for (;;) {
+        void* ptr = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? raw_aligned(alignment, request)
+                                                                 : raw_malloc(request);
+        if (ptr) [[likely]] {
+            record_allocation(size);
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocate_nothrow(size_t size, size_t alignment) noexcept {
+    try {
+        return allocate(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr) {
+        record_deallocation();
+        raw_free(ptr);
+    }
+}
+
+const char* size_class_label(size_t index) {
+    static constexpr const char* LABELS[] = {"1", "2", "4", "8", "16", "32", "64", "128", "256", "512", "1K", "2K", "4K", "8K", "16K", "32K", "64K", "128K", "256K", "512K", "1M", "2M", "4M", "8M", "16M", "32M", "64M", "128M", "256M", "512M", "1G", "inf"};
+    static_assert(std::size(LABELS) == SIZE_CLASSES);
+    return LABELS[index];
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Public interface
+// ============================================================================
+
+void set_enabled(bool enabled) noexcept {
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool enabled() noexcept {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+Stats thread_stats() noexcept {
+    return t_slot && t_slot != &g_shared ? t_slot->snapshot() : Stats{};
+}
+
+Stats total_stats() noexcept {
+    Stats total = g_shared.snapshot();
+    for (const auto& slot : g_slots) {
+        if (slot.in_use.load(std::memory_order_acquire)) {
+            total += slot.snapshot();
+        }
+    }
+    return total;
+}
+
+std::vector<ThreadStats> per_thread_stats() {
+    std::vector<ThreadStats> result;
+    result.reserve(MAX_THREADS + 1);
+    for (const auto& slot : g_slots) {
+        if (slot.in_use.load(std::memory_order_acquire)) {
+            result.push_back({slot.thread_index.load(std::memory_order_relaxed), slot.snapshot()});
+        }
+    }
+    std::sort(result.begin(), result.end(),
+              [](const ThreadStats& a, const ThreadStats& b) { return a.thread_index < b.thread_index; });
+    const Stats shared = g_shared.snapshot();
+    if (shared.allocations != 0 || shared.deallocations != 0) {
+        result.push_back({SHARED_THREAD_INDEX, shared});
+    }
+    return result;
+}
+
+void set_large_allocation_sampling(size_t threshold_bytes, uint32_t sample_every) noexcept {
+    g_large_threshold.store(threshold_bytes, std::memory_order_relaxed);
+    g_sample_every.store(sample_every, std::memory_order_relaxed);
+}
+
+std::vector<LargeAllocation> large_allocations() {
+    std::vector<LargeAllocation> result;
+    result.reserve(MAX_LARGE_SAMPLES);  // No allocation while holding the lock
+    lock_samples();
+    const uint64_t written = g_samples_written;
+    const uint64_t first = written > MAX_LARGE_SAMPLES ? written - MAX_LARGE_SAMPLES : 0;
+    for (uint64_t i = first; i < written; ++i) {
+        result.push_back(g_samples[i % MAX_LARGE_SAMPLES]);
+    }
+    unlock_samples();
+    return result;
+}
+
+void clear_large_allocations() noexcept {
+    lock_samples();
+    g_samples_written = 0;
+    unlock_samples();
+}
+
+void print_report(std::ostream& os) {
+    const auto threads = per_thread_stats();
+    Stats total;
+    os << "=== Allocation report ===\n";
+    os << std::setw(8) << "thread" << std::setw(14) << "allocs" << std::setw(14) << "frees"
+       << std::setw(16) << "bytes" << "\n";
+    for (const auto& [index, stats] : threads) {
+        if (index == SHARED_THREAD_INDEX) {
+            os << std::setw(8) << "exited";
+        } else {
+            os << std::setw(8) << index;
+        }
+        os << std::setw(14) << stats.allocations << std::setw(14) << stats.deallocations
+           << std::setw(16) << stats.bytes_allocated << "\n";
+        total += stats;
+    }
+
+    os << "\nSize classes (bytes <=):\n";
+    for (size_t i = 0; i < SIZE_CLASSES; ++i) {
+        if (total.size_classes[i] != 0) {
+            os << std::setw(8) << size_class_label(i) << std::setw(14) << total.size_classes[i] << "\n";
+        }
+    }
+
+    struct Site {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+    std::map<std::vector<void*>, Site> sites;
+    for (const auto& sample : large_allocations()) {
+        auto& site = sites[std::vector<void*>(sample.frames.begin(), sample.frames.begin() + sample.depth)];
+        ++site.count;
+        site.bytes += sample.bytes;
+    }
+    if (sites.empty()) {
+        return;
+    }
+    os << "\nSampled large allocations (>= " << g_large_threshold.load(std::memory_order_relaxed)
+       << " bytes) by call site:\n";
+    for (const auto& [frames, site] : sites) {
+        os << "  " << site.count << " allocations, " << site.bytes << " bytes\n";
+#ifdef HPC_ALLOC_TRACER_BACKTRACE
+        char** symbols = ::backtrace_symbols(frames.data(), static_cast<int>(frames.size()));
+        for (size_t i = 0; symbols && i < frames.size(); ++i) {
+            os << "    " << symbols[i] << "\n";
+        }
+        std::free(symbols);
+#endif
+    }
+}
+
+} // namespace hpc::bench::alloc_tracer
+
+// ============================================================================
+// Replacement functions
+// ============================================================================
+
+namespace tracer = hpc::bench::alloc_tracer;
+
+void* operator new(std::size_t size) { return tracer::allocate(size, 0); }
+void* operator new[](std::size_t size) { return tracer::allocate(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return tracer::allocate_nothrow(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return tracer::allocate_nothrow(size, 0); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return tracer::allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return tracer::allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return tracer::allocate_nothrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return tracer::allocate_nothrow(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept { tracer::deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { tracer::deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { tracer::deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { tracer::deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { tracer::deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { tracer::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { tracer::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { tracer::deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { tracer::deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { tracer::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracer::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracer::deallocate(ptr); }
+
+#ifdef HPC_ALLOC_TRACER_MALLOC
+extern "C" {
+
+void* malloc(size_t size) noexcept {
+    void* ptr = __libc_malloc(size);
+    if (ptr) {
+        tracer::record_allocation(size);
+    }
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    void* ptr = __libc_calloc(count, size);
+    if (ptr) {
+        tracer::record_allocation(count * size);
+    }
+    return ptr;
+}
+
+/// Counted as a free of the old block and an allocation of the new one
+void* realloc(void* ptr, size_t size) noexcept {
+    void* result = __libc_realloc(ptr, size);
+    if (ptr && (result || size == 0)) {
+        tracer::record_deallocation();
+    }
+    if (result) {
+        tracer::record_allocation(size);
+    }
+    return result;
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+    void* ptr = __libc_memalign(alignment, size);
+    if (ptr) {
+        tracer::record_allocation(size);
+    }
+    return ptr;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) noexcept {
+    if (alignment % sizeof(void*) != 0 || !std::has_single_bit(alignment)) {
+        return EINVAL;
+    }
+    void* ptr = memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *out = ptr;
+    return 0;
+}
+
+void free(void* ptr) noexcept {
+    if (ptr) {
+        tracer::record_deallocation();
+    }
+    __libc_free(ptr);
+}
+
+} // extern "C"
+#endif
@@ -0,0 +1,175 @@
+#pragma once
+/**
+ * @file alloc_tracer.hpp
+ * @brief Opt-in global allocation tracer for benchmarks
+ *
+ * Linking the alloc_tracer library (benchmarks/CMakeLists.txt) replaces the
+ * global operator new/delete for the whole executable, so every allocation
+ * is counted: the benchmark's own containers, the standard library, third
+ * party code. Configuring with -DHPC_ALLOC_TRACER_MALLOC=ON also interposes
+ * malloc/calloc/realloc/free (glibc only).
+ *
+ * Recorded per thread:
+ *   - allocation and deallocation counts, requested bytes
+ *   - a power-of-two size-class histogram
+ * and, for allocations above a threshold, a sampled call stack.
+ *
+ * Each thread writes only its own slot, so recording costs a handful of
+ * uncontended stores. Readers see relaxed snapshots: exact once the
+ * measured threads have stopped, approximate while they run.
+ *
+ * @code
+ * static void BM_Build(benchmark::State& state) {
+ *     hpc::bench::AllocationCounter allocs(state);  // allocs_per_iter, bytes_per_iter
+ *     for (auto _ : state) { ... }
+ *     allocs.stop();
+ *     state.SetItemsProcessed(state.iterations());
+ * }
+ * @endcode
+ */
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace hpc::bench {
+
+namespace alloc_tracer {
+
+/// Size classes: class 0 holds 0-1 bytes, class k holds (2^(k-1), 2^k]
+constexpr size_t SIZE_CLASSES = 32;
+
+/// Threads with a private slot; later threads share one overflow slot
+constexpr size_t MAX_THREADS = 256;
+
+/// Stack depth captured for sampled large allocations
+constexpr size_t MAX_FRAMES = 16;
+
+/// Large-allocation samples kept (oldest are overwritten)
+constexpr size_t MAX_LARGE_SAMPLES = 256;
+
+/// Thread index reported for the shared overflow slot
+constexpr uint32_t SHARED_THREAD_INDEX = UINT32_MAX;
+
+constexpr size_t size_class(size_t bytes) noexcept {
+    if (bytes <= 1) {
+        return 0;
+    }
+    const auto width = static_cast<size_t>(std::bit_width(bytes - 1));
+    return width < SIZE_CLASSES ? width : SIZE_CLASSES - 1;
+}
+
+struct Stats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes_allocated = 0;
+    std::array<uint64_t, SIZE_CLASSES> size_classes{};
+
+    Stats& operator+=(const Stats& other) noexcept {
+        allocations += other.allocations;
+        deallocations += other.deallocations;
+        bytes_allocated += other.bytes_allocated;
+        for (size_t i = 0; i < SIZE_CLASSES; ++i) {
+            size_classes[i] += other.size_classes[i];
+        }
+        return *this;
+    }
+
+    /// Difference between two snapshots of the same counters
+    friend Stats operator-(Stats later, const Stats& earlier) noexcept {
+        later.allocations -= earlier.allocations;
+        later.deallocations -= earlier.deallocations;
+        later.bytes_allocated -= earlier.bytes_allocated;
+        for (size_t i = 0; i < SIZE_CLASSES; ++i) {
+            later.size_classes[i] -= earlier.size_classes[i];
+        }
+        return later;
+    }
+};
+
+struct ThreadStats {
+    uint32_t thread_index;  ///< Order of first allocation; SHARED_THREAD_INDEX for overflow
+    Stats stats;
+};
+
+struct LargeAllocation {
+    size_t bytes;
+    uint32_t thread_index;
+    uint32_t depth;
+    std::array<void*, MAX_FRAMES> frames;
+};
+
+/// Pause or resume recording for all threads (recording starts enabled)
+void set_enabled(bool enabled) noexcept;
+bool enabled() noexcept;
+
+/// Counters of the calling thread
+Stats thread_stats() noexcept;
+
+/// Counters of all threads, including threads that have exited
+Stats total_stats() noexcept;
+
+/// One entry per live thread that has allocated, plus exited threads'
+/// totals under SHARED_THREAD_INDEX
+std::vector<ThreadStats> per_thread_stats();
+
+/**
+ * Capture a call stack for every @p sample_every-th allocation of at least
+ * @p threshold_bytes (default: every allocation of 1 MiB or more).
+ * @p sample_every == 0 disables sampling.
+ */
+void set_large_allocation_sampling(size_t threshold_bytes, uint32_t sample_every) noexcept;
+
+/// Sampled large allocations, oldest first
+std::vector<LargeAllocation> large_allocations();
+void clear_large_allocations() noexcept;
+
+/// Per-thread counters, the size-class histogram and large-allocation
+/// call sites grouped by stack (symbol names need -rdynamic)
+void print_report(std::ostream& os);
+
+} // namespace alloc_tracer
+
+/**
+ * @brief Report allocations per iteration as benchmark counters
+ *
+ * Construct right before the timing loop and call stop() right after it
+ * (the destructor stops if stop() was not called). Setting counters such
+ * as SetItemsProcessed() allocates, so do that after stop(). Counts every
+ * thread in the process, so background threads that allocate during the
+ * loop are included.
+ */
+class AllocationCounter {
+public:
+    explicit AllocationCounter(benchmark::State& state) noexcept
+        : state_(state), start_(alloc_tracer::total_stats()) {}
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+    ~AllocationCounter() { stop(); }
+
+    /// Sets allocs_per_iter and bytes_per_iter
+    void stop() {
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        const alloc_tracer::Stats delta = alloc_tracer::total_stats() - start_;
+        state_.counters["allocs_per_iter"] = benchmark::Counter(
+            static_cast<double>(delta.allocations), benchmark::Counter::kAvgIterations);
+        state_.counters["bytes_per_iter"] = benchmark::Counter(
+            static_cast<double>(delta.bytes_allocated), benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State& state_;
+    alloc_tracer::Stats start_;
+    bool stopped_ = false;
+};
+
+} // namespace hpc::bench
@@ -173,8 +173,20 @@ inline void export_suite_to_json(const std::string& filename,
         file << "      \"name\": \"" << r.name << "\",\n";
         file << "      \"iterations\": " << r.iterations << ",\n";
         file << "      \"real_time\": " << r.real_time_ns << ",\n";
-        file << "      \"cpu_time\": " << r.cpu_time_ns << "\n";
-        file << "    }";
+        file << "      \"cpu_time\": " << r.cpu_time_ns;
+
+        if (!r.counters.empty()) {
+            file << ",\n      \"counters\": {\n";
+            size_t counter_idx = 0;
+            for (const auto& [key, value] : r.counters) {
+                file << "        \"" << key << "\": " << value;
+                if (++counter_idx < r.counters.size()) file << ",";
+                file << "\n";
+            }
+            file << "      }";
+        }
+
+        file << "\n    }";
         if (i < suite.results.size() - 1) file << ",";
         file << "\n";
     }
@@ -183,6 +195,45 @@ inline void export_suite_to_json(const std::string& filename,
     file << "}\n";
 }
 
+/**
+ * @brief Console reporter that also collects each run into a BenchmarkSuite
+ *
+ * User counters set through state.counters (e.g. latency percentiles) are
+ * kept, so they reach the file written by export_suite_to_json. Aggregate
+ * rows (mean/median/stddev of repetitions) are printed but not collected.
+ *
+ * @code
+ * hpc::bench::BenchmarkSuite suite;
+ * hpc::bench::SuiteReporter reporter(suite);
+ * benchmark::RunSpecifiedBenchmarks(&reporter);
+ * hpc::bench::export_suite_to_json("results.json", suite);
+ * @endcode
+ */
+class SuiteReporter : public benchmark::ConsoleReporter {
+public:
+    explicit SuiteReporter(BenchmarkSuite& suite) : suite_(suite) {}
+
+    void ReportRuns(const std::vector<Run>& runs) override {
+        for (const auto& run : runs) {
+            if (run.run_type == Run::RT_Aggregate || run.iterations <= 0) {
+                continue;
+            }
+            const double iterations = static_cast<double>(run.iterations);
+            BenchmarkResult result(run.benchmark_name(), run.iterations,
+                                   run.real_accumulated_time * 1e9 / iterations,
+                                   run.cpu_accumulated_time * 1e9 / iterations);
+            for (const auto& [key, counter] : run.counters) {
+                result.counters[key] = counter.value;
+            }
+            suite_.results.push_back(std::move(result));
+        }
+        ConsoleReporter::ReportRuns(runs);
+    }
+
+private:
+    BenchmarkSuite& suite_;
+};
+
 /**
  * @brief Calculate speedup between two times
  */
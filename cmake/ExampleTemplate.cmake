@@ -9,6 +9,7 @@
 #     [BENCHMARK_SOURCES <benchmark source files...>]
 #     [INCLUDE_DIRS <include directories...>]
 #     [LIBRARIES <libraries to link...>]
+#     [BENCHMARK_LIBRARIES <libraries to link into the benchmark only...>]
 #     [ENABLE_OPENMP]
 #     [ENABLE_SIMD <SSE|AVX|AVX2|AVX512>]
 # )
@@ -20,7 +21,7 @@ function(hpc_add_example)
         ARG
         "ENABLE_OPENMP"
         "NAME"
-        "SOURCES;BENCHMARK_SOURCES;INCLUDE_DIRS;LIBRARIES;ENABLE_SIMD"
+        "SOURCES;BENCHMARK_SOURCES;INCLUDE_DIRS;LIBRARIES;BENCHMARK_LIBRARIES;ENABLE_SIMD"
         ${ARGN}
     )
     
@@ -83,6 +84,10 @@ function(hpc_add_example)
             target_link_libraries(${bench_name} PRIVATE ${ARG_LIBRARIES})
         endif()
         
+        if(ARG_BENCHMARK_LIBRARIES)
+            target_link_libraries(${bench_name} PRIVATE ${ARG_BENCHMARK_LIBRARIES})
+        endif()
+        
         if(ARG_ENABLE_OPENMP AND OpenMP_CXX_FOUND)
             target_link_libraries(${bench_name} PRIVATE OpenMP::OpenMP_CXX)
         endif()
@@ -4,15 +4,22 @@
  * 
  * Property 4: Cache-Line Aligned Counters Eliminate False Sharing
  * Validates: Requirements 2.2, 5.3
+ *
+ * The second argument is a hpc::concurrency::Placement: the cost of a
+ * bouncing line depends on whether the threads are SMT siblings (compact),
+ * separate cores, or in different L3/NUMA domains (scatter).
  */
 
 #include <benchmark/benchmark.h>
+#include "topology.hpp"
 #include <atomic>
 #include <thread>
 #include <vector>
 
 namespace {
 
+using hpc::concurrency::Placement;
+
 constexpr size_t CACHE_LINE_SIZE = 64;
 
 // Packed counters (false sharing)
@@ -25,13 +32,15 @@ struct alignas(CACHE_LINE_SIZE) PaddedCounter {
     std::atomic<int64_t> value{0};
 };
 
-void increment_packed(PackedCounters& c, int id, int64_t n) {
+void increment_packed(PackedCounters& c, int id, int64_t n, Placement placement) {
+    hpc::concurrency::pin_current_thread(placement, static_cast<unsigned int>(id));
     for (int64_t i = 0; i < n; ++i) {
         c.counters[id % 4].fetch_add(1, std::memory_order_relaxed);
     }
 }
 
-void increment_padded(PaddedCounter* counters, int id, int64_t n) {
+void increment_padded(PaddedCounter* counters, int id, int64_t n, Placement placement) {
+    hpc::concurrency::pin_current_thread(placement, static_cast<unsigned int>(id));
     for (int64_t i = 0; i < n; ++i) {
         counters[id % 4].value.fetch_add(1, std::memory_order_relaxed);
     }
@@ -39,6 +48,7 @@ void increment_padded(PaddedCounter* counters, int id, int64_t n) {
 
 static void BM_FalseSharing_Packed(benchmark::State& state) {
     const int num_threads = static_cast<int>(state.range(0));
+    const auto placement = static_cast<Placement>(state.range(1));
     const int64_t iterations = 100000;
     
     for (auto _ : state) {
@@ -46,7 +56,7 @@ static void BM_FalseSharing_Packed(benchmark::State& state) {
         std::vector<std::thread> threads;
         
         for (int t = 0; t < num_threads; ++t) {
-            threads.emplace_back(increment_packed, std::ref(counters), t, iterations);
+            threads.emplace_back(increment_packed, std::ref(counters), t, iterations, placement);
         }
         
         for (auto& thread : threads) {
@@ -57,10 +67,12 @@ static void BM_FalseSharing_Packed(benchmark::State& state) {
     }
     
     state.SetItemsProcessed(state.iterations() * num_threads * iterations);
+    state.SetLabel(hpc::concurrency::placement_name(placement));
 }
 
 static void BM_FalseSharing_Padded(benchmark::State& state) {
     const int num_threads = static_cast<int>(state.range(0));
+    const auto placement = static_cast<Placement>(state.range(1));
     const int64_t iterations = 100000;
     
     for (auto _ : state) {
@@ -68,7 +80,7 @@ static void BM_FalseSharing_Padded(benchmark::State& state) {
         std::vector<std::thread> threads;
         
         for (int t = 0; t < num_threads; ++t) {
-            threads.emplace_back(increment_padded, counters.data(), t, iterations);
+            threads.emplace_back(increment_padded, counters.data(), t, iterations, placement);
         }
         
         for (auto& thread : threads) {
@@ -79,15 +91,26 @@ static void BM_FalseSharing_Padded(benchmark::State& state) {
     }
     
     state.SetItemsProcessed(state.iterations() * num_threads * iterations);
+    state.SetLabel(hpc::concurrency::placement_name(placement));
+}
+
+// Thread counts x placement policies
+void thread_placements(benchmark::internal::Benchmark* b) {
+    for (int threads : {1, 2, 4, 8}) {
+        for (Placement p : {Placement::None, Placement::Compact, Placement::Scatter}) {
+            b->Args({threads, static_cast<int64_t>(p)});
+        }
+    }
+    b->ArgNames({"threads", "placement"});
 }
 
 BENCHMARK(BM_FalseSharing_Packed)
-    ->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+    ->Apply(thread_placements)
     ->Unit(benchmark::kMillisecond)
     ->UseRealTime();
 
 BENCHMARK(BM_FalseSharing_Padded)
-    ->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+    ->Apply(thread_placements)
     ->Unit(benchmark::kMillisecond)
     ->UseRealTime();
 
@@ -0,0 +1,229 @@
+/**
+ * @file compile_time_bench.cpp
+ * @brief Benchmark for compile-time string lookup
+ *
+ * Looks up 1024 random keys drawn from a set of 10, 100 or 1000 keys
+ * ("key_0", "key_1", ...) four ways:
+ *
+ *   IfChain        compare against each key in turn (what dispatch code
+ *                  written as a chain of ifs does)
+ *   UnorderedMap   std::unordered_map<std::string_view, size_t>
+ *   HashSwitch     switch on fnv1a_hash() with one case per "key"_hash,
+ *                  then compare the matched key; the compiler turns the
+ *                  sparse case values into a binary search
+ *   PerfectHash    make_perfect_hash(): one hash, one compare
+ *
+ * Every variant returns the key's position, so the work after the lookup
+ * is identical.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/perfect_hash.hpp"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using hpc::compile_time::fnv1a_hash;
+using hpc::compile_time::make_perfect_hash;
+
+constexpr size_t NPOS = static_cast<size_t>(-1);
+constexpr size_t QUERIES = 1024;
+
+//------------------------------------------------------------------------------
+// Key sets, generated at compile time
+//------------------------------------------------------------------------------
+
+using KeyChars = std::array<char, 12>;
+
+template<size_t N>
+constexpr std::array<KeyChars, N> make_key_chars() {
+    std::array<KeyChars, N> chars{};
+    for (size_t i = 0; i < N; ++i) {
+        size_t len = 0;
+        for (char c : std::string_view("key_")) {
+            chars[i][len++] = c;
+        }
+        std::array<char, 8> digits{};
+        size_t count = 0;
+        for (size_t v = i; count == 0 || v != 0; v /= 10) {
+            digits[count++] = static_cast<char>('0' + v % 10);
+        }
+        while (count > 0) {
+            chars[i][len++] = digits[--count];
+        }
+    }
+    return chars;
+}
+
+template<size_t N>
+inline constexpr std::array<KeyChars, N> KEY_CHARS = make_key_chars<N>();
+
+template<size_t N>
+constexpr std::array<std::string_view, N> make_keys() {
+    std::array<std::string_view, N> keys{};
+    for (size_t i = 0; i < N; ++i) {
+        keys[i] = std::string_view(KEY_CHARS<N>[i].data());
+    }
+    return keys;
+}
+
+template<size_t N>
+inline constexpr std::array<std::string_view, N> KEYS = make_keys<N>();
+
+template<size_t N>
+constexpr std::array<uint64_t, N> make_key_hashes() {
+    std::array<uint64_t, N> hashes{};
+    for (size_t i = 0; i < N; ++i) {
+        hashes[i] = fnv1a_hash(KEYS<N>[i]);
+    }
+    return hashes;
+}
+
+template<size_t N>
+inline constexpr std::array<uint64_t, N> KEY_HASHES = make_key_hashes<N>();
+
+/// Random keys of the set, copied to the heap so no lookup folds away
+template<size_t N>
+std::vector<std::string> make_queries() {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, N - 1);
+    std::vector<std::string> queries;
+    for (size_t q = 0; q < QUERIES; ++q) {
+        queries.emplace_back(KEYS<N>[pick(rng)]);
+    }
+    return queries;
+}
+
+//------------------------------------------------------------------------------
+// Lookups
+//------------------------------------------------------------------------------
+
+template<size_t N>
+size_t if_chain_lookup(std::string_view key) {
+    for (size_t i = 0; i < N; ++i) {
+        if (key == KEYS<N>[i]) {
+            return i;
+        }
+    }
+    return NPOS;
+}
+
+// One case per key, as a hand-written `case "key_7"_hash:` would be. Case
+// numbers are pasted onto a leading 1 (10-19, 100-199, ...) so none is an
+// octal literal; FIRST maps them back to key positions.
+#define HASH_CASE(x) \
+    case KEY_HASHES<N>[(x) - FIRST]: return key == KEYS<N>[(x) - FIRST] ? (x) - FIRST : NPOS;
+#define HASH_CASES_10(p) \
+    HASH_CASE(p##0) HASH_CASE(p##1) HASH_CASE(p##2) HASH_CASE(p##3) HASH_CASE(p##4) \
+    HASH_CASE(p##5) HASH_CASE(p##6) HASH_CASE(p##7) HASH_CASE(p##8) HASH_CASE(p##9)
+#define HASH_CASES_100(p) \
+    HASH_CASES_10(p##0) HASH_CASES_10(p##1) HASH_CASES_10(p##2) HASH_CASES_10(p##3) \
+    HASH_CASES_10(p##4) HASH_CASES_10(p##5) HASH_CASES_10(p##6) HASH_CASES_10(p##7) \
+    HASH_CASES_10(p##8) HASH_CASES_10(p##9)
+#define HASH_CASES_1000(p) \
+    HASH_CASES_100(p##0) HASH_CASES_100(p##1) HASH_CASES_100(p##2) HASH_CASES_100(p##3) \
+    HASH_CASES_100(p##4) HASH_CASES_100(p##5) HASH_CASES_100(p##6) HASH_CASES_100(p##7) \
+    HASH_CASES_100(p##8) HASH_CASES_100(p##9)
+
+template<size_t N>
+size_t switch_lookup(std::string_view key);
+
+template<>
+size_t switch_lookup<10>(std::string_view key) {
+    constexpr size_t N = 10, FIRST = 10;
+    switch (fnv1a_hash(key)) {
+        HASH_CASES_10(1)
+        default: return NPOS;
+    }
+}
+
+template<>
+size_t switch_lookup<100>(std::string_view key) {
+    constexpr size_t N = 100, FIRST = 100;
+    switch (fnv1a_hash(key)) {
+        HASH_CASES_100(1)
+        default: return NPOS;
+    }
+}
+
+template<>
+size_t switch_lookup<1000>(std::string_view key) {
+    constexpr size_t N = 1000, FIRST = 1000;
+    switch (fnv1a_hash(key)) {
+        HASH_CASES_1000(1)
+        default: return NPOS;
+    }
+}
+
+#undef HASH_CASES_1000
+#undef HASH_CASES_100
+#undef HASH_CASES_10
+#undef HASH_CASE
+
+template<size_t N, typename Lookup>
+void run_lookups(benchmark::State& state, Lookup lookup) {
+    const std::vector<std::string> queries = make_queries<N>();
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (const std::string& query : queries) {
+            sum += lookup(query);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(QUERIES));
+}
+
+//------------------------------------------------------------------------------
+// Benchmarks
+//------------------------------------------------------------------------------
+
+template<size_t N>
+static void BM_Lookup_IfChain(benchmark::State& state) {
+    run_lookups<N>(state, [](std::string_view key) { return if_chain_lookup<N>(key); });
+}
+
+template<size_t N>
+static void BM_Lookup_UnorderedMap(benchmark::State& state) {
+    std::unordered_map<std::string_view, size_t> map;
+    for (size_t i = 0; i < N; ++i) {
+        map.emplace(KEYS<N>[i], i);
+    }
+    run_lookups<N>(state, [&map](std::string_view key) {
+        const auto it = map.find(key);
+        return it == map.end() ? NPOS : it->second;
+    });
+}
+
+template<size_t N>
+static void BM_Lookup_HashSwitch(benchmark::State& state) {
+    run_lookups<N>(state, [](std::string_view key) { return switch_lookup<N>(key); });
+}
+
+template<size_t N>
+static void BM_Lookup_PerfectHash(benchmark::State& state) {
+    static constexpr auto TABLE = make_perfect_hash(KEYS<N>);
+    run_lookups<N>(state, [](std::string_view key) { return TABLE.index_of(key); });
+}
+
+BENCHMARK_TEMPLATE(BM_Lookup_IfChain, 10);
+BENCHMARK_TEMPLATE(BM_Lookup_IfChain, 100);
+BENCHMARK_TEMPLATE(BM_Lookup_IfChain, 1000);
+BENCHMARK_TEMPLATE(BM_Lookup_UnorderedMap, 10);
+BENCHMARK_TEMPLATE(BM_Lookup_UnorderedMap, 100);
+BENCHMARK_TEMPLATE(BM_Lookup_UnorderedMap, 1000);
+BENCHMARK_TEMPLATE(BM_Lookup_HashSwitch, 10);
+BENCHMARK_TEMPLATE(BM_Lookup_HashSwitch, 100);
+BENCHMARK_TEMPLATE(BM_Lookup_HashSwitch, 1000);
+BENCHMARK_TEMPLATE(BM_Lookup_PerfectHash, 10);
+BENCHMARK_TEMPLATE(BM_Lookup_PerfectHash, 100);
+BENCHMARK_TEMPLATE(BM_Lookup_PerfectHash, 1000);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -4,10 +4,22 @@
  * 
  * Property 6: Move Semantics Performance Advantage
  * Validates: Requirements 3.2
+ *
+ * The Sized_* benchmarks compare the heap-only Buffer with SboBuffer<64>
+ * from 8 B to 1 MB: below 64 bytes SboBuffer never allocates, and it does
+ * not zero-fill unless asked to.
+ *
+ * The Growth_* benchmarks append 1K-10M empty Buffer-like handles without
+ * reserve(): std::vector moves every element on each reallocation,
+ * relocating_vector grows a trivially relocatable handle with realloc().
  */
 
 #include <benchmark/benchmark.h>
+#include "../include/relocating_vector.hpp"
+#include "../include/sbo_buffer.hpp"
 #include <cstring>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -126,6 +138,161 @@ static void BM_Vector_EmplaceBack(benchmark::State& state) {
     }
 }
 
+//------------------------------------------------------------------------------
+// Buffer vs SboBuffer across sizes
+//------------------------------------------------------------------------------
+
+using SmallBuffer = hpc::move_semantics::SboBuffer<64>;
+
+template<typename B> B make_buffer(size_t size);
+
+template<> Buffer make_buffer<Buffer>(size_t size) {
+    return Buffer(size);
+}
+
+template<> SmallBuffer make_buffer<SmallBuffer>(size_t size) {
+    return SmallBuffer(size, hpc::move_semantics::uninitialized);
+}
+
+/// Construct and destroy; Buffer allocates and fills, SmallBuffer neither below 64 B
+template<typename B>
+static void BM_Sized_Create(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        B buf = make_buffer<B>(size);
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// SboBuffer with an explicit fill, for a like-for-like comparison with Buffer
+static void BM_Sized_Create_SboFilled(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        SmallBuffer buf(size, 'x');
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename B>
+static void BM_Sized_Copy(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const B source = make_buffer<B>(size);
+    for (auto _ : state) {
+        B copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Two moves per iteration (there and back), no timer pauses
+template<typename B>
+static void BM_Sized_Move(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    B a = make_buffer<B>(size);
+    for (auto _ : state) {
+        B b(std::move(a));
+        benchmark::DoNotOptimize(b);
+        a = std::move(b);
+        benchmark::DoNotOptimize(a);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+/// Build a vector of 100 buffers from temporaries
+template<typename B>
+static void BM_Sized_VectorOfBuffers(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    constexpr int count = 100;
+    for (auto _ : state) {
+        std::vector<B> vec;
+        vec.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            vec.push_back(make_buffer<B>(size));
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void buffer_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(8, 1024 * 1024);
+}
+
+//------------------------------------------------------------------------------
+// Growth without reserve: per-element moves vs realloc()
+//------------------------------------------------------------------------------
+
+/// Buffer's layout and move semantics; Relocatable selects the opt-in tag
+template<bool Relocatable>
+class Handle {
+public:
+    using trivially_relocatable = std::bool_constant<Relocatable>;
+    
+    Handle() = default;
+    ~Handle() { delete[] data_; }
+    
+    Handle(Handle&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+    
+    Handle& operator=(Handle&& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+    
+private:
+    char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template<typename Vec>
+static void BM_Growth(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Vec vec;
+        for (size_t i = 0; i < n; ++i) {
+            vec.emplace_back();
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+/// Lower bound: one allocation, no growth
+static void BM_Growth_StdVectorReserved(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<Handle<false>> vec;
+        vec.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            vec.emplace_back();
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+void growth_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(10)->Range(1000, 10'000'000)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_Growth, std::vector<Handle<false>>)->Apply(growth_sizes);
+BENCHMARK(BM_Growth_StdVectorReserved)->Apply(growth_sizes);
+BENCHMARK_TEMPLATE(BM_Growth, hpc::vector_reserve::relocating_vector<Handle<false>>)->Apply(growth_sizes);
+BENCHMARK_TEMPLATE(BM_Growth, hpc::vector_reserve::relocating_vector<Handle<true>>)->Apply(growth_sizes);
+
+BENCHMARK_TEMPLATE(BM_Sized_Create, Buffer)->Apply(buffer_sizes);
+BENCHMARK_TEMPLATE(BM_Sized_Create, SmallBuffer)->Apply(buffer_sizes);
+BENCHMARK(BM_Sized_Create_SboFilled)->Apply(buffer_sizes);
+BENCHMARK_TEMPLATE(BM_Sized_Copy, Buffer)->Apply(buffer_sizes);
+BENCHMARK_TEMPLATE(BM_Sized_Copy, SmallBuffer)->Apply(buffer_sizes);
+BENCHMARK_TEMPLATE(BM_Sized_Move, Buffer)->Apply(buffer_sizes);
+BENCHMARK_TEMPLATE(BM_Sized_Move, SmallBuffer)->Apply(buffer_sizes);
+BENCHMARK_TEMPLATE(BM_Sized_VectorOfBuffers, Buffer)->Apply(buffer_sizes);
+BENCHMARK_TEMPLATE(BM_Sized_VectorOfBuffers, SmallBuffer)->Apply(buffer_sizes);
+
 BENCHMARK(BM_Copy_Construction)
     ->RangeMultiplier(4)
     ->Range(1024, 4 * 1024 * 1024)
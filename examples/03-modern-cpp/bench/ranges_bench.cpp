@@ -5,9 +5,14 @@
  * Validates: Requirements 3.4
  */
 
+#include "parallel_pipeline.hpp"
+#include "simd_filter.hpp"
+#include "simd_ranges.hpp"
 #include <benchmark/benchmark.h>
 #include <algorithm>
+#include <cstdint>
 #include <numeric>
+#include <random>
 #include <ranges>
 #include <vector>
 
@@ -59,6 +64,21 @@ static void BM_Transform_Ranges(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
 }
 
+static void BM_Transform_SimdRanges(benchmark::State& state) {
+    using namespace hpc::ranges;
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<int> input(n);
+    std::vector<int> output(n);
+    std::iota(input.begin(), input.end(), 0);
+    
+    for (auto _ : state) {
+        input | simd_transform([](int x) { return x * 2 + 1; }) | simd_into(output);
+        benchmark::DoNotOptimize(output);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
 static void BM_Filter_RawLoop(benchmark::State& state) {
     const size_t n = static_cast<size_t>(state.range(0));
     std::vector<int> input(n);
@@ -95,6 +115,53 @@ static void BM_Filter_RangesView(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
 }
 
+static void BM_Filter_RawLoopSum(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<int> input(n);
+    std::iota(input.begin(), input.end(), 0);
+    
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (int x : input) {
+            if (x % 2 == 0) {
+                sum += x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+static void BM_Filter_SimdRanges(benchmark::State& state) {
+    using namespace hpc::ranges;
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<int> input(n);
+    std::iota(input.begin(), input.end(), 0);
+    
+    for (auto _ : state) {
+        auto output = input | simd_filter([](int x) { return x % 2 == 0; }) | simd_to_vector();
+        benchmark::DoNotOptimize(output);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+static void BM_Filter_SimdRangesSum(benchmark::State& state) {
+    using namespace hpc::ranges;
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<int> input(n);
+    std::iota(input.begin(), input.end(), 0);
+    
+    for (auto _ : state) {
+        int64_t sum = input | simd_filter([](int x) { return x % 2 == 0; })
+                            | simd_reduce(int64_t{0});
+        benchmark::DoNotOptimize(sum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
 static void BM_Chain_RawLoop(benchmark::State& state) {
     const size_t n = static_cast<size_t>(state.range(0));
     std::vector<int> input(n);
@@ -132,6 +199,251 @@ static void BM_Chain_RangesView(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
 }
 
+static void BM_Chain_SimdRanges(benchmark::State& state) {
+    using namespace hpc::ranges;
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<int> input(n);
+    std::iota(input.begin(), input.end(), 0);
+    
+    for (auto _ : state) {
+        int64_t sum = input | simd_filter([](int x) { return x % 2 == 0; })
+                            | simd_transform([](int x) { return x * 2 + 1; })
+                            | simd_reduce(int64_t{0});
+        benchmark::DoNotOptimize(sum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+//------------------------------------------------------------------------------
+// Selectivity sweep: keep x < p over uniform values in [0, 100), so p is
+// the percentage kept. Branches mispredict most near 50%.
+//------------------------------------------------------------------------------
+
+constexpr size_t SELECT_N = 1 << 20;
+
+template<typename T>
+std::vector<T> percent_values(size_t n) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 99);
+    std::vector<T> values(n);
+    for (auto& v : values) {
+        v = static_cast<T>(dist(rng));
+    }
+    return values;
+}
+
+static void BM_Select_BranchyPushBack(benchmark::State& state) {
+    const auto input = percent_values<int32_t>(SELECT_N);
+    const auto p = static_cast<int32_t>(state.range(0));
+    std::vector<int32_t> output;
+    output.reserve(SELECT_N);
+    
+    for (auto _ : state) {
+        output.clear();
+        for (int32_t x : input) {
+            if (x < p) {
+                output.push_back(x);
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SELECT_N));
+}
+
+static void BM_Select_BranchlessScalar(benchmark::State& state) {
+    const auto input = percent_values<int32_t>(SELECT_N);
+    const auto p = static_cast<int32_t>(state.range(0));
+    std::vector<int32_t> output(SELECT_N);
+    
+    for (auto _ : state) {
+        size_t n = 0;
+        for (int32_t x : input) {
+            output[n] = x;
+            n += static_cast<size_t>(x < p);
+        }
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SELECT_N));
+}
+
+static void BM_Select_SimdInt32(benchmark::State& state) {
+    const auto input = percent_values<int32_t>(SELECT_N);
+    const auto p = static_cast<int32_t>(state.range(0));
+    std::vector<int32_t> output(SELECT_N);
+    
+    for (auto _ : state) {
+        size_t n = hpc::ranges::filter_into(input, output, [p](int32_t x) { return x < p; });
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SELECT_N));
+}
+
+static void BM_Select_SimdFloat(benchmark::State& state) {
+    const auto input = percent_values<float>(SELECT_N);
+    const auto p = static_cast<float>(state.range(0));
+    std::vector<float> output(SELECT_N);
+    
+    for (auto _ : state) {
+        size_t n = hpc::ranges::filter_into(input, output, [p](float x) { return x < p; });
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SELECT_N));
+}
+
+static void BM_Select_SimdIndices(benchmark::State& state) {
+    const auto input = percent_values<int32_t>(SELECT_N);
+    const auto p = static_cast<int32_t>(state.range(0));
+    std::vector<uint32_t> output(SELECT_N);
+    
+    for (auto _ : state) {
+        size_t n = hpc::ranges::filter_indices(input, output, [p](int32_t x) { return x < p; });
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SELECT_N));
+}
+
+static void SelectivityArgs(benchmark::internal::Benchmark* b) {
+    for (int p : {1, 10, 25, 50, 75, 90, 99}) {
+        b->Arg(p);
+    }
+    b->ArgName("pct")->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(BM_Select_BranchyPushBack)->Apply(SelectivityArgs);
+BENCHMARK(BM_Select_BranchlessScalar)->Apply(SelectivityArgs);
+BENCHMARK(BM_Select_SimdInt32)->Apply(SelectivityArgs);
+BENCHMARK(BM_Select_SimdFloat)->Apply(SelectivityArgs);
+BENCHMARK(BM_Select_SimdIndices)->Apply(SelectivityArgs);
+
+//------------------------------------------------------------------------------
+// Parallel pipeline: filter even | x * 2 + 1 over 10M to 1B ints. The 1B
+// rows need 4 GiB for the input alone, so only reductions go that far.
+//------------------------------------------------------------------------------
+
+/// One input at a time, rebuilt only when the size changes
+const std::vector<int>& pipeline_input(size_t n) {
+    static std::vector<int> input;
+    if (input.size() != n) {
+        input = std::vector<int>();
+        input.resize(n);
+        std::iota(input.begin(), input.end(), 0);
+    }
+    return input;
+}
+
+static void BM_Pipeline_ViewSum(benchmark::State& state) {
+    const auto& input = pipeline_input(static_cast<size_t>(state.range(0)));
+    
+    for (auto _ : state) {
+        auto view = input 
+            | std::views::filter([](int x) { return x % 2 == 0; })
+            | std::views::transform([](int x) { return x * 2 + 1; });
+        int64_t sum = 0;
+        for (int x : view) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Pipeline_SimdSum(benchmark::State& state) {
+    using namespace hpc::ranges;
+    const auto& input = pipeline_input(static_cast<size_t>(state.range(0)));
+    
+    for (auto _ : state) {
+        int64_t sum = input | simd_filter([](int x) { return x % 2 == 0; })
+                            | simd_transform([](int x) { return x * 2 + 1; })
+                            | simd_reduce(int64_t{0});
+        benchmark::DoNotOptimize(sum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Pipeline_ParallelSum(benchmark::State& state) {
+    using namespace hpc::ranges;
+    const auto& input = pipeline_input(static_cast<size_t>(state.range(0)));
+    
+    for (auto _ : state) {
+        int64_t sum = input | in_parallel()
+                            | simd_filter([](int x) { return x % 2 == 0; })
+                            | simd_transform([](int x) { return x * 2 + 1; })
+                            | simd_reduce(int64_t{0});
+        benchmark::DoNotOptimize(sum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["threads"] = hpc::ranges::ThreadPool::global().size();
+}
+
+static void BM_Pipeline_ViewToVector(benchmark::State& state) {
+    const auto& input = pipeline_input(static_cast<size_t>(state.range(0)));
+    
+    for (auto _ : state) {
+        auto view = input 
+            | std::views::filter([](int x) { return x % 2 == 0; })
+            | std::views::transform([](int x) { return x * 2 + 1; });
+        std::vector<int> output;
+        output.reserve(input.size() / 2);
+        for (int x : view) {
+            output.push_back(x);
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// range(1): 1 = ordered, 0 = unordered
+static void BM_Pipeline_ParallelToVector(benchmark::State& state) {
+    using namespace hpc::ranges;
+    const auto& input = pipeline_input(static_cast<size_t>(state.range(0)));
+    const ParallelOptions options{.ordered = state.range(1) != 0};
+    
+    for (auto _ : state) {
+        auto output = input | in_parallel(options)
+                            | simd_filter([](int x) { return x % 2 == 0; })
+                            | simd_transform([](int x) { return x * 2 + 1; })
+                            | simd_to_vector();
+        benchmark::DoNotOptimize(output.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Pipeline_ViewSum)
+    ->Arg(10'000'000)->Arg(100'000'000)->Arg(1'000'000'000)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_Pipeline_SimdSum)
+    ->Arg(10'000'000)->Arg(100'000'000)->Arg(1'000'000'000)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_Pipeline_ParallelSum)
+    ->Arg(10'000'000)->Arg(100'000'000)->Arg(1'000'000'000)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_Pipeline_ViewToVector)
+    ->Arg(10'000'000)->Arg(100'000'000)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_Pipeline_ParallelToVector)
+    ->ArgsProduct({{10'000'000, 100'000'000}, {1, 0}})
+    ->ArgNames({"n", "ordered"})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
 BENCHMARK(BM_Transform_RawLoop)
     ->RangeMultiplier(4)
     ->Range(1024, 16 * 1024 * 1024)
@@ -147,6 +459,11 @@ BENCHMARK(BM_Transform_Ranges)
     ->Range(1024, 16 * 1024 * 1024)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_Transform_SimdRanges)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16 * 1024 * 1024)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK(BM_Filter_RawLoop)
     ->RangeMultiplier(4)
     ->Range(1024, 16 * 1024 * 1024)
@@ -157,6 +474,21 @@ BENCHMARK(BM_Filter_RangesView)
     ->Range(1024, 16 * 1024 * 1024)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_Filter_SimdRanges)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16 * 1024 * 1024)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Filter_RawLoopSum)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16 * 1024 * 1024)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Filter_SimdRangesSum)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16 * 1024 * 1024)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK(BM_Chain_RawLoop)
     ->RangeMultiplier(4)
     ->Range(1024, 16 * 1024 * 1024)
@@ -167,6 +499,11 @@ BENCHMARK(BM_Chain_RangesView)
     ->Range(1024, 16 * 1024 * 1024)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_Chain_SimdRanges)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16 * 1024 * 1024)
+    ->Unit(benchmark::kMicrosecond);
+
 } // namespace
 
 BENCHMARK_MAIN();
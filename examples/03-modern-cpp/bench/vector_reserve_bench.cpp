@@ -4,15 +4,26 @@
  * 
  * Property 7: Vector Reserve Reduces Allocations
  * Validates: Requirements 3.3
+ *
+ * The Small_* benchmarks build one short-lived container of n ints per
+ * iteration, the case inline storage is for: std::vector with and without
+ * reserve, small_vector<int, 16> and static_vector<int, 64>.
+ *
+ * allocs_per_iter and bytes_per_iter come from the global allocation
+ * tracer (benchmarks/common/alloc_tracer.hpp), which sees every operator
+ * new in the process rather than one container's allocator.
  */
 
 #include <benchmark/benchmark.h>
+#include "alloc_tracer.hpp"
+#include "../include/small_vector.hpp"
 #include <vector>
 
 namespace {
 
 static void BM_Vector_NoReserve(benchmark::State& state) {
     const size_t n = static_cast<size_t>(state.range(0));
+    hpc::bench::AllocationCounter allocs(state);
     
     for (auto _ : state) {
         std::vector<int> vec;
@@ -21,12 +32,14 @@ static void BM_Vector_NoReserve(benchmark::State& state) {
         }
         benchmark::DoNotOptimize(vec);
     }
+    allocs.stop();
     
     state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
 }
 
 static void BM_Vector_WithReserve(benchmark::State& state) {
     const size_t n = static_cast<size_t>(state.range(0));
+    hpc::bench::AllocationCounter allocs(state);
     
     for (auto _ : state) {
         std::vector<int> vec;
@@ -36,12 +49,14 @@ static void BM_Vector_WithReserve(benchmark::State& state) {
         }
         benchmark::DoNotOptimize(vec);
     }
+    allocs.stop();
     
     state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
 }
 
 static void BM_Vector_Resize(benchmark::State& state) {
     const size_t n = static_cast<size_t>(state.range(0));
+    hpc::bench::AllocationCounter allocs(state);
     
     for (auto _ : state) {
         std::vector<int> vec;
@@ -51,10 +66,59 @@ static void BM_Vector_Resize(benchmark::State& state) {
         }
         benchmark::DoNotOptimize(vec);
     }
+    allocs.stop();
     
     state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
 }
 
+//------------------------------------------------------------------------------
+// Small containers: std::vector vs small_vector vs static_vector
+//------------------------------------------------------------------------------
+
+template<typename Container, bool Reserve>
+void build_small(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    hpc::bench::AllocationCounter allocs(state);
+    for (auto _ : state) {
+        Container v;
+        if constexpr (Reserve) {
+            v.reserve(static_cast<size_t>(n));
+        }
+        for (int i = 0; i < n; ++i) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+        benchmark::ClobberMemory();
+    }
+    allocs.stop();
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_Small_StdVector(benchmark::State& state) {
+    build_small<std::vector<int>, false>(state);
+}
+
+static void BM_Small_StdVectorReserve(benchmark::State& state) {
+    build_small<std::vector<int>, true>(state);
+}
+
+static void BM_Small_SmallVector(benchmark::State& state) {
+    build_small<hpc::vector_reserve::small_vector<int, 16>, false>(state);
+}
+
+static void BM_Small_StaticVector(benchmark::State& state) {
+    build_small<hpc::vector_reserve::static_vector<int, 64>, false>(state);
+}
+
+void small_sizes(benchmark::internal::Benchmark* b) {
+    b->ArgName("n")->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+}
+
+BENCHMARK(BM_Small_StdVector)->Apply(small_sizes);
+BENCHMARK(BM_Small_StdVectorReserve)->Apply(small_sizes);
+BENCHMARK(BM_Small_SmallVector)->Apply(small_sizes);
+BENCHMARK(BM_Small_StaticVector)->Apply(small_sizes);
+
 BENCHMARK(BM_Vector_NoReserve)
     ->RangeMultiplier(4)
     ->Range(1024, 4 * 1024 * 1024)
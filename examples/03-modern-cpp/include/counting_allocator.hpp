@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file counting_allocator.hpp
+ * @brief Allocator that counts allocations and bytes (hpc::vector_reserve)
+ *
+ * Counters are per element type and global to the process; call
+ * reset_counts() before the code under measurement.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace hpc::vector_reserve {
+
+template<typename T>
+class CountingAllocator {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    CountingAllocator() noexcept = default;
+
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        ++allocation_count_;
+        total_bytes_allocated_ += n * sizeof(T);
+        void* p = std::malloc(n * sizeof(T));
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        ++deallocation_count_;
+        total_bytes_deallocated_ += n * sizeof(T);
+        std::free(ptr);
+    }
+
+    static void reset_counts() {
+        allocation_count_ = 0;
+        deallocation_count_ = 0;
+        total_bytes_allocated_ = 0;
+        total_bytes_deallocated_ = 0;
+    }
+
+    static inline size_t allocation_count_ = 0;
+    static inline size_t deallocation_count_ = 0;
+    static inline size_t total_bytes_allocated_ = 0;
+    static inline size_t total_bytes_deallocated_ = 0;
+};
+
+template<typename T, typename U>
+bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) noexcept {
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) noexcept {
+    return false;
+}
+
+} // namespace hpc::vector_reserve
@@ -0,0 +1,202 @@
+#pragma once
+
+/**
+ * @file parallel_pipeline.hpp
+ * @brief Run simd_ranges pipelines on a thread pool (hpc::ranges)
+ *
+ * in_parallel() turns a simd_ranges pipeline into a parallel one without
+ * changing its stages:
+ *
+ * @code
+ * int64_t sum = input | in_parallel()
+ *                     | simd_filter([](int x) { return x % 2 == 0; })
+ *                     | simd_transform([](int x) { return x * 2 + 1; })
+ *                     | simd_reduce(int64_t{0});
+ * auto kept = input | simd_filter(pred) | in_parallel({.ordered = false}) | simd_to_vector();
+ * @endcode
+ *
+ * The source is split into chunks of about chunk_bytes (an L2's worth by
+ * default), and the fused stages run chunk by chunk as ThreadPool tasks, so
+ * each element is read once and intermediate results never leave cache.
+ *
+ * Sinks:
+ *   - simd_reduce: one partial per chunk, folded in chunk order. The result
+ *     depends on chunk_bytes but not on the thread count or scheduling, so
+ *     floating-point sums are reproducible
+ *   - simd_to_vector, ordered (default): a first parallel pass counts each
+ *     chunk's output, a second reruns the stages and writes every chunk at
+ *     its offset. Rereading the source is cheaper than buffering the
+ *     output and copying it again. Without a filter every chunk's output
+ *     size is known up front, so chunks write straight to the result in
+ *     one pass
+ *   - simd_to_vector, unordered: chunks claim output ranges with one
+ *     atomic add as they finish; order unspecified. The stages run once,
+ *     but the result is first sized for the whole unfiltered source, so
+ *     this only wins when the stages cost more than that extra memory
+ *     traffic
+ *
+ * Stage functions run concurrently and must be safe to call from several
+ * threads at once.
+ */
+
+#include "simd_ranges.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace hpc::ranges {
+
+using hpc::concurrency::ThreadPool;
+
+struct ParallelOptions {
+    size_t chunk_bytes = 256 * 1024;  ///< Source bytes per task
+    bool ordered = true;              ///< simd_to_vector keeps source order
+    ThreadPool* pool = nullptr;       ///< nullptr: ThreadPool::global()
+};
+
+struct ParallelStage {
+    ParallelOptions options;
+};
+
+/// Run the rest of the pipeline in parallel
+inline ParallelStage in_parallel(ParallelOptions options = {}) {
+    return {options};
+}
+
+template<typename Pipeline>
+class ParallelPipeline {
+public:
+    using value_type = typename Pipeline::value_type;
+    using output_type = typename Pipeline::output_type;
+
+    ParallelPipeline(Pipeline pipeline, ParallelOptions options)
+        : pipeline_(std::move(pipeline)), options_(options) {}
+
+    template<typename F>
+    friend auto operator|(ParallelPipeline pp, TransformStage<F> stage) {
+        return make(std::move(pp.pipeline_) | std::move(stage), pp.options_);
+    }
+
+    template<typename Pred>
+    friend auto operator|(ParallelPipeline pp, FilterStage<Pred> stage) {
+        return make(std::move(pp.pipeline_) | std::move(stage), pp.options_);
+    }
+
+    template<typename Acc, typename Op>
+    friend Acc operator|(const ParallelPipeline& pp, const ReduceSink<Acc, Op>& sink) {
+        std::vector<Acc> partials(pp.num_chunks(), sink.identity);
+        pp.for_each_chunk([&](size_t c, size_t, const Pipeline& slice) {
+            partials[c] = slice | simd_reduce(sink.identity, sink.op, sink.identity);
+        });
+        Acc acc = sink.init;
+        for (const Acc& partial : partials) {
+            acc = sink.op(acc, partial);
+        }
+        return acc;
+    }
+
+    friend std::vector<output_type> operator|(const ParallelPipeline& pp, ToVectorSink) {
+        if constexpr (!Pipeline::filters) {
+            return pp.collect_in_place();
+        } else if (pp.options_.ordered) {
+            return pp.collect_ordered();
+        } else {
+            return pp.collect_unordered();
+        }
+    }
+
+    /// Source elements per task: chunk_bytes rounded to whole simd_chunks
+    size_t chunk_elements() const {
+        constexpr size_t step = simd_chunk<value_type>;
+        const size_t elements = std::max(step, options_.chunk_bytes / sizeof(value_type));
+        return (elements + step - 1) / step * step;
+    }
+
+    size_t num_chunks() const {
+        const size_t chunk = chunk_elements();
+        return (pipeline_.size() + chunk - 1) / chunk;
+    }
+
+private:
+    template<typename P>
+    static ParallelPipeline<P> make(P pipeline, ParallelOptions options) {
+        return ParallelPipeline<P>(std::move(pipeline), options);
+    }
+
+    ThreadPool& pool() const {
+        return options_.pool ? *options_.pool : ThreadPool::global();
+    }
+
+    /// fn(chunk index, first source element, pipeline over the chunk)
+    template<typename Fn>
+    void for_each_chunk(Fn&& fn) const {
+        const size_t n = pipeline_.size();
+        const size_t chunk = chunk_elements();
+        pool().run(num_chunks(), [&](size_t c) {
+            const size_t begin = c * chunk;
+            fn(c, begin, pipeline_.slice(begin, std::min(n, begin + chunk)));
+        });
+    }
+
+    /// No filter: chunk c's output goes to the same positions as its input
+    std::vector<output_type> collect_in_place() const {
+        std::vector<output_type> out(pipeline_.size());
+        for_each_chunk([&](size_t, size_t begin, const Pipeline& slice) {
+            slice | simd_into(std::span<output_type>(out).subspan(begin, slice.size()));
+        });
+        return out;
+    }
+
+    /// Count each chunk's output, then rerun every chunk into its offset
+    std::vector<output_type> collect_ordered() const {
+        std::vector<size_t> offsets(num_chunks() + 1, 0);
+        for_each_chunk([&](size_t c, size_t, const Pipeline& slice) {
+            detail::CountState count;
+            slice.run(count);
+            offsets[c + 1] = count.count;
+        });
+        for (size_t c = 0; c + 1 < offsets.size(); ++c) {
+            offsets[c + 1] += offsets[c];
+        }
+        std::vector<output_type> out(offsets.back());
+        for_each_chunk([&](size_t c, size_t, const Pipeline& slice) {
+            detail::WriteState<output_type> write(out.data() + offsets[c]);
+            slice.run(write);
+        });
+        return out;
+    }
+
+    std::vector<output_type> collect_unordered() const {
+        std::vector<output_type> out(pipeline_.size());
+        std::atomic<size_t> cursor{0};
+        for_each_chunk([&](size_t, size_t, const Pipeline& slice) {
+            // Reused across tasks, so steady state allocates nothing
+            static thread_local std::vector<output_type> buffer;
+            buffer.resize(slice.size());
+            const size_t k = slice | simd_into(buffer);
+            const size_t offset = cursor.fetch_add(k, std::memory_order_relaxed);
+            std::copy_n(buffer.begin(), k, out.begin() + static_cast<std::ptrdiff_t>(offset));
+        });
+        out.resize(cursor.load(std::memory_order_relaxed));
+        return out;
+    }
+
+    Pipeline pipeline_;
+    ParallelOptions options_;
+};
+
+template<typename T, typename... Stages>
+ParallelPipeline<SimdPipeline<T, Stages...>> operator|(SimdPipeline<T, Stages...> pipeline, ParallelStage stage) {
+    return {std::move(pipeline), stage.options};
+}
+
+template<detail::SimdSource R>
+auto operator|(R&& range, ParallelStage stage) {
+    return detail::make_pipeline(range) | stage;
+}
+
+} // namespace hpc::ranges
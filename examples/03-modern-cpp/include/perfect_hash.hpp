@@ -0,0 +1,236 @@
+#pragma once
+
+/**
+ * @file perfect_hash.hpp
+ * @brief Collision-free string lookup tables built at compile time (hpc::compile_time)
+ *
+ * Dispatching on a string with a chain of ifs compares against every key
+ * until one matches. A switch on fnv1a_hash() is a binary search over the
+ * case values, and still has to compare the string afterwards. An
+ * unordered_map hashes, then walks a bucket list on the heap.
+ *
+ * make_perfect_hash() runs at compile time and finds a hash function that
+ * places every key of a fixed set in its own slot (hash and displace):
+ *
+ *   1. keys are split into buckets by one hash of the key
+ *   2. buckets are placed largest first; each gets the first seed that
+ *      moves all its keys into free slots
+ *   3. lookup: bucket -> seed -> slot, then one string compare decides
+ *      whether the key really is in the set
+ *
+ * @code
+ * constexpr auto COMMANDS = make_perfect_hash({"get", "set", "del", "incr"});
+ * switch (COMMANDS.index_of(command)) {       // Position in the list above
+ *     case 0: ...
+ *     case PerfectHashTable<4>::npos: ...     // Not a command
+ * }
+ * constexpr auto PORTS = make_perfect_hash_map<int>({{"http", 80}, {"https", 443}});
+ * if (const int* port = PORTS.find(name)) { ... }
+ * @endcode
+ *
+ * The key string is hashed once; the slot needs one multiply-xorshift
+ * more. Tables hold string_views, so keys must outlive them (literals do).
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace hpc::compile_time {
+
+/// FNV-1a over the bytes of @p str
+constexpr uint64_t fnv1a_hash(std::string_view str) {
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    uint64_t hash = FNV_OFFSET;
+    for (char c : str) {
+        hash ^= static_cast<uint64_t>(static_cast<unsigned char>(c));
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/// Hash of a string literal, usable as a case label
+consteval uint64_t operator""_hash(const char* str, size_t len) {
+    return fnv1a_hash(std::string_view(str, len));
+}
+
+namespace detail {
+
+/// splitmix64 finalizer: spreads the key hash mixed with a bucket's seed
+constexpr uint64_t mix(uint64_t h, uint32_t seed) {
+    h ^= seed * 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+}
+
+/// Seeds tried per bucket before giving up; a bucket of a few keys in a
+/// table at most 80% full needs a handful
+inline constexpr uint32_t MAX_SEED = 1u << 16;
+
+} // namespace detail
+
+/// Maps each key of a fixed set to its position in that set
+template<size_t N>
+class PerfectHashTable {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// At most 80% full, so the last buckets still find free slots quickly
+    static constexpr size_t SLOTS = std::bit_ceil(N + N / 4 + 1);
+    /// About three keys per bucket
+    static constexpr size_t BUCKETS = std::bit_ceil(N / 3 + 1);
+
+    /// Position of @p key in the key list, or npos
+    constexpr size_t index_of(std::string_view key) const {
+        const uint64_t h = fnv1a_hash(key);
+        const size_t slot = slot_of(h, seeds_[bucket_of(h)]);
+        return keys_[slot] == key ? index_[slot] : npos;
+    }
+
+    constexpr bool contains(std::string_view key) const { return index_of(key) != npos; }
+
+    static constexpr size_t size() { return N; }
+
+    /// Build the table; fails to compile if two keys are equal
+    static consteval PerfectHashTable build(const std::array<std::string_view, N>& keys) {
+        PerfectHashTable t;
+        std::array<uint64_t, N> hashes{};
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = fnv1a_hash(keys[i]);
+        }
+
+        // Keys grouped by bucket (counting sort): bucket b owns members[first[b], first[b + 1])
+        std::array<size_t, BUCKETS + 1> first{};
+        for (size_t i = 0; i < N; ++i) {
+            ++first[bucket_of(hashes[i]) + 1];
+        }
+        size_t largest = 0;
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            largest = std::max(largest, first[b + 1]);
+            first[b + 1] += first[b];
+        }
+        std::array<size_t, N> members{};
+        std::array<size_t, BUCKETS> fill{};
+        for (size_t i = 0; i < N; ++i) {
+            const size_t b = bucket_of(hashes[i]);
+            members[first[b] + fill[b]++] = i;
+        }
+
+        // Free slots hold "" and index npos, so a lookup landing on one
+        // returns npos, even for "". (A null string_view would do at run
+        // time, but GCC 12 rejects comparing one in a constant expression.)
+        t.keys_.fill("");
+        t.index_.fill(npos);
+        std::array<bool, SLOTS> taken{};
+        for (size_t count = largest; count > 0; --count) {
+            for (size_t b = 0; b < BUCKETS; ++b) {
+                if (first[b + 1] - first[b] == count) {
+                    t.seeds_[b] = place(b, first, members, hashes, taken);
+                    for (size_t m = first[b]; m < first[b + 1]; ++m) {
+                        const size_t slot = slot_of(hashes[members[m]], t.seeds_[b]);
+                        taken[slot] = true;
+                        t.keys_[slot] = keys[members[m]];
+                        t.index_[slot] = members[m];
+                    }
+                }
+            }
+        }
+        return t;
+    }
+
+private:
+    static constexpr size_t bucket_of(uint64_t h) { return static_cast<size_t>(h >> 40) & (BUCKETS - 1); }
+
+    static constexpr size_t slot_of(uint64_t h, uint32_t seed) {
+        return static_cast<size_t>(detail::mix(h, seed)) & (SLOTS - 1);
+    }
+
+    /// First seed that sends every key of bucket @p b to a distinct free slot
+    static consteval uint32_t place(size_t b, const std::array<size_t, BUCKETS + 1>& first,
+                                    const std::array<size_t, N>& members,
+                                    const std::array<uint64_t, N>& hashes,
+                                    const std::array<bool, SLOTS>& taken) {
+        // Equal hashes land in the same slot for every seed
+        for (size_t m = first[b]; m < first[b + 1]; ++m) {
+            for (size_t e = first[b]; e < m; ++e) {
+                if (hashes[members[e]] == hashes[members[m]]) {
+                    throw std::invalid_argument("make_perfect_hash: duplicate keys");
+                }
+            }
+        }
+        for (uint32_t seed = 0; seed < detail::MAX_SEED; ++seed) {
+            bool fits = true;
+            for (size_t m = first[b]; m < first[b + 1] && fits; ++m) {
+                const size_t slot = slot_of(hashes[members[m]], seed);
+                fits = !taken[slot];
+                // Buckets hold a few keys: compare against the earlier ones
+                for (size_t e = first[b]; e < m && fits; ++e) {
+                    fits = slot_of(hashes[members[e]], seed) != slot;
+                }
+            }
+            if (fits) {
+                return seed;
+            }
+        }
+        throw std::invalid_argument("make_perfect_hash: no seed separates a bucket");
+    }
+
+    std::array<uint32_t, BUCKETS> seeds_{};
+    std::array<std::string_view, SLOTS> keys_{};
+    std::array<size_t, SLOTS> index_{};
+};
+
+/// Maps each key of a fixed set to a value
+template<typename V, size_t N>
+class PerfectHashMap {
+public:
+    constexpr PerfectHashMap(PerfectHashTable<N> table, std::array<V, N> values)
+        : table_(table), values_(values) {}
+
+    /// The key's value, or nullptr
+    constexpr const V* find(std::string_view key) const {
+        const size_t i = table_.index_of(key);
+        return i == PerfectHashTable<N>::npos ? nullptr : &values_[i];
+    }
+
+    constexpr bool contains(std::string_view key) const { return table_.contains(key); }
+
+    static constexpr size_t size() { return N; }
+
+private:
+    PerfectHashTable<N> table_;
+    std::array<V, N> values_;
+};
+
+/// Perfect hash of @p keys; index_of(keys[i]) == i
+template<size_t N>
+consteval PerfectHashTable<N> make_perfect_hash(const std::string_view (&keys)[N]) {
+    return PerfectHashTable<N>::build(std::to_array(keys));
+}
+
+template<size_t N>
+consteval PerfectHashTable<N> make_perfect_hash(const std::array<std::string_view, N>& keys) {
+    return PerfectHashTable<N>::build(keys);
+}
+
+/// Perfect hash map of @p entries; V is not deduced from a braced list
+template<typename V, size_t N>
+consteval PerfectHashMap<V, N> make_perfect_hash_map(const std::pair<std::string_view, V> (&entries)[N]) {
+    std::array<std::string_view, N> keys{};
+    std::array<V, N> values{};
+    for (size_t i = 0; i < N; ++i) {
+        keys[i] = entries[i].first;
+        values[i] = entries[i].second;
+    }
+    return {PerfectHashTable<N>::build(keys), values};
+}
+
+} // namespace hpc::compile_time
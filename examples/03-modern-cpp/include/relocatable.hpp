@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file relocatable.hpp
+ * @brief Trivially relocatable types (hpc::vector_reserve)
+ *
+ * Relocation = move-construct into new storage, then destroy the source.
+ * For most types that own resources through a pointer (Buffer,
+ * unique_ptr, a vector) the pair is equivalent to copying the object's
+ * bytes and forgetting the source, because neither the move constructor
+ * nor the destructor depend on the object's address. A container can
+ * then grow with one memcpy, or with realloc(), instead of N move
+ * constructor and N destructor calls.
+ *
+ * Trivially copyable types are trivially relocatable automatically.
+ * Other types opt in with a member alias
+ *
+ *     using trivially_relocatable = std::true_type;
+ *
+ * or by specializing is_trivially_relocatable. Do not opt in for types
+ * that store pointers into themselves (libstdc++'s std::string with SSO,
+ * std::list headers) or register their address somewhere.
+ */
+
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace hpc::vector_reserve {
+
+namespace detail {
+
+template<typename T>
+concept HasRelocatableTag = T::trivially_relocatable::value;
+
+} // namespace detail
+
+template<typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T> || detail::HasRelocatableTag<T>> {};
+
+// Owning pointers only hold the pointee's address, never their own
+template<typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template<typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+namespace detail {
+
+/// Elements that may be moved around with memcpy/memmove
+template<typename T>
+inline constexpr bool relocate_with_memcpy = is_trivially_relocatable_v<T>;
+
+/**
+ * Move [first, last) into uninitialized @p dest and end the source
+ * lifetimes. Copies instead of moving when the move constructor may
+ * throw, so an exception leaves the source untouched.
+ */
+template<typename T>
+void relocate(T* first, T* last, T* dest) {
+    if constexpr (relocate_with_memcpy<T>) {
+        if (first != last) {
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                        static_cast<size_t>(last - first) * sizeof(T));
+        }
+    } else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        std::uninitialized_move(first, last, dest);
+        std::destroy(first, last);
+    } else {
+        std::uninitialized_copy(first, last, dest);
+        std::destroy(first, last);
+    }
+}
+
+/// Shift [first, last) by @p offset slots within one buffer (memmove semantics)
+template<typename T>
+void relocate_within(T* first, T* last, std::ptrdiff_t offset) noexcept {
+    static_assert(relocate_with_memcpy<T>);
+    if (first != last) {
+        std::memmove(static_cast<void*>(first + offset), static_cast<const void*>(first),
+                     static_cast<size_t>(last - first) * sizeof(T));
+    }
+}
+
+} // namespace detail
+
+} // namespace hpc::vector_reserve
@@ -0,0 +1,161 @@
+#pragma once
+
+/**
+ * @file relocating_vector.hpp
+ * @brief Vector that grows with realloc() for trivially relocatable types
+ *
+ * On reallocation std::vector<Buffer> allocates a new block, calls the
+ * move constructor for every element and the destructor for every old
+ * one; std::allocator cannot grow a block in place. relocating_vector<T>
+ * keeps its elements in malloc() memory instead:
+ *
+ *   - trivially relocatable T (relocatable.hpp): growth is one realloc().
+ *     glibc extends the block in place when the next chunk is free, and
+ *     moves large mmap-backed blocks with mremap(), which remaps pages
+ *     instead of copying them. insert/erase shift elements with memmove.
+ *   - any other T: new block plus one move per element, like std::vector
+ *
+ * The interface is the same as small_vector's (std::vector-like, raw
+ * pointer iterators), minus the allocator.
+ */
+
+#include "relocatable.hpp"
+#include "small_vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace hpc::vector_reserve {
+
+template<typename T>
+class relocating_vector : public detail::VectorBase<relocating_vector<T>, T> {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc() only guarantees max_align_t");
+
+    using Base = detail::VectorBase<relocating_vector, T>;
+    friend Base;
+
+public:
+    using typename Base::size_type;
+
+    relocating_vector() noexcept = default;
+
+    explicit relocating_vector(size_type count) {
+        this->construct_with([&] { this->resize(count); });
+    }
+
+    relocating_vector(size_type count, const T& value) {
+        this->construct_with([&] { this->assign(count, value); });
+    }
+
+    template<std::input_iterator It>
+    relocating_vector(It first, It last) {
+        this->construct_with([&] { this->assign(first, last); });
+    }
+
+    relocating_vector(std::initializer_list<T> values) : relocating_vector(values.begin(), values.end()) {}
+
+    relocating_vector(const relocating_vector& other) {
+        this->construct_with([&] { this->assign(other.begin(), other.end()); });
+    }
+
+    relocating_vector(relocating_vector&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)) {
+        this->size_ = std::exchange(other.size_, 0);
+    }
+
+    ~relocating_vector() {
+        this->clear();
+        release_storage();
+    }
+
+    relocating_vector& operator=(const relocating_vector& other) {
+        if (this != &other) {
+            this->assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    relocating_vector& operator=(relocating_vector&& other) noexcept {
+        relocating_vector tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    relocating_vector& operator=(std::initializer_list<T> values) {
+        this->assign(values);
+        return *this;
+    }
+
+    void swap(relocating_vector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(this->size_, other.size_);
+    }
+
+    friend void swap(relocating_vector& a, relocating_vector& b) noexcept {
+        a.swap(b);
+    }
+
+    void shrink_to_fit() {
+        if (this->size_ == capacity_) {
+            return;
+        }
+        if (this->size_ == 0) {
+            release_storage();
+        } else {
+            reallocate(this->size_);
+        }
+    }
+
+    static constexpr size_type max_size() noexcept {
+        return static_cast<size_type>(PTRDIFF_MAX) / sizeof(T);
+    }
+
+private:
+    T* storage() noexcept { return data_; }
+    size_type storage_capacity() const noexcept { return capacity_; }
+
+    void reallocate(size_type new_capacity) {
+        if (new_capacity > max_size()) {
+            throw std::length_error("relocating_vector");
+        }
+        if constexpr (detail::relocate_with_memcpy<T>) {
+            void* block = std::realloc(static_cast<void*>(data_), new_capacity * sizeof(T));
+            if (!block) {
+                throw std::bad_alloc();
+            }
+            data_ = static_cast<T*>(block);
+        } else {
+            T* const block = static_cast<T*>(std::malloc(new_capacity * sizeof(T)));
+            if (!block) {
+                throw std::bad_alloc();
+            }
+            try {
+                detail::relocate(data_, data_ + this->size_, block);
+            } catch (...) {
+                std::free(block);
+                throw;
+            }
+            std::free(data_);
+            data_ = block;
+        }
+        capacity_ = new_capacity;
+    }
+
+    void release_storage() noexcept {
+        std::free(data_);
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+
+    T* data_ = nullptr;
+    size_type capacity_ = 0;
+};
+
+} // namespace hpc::vector_reserve
@@ -0,0 +1,236 @@
+#pragma once
+
+/**
+ * @file sbo_buffer.hpp
+ * @brief Byte buffer with small-buffer optimization (hpc::move_semantics)
+ *
+ * `Buffer` in move_semantics.cpp pays for `new char[size]` plus a memset
+ * even for an 8-byte payload. SboBuffer<N> keeps up to N bytes inline in
+ * the object and only goes to the allocator above that:
+ *
+ *   - data_ always points at the live bytes (inline or heap), so data()
+ *     is branch-free; moves re-point it
+ *   - nothing is zero-filled unless asked: sizes are given either with
+ *     the `uninitialized` tag or with a fill value
+ *   - moving a heap buffer steals the pointer; moving an inline one copies
+ *     the inline bytes (a fixed-size copy for N <= INLINE_COPY_ALL)
+ *   - the allocator follows the usual allocator_traits propagation rules
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace hpc::move_semantics {
+
+/// Tag for constructors and resize() that leave new bytes uninitialized
+struct uninitialized_t {
+    explicit uninitialized_t() = default;
+};
+inline constexpr uninitialized_t uninitialized{};
+
+template<size_t N = 64, typename Allocator = std::allocator<char>>
+class SboBuffer {
+    static_assert(N > 0, "use Buffer for a heap-only buffer");
+
+    using AllocTraits = typename std::allocator_traits<Allocator>::template rebind_traits<char>;
+
+public:
+    using allocator_type = typename AllocTraits::allocator_type;
+
+    static constexpr size_t INLINE_CAPACITY = N;
+    /// Up to this size, inline moves copy all N bytes (no length-dependent memcpy)
+    static constexpr size_t INLINE_COPY_ALL = 128;
+
+    SboBuffer() noexcept(noexcept(allocator_type())) : SboBuffer(allocator_type()) {}
+
+    explicit SboBuffer(const allocator_type& alloc) noexcept : alloc_(alloc) {}
+
+    SboBuffer(size_t size, uninitialized_t, const allocator_type& alloc = allocator_type())
+        : alloc_(alloc) {
+        reserve(size);
+        size_ = size;
+    }
+
+    SboBuffer(size_t size, char value, const allocator_type& alloc = allocator_type())
+        : SboBuffer(size, uninitialized, alloc) {
+        std::memset(data_, value, size);
+    }
+
+    SboBuffer(const SboBuffer& other)
+        : SboBuffer(other.size_, uninitialized,
+                    AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+        std::memcpy(data_, other.data_, size_);
+    }
+
+    SboBuffer(SboBuffer&& other) noexcept : alloc_(std::move(other.alloc_)) {
+        steal(other);
+    }
+
+    ~SboBuffer() {
+        release();
+    }
+
+    SboBuffer& operator=(const SboBuffer& other) {
+        if (this == &other) {
+            return *this;
+        }
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) {
+                release();  // Our heap block belongs to the old allocator
+            }
+            alloc_ = other.alloc_;
+        }
+        assign(other.data_, other.size_);
+        return *this;
+    }
+
+    SboBuffer& operator=(SboBuffer&& other) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            release();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                release();
+                steal(other);
+            } else {
+                // Cannot take a block from a different allocator
+                assign(other.data_, other.size_);
+                other.size_ = 0;
+            }
+        }
+        return *this;
+    }
+
+    /// Replace the contents with a copy of [src, src + size)
+    void assign(const char* src, size_t size) {
+        size_ = 0;  // Nothing to preserve on growth
+        reserve(size);
+        std::memcpy(data_, src, size);
+        size_ = size;
+    }
+
+    /// Make room for @p capacity bytes, keeping the current contents
+    void reserve(size_t capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+        char* block = AllocTraits::allocate(alloc_, capacity);
+        std::memcpy(block, data_, size_);
+        release();
+        data_ = block;
+        capacity_ = capacity;
+    }
+
+    /// Resize without touching the new bytes
+    void resize(size_t size, uninitialized_t) {
+        reserve(size);
+        size_ = size;
+    }
+
+    void resize(size_t size, char value) {
+        const size_t old_size = size_;
+        resize(size, uninitialized);
+        if (size > old_size) {
+            std::memset(data_ + old_size, value, size - old_size);
+        }
+    }
+
+    void clear() noexcept {
+        size_ = 0;
+    }
+
+    void swap(SboBuffer& other) noexcept {
+        if (this == &other) {
+            return;
+        }
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        } else {
+            assert(alloc_ == other.alloc_);
+        }
+        // Park other's state, move ours over, then install the parked state
+        char parked[N];
+        const bool parked_inline = other.is_inline();
+        char* const parked_heap = other.data_;
+        const size_t parked_size = other.size_;
+        const size_t parked_capacity = other.capacity_;
+        if (parked_inline) {
+            std::memcpy(parked, other.inline_, parked_size);
+        }
+        other.steal(*this);
+        size_ = parked_size;
+        if (parked_inline) {
+            std::memcpy(inline_, parked, parked_size);
+        } else {
+            data_ = parked_heap;
+            capacity_ = parked_capacity;
+        }
+    }
+
+    char* data() noexcept { return data_; }
+    const char* data() const noexcept { return data_; }
+    char& operator[](size_t i) noexcept { return data_[i]; }
+    const char& operator[](size_t i) const noexcept { return data_[i]; }
+    char* begin() noexcept { return data_; }
+    char* end() noexcept { return data_ + size_; }
+    const char* begin() const noexcept { return data_; }
+    const char* end() const noexcept { return data_ + size_; }
+
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool is_inline() const noexcept { return data_ == inline_; }
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+private:
+    /// Take other's contents; we must own no heap block. Leaves other empty and inline.
+    void steal(SboBuffer& other) noexcept {
+        size_ = other.size_;
+        if (other.is_inline()) {
+            if constexpr (N <= INLINE_COPY_ALL) {
+                std::memcpy(inline_, other.inline_, N);
+            } else {
+                std::memcpy(inline_, other.inline_, size_);
+            }
+            data_ = inline_;
+            capacity_ = N;
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+        }
+        other.data_ = other.inline_;
+        other.size_ = 0;
+        other.capacity_ = N;
+    }
+
+    void release() noexcept {
+        if (!is_inline()) {
+            AllocTraits::deallocate(alloc_, data_, capacity_);
+        }
+        data_ = inline_;
+        capacity_ = N;
+    }
+
+    char* data_ = inline_;
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    [[no_unique_address]] allocator_type alloc_;
+    alignas(std::max_align_t) char inline_[N];
+};
+
+template<size_t N, typename Allocator>
+void swap(SboBuffer<N, Allocator>& a, SboBuffer<N, Allocator>& b) noexcept {
+    a.swap(b);
+}
+
+} // namespace hpc::move_semantics
@@ -0,0 +1,219 @@
+#pragma once
+
+/**
+ * @file simd_filter.hpp
+ * @brief Branchless SIMD filter into a preallocated output (hpc::ranges)
+ *
+ * A filter loop that branches on the predicate and push_back()s mispredicts
+ * on every element whose outcome the branch predictor cannot guess, which
+ * at 50% selectivity on random data is half of them. filter_into() never
+ * branches on the data:
+ *
+ *   1. the predicate is evaluated over a block into 0/1 flags (a loop the
+ *      compiler vectorizes)
+ *   2. each register's worth of flags becomes a lane mask, and the kept
+ *      lanes are packed to the front of the register and stored at the
+ *      output cursor, which then advances by popcount(mask)
+ *
+ * Packing uses vpcompressd/q with AVX-512 and, with AVX2, a vpermd whose
+ * index vector comes from a 256-entry table indexed by the 8-bit mask
+ * (COMPRESS_PERMUTE_8X32, generated at compile time by simd_tables.hpp).
+ * Without either, a scalar loop writes every element and advances the
+ * cursor by the flag.
+ *
+ * @code
+ * std::vector<int32_t> out(in.size());               // Room for everything
+ * size_t n = filter_into(in, out, [](int32_t x) { return x < 42; });
+ * std::vector<uint32_t> idx(in.size());
+ * size_t m = filter_indices(in, idx, [](int32_t x) { return x < 42; });
+ * @endcode
+ *
+ * The output must hold as many elements as the input: every store is a
+ * full register at the cursor, which never passes the read position, so
+ * nothing beyond out[in.size()) is touched.
+ */
+
+#include "simd_tables.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace hpc::ranges {
+
+/// Unsigned integer as wide as T (bytes for odd sizes); predicate flags
+/// this wide let GCC vectorize the compare loop
+template<typename T>
+using flag_t = std::conditional_t<
+    sizeof(T) == 8, uint64_t,
+    std::conditional_t<sizeof(T) == 4, uint32_t, std::conditional_t<sizeof(T) == 2, uint16_t, uint8_t>>>;
+
+/// Elements whose flags are computed before compaction: 4 KiB of int32
+inline constexpr size_t FILTER_BLOCK = 1024;
+
+namespace detail {
+
+#if defined(__AVX2__) && !defined(__AVX512F__)
+
+inline uint32_t flags_to_mask8(const uint32_t* flags) {
+    const __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags));
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(f, 31))));
+}
+
+inline __m256i compress_permute(__m256i v, uint32_t mask) {
+    const auto& row = hpc::simd::COMPRESS_PERMUTE_8X32[mask];
+    return _mm256_permutevar8x32_epi32(v, _mm256_load_si256(reinterpret_cast<const __m256i*>(row.data())));
+}
+
+#endif
+
+/**
+ * Copy the elements of in[0, k) whose flag is set to out, in order;
+ * returns their count. Whole registers are stored at out + count, so out
+ * must hold k elements.
+ */
+template<typename T>
+inline size_t compact(const T* in, const flag_t<T>* flags, size_t k, T* out) {
+    size_t kept = 0;
+    size_t j = 0;
+#if defined(__AVX512F__)
+    if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+        constexpr size_t W = 64 / sizeof(T);
+        for (; j + W <= k; j += W) {
+            const __m512i f = _mm512_loadu_si512(flags + j);
+            const __m512i v = _mm512_loadu_si512(in + j);
+            uint32_t mask = 0;
+            if constexpr (W == 16) {
+                const __mmask16 m = _mm512_test_epi32_mask(f, f);
+                _mm512_storeu_si512(out + kept, _mm512_maskz_compress_epi32(m, v));
+                mask = m;
+            } else {
+                const __mmask8 m = _mm512_test_epi64_mask(f, f);
+                _mm512_storeu_si512(out + kept, _mm512_maskz_compress_epi64(m, v));
+                mask = m;
+            }
+            kept += static_cast<size_t>(std::popcount(mask));
+        }
+    }
+#elif defined(__AVX2__)
+    if constexpr (sizeof(T) == 4) {
+        for (; j + 8 <= k; j += 8) {
+            const uint32_t mask = flags_to_mask8(flags + j);
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + j));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + kept), compress_permute(v, mask));
+            kept += static_cast<size_t>(std::popcount(mask));
+        }
+    }
+#endif
+    // Branchless: always write, advance only past kept elements
+    for (; j < k; ++j) {
+        out[kept] = in[j];
+        kept += static_cast<size_t>(flags[j]);
+    }
+    return kept;
+}
+
+/// Like compact(), writing base + j for each set flag instead of the element
+inline size_t compact_indices(uint32_t base, const uint32_t* flags, size_t k, uint32_t* out) {
+    size_t kept = 0;
+    size_t j = 0;
+#if defined(__AVX512F__)
+    const __m512i step = _mm512_set1_epi32(16);
+    __m512i idx = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(base)),
+                                   _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    for (; j + 16 <= k; j += 16) {
+        const __m512i f = _mm512_loadu_si512(flags + j);
+        const __mmask16 m = _mm512_test_epi32_mask(f, f);
+        _mm512_storeu_si512(out + kept, _mm512_maskz_compress_epi32(m, idx));
+        kept += static_cast<size_t>(std::popcount(static_cast<uint32_t>(m)));
+        idx = _mm512_add_epi32(idx, step);
+    }
+#elif defined(__AVX2__)
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i idx = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(base)),
+                                   _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    for (; j + 8 <= k; j += 8) {
+        const uint32_t mask = flags_to_mask8(flags + j);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + kept), compress_permute(idx, mask));
+        kept += static_cast<size_t>(std::popcount(mask));
+        idx = _mm256_add_epi32(idx, step);
+    }
+#endif
+    for (; j < k; ++j) {
+        out[kept] = base + static_cast<uint32_t>(j);
+        kept += flags[j];
+    }
+    return kept;
+}
+
+template<typename F, typename T, typename Pred>
+inline void evaluate_flags(const T* in, size_t k, F* flags, const Pred& pred) {
+    for (size_t j = 0; j < k; ++j) {
+        flags[j] = std::invoke(pred, in[j]) ? 1 : 0;
+    }
+}
+
+} // namespace detail
+
+/**
+ * Copy the elements of @p in that satisfy @p pred to the front of @p out,
+ * in order; returns how many were copied. @p out needs room for
+ * in.size() elements.
+ */
+template<typename T, typename Pred>
+size_t filter_into(std::span<const T> in, std::span<T> out, Pred pred) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    assert(out.size() >= in.size() && "filter_into: output smaller than input");
+    std::array<flag_t<T>, FILTER_BLOCK> flags;
+    size_t kept = 0;
+    for (size_t i = 0; i < in.size(); i += FILTER_BLOCK) {
+        const size_t k = std::min(FILTER_BLOCK, in.size() - i);
+        detail::evaluate_flags(in.data() + i, k, flags.data(), pred);
+        kept += detail::compact(in.data() + i, flags.data(), k, out.data() + kept);
+    }
+    return kept;
+}
+
+/**
+ * Write the positions of the elements of @p in that satisfy @p pred to
+ * @p out, ascending; returns how many were written. @p out needs room for
+ * in.size() indices.
+ */
+template<typename T, typename Pred>
+size_t filter_indices(std::span<const T> in, std::span<uint32_t> out, Pred pred) {
+    assert(out.size() >= in.size() && "filter_indices: output smaller than input");
+    assert(in.size() <= UINT32_MAX);
+    std::array<uint32_t, FILTER_BLOCK> flags;
+    size_t kept = 0;
+    for (size_t i = 0; i < in.size(); i += FILTER_BLOCK) {
+        const size_t k = std::min(FILTER_BLOCK, in.size() - i);
+        detail::evaluate_flags(in.data() + i, k, flags.data(), pred);
+        kept += detail::compact_indices(static_cast<uint32_t>(i), flags.data(), k, out.data() + kept);
+    }
+    return kept;
+}
+
+// std::span<const T> does not deduce from a vector; these forward to the above
+
+template<typename T, typename Pred>
+size_t filter_into(const std::vector<T>& in, std::vector<T>& out, Pred pred) {
+    return filter_into(std::span<const T>(in), std::span<T>(out), std::move(pred));
+}
+
+template<typename T, typename Pred>
+size_t filter_indices(const std::vector<T>& in, std::vector<uint32_t>& out, Pred pred) {
+    return filter_indices(std::span<const T>(in), std::span<uint32_t>(out), std::move(pred));
+}
+
+} // namespace hpc::ranges
@@ -0,0 +1,400 @@
+#pragma once
+
+/**
+ * @file simd_ranges.hpp
+ * @brief Chunked range adaptors: simd_transform, simd_filter, simd_reduce (hpc::ranges)
+ *
+ * std::views::filter | std::views::transform hands one element at a time
+ * through a chain of iterator adaptors; the filter's data-dependent branch
+ * keeps the compiler from vectorizing the loop. These adaptors keep the
+ * pipe syntax but run the pipeline over chunks of a few hundred elements,
+ * a fixed number of SIMD registers, with one tight loop per stage:
+ *
+ * @code
+ * int64_t sum = input | simd_filter([](int x) { return x % 2 == 0; })
+ *                     | simd_transform([](int x) { return x * 2 + 1; })
+ *                     | simd_reduce(int64_t{0});
+ * @endcode
+ *
+ *   - simd_transform applies its function across the chunk in a loop the
+ *     compiler vectorizes
+ *   - simd_filter evaluates the predicate over the chunk, then compacts
+ *     the surviving elements without branches (the kernels of
+ *     simd_filter.hpp: vpcompressd/q or an AVX2 permute table)
+ *   - simd_reduce keeps one accumulator per lane and folds them at the end
+ *   - simd_to_vector / simd_into materialize the result
+ *
+ * The source must be a contiguous range of trivially copyable elements,
+ * and the pipeline runs eagerly when a sink is applied. Functions may
+ * not rely on side effects or evaluation order.
+ */
+
+#include "simd_filter.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpc::ranges {
+
+//------------------------------------------------------------------------------
+// Chunk width
+//------------------------------------------------------------------------------
+
+#if defined(__AVX512F__)
+inline constexpr size_t SIMD_REGISTER_BYTES = 64;
+#elif defined(__AVX__)
+inline constexpr size_t SIMD_REGISTER_BYTES = 32;
+#else
+inline constexpr size_t SIMD_REGISTER_BYTES = 16;
+#endif
+
+/// Elements of T in one SIMD register
+template<typename T>
+inline constexpr size_t simd_lanes = std::max<size_t>(1, SIMD_REGISTER_BYTES / sizeof(T));
+
+/// Elements of the source handed through the stages at a time: enough
+/// registers to amortize each stage's loop overhead, few enough that
+/// every stage's buffer stays in L1
+template<typename T>
+inline constexpr size_t simd_chunk = simd_lanes<T> * 16;
+
+//------------------------------------------------------------------------------
+// Stages and sinks
+//------------------------------------------------------------------------------
+
+template<typename F>
+struct TransformStage {
+    F fn;
+};
+
+template<typename Pred>
+struct FilterStage {
+    Pred pred;
+};
+
+template<typename Acc, typename Op>
+struct ReduceSink {
+    Acc init;
+    Op op;
+    Acc identity;
+};
+
+struct ToVectorSink {};
+
+template<typename U>
+struct IntoSink {
+    std::span<U> out;
+};
+
+/// Apply @p fn to every element
+template<typename F>
+TransformStage<F> simd_transform(F fn) {
+    return {std::move(fn)};
+}
+
+/// Keep the elements for which @p pred returns true
+template<typename Pred>
+FilterStage<Pred> simd_filter(Pred pred) {
+    return {std::move(pred)};
+}
+
+/**
+ * Fold the elements into @p init with @p op. Each lane starts from
+ * @p identity, op's neutral element (1 for a product, the lowest value for
+ * a max), so op must be associative and commutative (the result of a
+ * floating-point sum differs from a sequential one by rounding).
+ */
+template<typename Acc, typename Op>
+ReduceSink<Acc, Op> simd_reduce(Acc init, Op op, Acc identity) {
+    return {init, std::move(op), identity};
+}
+
+/// Sum the elements into @p init: the only op whose identity, Acc{}, can
+/// be assumed
+template<typename Acc>
+ReduceSink<Acc, std::plus<>> simd_reduce(Acc init, std::plus<> op = {}) {
+    return {init, op, Acc{}};
+}
+
+/// Collect the elements into a std::vector
+inline ToVectorSink simd_to_vector() {
+    return {};
+}
+
+/// Write the elements to the front of @p out, which must hold at least as
+/// many elements as the source; returns how many were written
+template<typename U>
+IntoSink<U> simd_into(std::span<U> out) {
+    return {out};
+}
+
+template<typename U>
+IntoSink<U> simd_into(std::vector<U>& out) {
+    return {std::span<U>(out)};
+}
+
+namespace detail {
+
+//------------------------------------------------------------------------------
+// Chunk kernels
+//------------------------------------------------------------------------------
+
+/// Copy the elements of in[0, k) that satisfy @p pred to the front of
+/// @p out; returns their count
+template<size_t N, typename T, typename Pred>
+inline size_t compress(const T* in, size_t k, std::array<T, N>& out, const Pred& pred) {
+    std::array<flag_t<T>, N> keep;
+    evaluate_flags(in, k, keep.data(), pred);
+    return compact(in, keep.data(), k, out.data());
+}
+
+template<typename Acc, typename Op>
+class ReduceState {
+public:
+    static constexpr size_t LANES = simd_lanes<Acc>;
+
+    explicit ReduceState(const ReduceSink<Acc, Op>& sink) : sink_(sink) {
+        lanes_.fill(sink.identity);
+    }
+
+    template<typename U>
+    void consume(const U* in, size_t k) {
+        // Independent accumulators per lane, so floating-point ops vectorize too
+        std::array<Acc, LANES> lanes = lanes_;
+        size_t j = 0;
+        for (; j + LANES <= k; j += LANES) {
+            for (size_t l = 0; l < LANES; ++l) {
+                lanes[l] = sink_.op(lanes[l], in[j + l]);
+            }
+        }
+        for (size_t l = 0; j < k; ++j, ++l) {
+            lanes[l] = sink_.op(lanes[l], in[j]);
+        }
+        lanes_ = lanes;
+    }
+
+    Acc result() const {
+        Acc acc = sink_.init;
+        for (const Acc& lane : lanes_) {
+            acc = sink_.op(acc, lane);
+        }
+        return acc;
+    }
+
+private:
+    const ReduceSink<Acc, Op>& sink_;
+    std::array<Acc, LANES> lanes_;
+};
+
+template<typename U>
+class VectorState {
+public:
+    explicit VectorState(size_t max_size) { out_.reserve(max_size); }
+
+    void consume(const U* in, size_t k) { out_.insert(out_.end(), in, in + k); }
+
+    std::vector<U> result() { return std::move(out_); }
+
+private:
+    std::vector<U> out_;
+};
+
+/// Writes chunks through a pointer; the caller guarantees the room
+template<typename U>
+class WriteState {
+public:
+    explicit WriteState(U* out) : out_(out) {}
+
+    template<typename V>
+    void consume(const V* in, size_t k) {
+        std::copy_n(in, k, out_ + written_);
+        written_ += k;
+    }
+
+    size_t written() const { return written_; }
+
+private:
+    U* out_;
+    size_t written_ = 0;
+};
+
+/// Counts the elements that reach the sink
+class CountState {
+public:
+    template<typename U>
+    void consume(const U*, size_t k) { count += k; }
+
+    size_t count = 0;
+};
+
+/// Element type after running T through the stages
+template<typename T, typename... Stages>
+struct stage_output {
+    using type = T;
+};
+
+template<typename T, typename F, typename... Rest>
+struct stage_output<T, TransformStage<F>, Rest...>
+    : stage_output<std::remove_cvref_t<std::invoke_result_t<const F&, const T&>>, Rest...> {};
+
+template<typename T, typename Pred, typename... Rest>
+struct stage_output<T, FilterStage<Pred>, Rest...> : stage_output<T, Rest...> {};
+
+template<size_t N, typename T, typename State>
+inline void push_chunk(const T* in, size_t k, State& state) {
+    state.consume(in, k);
+}
+
+template<size_t N, typename T, typename State, typename F, typename... Rest>
+inline void push_chunk(const T* in, size_t k, State& state,
+                       const TransformStage<F>& stage, const Rest&... rest) {
+    using U = std::remove_cvref_t<std::invoke_result_t<const F&, const T&>>;
+    std::array<U, N> out;
+    for (size_t j = 0; j < k; ++j) {
+        out[j] = std::invoke(stage.fn, in[j]);
+    }
+    push_chunk<N>(out.data(), k, state, rest...);
+}
+
+template<size_t N, typename T, typename State, typename Pred, typename... Rest>
+inline void push_chunk(const T* in, size_t k, State& state,
+                       const FilterStage<Pred>& stage, const Rest&... rest) {
+    std::array<T, N> out;
+    k = compress(in, k, out, stage.pred);
+    if (k != 0) {
+        push_chunk<N>(out.data(), k, state, rest...);
+    }
+}
+
+template<typename Stage>
+struct is_filter : std::false_type {};
+
+template<typename Pred>
+struct is_filter<FilterStage<Pred>> : std::true_type {};
+
+template<typename R>
+concept SimdSource = std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+                     std::ranges::borrowed_range<R> &&
+                     std::is_trivially_copyable_v<std::ranges::range_value_t<R>>;
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+// Pipeline
+//------------------------------------------------------------------------------
+
+/// A source plus the stages applied so far; a sink runs it
+template<typename T, typename... Stages>
+class SimdPipeline {
+public:
+    using value_type = T;
+    using output_type = typename detail::stage_output<T, Stages...>::type;
+
+    /// True when some stage can drop elements
+    static constexpr bool filters = (detail::is_filter<Stages>::value || ...);
+
+    SimdPipeline(std::span<const T> source, std::tuple<Stages...> stages)
+        : source_(source), stages_(std::move(stages)) {}
+
+    /// Source elements
+    size_t size() const { return source_.size(); }
+
+    /// The same stages over source elements [begin, end)
+    SimdPipeline slice(size_t begin, size_t end) const {
+        return {source_.subspan(begin, end - begin), stages_};
+    }
+
+    template<typename F>
+    friend SimdPipeline<T, Stages..., TransformStage<F>> operator|(SimdPipeline p, TransformStage<F> stage) {
+        return p.append(std::move(stage));
+    }
+
+    template<typename Pred>
+    friend SimdPipeline<T, Stages..., FilterStage<Pred>> operator|(SimdPipeline p, FilterStage<Pred> stage) {
+        return p.append(std::move(stage));
+    }
+
+    template<typename Acc, typename Op>
+    friend Acc operator|(const SimdPipeline& p, const ReduceSink<Acc, Op>& sink) {
+        detail::ReduceState<Acc, Op> state(sink);
+        p.run(state);
+        return state.result();
+    }
+
+    /// Reserves the unfiltered count, so appending never reallocates
+    friend std::vector<output_type> operator|(const SimdPipeline& p, ToVectorSink) {
+        detail::VectorState<output_type> state(p.source_.size());
+        p.run(state);
+        return state.result();
+    }
+
+    template<typename U>
+    friend size_t operator|(const SimdPipeline& p, IntoSink<U> sink) {
+        assert(sink.out.size() >= p.source_.size() && "simd_into: output range too small");
+        detail::WriteState<U> state(sink.out.data());
+        p.run(state);
+        return state.written();
+    }
+
+    /// Push the source through the stages chunk by chunk, handing each
+    /// surviving chunk to state.consume(const output_type*, size_t)
+    template<typename State>
+    void run(State& state) const {
+        const T* data = source_.data();
+        const size_t n = source_.size();
+        for (size_t i = 0; i < n; i += N) {
+            const size_t k = std::min(N, n - i);
+            std::apply([&](const Stages&... stages) { detail::push_chunk<N>(data + i, k, state, stages...); },
+                       stages_);
+        }
+    }
+
+private:
+    static constexpr size_t N = simd_chunk<T>;
+
+    template<typename Stage>
+    SimdPipeline<T, Stages..., Stage> append(Stage stage) {
+        return {source_, std::tuple_cat(std::move(stages_), std::tuple<Stage>(std::move(stage)))};
+    }
+
+    std::span<const T> source_;
+    std::tuple<Stages...> stages_;
+};
+
+namespace detail {
+
+template<typename R>
+auto make_pipeline(R& range) {
+    using T = std::ranges::range_value_t<R>;
+    return SimdPipeline<T>(std::span<const T>(std::ranges::data(range), std::ranges::size(range)), {});
+}
+
+} // namespace detail
+
+template<detail::SimdSource R, typename F>
+auto operator|(R&& range, TransformStage<F> stage) {
+    return detail::make_pipeline(range) | std::move(stage);
+}
+
+template<detail::SimdSource R, typename Pred>
+auto operator|(R&& range, FilterStage<Pred> stage) {
+    return detail::make_pipeline(range) | std::move(stage);
+}
+
+template<detail::SimdSource R, typename Acc, typename Op>
+Acc operator|(R&& range, const ReduceSink<Acc, Op>& sink) {
+    return detail::make_pipeline(range) | sink;
+}
+
+} // namespace hpc::ranges
@@ -0,0 +1,645 @@
+#pragma once
+
+/**
+ * @file small_vector.hpp
+ * @brief Vectors with inline storage: small_vector and static_vector
+ *
+ * Most vectors in hot code are small: a handful of neighbours, a few
+ * pending events, the tokens of one line. std::vector allocates for the
+ * first element no matter what, and reserve() only removes the regrowth.
+ *
+ *   small_vector<T, N>   first N elements live inside the object; beyond
+ *                        that it spills to the allocator and grows 2x
+ *   static_vector<T, N>  capacity fixed at N, never allocates; overflow
+ *                        throws std::bad_alloc (as std::inplace_vector),
+ *                        try_emplace_back() returns nullptr instead
+ *
+ * Both offer the std::vector interface (iterators are raw pointers).
+ * Trivially relocatable elements (relocatable.hpp) are moved with
+ * memcpy/memmove on growth, insert, erase and container moves instead of
+ * one move constructor and destructor call per element.
+ */
+
+#include "relocatable.hpp"
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace hpc::vector_reserve {
+
+namespace detail {
+
+/**
+ * The std::vector interface over storage provided by Derived:
+ *
+ *   T* storage()                        first element
+ *   size_t storage_capacity() const
+ *   void reallocate(size_t capacity)    relocate into >= capacity slots
+ */
+template<typename Derived, typename T>
+class VectorBase {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // ------------------------------------------------------------------------
+    // Element access
+    // ------------------------------------------------------------------------
+
+    T& operator[](size_type i) noexcept { return data()[i]; }
+    const T& operator[](size_type i) const noexcept { return data()[i]; }
+
+    T& at(size_type i) {
+        if (i >= size_) {
+            throw std::out_of_range("vector index out of range");
+        }
+        return data()[i];
+    }
+    const T& at(size_type i) const {
+        return const_cast<VectorBase*>(this)->at(i);
+    }
+
+    T& front() noexcept { return data()[0]; }
+    const T& front() const noexcept { return data()[0]; }
+    T& back() noexcept { return data()[size_ - 1]; }
+    const T& back() const noexcept { return data()[size_ - 1]; }
+    T* data() noexcept { return self().storage(); }
+    const T* data() const noexcept { return const_cast<Derived&>(self()).storage(); }
+
+    // ------------------------------------------------------------------------
+    // Iterators
+    // ------------------------------------------------------------------------
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size_; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size_; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // ------------------------------------------------------------------------
+    // Capacity
+    // ------------------------------------------------------------------------
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return self().storage_capacity(); }
+
+    void reserve(size_type new_capacity) {
+        if (new_capacity > capacity()) {
+            self().reallocate(new_capacity);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Modifiers
+    // ------------------------------------------------------------------------
+
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity()) [[unlikely]] {
+            T tmp(std::forward<Args>(args)...);  // The arguments may refer to our elements
+            grow(size_ + 1);
+            return construct_at_end(std::move(tmp));
+        }
+        return construct_at_end(std::forward<Args>(args)...);
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        --size_;
+        std::destroy_at(end());
+    }
+
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const size_type index = static_cast<size_type>(pos - cbegin());
+        if (index == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return begin() + index;
+        }
+        T tmp(std::forward<Args>(args)...);
+        reserve_for(size_ + 1);
+        T* const p = begin() + index;
+        T* const e = end();
+        if constexpr (relocate_with_memcpy<T>) {
+            relocate_within(p, e, 1);
+            try {
+                std::construct_at(p, std::move(tmp));
+            } catch (...) {
+                relocate_within(p + 1, e + 1, -1);
+                throw;
+            }
+            ++size_;
+        } else {
+            std::construct_at(e, std::move(*(e - 1)));
+            ++size_;
+            std::move_backward(p, e - 1, e);
+            *p = std::move(tmp);
+        }
+        return p;
+    }
+
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    iterator insert(const_iterator pos, size_type count, const T& value) {
+        const size_type index = static_cast<size_type>(pos - cbegin());
+        if (count == 0) {
+            return begin() + index;
+        }
+        const T copy = value;
+        if constexpr (relocate_with_memcpy<T>) {
+            reserve_for(size_ + count);
+            T* const p = begin() + index;
+            fill_gap(p, count, [&] { std::uninitialized_fill_n(p, count, copy); });
+        } else {
+            const size_type old_size = size_;
+            reserve_for(size_ + count);
+            for (size_type i = 0; i < count; ++i) {
+                emplace_back(copy);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+        }
+        return begin() + index;
+    }
+
+    template<std::input_iterator It>
+    iterator insert(const_iterator pos, It first, It last) {
+        const size_type index = static_cast<size_type>(pos - cbegin());
+        if constexpr (relocate_with_memcpy<T> && std::forward_iterator<It>) {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            reserve_for(size_ + count);
+            T* const p = begin() + index;
+            fill_gap(p, count, [&] { std::uninitialized_copy(first, last, p); });
+        } else {
+            const size_type old_size = size_;
+            if constexpr (std::forward_iterator<It>) {
+                reserve_for(size_ + static_cast<size_type>(std::distance(first, last)));
+            }
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+        }
+        return begin() + index;
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<T> values) {
+        return insert(pos, values.begin(), values.end());
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T* const f = begin() + (first - cbegin());
+        T* const l = begin() + (last - cbegin());
+        if (f != l) {
+            if constexpr (relocate_with_memcpy<T>) {
+                std::destroy(f, l);
+                relocate_within(l, end(), f - l);
+            } else {
+                T* const new_end = std::move(l, end(), f);
+                std::destroy(new_end, end());
+            }
+            size_ -= static_cast<size_type>(l - f);
+        }
+        return f;
+    }
+
+    void resize(size_type count) {
+        if (count <= size_) {
+            std::destroy(begin() + count, end());
+        } else {
+            reserve(count);
+            std::uninitialized_value_construct(end(), begin() + count);
+        }
+        size_ = count;
+    }
+
+    void resize(size_type count, const T& value) {
+        if (count <= size_) {
+            std::destroy(begin() + count, end());
+            size_ = count;
+        } else {
+            insert(cend(), count - size_, value);
+        }
+    }
+
+    void assign(size_type count, const T& value) {
+        const T copy = value;
+        clear();
+        reserve(count);
+        std::uninitialized_fill_n(begin(), count, copy);
+        size_ = count;
+    }
+
+    template<std::input_iterator It>
+    void assign(It first, It last) {
+        clear();
+        if constexpr (std::forward_iterator<It>) {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    void assign(std::initializer_list<T> values) {
+        assign(values.begin(), values.end());
+    }
+
+    // ------------------------------------------------------------------------
+    // Comparison
+    // ------------------------------------------------------------------------
+
+    friend bool operator==(const Derived& a, const Derived& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    friend auto operator<=>(const Derived& a, const Derived& b) requires std::three_way_comparable<T> {
+        return std::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+protected:
+    VectorBase() noexcept = default;
+    ~VectorBase() = default;
+
+    Derived& self() noexcept { return static_cast<Derived&>(*this); }
+    const Derived& self() const noexcept { return static_cast<const Derived&>(*this); }
+
+    /// Geometric growth to at least @p min_capacity
+    void grow(size_type min_capacity) {
+        self().reallocate(std::max(min_capacity, 2 * capacity()));
+    }
+
+    void reserve_for(size_type new_size) {
+        if (new_size > capacity()) {
+            grow(new_size);
+        }
+    }
+
+    /// Open a gap of @p count slots at @p p, then construct into it with fill()
+    template<typename Fill>
+    void fill_gap(T* p, size_type count, Fill fill) {
+        T* const e = end();
+        relocate_within(p, e, static_cast<std::ptrdiff_t>(count));
+        try {
+            fill();
+        } catch (...) {
+            relocate_within(p + count, e + count, -static_cast<std::ptrdiff_t>(count));
+            throw;
+        }
+        size_ += count;
+    }
+
+    template<typename... Args>
+    T& construct_at_end(Args&&... args) {
+        T* const p = std::construct_at(end(), std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+
+    /// Run a constructor body; on exception destroy what it built (no destructor will run)
+    template<typename Func>
+    void construct_with(Func func) {
+        try {
+            func();
+        } catch (...) {
+            clear();
+            self().release_storage();
+            throw;
+        }
+    }
+
+    size_type size_ = 0;
+};
+
+} // namespace detail
+
+// ============================================================================
+// small_vector
+// ============================================================================
+
+/**
+ * Vector with N elements of inline storage that spills to the heap
+ *
+ * Moving a spilled small_vector steals its heap block; moving an inline
+ * one relocates the elements (memcpy for trivially relocatable T). Either
+ * way the source is left empty. shrink_to_fit() returns to inline
+ * storage when the elements fit again.
+ */
+template<typename T, size_t N, typename Allocator = std::allocator<T>>
+class small_vector : public detail::VectorBase<small_vector<T, N, Allocator>, T> {
+    static_assert(N > 0, "use std::vector for a vector without inline storage");
+
+    using Base = detail::VectorBase<small_vector, T>;
+    using AllocTraits = std::allocator_traits<Allocator>;
+    friend Base;
+
+public:
+    using typename Base::size_type;
+    using allocator_type = Allocator;
+
+    static constexpr size_t INLINE_CAPACITY = N;
+
+    small_vector() noexcept(noexcept(Allocator())) : small_vector(Allocator()) {}
+
+    explicit small_vector(const Allocator& alloc) noexcept : alloc_(alloc) {}
+
+    explicit small_vector(size_type count, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+        this->construct_with([&] { this->resize(count); });
+    }
+
+    small_vector(size_type count, const T& value, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+        this->construct_with([&] { this->assign(count, value); });
+    }
+
+    template<std::input_iterator It>
+    small_vector(It first, It last, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+        this->construct_with([&] { this->assign(first, last); });
+    }
+
+    small_vector(std::initializer_list<T> values, const Allocator& alloc = Allocator())
+        : small_vector(values.begin(), values.end(), alloc) {}
+
+    small_vector(const small_vector& other)
+        : alloc_(AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+        this->construct_with([&] { this->assign(other.begin(), other.end()); });
+    }
+
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : alloc_(std::move(other.alloc_)) {
+        take(other);
+    }
+
+    ~small_vector() {
+        this->clear();
+        release_storage();
+    }
+
+    small_vector& operator=(const small_vector& other) {
+        if (this != &other) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                if (alloc_ != other.alloc_) {
+                    this->clear();
+                    release_storage();  // Belongs to the old allocator
+                }
+                alloc_ = other.alloc_;
+            }
+            this->assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T> &&
+        (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)) {
+        if (this == &other) {
+            return *this;
+        }
+        this->clear();
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            release_storage();
+            alloc_ = std::move(other.alloc_);
+            take(other);
+        } else {
+            if (other.is_inline() || alloc_ == other.alloc_) {
+                release_storage();
+                take(other);
+            } else {
+                // Cannot adopt a block from a different allocator: move element-wise
+                this->reserve(other.size_);
+                std::uninitialized_move(other.begin(), other.end(), this->begin());
+                this->size_ = other.size_;
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<T> values) {
+        this->assign(values);
+        return *this;
+    }
+
+    void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        small_vector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend void swap(small_vector& a, small_vector& b) noexcept(noexcept(a.swap(b))) {
+        a.swap(b);
+    }
+
+    void shrink_to_fit() {
+        if (is_inline() || this->size_ == capacity_) {
+            return;
+        }
+        if (this->size_ <= N) {
+            T* const heap = data_;
+            detail::relocate(heap, heap + this->size_, inline_data());
+            AllocTraits::deallocate(alloc_, heap, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        } else {
+            reallocate(this->size_);
+        }
+    }
+
+    size_type max_size() const noexcept { return AllocTraits::max_size(alloc_); }
+    bool is_inline() const noexcept { return data_ == inline_data(); }
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+private:
+    T* storage() noexcept { return data_; }
+    size_type storage_capacity() const noexcept { return capacity_; }
+
+    void reallocate(size_type new_capacity) {
+        T* const block = AllocTraits::allocate(alloc_, new_capacity);
+        try {
+            detail::relocate(data_, data_ + this->size_, block);
+        } catch (...) {
+            AllocTraits::deallocate(alloc_, block, new_capacity);
+            throw;
+        }
+        release_storage();
+        data_ = block;
+        capacity_ = new_capacity;
+    }
+
+    /// Free the heap block (elements must already be gone or relocated)
+    void release_storage() noexcept {
+        if (!is_inline()) {
+            AllocTraits::deallocate(alloc_, data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+
+    /// Adopt other's elements; we hold none and are inline. Leaves other empty.
+    void take(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.is_inline()) {
+            detail::relocate(other.data_, other.data_ + other.size_, inline_data());
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.capacity_ = N;
+        }
+        this->size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    T* inline_data() noexcept { return reinterpret_cast<T*>(inline_); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_); }
+
+    T* data_ = inline_data();
+    size_type capacity_ = N;
+    [[no_unique_address]] Allocator alloc_;
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+};
+
+// ============================================================================
+// static_vector
+// ============================================================================
+
+/**
+ * Vector with a fixed capacity of N elements stored inline
+ *
+ * Growing past N throws std::bad_alloc; try_emplace_back() reports a
+ * full vector with nullptr instead. The object is just a size and the
+ * element slots, with no pointer and no allocator.
+ */
+template<typename T, size_t N>
+class static_vector : public detail::VectorBase<static_vector<T, N>, T> {
+    static_assert(N > 0);
+
+    using Base = detail::VectorBase<static_vector, T>;
+    friend Base;
+
+public:
+    using typename Base::size_type;
+
+    static_vector() noexcept = default;
+
+    explicit static_vector(size_type count) {
+        this->construct_with([&] { this->resize(count); });
+    }
+
+    static_vector(size_type count, const T& value) {
+        this->construct_with([&] { this->assign(count, value); });
+    }
+
+    template<std::input_iterator It>
+    static_vector(It first, It last) {
+        this->construct_with([&] { this->assign(first, last); });
+    }
+
+    static_vector(std::initializer_list<T> values) : static_vector(values.begin(), values.end()) {}
+
+    static_vector(const static_vector& other) {
+        this->construct_with([&] { this->assign(other.begin(), other.end()); });
+    }
+
+    static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        detail::relocate(other.begin(), other.end(), storage());
+        this->size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    ~static_vector() {
+        this->clear();
+    }
+
+    static_vector& operator=(const static_vector& other) {
+        if (this != &other) {
+            this->assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    static_vector& operator=(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            this->clear();
+            detail::relocate(other.begin(), other.end(), storage());
+            this->size_ = other.size_;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    static_vector& operator=(std::initializer_list<T> values) {
+        this->assign(values);
+        return *this;
+    }
+
+    void swap(static_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        static_vector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend void swap(static_vector& a, static_vector& b) noexcept(noexcept(a.swap(b))) {
+        a.swap(b);
+    }
+
+    /// Append unless full; @return the new element, or nullptr if full
+    template<typename... Args>
+    T* try_emplace_back(Args&&... args) {
+        if (this->size_ == N) {
+            return nullptr;
+        }
+        return &this->construct_at_end(std::forward<Args>(args)...);
+    }
+
+    void shrink_to_fit() noexcept {}
+    static constexpr size_type max_size() noexcept { return N; }
+
+private:
+    T* storage() noexcept { return reinterpret_cast<T*>(storage_); }
+    static constexpr size_type storage_capacity() noexcept { return N; }
+
+    [[noreturn]] void reallocate(size_type) {
+        throw std::bad_alloc();
+    }
+
+    void release_storage() noexcept {}
+
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+};
+
+} // namespace hpc::vector_reserve
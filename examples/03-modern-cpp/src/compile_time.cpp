@@ -10,8 +10,11 @@
  * - consteval: must be evaluated at compile time
  * - Compile-time lookup tables
  * - Template metaprogramming vs constexpr
+ * - Compile-time perfect hashing for string dispatch
  */
 
+#include "function_table.hpp"  // make_function_table (04-simd-vectorization)
+#include "perfect_hash.hpp"    // fnv1a_hash, _hash, make_perfect_hash
 #include <array>
 #include <chrono>
 #include <cmath>
@@ -66,77 +69,20 @@ consteval int64_t factorial_consteval(int n) {
 //------------------------------------------------------------------------------
 
 /**
- * @brief Generate sine lookup table at compile time
+ * @brief Sine table generated at compile time
+ *
+ * 1024 samples of one period with linear interpolation; the lookup wraps
+ * the angle with a floor instead of while loops (function_table.hpp)
  */
-template<size_t N>
-constexpr std::array<double, N> generate_sin_table() {
-    std::array<double, N> table{};
-    constexpr double PI = 3.14159265358979323846;
-    for (size_t i = 0; i < N; ++i) {
-        double angle = (2.0 * PI * static_cast<double>(i)) / static_cast<double>(N);
-        // Taylor series approximation for sin (constexpr-friendly)
-        double x = angle;
-        // Normalize to [-PI, PI]
-        while (x > PI) x -= 2.0 * PI;
-        while (x < -PI) x += 2.0 * PI;
-        
-        // Taylor series: sin(x) = x - x^3/3! + x^5/5! - x^7/7! + ...
-        double x2 = x * x;
-        double term = x;
-        double sum = x;
-        for (int n = 1; n < 10; ++n) {
-            term *= -x2 / static_cast<double>((2 * n) * (2 * n + 1));
-            sum += term;
-        }
-        table[i] = sum;
-    }
-    return table;
-}
-
-// Compile-time generated lookup table
-constexpr auto SIN_TABLE = generate_sin_table<1024>();
+constexpr auto SIN_TABLE = hpc::simd::make_function_table<1024, hpc::simd::Interpolation::Linear,
+                                                          hpc::simd::Domain::Periodic>(
+    hpc::simd::constexpr_sin<double>, 0.0, 2.0 * 3.14159265358979323846);
 
 /**
  * @brief Fast sine using compile-time lookup table
  */
 double fast_sin(double angle) {
-    constexpr double PI = 3.14159265358979323846;
-    constexpr double TWO_PI = 2.0 * PI;
-    constexpr size_t TABLE_SIZE = SIN_TABLE.size();
-    
-    // Normalize angle to [0, 2*PI)
-    while (angle < 0) angle += TWO_PI;
-    while (angle >= TWO_PI) angle -= TWO_PI;
-    
-    // Convert to table index
-    size_t index = static_cast<size_t>((angle / TWO_PI) * TABLE_SIZE) % TABLE_SIZE;
-    return SIN_TABLE[index];
-}
-
-//------------------------------------------------------------------------------
-// Compile-time string hashing
-//------------------------------------------------------------------------------
-
-/**
- * @brief FNV-1a hash at compile time
- */
-constexpr uint64_t fnv1a_hash(const char* str) {
-    constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
-    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
-    
-    uint64_t hash = FNV_OFFSET;
-    while (*str) {
-        hash ^= static_cast<uint64_t>(*str++);
-        hash *= FNV_PRIME;
-    }
-    return hash;
-}
-
-/**
- * @brief String literal hash operator
- */
-consteval uint64_t operator""_hash(const char* str, size_t) {
-    return fnv1a_hash(str);
+    return SIN_TABLE(angle);
 }
 
 //------------------------------------------------------------------------------
@@ -283,6 +229,19 @@ void demonstrate_string_hash() {
         default:
             std::cout << "No match\n";
     }
+
+    // A perfect hash maps each key to its own slot: one hash, one compare
+    static constexpr auto COMMANDS = make_perfect_hash({"get", "set", "del", "incr", "expire"});
+    static_assert(COMMANDS.index_of("incr") == 3);
+    for (const char* command : {"set", "expire", "flush"}) {
+        const size_t index = COMMANDS.index_of(command);
+        std::cout << "Command '" << command << "': ";
+        if (index == COMMANDS.npos) {
+            std::cout << "unknown\n";
+        } else {
+            std::cout << "#" << index << "\n";
+        }
+    }
 }
 
 void demonstrate_primes() {
@@ -10,8 +10,12 @@
  * - std::move and rvalue references
  * - Return value optimization (RVO/NRVO)
  * - When to use std::move
+ * - Small-buffer optimization (SboBuffer): no allocation for small payloads
+ * - Trivially relocatable types: growing a vector without per-element moves
  */
 
+#include "../include/relocating_vector.hpp"
+#include "../include/sbo_buffer.hpp"
 #include <chrono>
 #include <cstring>
 #include <iostream>
@@ -32,6 +36,9 @@ namespace hpc::move_semantics {
  */
 class Buffer {
 public:
+    // Owns its block through a plain pointer, so moving the bytes moves the Buffer
+    using trivially_relocatable = std::true_type;
+    
     // Default constructor
     Buffer() : data_(nullptr), size_(0) {}
     
@@ -279,6 +286,91 @@ void demonstrate_return_value() {
     std::cout << "Note: With RVO/NRVO, copies and moves should be 0\n";
 }
 
+//------------------------------------------------------------------------------
+// Small-buffer optimization
+//------------------------------------------------------------------------------
+
+void demonstrate_small_buffers() {
+    std::cout << "\n=== Small-Buffer Optimization (1M buffers of 16 bytes) ===\n";
+    
+    constexpr size_t BUFFER_SIZE = 16;
+    constexpr int ITERATIONS = 1'000'000;
+    
+    // Heap-allocated and zero-filled every time
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            Buffer buf(BUFFER_SIZE);
+            buf.data()[0] = static_cast<char>(i);
+            volatile char c = buf.data()[0];
+            (void)c;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        std::cout << "Buffer:        " << us << " us\n";
+    }
+    
+    // Inline storage, nothing allocated or filled
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            SboBuffer<64> buf(BUFFER_SIZE, uninitialized);
+            buf.data()[0] = static_cast<char>(i);
+            volatile char c = buf.data()[0];
+            (void)c;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        std::cout << "SboBuffer<64>: " << us << " us\n";
+    }
+    
+    SboBuffer<64> small(BUFFER_SIZE, 'a');
+    SboBuffer<64> large(4096, 'b');
+    SboBuffer<64> moved_small = std::move(small);
+    SboBuffer<64> moved_large = std::move(large);
+    std::cout << "16 B inline: " << std::boolalpha << moved_small.is_inline()
+              << ", 4 KB inline: " << moved_large.is_inline()
+              << " (moved-from sizes: " << small.size() << ", " << large.size() << ")\n";
+}
+
+//------------------------------------------------------------------------------
+// Trivially relocatable growth
+//------------------------------------------------------------------------------
+
+void demonstrate_relocation() {
+    std::cout << "\n=== Growth Without reserve() (1M empty Buffers) ===\n";
+    
+    constexpr int NUM_BUFFERS = 1'000'000;
+    
+    // Every reallocation move-constructs and destroys each element
+    {
+        Buffer::reset_counts();
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<Buffer> vec;
+        for (int i = 0; i < NUM_BUFFERS; ++i) {
+            vec.emplace_back();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        std::cout << "std::vector<Buffer>:       " << us << " us"
+                  << " (moves: " << Buffer::move_count_ << ")\n";
+    }
+    
+    // Buffer is marked trivially relocatable: growth is realloc()
+    {
+        Buffer::reset_counts();
+        auto start = std::chrono::high_resolution_clock::now();
+        hpc::vector_reserve::relocating_vector<Buffer> vec;
+        for (int i = 0; i < NUM_BUFFERS; ++i) {
+            vec.emplace_back();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        std::cout << "relocating_vector<Buffer>: " << us << " us"
+                  << " (moves: " << Buffer::move_count_ << ")\n";
+    }
+}
+
 } // namespace hpc::move_semantics
 
 int main() {
@@ -287,12 +379,16 @@ int main() {
     hpc::move_semantics::demonstrate_vector_push_back();
     hpc::move_semantics::demonstrate_function_calls();
     hpc::move_semantics::demonstrate_return_value();
+    hpc::move_semantics::demonstrate_small_buffers();
+    hpc::move_semantics::demonstrate_relocation();
     
     std::cout << "\nKey takeaways:\n";
     std::cout << "1. Use std::move when you no longer need the source object\n";
     std::cout << "2. Use emplace_back instead of push_back when possible\n";
     std::cout << "3. Pass large objects by const reference when not transferring ownership\n";
     std::cout << "4. Return by value - RVO/NRVO will optimize it\n";
+    std::cout << "5. Keep small payloads inline (SBO) instead of heap-allocating them\n";
+    std::cout << "6. Mark pointer-owning types trivially relocatable so containers can memcpy/realloc them\n";
     
     return 0;
 }
@@ -9,8 +9,14 @@
  * - std::ranges algorithms
  * - Range views (lazy evaluation)
  * - Compiler optimization of ranges
+ * - SIMD-chunked adaptors (simd_ranges.hpp)
+ * - Branchless SIMD filter (simd_filter.hpp)
+ * - Chunked parallel execution (parallel_pipeline.hpp)
  */
 
+#include "parallel_pipeline.hpp"
+#include "simd_filter.hpp"
+#include "simd_ranges.hpp"
 #include <algorithm>
 #include <chrono>
 #include <iostream>
@@ -82,6 +88,17 @@ std::vector<int> filter_algorithm(const std::vector<int>& input) {
     return output;
 }
 
+/**
+ * @brief Branchless SIMD filter into a preallocated output
+ *
+ * output keeps input.size() elements so repeated calls never reallocate;
+ * returns how many of them hold results.
+ */
+size_t filter_simd(const std::vector<int>& input, std::vector<int>& output) {
+    output.resize(input.size());
+    return filter_into(input, output, [](int x) { return x % 2 == 0; });
+}
+
 /**
  * @brief Filter using ranges view (lazy)
  */
@@ -245,6 +262,19 @@ void benchmark_filter() {
         std::cout << "std::copy_if: " << ms << " ms\n";
     }
     
+    // Branchless SIMD filter (output allocated once)
+    {
+        std::vector<int> output;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            volatile size_t s = filter_simd(input, output);
+            (void)s;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        std::cout << "SIMD filter_into: " << ms << " ms\n";
+    }
+    
     // Ranges view (lazy, just iteration)
     {
         auto start = std::chrono::high_resolution_clock::now();
@@ -315,6 +345,38 @@ void benchmark_chain() {
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
         std::cout << "Ranges (lazy sum): " << ms << " ms\n";
     }
+    
+    // SIMD ranges: same pipe syntax, evaluated a chunk of registers at a time
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            int64_t sum = input | simd_filter([](int x) { return x % 2 == 0; })
+                                | simd_transform([](int x) { return x * 2 + 1; })
+                                | simd_reduce(int64_t{0});
+            volatile int64_t s = sum;
+            (void)s;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        std::cout << "SIMD ranges (sum): " << ms << " ms\n";
+    }
+    
+    // Same pipeline, chunks spread over the thread pool
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            int64_t sum = input | in_parallel()
+                                | simd_filter([](int x) { return x % 2 == 0; })
+                                | simd_transform([](int x) { return x * 2 + 1; })
+                                | simd_reduce(int64_t{0});
+            volatile int64_t s = sum;
+            (void)s;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        std::cout << "Parallel SIMD ranges (sum, " << ThreadPool::global().size()
+                  << " threads): " << ms << " ms\n";
+    }
 }
 
 } // namespace hpc::ranges
@@ -331,6 +393,7 @@ int main() {
     std::cout << "2. Ranges views are lazy - no intermediate allocations\n";
     std::cout << "3. Chained operations with views can be more efficient\n";
     std::cout << "4. Modern compilers optimize ranges well\n";
+    std::cout << "5. filter views branch per element; chunked SIMD adaptors do not\n";
     
     return 0;
 }
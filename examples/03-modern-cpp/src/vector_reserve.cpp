@@ -9,9 +9,13 @@
  * - Vector growth strategy (typically 1.5x or 2x)
  * - reserve() vs resize()
  * - Counting allocations with custom allocator
+ * - small_vector / static_vector: no allocation at all for small sizes
  */
 
+#include "../include/counting_allocator.hpp"
+#include "../include/small_vector.hpp"
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
@@ -19,69 +23,6 @@
 
 namespace hpc::vector_reserve {
 
-//------------------------------------------------------------------------------
-// Counting allocator to track allocations
-//------------------------------------------------------------------------------
-
-template<typename T>
-class CountingAllocator {
-public:
-    using value_type = T;
-    using size_type = std::size_t;
-    using difference_type = std::ptrdiff_t;
-    
-    CountingAllocator() noexcept = default;
-    
-    template<typename U>
-    CountingAllocator(const CountingAllocator<U>&) noexcept {}
-    
-    T* allocate(std::size_t n) {
-        ++allocation_count_;
-        total_bytes_allocated_ += n * sizeof(T);
-        return static_cast<T*>(std::malloc(n * sizeof(T)));
-    }
-    
-    void deallocate(T* ptr, std::size_t n) noexcept {
-        ++deallocation_count_;
-        total_bytes_deallocated_ += n * sizeof(T);
-        std::free(ptr);
-    }
-    
-    static void reset_counts() {
-        allocation_count_ = 0;
-        deallocation_count_ = 0;
-        total_bytes_allocated_ = 0;
-        total_bytes_deallocated_ = 0;
-    }
-    
-    static size_t allocation_count_;
-    static size_t deallocation_count_;
-    static size_t total_bytes_allocated_;
-    static size_t total_bytes_deallocated_;
-};
-
-template<typename T>
-size_t CountingAllocator<T>::allocation_count_ = 0;
-
-template<typename T>
-size_t CountingAllocator<T>::deallocation_count_ = 0;
-
-template<typename T>
-size_t CountingAllocator<T>::total_bytes_allocated_ = 0;
-
-template<typename T>
-size_t CountingAllocator<T>::total_bytes_deallocated_ = 0;
-
-template<typename T, typename U>
-bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) noexcept {
-    return true;
-}
-
-template<typename T, typename U>
-bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) noexcept {
-    return false;
-}
-
 //------------------------------------------------------------------------------
 // Demonstrations
 //------------------------------------------------------------------------------
@@ -210,6 +151,50 @@ void demonstrate_clear_vs_shrink() {
     std::cout << "After swap trick: size=" << vec.size() << ", capacity=" << vec.capacity() << "\n";
 }
 
+void demonstrate_inline_storage() {
+    std::cout << "\n=== Inline Storage: 100K containers of 8 ints ===\n";
+    
+    constexpr int CONTAINERS = 100'000;
+    constexpr int ELEMENTS = 8;
+    
+    auto run = [](const char* label, auto make) {
+        using Container = decltype(make());
+        CountingAllocator<int>::reset_counts();
+        auto start = std::chrono::high_resolution_clock::now();
+        int64_t checksum = 0;
+        for (int c = 0; c < CONTAINERS; ++c) {
+            Container v = make();
+            for (int i = 0; i < ELEMENTS; ++i) {
+                v.push_back(i + c);
+            }
+            checksum += v.back();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        std::cout << label << us << " us, allocations: " << CountingAllocator<int>::allocation_count_
+                  << " (checksum " << checksum << ")\n";
+    };
+    
+    using CountingVector = std::vector<int, CountingAllocator<int>>;
+    run("std::vector:               ", [] { return CountingVector(); });
+    run("std::vector + reserve(8):  ", [] {
+        CountingVector v;
+        v.reserve(ELEMENTS);
+        return v;
+    });
+    run("small_vector<int, 8>:      ", [] { return small_vector<int, 8, CountingAllocator<int>>(); });
+    run("static_vector<int, 8>:     ", [] { return static_vector<int, 8>(); });
+    
+    // One element past the inline capacity spills to the heap once
+    CountingAllocator<int>::reset_counts();
+    small_vector<int, 8, CountingAllocator<int>> spilled;
+    for (int i = 0; i < 9; ++i) {
+        spilled.push_back(i);
+    }
+    std::cout << "small_vector<int, 8> with 9 elements: " << CountingAllocator<int>::allocation_count_
+              << " allocation, capacity " << spilled.capacity() << "\n";
+}
+
 } // namespace hpc::vector_reserve
 
 int main() {
@@ -220,12 +205,14 @@ int main() {
     hpc::vector_reserve::demonstrate_resize_vs_reserve();
     hpc::vector_reserve::demonstrate_shrink_to_fit();
     hpc::vector_reserve::demonstrate_clear_vs_shrink();
+    hpc::vector_reserve::demonstrate_inline_storage();
     
     std::cout << "\nKey takeaways:\n";
     std::cout << "1. Always use reserve() when you know the final size\n";
     std::cout << "2. Without reserve(), vector may reallocate O(log N) times\n";
     std::cout << "3. Each reallocation copies all existing elements\n";
     std::cout << "4. Use shrink_to_fit() or swap trick to release excess capacity\n";
+    std::cout << "5. For small, bounded sizes, inline storage avoids the heap entirely\n";
     
     return 0;
 }
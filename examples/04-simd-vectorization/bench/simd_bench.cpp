@@ -6,14 +6,40 @@
  * 1. Scalar vs SSE vs AVX2 vs AVX-512 performance
  * 2. Speedup ratios for different operations
  * 3. Impact of array size on SIMD efficiency
+ * 4. clamp(a*s + b) at cache- and DRAM-sized arrays: one *_wrapped pass
+ *    per operation vs one fused expression-template pass (simd_expr.hpp)
+ * 5. sin through compile-time interpolated tables (function_table.hpp) of
+ *    64-16384 samples, scalar and gathered, vs std::sin; max_err reports
+ *    each table's accuracy over the benchmark's inputs
+ * 6. popcount of a byte buffer: scalar popcnt per 64-bit word vs vpshufb
+ *    lookups of the compile-time nibble table (simd_tables.hpp)
+ * 7. dot/axpy/norm on 3-16 element vectors and 4x4 matvec/matmul: the
+ *    runtime-n *_wrapped kernels vs the unrolled fixed-size ones
+ *    (simd_fixed.hpp), over a batch of small vectors
+ * 8. Bitset (simd_bitset.hpp) vs std::bitset vs std::vector<bool> at 1K-1G
+ *    bits: AND, count and set-bit iteration, plus the bitmap decoder vs a
+ *    tzcnt loop and RankSelect queries
  */
 
 #include <benchmark/benchmark.h>
 #include "../include/simd_utils.hpp"
+#include "../include/simd_bitset.hpp"
+#include "../include/function_table.hpp"
+#include "../include/simd_expr.hpp"
+#include "../include/simd_fixed.hpp"
 #include "../include/simd_wrapper.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
 #include <vector>
 #include <random>
 #include <cmath>
+#include <numbers>
 
 namespace {
 
@@ -299,4 +325,722 @@ static void BM_FloatVec_HorizontalSum(benchmark::State& state) {
 
 BENCHMARK(BM_FloatVec_HorizontalSum);
 
+// ============================================================================
+// Chained Operations: clamp(a*s + b)
+// ============================================================================
+
+namespace {
+
+constexpr float CHAIN_SCALE = 1.5f;
+constexpr float CHAIN_LO = -50.0f;
+constexpr float CHAIN_HI = 50.0f;
+
+struct ChainArrays {
+    explicit ChainArrays(size_t n) : a(n), b(n), out(n), tmp(n) {
+        init_random(a.data(), n);
+        init_random(b.data(), n);
+    }
+
+    hpc::simd::Array<float> a, b, out, tmp;
+};
+
+void set_chain_counters(benchmark::State& state, size_t n) {
+    // Useful traffic: read a and b, write out
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * sizeof(float) * 3));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+} // anonymous namespace
+
+/// Function per pass: copy, scale in place, add, clamp in place (4 passes, 1 temporary)
+static void BM_Chain_PerPass(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    ChainArrays arr(n);
+    for (auto _ : state) {
+        std::copy(arr.a.begin(), arr.a.end(), arr.tmp.begin());
+        hpc::simd::scale_array_wrapped(arr.tmp.data(), CHAIN_SCALE, n);
+        hpc::simd::add_arrays_wrapped(arr.tmp.data(), arr.b.data(), arr.out.data(), n);
+        hpc::simd::clamp_array_wrapped(arr.out.data(), CHAIN_LO, CHAIN_HI, n);
+        benchmark::DoNotOptimize(arr.out.data());
+        benchmark::ClobberMemory();
+    }
+    set_chain_counters(state, n);
+}
+
+/// Hand-written fused SimdVec loop: the lower bound for the expression
+static void BM_Chain_HandFused(benchmark::State& state) {
+    using hpc::simd::FloatVec;
+    const size_t n = static_cast<size_t>(state.range(0));
+    ChainArrays arr(n);
+    const FloatVec vs(CHAIN_SCALE), vlo(CHAIN_LO), vhi(CHAIN_HI);
+    for (auto _ : state) {
+        size_t i = 0;
+        for (; i + hpc::simd::FLOAT_VEC_WIDTH <= n; i += hpc::simd::FLOAT_VEC_WIDTH) {
+            FloatVec v = FloatVec(&arr.a[i]) * vs + FloatVec(&arr.b[i]);
+            v.max(vlo).min(vhi).store(&arr.out[i]);
+        }
+        for (; i < n; ++i) {
+            arr.out[i] = std::min(std::max(arr.a[i] * CHAIN_SCALE + arr.b[i], CHAIN_LO), CHAIN_HI);
+        }
+        benchmark::DoNotOptimize(arr.out.data());
+        benchmark::ClobberMemory();
+    }
+    set_chain_counters(state, n);
+}
+
+/// Expression template: one pass, no temporary
+static void BM_Chain_Expression(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    ChainArrays arr(n);
+    const auto e = clamp(arr.a * CHAIN_SCALE + arr.b, CHAIN_LO, CHAIN_HI);
+    for (auto _ : state) {
+        arr.out = e;
+        benchmark::DoNotOptimize(arr.out.data());
+        benchmark::ClobberMemory();
+    }
+    set_chain_counters(state, n);
+}
+
+/// Expression template split across all hardware threads
+static void BM_Chain_ExpressionParallel(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    ChainArrays arr(n);
+    const auto e = clamp(arr.a * CHAIN_SCALE + arr.b, CHAIN_LO, CHAIN_HI);
+    for (auto _ : state) {
+        arr.out.assign_parallel(e);
+        benchmark::DoNotOptimize(arr.out.data());
+        benchmark::ClobberMemory();
+    }
+    set_chain_counters(state, n);
+}
+
+// 64K floats fit in L2; 16M and 64M floats (64/256 MB per array) stream from DRAM
+void chain_sizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 24)->Arg(1 << 26)->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(BM_Chain_PerPass)->Apply(chain_sizes);
+BENCHMARK(BM_Chain_HandFused)->Apply(chain_sizes);
+BENCHMARK(BM_Chain_Expression)->Apply(chain_sizes);
+BENCHMARK(BM_Chain_ExpressionParallel)->Apply(chain_sizes)->UseRealTime();
+
+// ============================================================================
+// Interpolated function tables: sin
+// ============================================================================
+
+namespace {
+
+using hpc::simd::Interpolation;
+
+constexpr size_t SIN_INPUTS = 1 << 14;
+
+template<size_t N, Interpolation Interp>
+constexpr auto SIN_TABLE = hpc::simd::make_function_table<N, Interp, hpc::simd::Domain::Periodic>(
+    hpc::simd::constexpr_sin<double>, 0.0, 2 * std::numbers::pi);
+
+/// Angles over several periods, both signs, so the range reduction is exercised
+std::vector<double> sin_inputs() {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<double> x(SIN_INPUTS);
+    for (double& v : x) {
+        v = dist(gen);
+    }
+    return x;
+}
+
+template<typename Table>
+void set_sin_counters(benchmark::State& state, const Table& table, const std::vector<double>& x) {
+    double max_err = 0;
+    for (double v : x) {
+        max_err = std::max(max_err, std::abs(table(v) - std::sin(v)));
+    }
+    state.counters["max_err"] = max_err;
+    state.counters["table_bytes"] = static_cast<double>(table.bytes());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * x.size()));
+}
+
+} // anonymous namespace
+
+static void BM_Sin_Std(benchmark::State& state) {
+    const auto x = sin_inputs();
+    std::vector<double> y(x.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < x.size(); ++i) {
+            y[i] = std::sin(x[i]);
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * x.size()));
+}
+
+/// One scalar lookup per element
+template<size_t N, Interpolation Interp>
+static void BM_Sin_TableScalar(benchmark::State& state) {
+    const auto& table = SIN_TABLE<N, Interp>;
+    const auto x = sin_inputs();
+    std::vector<double> y(x.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < x.size(); ++i) {
+            y[i] = table(x[i]);
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_sin_counters(state, table, x);
+}
+
+/// evaluate(): DoubleVec registers, samples fetched with gathers
+template<size_t N, Interpolation Interp>
+static void BM_Sin_TableBatch(benchmark::State& state) {
+    const auto& table = SIN_TABLE<N, Interp>;
+    const auto x = sin_inputs();
+    std::vector<double> y(x.size());
+    for (auto _ : state) {
+        table.evaluate(x.data(), y.data(), x.size());
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_sin_counters(state, table, x);
+}
+
+BENCHMARK(BM_Sin_Std);
+BENCHMARK_TEMPLATE(BM_Sin_TableScalar, 1024, Interpolation::Linear);
+BENCHMARK_TEMPLATE(BM_Sin_TableScalar, 256, Interpolation::Cubic);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 64, Interpolation::Linear);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 256, Interpolation::Linear);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 1024, Interpolation::Linear);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 4096, Interpolation::Linear);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 16384, Interpolation::Linear);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 64, Interpolation::Cubic);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 256, Interpolation::Cubic);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 1024, Interpolation::Cubic);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 4096, Interpolation::Cubic);
+BENCHMARK_TEMPLATE(BM_Sin_TableBatch, 16384, Interpolation::Cubic);
+
+// ============================================================================
+// Popcount: popcnt vs nibble table
+// ============================================================================
+
+namespace {
+
+std::vector<uint8_t> random_bytes(size_t n) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> bytes(n);
+    for (uint8_t& b : bytes) {
+        b = static_cast<uint8_t>(dist(gen));
+    }
+    return bytes;
+}
+
+} // anonymous namespace
+
+/// std::popcount per 64-bit word: one popcnt instruction with -march=native
+static void BM_Popcount_Scalar(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto bytes = random_bytes(n);
+    for (auto _ : state) {
+        uint64_t count = 0;
+        for (size_t i = 0; i + 8 <= n; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes.data() + i, sizeof(word));
+            count += static_cast<uint64_t>(std::popcount(word));
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+/// popcount_wrapped(): NIBBLE_POPCOUNT through vpshufb, a register at a time
+static void BM_Popcount_NibbleTable(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto bytes = random_bytes(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hpc::simd::popcount_wrapped(bytes.data(), n));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+BENCHMARK(BM_Popcount_Scalar)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(BM_Popcount_NibbleTable)->Arg(4096)->Arg(1 << 20);
+
+// ============================================================================
+// Fixed-size kernels: runtime n vs compile-time N
+// ============================================================================
+
+namespace {
+
+using hpc::simd::Mat4f;
+
+/// Small vectors per iteration: 1024 of N floats stay in L1/L2
+constexpr size_t FIXED_BATCH = 1024;
+
+template<size_t N>
+std::vector<std::array<float, N>> random_vectors() {
+    std::vector<std::array<float, N>> v(FIXED_BATCH);
+    init_random(v.front().data(), FIXED_BATCH * N);
+    return v;
+}
+
+std::vector<Mat4f> random_matrices() {
+    std::vector<Mat4f> m(FIXED_BATCH);
+    init_random(m.front().cols.front().data(), FIXED_BATCH * 16);
+    return m;
+}
+
+/// n as the runtime kernels see it: not a constant the compiler can fold in
+size_t opaque(size_t n) {
+    benchmark::DoNotOptimize(n);
+    return n;
+}
+
+/// y = m * x through the runtime kernels: one axpy per column
+void matvec_runtime(const float* m, const float* x, float* y, size_t rows, size_t cols) {
+    std::fill(y, y + rows, 0.0f);
+    for (size_t c = 0; c < cols; ++c) {
+        hpc::simd::axpy_wrapped(x[c], m + c * rows, y, rows);
+    }
+}
+
+} // anonymous namespace
+
+template<size_t N>
+static void BM_Dot_Runtime(benchmark::State& state) {
+    const auto a = random_vectors<N>();
+    const auto b = random_vectors<N>();
+    const size_t n = opaque(N);
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            sum += hpc::simd::dot_product_wrapped(a[i].data(), b[i].data(), n);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+template<size_t N>
+static void BM_Dot_Fixed(benchmark::State& state) {
+    const auto a = random_vectors<N>();
+    const auto b = random_vectors<N>();
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            sum += hpc::simd::dot(a[i], b[i]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+template<size_t N>
+static void BM_Norm_Runtime(benchmark::State& state) {
+    const auto a = random_vectors<N>();
+    const size_t n = opaque(N);
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            sum += std::sqrt(hpc::simd::dot_product_wrapped(a[i].data(), a[i].data(), n));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+template<size_t N>
+static void BM_Norm_Fixed(benchmark::State& state) {
+    const auto a = random_vectors<N>();
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            sum += hpc::simd::norm(a[i]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+template<size_t N>
+static void BM_Axpy_Runtime(benchmark::State& state) {
+    const auto x = random_vectors<N>();
+    auto y = random_vectors<N>();
+    const size_t n = opaque(N);
+    for (auto _ : state) {
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            hpc::simd::axpy_wrapped(1e-3f, x[i].data(), y[i].data(), n);
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+template<size_t N>
+static void BM_Axpy_Fixed(benchmark::State& state) {
+    const auto x = random_vectors<N>();
+    auto y = random_vectors<N>();
+    for (auto _ : state) {
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            hpc::simd::axpy(1e-3f, x[i], y[i]);
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+static void BM_Matvec4_Runtime(benchmark::State& state) {
+    const auto m = random_matrices();
+    const auto x = random_vectors<4>();
+    std::vector<std::array<float, 4>> y(FIXED_BATCH);
+    const size_t n = opaque(4);
+    for (auto _ : state) {
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            matvec_runtime(m[i].cols.front().data(), x[i].data(), y[i].data(), n, n);
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+static void BM_Matvec4_Fixed(benchmark::State& state) {
+    const auto m = random_matrices();
+    const auto x = random_vectors<4>();
+    std::vector<std::array<float, 4>> y(FIXED_BATCH);
+    for (auto _ : state) {
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            y[i] = hpc::simd::matvec(m[i], x[i]);
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+/// Column c of a * b is a * (column c of b): four runtime matvecs
+static void BM_Matmul4_Runtime(benchmark::State& state) {
+    const auto a = random_matrices();
+    const auto b = random_matrices();
+    std::vector<Mat4f> p(FIXED_BATCH);
+    const size_t n = opaque(4);
+    for (auto _ : state) {
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            for (size_t c = 0; c < n; ++c) {
+                matvec_runtime(a[i].cols.front().data(), b[i].cols[c].data(), p[i].cols[c].data(), n, n);
+            }
+        }
+        benchmark::DoNotOptimize(p.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+static void BM_Matmul4_Fixed(benchmark::State& state) {
+    const auto a = random_matrices();
+    const auto b = random_matrices();
+    std::vector<Mat4f> p(FIXED_BATCH);
+    for (auto _ : state) {
+        for (size_t i = 0; i < FIXED_BATCH; ++i) {
+            p[i] = hpc::simd::matmul(a[i], b[i]);
+        }
+        benchmark::DoNotOptimize(p.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FIXED_BATCH));
+}
+
+BENCHMARK_TEMPLATE(BM_Dot_Runtime, 3);
+BENCHMARK_TEMPLATE(BM_Dot_Fixed, 3);
+BENCHMARK_TEMPLATE(BM_Dot_Runtime, 4);
+BENCHMARK_TEMPLATE(BM_Dot_Fixed, 4);
+BENCHMARK_TEMPLATE(BM_Dot_Runtime, 8);
+BENCHMARK_TEMPLATE(BM_Dot_Fixed, 8);
+BENCHMARK_TEMPLATE(BM_Dot_Runtime, 16);
+BENCHMARK_TEMPLATE(BM_Dot_Fixed, 16);
+BENCHMARK_TEMPLATE(BM_Norm_Runtime, 3);
+BENCHMARK_TEMPLATE(BM_Norm_Fixed, 3);
+BENCHMARK_TEMPLATE(BM_Norm_Runtime, 4);
+BENCHMARK_TEMPLATE(BM_Norm_Fixed, 4);
+BENCHMARK_TEMPLATE(BM_Axpy_Runtime, 3);
+BENCHMARK_TEMPLATE(BM_Axpy_Fixed, 3);
+BENCHMARK_TEMPLATE(BM_Axpy_Runtime, 4);
+BENCHMARK_TEMPLATE(BM_Axpy_Fixed, 4);
+BENCHMARK_TEMPLATE(BM_Axpy_Runtime, 8);
+BENCHMARK_TEMPLATE(BM_Axpy_Fixed, 8);
+BENCHMARK_TEMPLATE(BM_Axpy_Runtime, 16);
+BENCHMARK_TEMPLATE(BM_Axpy_Fixed, 16);
+BENCHMARK(BM_Matvec4_Runtime);
+BENCHMARK(BM_Matvec4_Fixed);
+BENCHMARK(BM_Matmul4_Runtime);
+BENCHMARK(BM_Matmul4_Fixed);
+
+// ============================================================================
+// Bitsets: SIMD words vs std::bitset vs std::vector<bool>
+// ============================================================================
+
+namespace {
+
+using hpc::simd::Bitset;
+
+/// Dense inputs are half ones; sparse ones have one bit in 16 set, for
+/// iteration and decoding (1G bits would otherwise decode to 2 GB)
+struct BitsetInputs {
+    Bitset a, b, sparse;
+    std::vector<bool> va, vb, vsparse;
+};
+
+Bitset random_bitset(size_t n, std::mt19937_64& gen, int ands) {
+    Bitset bits(n);
+    for (size_t j = 0; j < n / 64; ++j) {
+        uint64_t w = gen();
+        for (int k = 0; k < ands; ++k) w &= gen();
+        bits.data()[j] = w;
+    }
+    return bits;
+}
+
+std::vector<bool> to_vector_bool(const Bitset& bits) {
+    std::vector<bool> v(bits.size());
+    bits.for_each_set([&](size_t i) { v[i] = true; });
+    return v;
+}
+
+/// Built once per size: filling 1G bits takes longer than the benchmark
+const BitsetInputs& bitset_inputs(size_t n) {
+    static std::map<size_t, std::unique_ptr<BitsetInputs>> cache;
+    auto& inputs = cache[n];
+    if (!inputs) {
+        std::mt19937_64 gen(42);
+        inputs = std::make_unique<BitsetInputs>();
+        inputs->a = random_bitset(n, gen, 0);
+        inputs->b = random_bitset(n, gen, 0);
+        inputs->sparse = random_bitset(n, gen, 3);
+        inputs->va = to_vector_bool(inputs->a);
+        inputs->vb = to_vector_bool(inputs->b);
+        inputs->vsparse = to_vector_bool(inputs->sparse);
+    }
+    return *inputs;
+}
+
+/// The same bits in a std::bitset; on the heap, as 1G bits is 128 MB
+template<size_t N>
+const std::bitset<N>& std_bitset(const Bitset& bits) {
+    static std::map<const Bitset*, std::unique_ptr<std::bitset<N>>> cache;
+    auto& out = cache[&bits];
+    if (!out) {
+        out = std::make_unique<std::bitset<N>>();
+        bits.for_each_set([&](size_t i) { out->set(i); });
+    }
+    return *out;
+}
+
+void set_bit_throughput(benchmark::State& state, size_t bits) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bits));
+}
+
+} // anonymous namespace
+
+static void BM_BitsetAnd_Simd(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& in = bitset_inputs(n);
+    Bitset dst = in.a;
+    for (auto _ : state) {
+        dst &= in.b;
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    set_bit_throughput(state, n);
+}
+
+template<size_t N>
+static void BM_BitsetAnd_StdBitset(benchmark::State& state) {
+    const auto& in = bitset_inputs(N);
+    auto dst = std::make_unique<std::bitset<N>>(std_bitset<N>(in.a));
+    const auto& b = std_bitset<N>(in.b);
+    for (auto _ : state) {
+        *dst &= b;
+        benchmark::DoNotOptimize(dst.get());
+        benchmark::ClobberMemory();
+    }
+    set_bit_throughput(state, N);
+}
+
+/// vector<bool> has no bulk operations: one proxy read-modify-write per bit
+static void BM_BitsetAnd_VectorBool(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& in = bitset_inputs(n);
+    std::vector<bool> dst = in.va;
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = dst[i] && in.vb[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    set_bit_throughput(state, n);
+}
+
+static void BM_BitsetCount_Simd(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& in = bitset_inputs(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.a.count());
+    }
+    set_bit_throughput(state, n);
+}
+
+template<size_t N>
+static void BM_BitsetCount_StdBitset(benchmark::State& state) {
+    const auto& bits = std_bitset<N>(bitset_inputs(N).a);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bits.count());
+    }
+    set_bit_throughput(state, N);
+}
+
+/// libstdc++ counts whole words for vector<bool> iterators
+static void BM_BitsetCount_VectorBool(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& in = bitset_inputs(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(in.va.begin(), in.va.end(), true));
+    }
+    set_bit_throughput(state, n);
+}
+
+/// Sum of set-bit positions, one bit in 16 set
+static void BM_BitsetIterate_Simd(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& in = bitset_inputs(n);
+    for (auto _ : state) {
+        size_t sum = 0;
+        in.sparse.for_each_set([&](size_t i) { sum += i; });
+        benchmark::DoNotOptimize(sum);
+    }
+    set_bit_throughput(state, n);
+}
+
+template<size_t N>
+static void BM_BitsetIterate_StdBitset(benchmark::State& state) {
+    const auto& bits = std_bitset<N>(bitset_inputs(N).sparse);
+    for (auto _ : state) {
+        size_t sum = 0;
+#if defined(__GLIBCXX__)
+        for (size_t i = bits._Find_first(); i < N; i = bits._Find_next(i)) {
+            sum += i;
+        }
+#else
+        for (size_t i = 0; i < N; ++i) {
+            if (bits.test(i)) sum += i;
+        }
+#endif
+        benchmark::DoNotOptimize(sum);
+    }
+    set_bit_throughput(state, N);
+}
+
+static void BM_BitsetIterate_VectorBool(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& in = bitset_inputs(n);
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (in.vsparse[i]) sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_bit_throughput(state, n);
+}
+
+/// Set-bit positions to uint32 indices: clear-lowest-bit and tzcnt per bit
+static void BM_BitmapDecode_Scalar(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& bits = bitset_inputs(n).sparse;
+    std::vector<uint32_t> out(bits.count());
+    for (auto _ : state) {
+        size_t k = 0;
+        for (size_t j = 0; j < bits.words(); ++j) {
+            for (uint64_t w = bits.data()[j]; w != 0; w &= w - 1) {
+                out[k++] = static_cast<uint32_t>(j * 64 + static_cast<size_t>(std::countr_zero(w)));
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    set_bit_throughput(state, n);
+}
+
+/// decode_bitmap(): a compress (or a permute-table row) per 16 (8) bits
+static void BM_BitmapDecode_Simd(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& bits = bitset_inputs(n).sparse;
+    std::vector<uint32_t> out(bits.count() + hpc::simd::DECODE_SLACK);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hpc::simd::decode_bitmap(bits.data(), bits.words(), out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_bit_throughput(state, n);
+}
+
+/// Random rank(i) and select(k) queries on the dense bits
+static void BM_RankSelect_Rank(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& bits = bitset_inputs(n).a;
+    const hpc::simd::RankSelect rs(bits);
+    std::mt19937_64 gen(7);
+    std::vector<size_t> queries(1024);
+    for (size_t& q : queries) q = gen() % n;
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (size_t q : queries) sum += rs.rank(q);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * queries.size()));
+}
+
+static void BM_RankSelect_Select(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto& bits = bitset_inputs(n).a;
+    const hpc::simd::RankSelect rs(bits);
+    std::mt19937_64 gen(7);
+    std::vector<size_t> queries(1024);
+    for (size_t& q : queries) q = gen() % rs.count();
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (size_t q : queries) sum += rs.select(q);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * queries.size()));
+}
+
+// 1K bits fit in a few registers, 1M in L2; 32M (4 MB) and 1G (128 MB) stream
+void bitset_sizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 25)->Arg(1 << 30)->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(BM_BitsetAnd_Simd)->Apply(bitset_sizes);
+BENCHMARK_TEMPLATE(BM_BitsetAnd_StdBitset, 1 << 10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitsetAnd_StdBitset, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitsetAnd_StdBitset, 1 << 25)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitsetAnd_StdBitset, 1 << 30)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BitsetAnd_VectorBool)->Apply(bitset_sizes);
+BENCHMARK(BM_BitsetCount_Simd)->Apply(bitset_sizes);
+BENCHMARK_TEMPLATE(BM_BitsetCount_StdBitset, 1 << 10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitsetCount_StdBitset, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitsetCount_StdBitset, 1 << 25)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitsetCount_StdBitset, 1 << 30)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BitsetCount_VectorBool)->Apply(bitset_sizes);
+BENCHMARK(BM_BitsetIterate_Simd)->Apply(bitset_sizes);
+BENCHMARK_TEMPLATE(BM_BitsetIterate_StdBitset, 1 << 10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitsetIterate_StdBitset, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitsetIterate_StdBitset, 1 << 25)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BitsetIterate_StdBitset, 1 << 30)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BitsetIterate_VectorBool)->Apply(bitset_sizes);
+BENCHMARK(BM_BitmapDecode_Scalar)->Apply(bitset_sizes);
+BENCHMARK(BM_BitmapDecode_Simd)->Apply(bitset_sizes);
+BENCHMARK(BM_RankSelect_Rank)->Apply(bitset_sizes);
+BENCHMARK(BM_RankSelect_Select)->Apply(bitset_sizes);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,431 @@
+#pragma once
+
+/**
+ * @file simd_bitset.hpp
+ * @brief Runtime-sized bitsets with SIMD set operations, popcount,
+ *        rank/select and bitmap-to-index decoding
+ *
+ * std::bitset fixes its size at compile time. std::vector<bool> hides its
+ * words behind proxy references, so algorithms on it go bit by bit.
+ * Bitset keeps 64-bit words in a SIMD-aligned buffer, padded to whole
+ * 512-bit blocks. Padding bits are always zero, so every kernel runs on
+ * full registers with no tail:
+ *
+ *   &=, |=, ^=, and_not()  one vector instruction per register
+ *   count()                VPOPCNTDQ (AVX-512); Harley-Seal carry-save
+ *                          adders (AVX2), where one nibble-table popcount
+ *                          covers 16 registers; popcnt per word otherwise
+ *   for_each_set()         skips all-zero blocks with one test, then
+ *   find_next()            tzcnt through each word
+ *   decode_bitmap()        positions of the set bits as uint32 indices:
+ *                          vpcompressd per 16 bits (AVX-512), or per byte a
+ *                          COMPRESS_PERMUTE_8X32 row plus the byte's offset
+ *   RankSelect             per-block prefix counts: rank in O(1); select
+ *                          by a binary search between sampled blocks and
+ *                          a pdep within the word
+ *
+ * @code
+ * Bitset a(n), b(n);
+ * a.set(3); b.set(3); b.set(7);
+ * a &= b;                                    // {3}
+ * size_t ones = b.count();                   // 2
+ * b.for_each_set([](size_t i) { ... });      // 3, 7
+ * std::vector<uint32_t> idx = b.to_indices();
+ * RankSelect rs(b);
+ * rs.rank(7);                                // 1: set bits before 7
+ * rs.select(1);                              // 7: second set bit
+ * @endcode
+ */
+
+#include "simd_tables.hpp"
+#include "simd_utils.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(HPC_HAS_AVX2) || defined(__BMI2__)
+    #include <immintrin.h>
+#endif
+
+namespace hpc::simd {
+
+/// Bits per block: one AVX-512 register, the unit of padding and of rank samples
+inline constexpr size_t BITSET_BLOCK_BITS = 512;
+inline constexpr size_t BITSET_BLOCK_WORDS = BITSET_BLOCK_BITS / 64;
+
+/// Entries decode_bitmap() may write past the last index it returns
+inline constexpr size_t DECODE_SLACK = 16;
+
+// ============================================================================
+// Word kernels
+// ============================================================================
+
+enum class BitOp { And, Or, Xor, AndNot };
+
+namespace detail {
+
+#if defined(HPC_HAS_AVX2) && !defined(__AVX512VPOPCNTDQ__)
+
+/// Set bits per 64-bit lane: nibble-table vpshufb, then vpsadbw
+inline __m256i popcount_lanes(__m256i v) {
+    const __m256i table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(NIBBLE_POPCOUNT.data())));
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+    const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+
+/// Carry-save adder: a + b + c = 2 * high + low, per bit
+inline void csa(__m256i& high, __m256i& low, __m256i a, __m256i b, __m256i c) {
+    const __m256i u = _mm256_xor_si256(a, b);
+    high = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    low = _mm256_xor_si256(u, c);
+}
+
+#endif
+
+} // namespace detail
+
+/// dst[i] = dst[i] op src[i]; n is a multiple of BITSET_BLOCK_WORDS and both
+/// arrays are SIMD-aligned
+template<BitOp Op>
+void combine_words(uint64_t* dst, const uint64_t* src, size_t n) {
+#if defined(HPC_HAS_AVX512)
+    for (size_t i = 0; i < n; i += 8) {
+        const __m512i a = _mm512_load_si512(dst + i);
+        const __m512i b = _mm512_load_si512(src + i);
+        __m512i r;
+        if constexpr (Op == BitOp::And) r = _mm512_and_si512(a, b);
+        else if constexpr (Op == BitOp::Or) r = _mm512_or_si512(a, b);
+        else if constexpr (Op == BitOp::Xor) r = _mm512_xor_si512(a, b);
+        else r = _mm512_maskz_andnot_epi64(0xFF, b, a);
+        _mm512_store_si512(dst + i, r);
+    }
+#elif defined(HPC_HAS_AVX2)
+    for (size_t i = 0; i < n; i += 4) {
+        const __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i r;
+        if constexpr (Op == BitOp::And) r = _mm256_and_si256(a, b);
+        else if constexpr (Op == BitOp::Or) r = _mm256_or_si256(a, b);
+        else if constexpr (Op == BitOp::Xor) r = _mm256_xor_si256(a, b);
+        else r = _mm256_andnot_si256(b, a);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), r);
+    }
+#else
+    for (size_t i = 0; i < n; ++i) {
+        if constexpr (Op == BitOp::And) dst[i] &= src[i];
+        else if constexpr (Op == BitOp::Or) dst[i] |= src[i];
+        else if constexpr (Op == BitOp::Xor) dst[i] ^= src[i];
+        else dst[i] &= ~src[i];
+    }
+#endif
+}
+
+/// Set bits in words[0, n); n is a multiple of BITSET_BLOCK_WORDS and
+/// words is SIMD-aligned
+inline uint64_t popcount_words(const uint64_t* words, size_t n) {
+    uint64_t count = 0;
+#if defined(__AVX512VPOPCNTDQ__)
+    __m512i acc = _mm512_setzero_si512();
+    for (size_t i = 0; i < n; i += 8) {
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_load_si512(words + i)));
+    }
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, acc);
+    for (uint64_t lane : lanes) count += lane;
+#elif defined(HPC_HAS_AVX2)
+    // Harley-Seal: 16 registers fold into ones/twos/fours/eights counters,
+    // and only the sixteens carry is popcounted
+    const auto* d = reinterpret_cast<const __m256i*>(words);
+    const size_t regs = n / 4;
+    __m256i total = _mm256_setzero_si256();
+    __m256i ones = _mm256_setzero_si256(), twos = ones, fours = ones, eights = ones, sixteens;
+    __m256i twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+    size_t i = 0;
+    for (; i + 16 <= regs; i += 16) {
+        detail::csa(twos_a, ones, ones, _mm256_load_si256(d + i), _mm256_load_si256(d + i + 1));
+        detail::csa(twos_b, ones, ones, _mm256_load_si256(d + i + 2), _mm256_load_si256(d + i + 3));
+        detail::csa(fours_a, twos, twos, twos_a, twos_b);
+        detail::csa(twos_a, ones, ones, _mm256_load_si256(d + i + 4), _mm256_load_si256(d + i + 5));
+        detail::csa(twos_b, ones, ones, _mm256_load_si256(d + i + 6), _mm256_load_si256(d + i + 7));
+        detail::csa(fours_b, twos, twos, twos_a, twos_b);
+        detail::csa(eights_a, fours, fours, fours_a, fours_b);
+        detail::csa(twos_a, ones, ones, _mm256_load_si256(d + i + 8), _mm256_load_si256(d + i + 9));
+        detail::csa(twos_b, ones, ones, _mm256_load_si256(d + i + 10), _mm256_load_si256(d + i + 11));
+        detail::csa(fours_a, twos, twos, twos_a, twos_b);
+        detail::csa(twos_a, ones, ones, _mm256_load_si256(d + i + 12), _mm256_load_si256(d + i + 13));
+        detail::csa(twos_b, ones, ones, _mm256_load_si256(d + i + 14), _mm256_load_si256(d + i + 15));
+        detail::csa(fours_b, twos, twos, twos_a, twos_b);
+        detail::csa(eights_b, fours, fours, fours_a, fours_b);
+        detail::csa(sixteens, eights, eights, eights_a, eights_b);
+        total = _mm256_add_epi64(total, detail::popcount_lanes(sixteens));
+    }
+    total = _mm256_slli_epi64(total, 4);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(detail::popcount_lanes(eights), 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(detail::popcount_lanes(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(detail::popcount_lanes(twos), 1));
+    total = _mm256_add_epi64(total, detail::popcount_lanes(ones));
+    for (; i < regs; ++i) {
+        total = _mm256_add_epi64(total, detail::popcount_lanes(_mm256_load_si256(d + i)));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+    count = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#else
+    for (size_t i = 0; i < n; ++i) {
+        count += static_cast<uint64_t>(std::popcount(words[i]));
+    }
+#endif
+    return count;
+}
+
+/// Write the positions of the set bits of words[0, n) to out, ascending;
+/// returns their count. out must hold count + DECODE_SLACK entries: whole
+/// registers are stored at the cursor
+inline size_t decode_bitmap(const uint64_t* words, size_t n, uint32_t* out) {
+    assert(n <= (size_t{1} << 26) && "indices are uint32");
+    size_t k = 0;
+#if defined(HPC_HAS_AVX512)
+    const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    for (size_t j = 0; j < n; ++j) {
+        const uint64_t w = words[j];
+        if (w == 0) continue;
+        for (uint32_t part = 0; part < 4; ++part) {
+            const auto mask = static_cast<__mmask16>(w >> (16 * part));
+            const __m512i idx = _mm512_add_epi32(iota, _mm512_set1_epi32(static_cast<int>(j * 64 + 16 * part)));
+            _mm512_storeu_si512(out + k, _mm512_maskz_compress_epi32(mask, idx));
+            k += static_cast<size_t>(std::popcount(static_cast<uint32_t>(mask)));
+        }
+    }
+#elif defined(HPC_HAS_AVX2)
+    for (size_t j = 0; j < n; ++j) {
+        const uint64_t w = words[j];
+        if (w == 0) continue;
+        for (uint32_t part = 0; part < 8; ++part) {
+            const auto byte = static_cast<uint8_t>(w >> (8 * part));
+            const __m256i row = _mm256_load_si256(reinterpret_cast<const __m256i*>(COMPRESS_PERMUTE_8X32[byte].data()));
+            const __m256i idx = _mm256_add_epi32(row, _mm256_set1_epi32(static_cast<int>(j * 64 + 8 * part)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), idx);
+            k += static_cast<size_t>(std::popcount(byte));
+        }
+    }
+#else
+    for (size_t j = 0; j < n; ++j) {
+        for (uint64_t w = words[j]; w != 0; w &= w - 1) {
+            out[k++] = static_cast<uint32_t>(j * 64 + static_cast<size_t>(std::countr_zero(w)));
+        }
+    }
+#endif
+    return k;
+}
+
+// ============================================================================
+// Bitset
+// ============================================================================
+
+class Bitset {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    Bitset() = default;
+
+    /// @p bits zero bits
+    explicit Bitset(size_t bits)
+        : bits_(bits),
+          words_((bits + BITSET_BLOCK_BITS - 1) / BITSET_BLOCK_BITS * BITSET_BLOCK_WORDS, 0) {}
+
+    size_t size() const { return bits_; }
+
+    bool test(size_t i) const {
+        assert(i < bits_);
+        return (words_[i / 64] >> (i % 64)) & 1;
+    }
+
+    void set(size_t i) {
+        assert(i < bits_);
+        words_[i / 64] |= uint64_t{1} << (i % 64);
+    }
+
+    void reset(size_t i) {
+        assert(i < bits_);
+        words_[i / 64] &= ~(uint64_t{1} << (i % 64));
+    }
+
+    Bitset& operator&=(const Bitset& other) { return apply<BitOp::And>(other); }
+    Bitset& operator|=(const Bitset& other) { return apply<BitOp::Or>(other); }
+    Bitset& operator^=(const Bitset& other) { return apply<BitOp::Xor>(other); }
+
+    /// this &= ~other
+    Bitset& and_not(const Bitset& other) { return apply<BitOp::AndNot>(other); }
+
+    friend Bitset operator&(Bitset a, const Bitset& b) { return a &= b; }
+    friend Bitset operator|(Bitset a, const Bitset& b) { return a |= b; }
+    friend Bitset operator^(Bitset a, const Bitset& b) { return a ^= b; }
+
+    bool operator==(const Bitset& other) const = default;
+
+    /// Number of set bits
+    size_t count() const { return popcount_words(words_.data(), words_.size()); }
+
+    /// Position of the first set bit at or after @p from, or npos
+    size_t find_next(size_t from) const {
+        if (from >= bits_) return npos;
+        size_t j = from / 64;
+        uint64_t w = words_[j] & (~uint64_t{0} << (from % 64));
+        while (w == 0) {
+            if (++j == words_.size()) return npos;
+            if (j % BITSET_BLOCK_WORDS == 0) {
+                j = next_nonzero_block(j);
+                if (j == words_.size()) return npos;
+            }
+            w = words_[j];
+        }
+        return j * 64 + static_cast<size_t>(std::countr_zero(w));
+    }
+
+    size_t find_first() const { return find_next(0); }
+
+    /// f(i) for every set bit i, ascending
+    template<typename F>
+    void for_each_set(F&& f) const {
+        for (size_t block = next_nonzero_block(0); block < words_.size();
+             block = next_nonzero_block(block + BITSET_BLOCK_WORDS)) {
+            for (size_t j = block; j < block + BITSET_BLOCK_WORDS; ++j) {
+                for (uint64_t w = words_[j]; w != 0; w &= w - 1) {
+                    f(j * 64 + static_cast<size_t>(std::countr_zero(w)));
+                }
+            }
+        }
+    }
+
+    /// Positions of the set bits, ascending (decode_bitmap)
+    std::vector<uint32_t> to_indices() const {
+        std::vector<uint32_t> out(count() + DECODE_SLACK);
+        out.resize(decode_bitmap(words_.data(), words_.size(), out.data()));
+        return out;
+    }
+
+    /// Words, padding included; bits at and past size() are zero
+    const uint64_t* data() const { return words_.data(); }
+    uint64_t* data() { return words_.data(); }
+    size_t words() const { return words_.size(); }
+
+private:
+    template<BitOp Op>
+    Bitset& apply(const Bitset& other) {
+        assert(bits_ == other.bits_);
+        combine_words<Op>(words_.data(), other.words_.data(), words_.size());
+        return *this;
+    }
+
+    /// First block starting at or after word @p j with a set bit, or words()
+    size_t next_nonzero_block(size_t j) const {
+        for (; j < words_.size(); j += BITSET_BLOCK_WORDS) {
+#if defined(HPC_HAS_AVX512)
+            const __m512i v = _mm512_load_si512(words_.data() + j);
+            if (_mm512_test_epi64_mask(v, v) != 0) return j;
+#elif defined(HPC_HAS_AVX2)
+            const auto* p = reinterpret_cast<const __m256i*>(words_.data() + j);
+            const __m256i v = _mm256_or_si256(_mm256_load_si256(p), _mm256_load_si256(p + 1));
+            if (!_mm256_testz_si256(v, v)) return j;
+#else
+            uint64_t any = 0;
+            for (size_t i = 0; i < BITSET_BLOCK_WORDS; ++i) any |= words_[j + i];
+            if (any != 0) return j;
+#endif
+        }
+        return words_.size();
+    }
+
+    size_t bits_ = 0;
+    aligned_vector<uint64_t> words_;
+};
+
+// ============================================================================
+// Rank / select
+// ============================================================================
+
+/// Rank and select over a Bitset that is not modified while this is used
+class RankSelect {
+public:
+    static constexpr size_t npos = Bitset::npos;
+
+    /// Set bits between select samples
+    static constexpr uint64_t SELECT_SAMPLE = 4096;
+
+    /// One pass over @p bits: the set bits before each block, and the block
+    /// holding every SELECT_SAMPLE-th set bit
+    explicit RankSelect(const Bitset& bits) : bits_(&bits) {
+        const size_t blocks = bits.words() / BITSET_BLOCK_WORDS;
+        before_.resize(blocks + 1);
+        for (size_t b = 0; b < blocks; ++b) {
+            before_[b + 1] = before_[b] + popcount_words(bits.data() + b * BITSET_BLOCK_WORDS, BITSET_BLOCK_WORDS);
+            while (samples_.size() * SELECT_SAMPLE < before_[b + 1]) {
+                samples_.push_back(b);
+            }
+        }
+    }
+
+    size_t count() const { return static_cast<size_t>(before_.back()); }
+
+    /// Set bits in [0, i), for i <= size()
+    size_t rank(size_t i) const {
+        assert(i <= bits_->size());
+        const uint64_t* words = bits_->data();
+        const size_t block = i / BITSET_BLOCK_BITS;
+        uint64_t r = before_[block];
+        for (size_t j = block * BITSET_BLOCK_WORDS; j < i / 64; ++j) {
+            r += static_cast<uint64_t>(std::popcount(words[j]));
+        }
+        if (i % 64 != 0) {
+            r += static_cast<uint64_t>(std::popcount(words[i / 64] & ((uint64_t{1} << (i % 64)) - 1)));
+        }
+        return static_cast<size_t>(r);
+    }
+
+    /// Position of set bit number @p k (from 0), or npos if k >= count()
+    size_t select(size_t k) const {
+        if (k >= count()) return npos;
+        // Last block with fewer than k + 1 set bits before it, between the
+        // blocks of the samples on either side of k
+        const size_t s = k / SELECT_SAMPLE;
+        const size_t lo = samples_[s];
+        const size_t hi = s + 1 < samples_.size() ? samples_[s + 1] : before_.size() - 2;
+        const auto first = before_.begin() + static_cast<std::ptrdiff_t>(lo) + 1;
+        const auto last = before_.begin() + static_cast<std::ptrdiff_t>(hi) + 1;
+        const auto it = std::upper_bound(first, last, static_cast<uint64_t>(k));
+        const size_t block = static_cast<size_t>(it - before_.begin()) - 1;
+        uint64_t remaining = k - before_[block];
+        const uint64_t* words = bits_->data();
+        for (size_t j = block * BITSET_BLOCK_WORDS;; ++j) {
+            const auto c = static_cast<uint64_t>(std::popcount(words[j]));
+            if (remaining < c) {
+                return j * 64 + select_in_word(words[j], remaining);
+            }
+            remaining -= c;
+        }
+    }
+
+private:
+    /// Position of set bit number @p r of @p w; pdep deposits a 1 right there
+    static size_t select_in_word(uint64_t w, uint64_t r) {
+#if defined(__BMI2__)
+        return static_cast<size_t>(std::countr_zero(_pdep_u64(uint64_t{1} << r, w)));
+#else
+        for (; r > 0; --r) w &= w - 1;
+        return static_cast<size_t>(std::countr_zero(w));
+#endif
+    }
+
+    const Bitset* bits_;
+    /// before_[b]: set bits in blocks [0, b)
+    std::vector<uint64_t> before_;
+    /// samples_[s]: block holding set bit number s * SELECT_SAMPLE
+    std::vector<size_t> samples_;
+};
+
+} // namespace hpc::simd
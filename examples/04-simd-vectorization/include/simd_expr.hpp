@@ -0,0 +1,387 @@
+#pragma once
+
+/**
+ * @file simd_expr.hpp
+ * @brief Lazy expression templates over aligned arrays
+ *
+ * Chaining the *_wrapped functions costs one full pass over memory per
+ * operation: clamp(a*s + b) reads and writes the arrays three times and
+ * needs a temporary. With Array<T> the same expression only builds a
+ * small tree of nodes; assigning it runs a single SimdVec loop that loads
+ * a and b once and stores the result once:
+ *
+ * @code
+ * Array<float> a(n), b(n), out(n);
+ * auto e = clamp(a * s + b, lo, hi);   // Nothing computed yet
+ * out = e;                             // One fused pass
+ * out.assign_parallel(e);              // Same, split across threads
+ * @endcode
+ *
+ * Expressions hold arrays by pointer, so they must not outlive them.
+ * Every operation is element-wise, so `a = a * 2 + b` is safe.
+ */
+
+#include "simd_utils.hpp"
+#include "simd_wrapper.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpc::simd {
+
+// ============================================================================
+// Expression nodes
+// ============================================================================
+
+/// CRTP base of every expression node
+template<typename E>
+struct Expr {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+/// An expression node: size(), at(i) for scalar tails, load(i) for SIMD bodies
+template<typename E>
+concept ExprNode = std::derived_from<E, Expr<E>> && requires(const E& e, size_t i) {
+    typename E::value_type;
+    typename E::vec_type;
+    { e.size() } -> std::same_as<size_t>;
+    { e.at(i) } -> std::same_as<typename E::value_type>;
+    { e.load(i) } -> std::same_as<typename E::vec_type>;
+};
+
+/// Size of a broadcast scalar: matches any array length
+inline constexpr size_t ANY_SIZE = static_cast<size_t>(-1);
+
+/// Leaf: a view of contiguous elements
+template<typename T>
+class ArrayRef : public Expr<ArrayRef<T>> {
+public:
+    using value_type = T;
+    using vec_type = native_vec_t<T>;
+
+    ArrayRef(const T* data, size_t size) : data_(data), size_(size) {}
+
+    size_t size() const { return size_; }
+    T at(size_t i) const { return data_[i]; }
+    vec_type load(size_t i) const { return vec_type(data_ + i); }
+
+private:
+    const T* data_;
+    size_t size_;
+};
+
+/// Leaf: one value in every lane
+template<typename T>
+class Broadcast : public Expr<Broadcast<T>> {
+public:
+    using value_type = T;
+    using vec_type = native_vec_t<T>;
+
+    explicit Broadcast(T value) : value_(value), vec_(value) {}
+
+    size_t size() const { return ANY_SIZE; }
+    T at(size_t) const { return value_; }
+    vec_type load(size_t) const { return vec_; }
+
+private:
+    T value_;
+    vec_type vec_;
+};
+
+namespace expr_op {
+
+struct Add {
+    template<typename V>
+    static V apply(const V& a, const V& b) { return a + b; }
+};
+
+struct Sub {
+    template<typename V>
+    static V apply(const V& a, const V& b) { return a - b; }
+};
+
+struct Mul {
+    template<typename V>
+    static V apply(const V& a, const V& b) { return a * b; }
+};
+
+struct Div {
+    template<typename V>
+    static V apply(const V& a, const V& b) { return a / b; }
+};
+
+// Scalar forms follow minps/maxps: the second operand wins unless the
+// first compares strictly smaller (larger), so tails match SIMD lanes
+struct Min {
+    template<typename V>
+    static V apply(const V& a, const V& b) {
+        if constexpr (std::is_arithmetic_v<V>) {
+            return a < b ? a : b;
+        } else {
+            return a.min(b);
+        }
+    }
+};
+
+struct Max {
+    template<typename V>
+    static V apply(const V& a, const V& b) {
+        if constexpr (std::is_arithmetic_v<V>) {
+            return a > b ? a : b;
+        } else {
+            return a.max(b);
+        }
+    }
+};
+
+struct Sqrt {
+    template<typename V>
+    static V apply(const V& a) {
+        if constexpr (std::is_arithmetic_v<V>) {
+            return std::sqrt(a);
+        } else {
+            return a.sqrt();
+        }
+    }
+};
+
+} // namespace expr_op
+
+template<typename Op, ExprNode L, ExprNode R>
+class BinaryExpr : public Expr<BinaryExpr<Op, L, R>> {
+    static_assert(std::is_same_v<typename L::value_type, typename R::value_type>);
+
+public:
+    using value_type = typename L::value_type;
+    using vec_type = typename L::vec_type;
+
+    BinaryExpr(L lhs, R rhs) : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+        assert(lhs_.size() == rhs_.size() || lhs_.size() == ANY_SIZE || rhs_.size() == ANY_SIZE);
+    }
+
+    size_t size() const { return std::min(lhs_.size(), rhs_.size()); }
+    value_type at(size_t i) const { return Op::apply(lhs_.at(i), rhs_.at(i)); }
+    vec_type load(size_t i) const { return Op::apply(lhs_.load(i), rhs_.load(i)); }
+
+private:
+    L lhs_;
+    R rhs_;
+};
+
+template<typename Op, ExprNode E>
+class UnaryExpr : public Expr<UnaryExpr<Op, E>> {
+public:
+    using value_type = typename E::value_type;
+    using vec_type = typename E::vec_type;
+
+    explicit UnaryExpr(E operand) : operand_(std::move(operand)) {}
+
+    size_t size() const { return operand_.size(); }
+    value_type at(size_t i) const { return Op::apply(operand_.at(i)); }
+    vec_type load(size_t i) const { return Op::apply(operand_.load(i)); }
+
+private:
+    E operand_;
+};
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+/// Evaluate elements [begin, end) of @p e into @p out: SIMD body, scalar tail
+template<ExprNode E>
+void evaluate(const E& e, typename E::value_type* out, size_t begin, size_t end) {
+    constexpr size_t W = E::vec_type::width;
+    size_t i = begin;
+    for (; i + W <= end; i += W) {
+        e.load(i).store(out + i);
+    }
+    for (; i < end; ++i) {
+        out[i] = e.at(i);
+    }
+}
+
+/// Below this many elements per thread, parallel evaluation runs serially
+inline constexpr size_t PARALLEL_MIN_ELEMENTS = 1 << 16;
+
+/**
+ * Evaluate @p e into @p out on up to @p threads threads (0 = all hardware
+ * threads). Chunk boundaries fall on 64-byte multiples so no two threads
+ * write the same cache line of an aligned output.
+ */
+template<ExprNode E>
+void evaluate_parallel(const E& e, typename E::value_type* out, size_t n, size_t threads = 0) {
+    using T = typename E::value_type;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, std::max<size_t>(1, n / PARALLEL_MIN_ELEMENTS));
+    if (threads <= 1) {
+        evaluate(e, out, 0, n);
+        return;
+    }
+    const size_t chunk = align_up((n + threads - 1) / threads, 64 / sizeof(T));
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t begin = chunk; begin < n; begin += chunk) {
+        workers.emplace_back([&e, out, begin, end = std::min(n, begin + chunk)] {
+            evaluate(e, out, begin, end);
+        });
+    }
+    evaluate(e, out, 0, std::min(n, chunk));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// ============================================================================
+// Array
+// ============================================================================
+
+/// Aligned array whose assignment from an expression is one fused loop
+template<typename T>
+class Array {
+public:
+    using value_type = T;
+
+    Array() = default;
+    explicit Array(size_t n) : data_(n) {}
+    Array(size_t n, T value) : data_(n, value) {}
+
+    template<ExprNode E>
+    Array(const E& e) : data_(e.size()) {
+        evaluate(e, data(), 0, size());
+    }
+
+    template<ExprNode E>
+    Array& operator=(const E& e) {
+        resize_for(e);
+        evaluate(e, data(), 0, size());
+        return *this;
+    }
+
+    /// Like operator=, with the loop split across threads
+    template<ExprNode E>
+    Array& assign_parallel(const E& e, size_t threads = 0) {
+        resize_for(e);
+        evaluate_parallel(e, data(), size(), threads);
+        return *this;
+    }
+
+    ArrayRef<T> ref() const { return ArrayRef<T>(data(), size()); }
+
+    T* data() { return data_.data(); }
+    const T* data() const { return data_.data(); }
+    size_t size() const { return data_.size(); }
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+    T* begin() { return data(); }
+    T* end() { return data() + size(); }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + size(); }
+
+private:
+    template<ExprNode E>
+    void resize_for(const E& e) {
+        assert(e.size() != ANY_SIZE && "a scalar-only expression has no size");
+        if (e.size() != size()) {
+            data_ = aligned_vector<T>(e.size());
+        }
+    }
+
+    aligned_vector<T> data_;
+};
+
+// ============================================================================
+// Operators
+// ============================================================================
+
+namespace detail {
+
+template<typename X>
+struct is_array : std::false_type {};
+
+template<typename T>
+struct is_array<Array<T>> : std::true_type {};
+
+/// Arrays and expression nodes; scalars only combine with these
+template<typename X>
+concept Operand = ExprNode<X> || is_array<X>::value;
+
+template<typename X>
+concept ScalarOperand = std::is_arithmetic_v<X>;
+
+template<typename A, typename B>
+concept OperandPair = (Operand<A> && (Operand<B> || ScalarOperand<B>)) ||
+                      (ScalarOperand<A> && Operand<B>);
+
+template<typename A, typename B>
+using pair_value_t = typename std::conditional_t<Operand<A>, A, B>::value_type;
+
+/// Arrays become views, scalars broadcasts; nodes are copied (they are small)
+template<typename T, typename X>
+auto to_expr(const X& x) {
+    if constexpr (is_array<X>::value) {
+        return x.ref();
+    } else if constexpr (ScalarOperand<X>) {
+        return Broadcast<T>(static_cast<T>(x));
+    } else {
+        return x;
+    }
+}
+
+template<typename Op, typename A, typename B>
+auto make_binary(const A& a, const B& b) {
+    using T = pair_value_t<A, B>;
+    using L = decltype(to_expr<T>(a));
+    using R = decltype(to_expr<T>(b));
+    return BinaryExpr<Op, L, R>(to_expr<T>(a), to_expr<T>(b));
+}
+
+} // namespace detail
+
+template<typename A, typename B>
+    requires detail::OperandPair<A, B>
+auto operator+(const A& a, const B& b) { return detail::make_binary<expr_op::Add>(a, b); }
+
+template<typename A, typename B>
+    requires detail::OperandPair<A, B>
+auto operator-(const A& a, const B& b) { return detail::make_binary<expr_op::Sub>(a, b); }
+
+template<typename A, typename B>
+    requires detail::OperandPair<A, B>
+auto operator*(const A& a, const B& b) { return detail::make_binary<expr_op::Mul>(a, b); }
+
+template<typename A, typename B>
+    requires detail::OperandPair<A, B>
+auto operator/(const A& a, const B& b) { return detail::make_binary<expr_op::Div>(a, b); }
+
+template<typename A, typename B>
+    requires detail::OperandPair<A, B>
+auto min(const A& a, const B& b) { return detail::make_binary<expr_op::Min>(a, b); }
+
+template<typename A, typename B>
+    requires detail::OperandPair<A, B>
+auto max(const A& a, const B& b) { return detail::make_binary<expr_op::Max>(a, b); }
+
+/// min(max(x, lo), hi), the same lane semantics as clamp_array_wrapped
+template<detail::Operand X, typename Lo, typename Hi>
+    requires detail::OperandPair<X, Lo> && detail::OperandPair<X, Hi>
+auto clamp(const X& x, const Lo& lo, const Hi& hi) {
+    return min(max(x, lo), hi);
+}
+
+template<detail::Operand X>
+auto sqrt(const X& x) {
+    using E = decltype(detail::to_expr<typename X::value_type>(x));
+    return UnaryExpr<expr_op::Sqrt, E>(detail::to_expr<typename X::value_type>(x));
+}
+
+} // namespace hpc::simd
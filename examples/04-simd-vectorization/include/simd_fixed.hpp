@@ -0,0 +1,186 @@
+#pragma once
+
+/**
+ * @file simd_fixed.hpp
+ * @brief Fixed-size vector and matrix kernels unrolled at compile time
+ *
+ * The *_wrapped kernels take a runtime n: for a 4-element vector the loop
+ * test, the scalar tail and the stride arithmetic cost more than the four
+ * multiplies. Here the size is a template parameter:
+ *
+ *   - each vector maps onto the narrowest SimdVec that holds it (float4 ->
+ *     SSE, float8 -> AVX2, float16 -> AVX-512), or onto several native
+ *     registers; a partial last register is loaded with a masked
+ *     load_first() instead of a scalar tail (float3 -> one SSE register)
+ *   - every register and every matrix column is a separate statement,
+ *     unrolled through index sequences, so nothing loops at run time
+ *
+ * Matrices are column-major (as in GLM and Eigen), so M * x is a sum of
+ * columns scaled by broadcast elements of x: fmadds, with no horizontal adds.
+ *
+ * @code
+ * std::array<float, 4> a = ..., b = ...;
+ * float d = dot(a, b);                  // One register multiply + reduction
+ * axpy(2.0f, a, b);                     // b = 2a + b
+ * Mat4f m = ...;
+ * auto y = matvec(m, a);                // Four broadcast fmadds
+ * Mat4f p = matmul(m, m);               // Four matvecs
+ * @endcode
+ */
+
+#include "simd_wrapper.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace hpc::simd {
+
+// ============================================================================
+// Register selection
+// ============================================================================
+
+namespace detail {
+
+/// SimdVec<T, W> is specialized for this build's instruction set
+template<typename T, size_t W>
+concept has_simd_vec = W >= 1 && requires { sizeof(SimdVec<T, W>); };
+
+template<typename T, size_t N, size_t W>
+constexpr auto pick_register() {
+    if constexpr (W / 2 >= N && has_simd_vec<T, W / 2>) {
+        return pick_register<T, N, W / 2>();
+    } else if constexpr (W == native_vec_t<T>::width) {
+        return std::type_identity<native_vec_t<T>>{};
+    } else {
+        return std::type_identity<SimdVec<T, W>>{};
+    }
+}
+
+/// Call f(integral_constant<I>) for I in [0, N), each call a separate statement
+template<size_t N, typename F>
+void unroll(F&& f) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<size_t, I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+} // namespace detail
+
+/// Narrowest vector type holding N elements of T, or the native one if none does
+template<typename T, size_t N>
+using fixed_vec_t = typename decltype(detail::pick_register<T, N, native_vec_t<T>::width>())::type;
+
+namespace detail {
+
+/// Registers covering N elements: f(offset, count) for each, count < width
+/// only for the last
+template<typename T, size_t N, typename F>
+void for_each_register(F&& f) {
+    constexpr size_t W = fixed_vec_t<T, N>::width;
+    unroll<(N + W - 1) / W>([&](auto r) {
+        constexpr size_t OFFSET = r * W;
+        constexpr size_t COUNT = N - OFFSET < W ? N - OFFSET : W;
+        f(std::integral_constant<size_t, OFFSET>{}, std::integral_constant<size_t, COUNT>{});
+    });
+}
+
+template<typename V, size_t Count>
+V load(const typename V::value_type* ptr) {
+    if constexpr (Count == V::width) {
+        return V(ptr);
+    } else {
+        return V::load_first(ptr, Count);
+    }
+}
+
+/// A partial register is spilled and copied: Count is known, so the copy
+/// becomes plain narrow stores. A masked store would cover the whole
+/// register and stall the next load from the neighbouring bytes
+template<typename V, size_t Count>
+void store(const V& v, typename V::value_type* ptr) {
+    if constexpr (Count == V::width) {
+        v.store(ptr);
+    } else {
+        alignas(64) typename V::value_type lanes[V::width];
+        v.store(lanes);
+        std::memcpy(ptr, lanes, Count * sizeof(typename V::value_type));
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// Vector kernels
+// ============================================================================
+
+/// Sum of a[i] * b[i]
+template<typename T, size_t N>
+T dot(const std::array<T, N>& a, const std::array<T, N>& b) {
+    using V = fixed_vec_t<T, N>;
+    V acc(T{0});
+    detail::for_each_register<T, N>([&](auto offset, auto count) {
+        acc = V::fmadd(detail::load<V, count>(a.data() + offset), detail::load<V, count>(b.data() + offset), acc);
+    });
+    return acc.horizontal_sum();
+}
+
+/// y = alpha * x + y
+template<typename T, size_t N>
+void axpy(T alpha, const std::array<T, N>& x, std::array<T, N>& y) {
+    using V = fixed_vec_t<T, N>;
+    const V va(alpha);
+    detail::for_each_register<T, N>([&](auto offset, auto count) {
+        const V r = V::fmadd(va, detail::load<V, count>(x.data() + offset), detail::load<V, count>(y.data() + offset));
+        detail::store<V, count>(r, y.data() + offset);
+    });
+}
+
+/// Euclidean length
+template<typename T, size_t N>
+T norm(const std::array<T, N>& x) {
+    return std::sqrt(dot(x, x));
+}
+
+// ============================================================================
+// Matrix kernels
+// ============================================================================
+
+/// R x C matrix, column-major: cols[c][r] is row r of column c
+template<typename T, size_t R, size_t C>
+struct FixedMat {
+    std::array<std::array<T, R>, C> cols{};
+
+    T& operator()(size_t r, size_t c) { return cols[c][r]; }
+    T operator()(size_t r, size_t c) const { return cols[c][r]; }
+};
+
+using Mat4f = FixedMat<float, 4, 4>;
+using Mat4d = FixedMat<double, 4, 4>;
+
+/// m * x: the columns of m scaled by the elements of x, summed
+template<typename T, size_t R, size_t C>
+std::array<T, R> matvec(const FixedMat<T, R, C>& m, const std::array<T, C>& x) {
+    using V = fixed_vec_t<T, R>;
+    std::array<T, R> y;
+    detail::for_each_register<T, R>([&](auto offset, auto count) {
+        V acc(T{0});
+        detail::unroll<C>([&](auto c) {
+            acc = V::fmadd(V(x[c]), detail::load<V, count>(m.cols[c].data() + offset), acc);
+        });
+        detail::store<V, count>(acc, y.data() + offset);
+    });
+    return y;
+}
+
+/// a * b: column c of the product is a * (column c of b)
+template<typename T, size_t R, size_t K, size_t C>
+FixedMat<T, R, C> matmul(const FixedMat<T, R, K>& a, const FixedMat<T, K, C>& b) {
+    FixedMat<T, R, C> p;
+    detail::unroll<C>([&](auto c) { p.cols[c] = matvec(a, b.cols[c]); });
+    return p;
+}
+
+} // namespace hpc::simd
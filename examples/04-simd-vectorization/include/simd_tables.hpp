@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file simd_tables.hpp
+ * @brief Shuffle and mask lookup tables generated at compile time
+ *
+ * Where an ISA has no instruction for an operation, kernels index a table
+ * with a movemask or a nibble instead. Pasted in by hand, such tables are
+ * hundreds of numbers nobody re-checks. Here each one is a constexpr
+ * function of its definition, like generate_primes() in compile_time.cpp:
+ *
+ *   make_compress_permute_table<L>()  row m lists the lanes set in m,
+ *                                     ascending: vpermd indices that pack
+ *                                     those lanes to the front (AVX2 stream
+ *                                     compaction), or the positions of the
+ *                                     set bits of a byte
+ *   make_nibble_table(f)              f(0) .. f(15): a vpshufb lookup that
+ *                                     maps every nibble of a vector at once
+ *   make_lane_mask_table<T, L>()      row m has lane i all ones iff bit i of
+ *                                     m is set: masks for vmaskmov/blendv
+ *
+ * Tables are 64-byte aligned, so a row of up to 64 bytes never straddles
+ * two cache lines.
+ */
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpc::simd {
+
+template<typename T, size_t Lanes>
+using LaneTable = std::array<std::array<T, Lanes>, (size_t{1} << Lanes)>;
+
+/// Row m: the indices of the bits set in m, ascending; remaining lanes 0
+template<size_t Lanes, typename Index = uint32_t>
+constexpr LaneTable<Index, Lanes> make_compress_permute_table() {
+    static_assert(Lanes >= 1 && Lanes <= 16);
+    LaneTable<Index, Lanes> table{};
+    for (size_t mask = 0; mask < table.size(); ++mask) {
+        size_t out = 0;
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+            if ((mask >> lane) & 1) {
+                table[mask][out++] = static_cast<Index>(lane);
+            }
+        }
+    }
+    return table;
+}
+
+/// Entry n: f(n) for every nibble n; broadcast to each 128-bit lane for vpshufb
+template<typename F>
+constexpr std::array<uint8_t, 16> make_nibble_table(F f) {
+    std::array<uint8_t, 16> table{};
+    for (uint8_t n = 0; n < 16; ++n) {
+        table[n] = static_cast<uint8_t>(f(n));
+    }
+    return table;
+}
+
+/// Row m: lane i is all ones if bit i of m is set, zero otherwise
+template<typename T, size_t Lanes>
+constexpr LaneTable<T, Lanes> make_lane_mask_table() {
+    static_assert(Lanes >= 1 && Lanes <= 16);
+    LaneTable<T, Lanes> table{};
+    for (size_t mask = 0; mask < table.size(); ++mask) {
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+            table[mask][lane] = ((mask >> lane) & 1) ? static_cast<T>(~T{0}) : T{0};
+        }
+    }
+    return table;
+}
+
+/// vpermd indices for packing the lanes of an 8-bit mask (8 KiB)
+alignas(64) inline constexpr auto COMPRESS_PERMUTE_8X32 = make_compress_permute_table<8, uint32_t>();
+
+/// Set bits per nibble: two vpshufb lookups count the bits of every byte
+alignas(64) inline constexpr auto NIBBLE_POPCOUNT = make_nibble_table([](uint8_t n) { return std::popcount(n); });
+
+/// vmaskmovps / vmaskmovpd masks for 256-bit and 128-bit registers
+alignas(64) inline constexpr auto LANE_MASK_8X32 = make_lane_mask_table<int32_t, 8>();
+alignas(64) inline constexpr auto LANE_MASK_4X64 = make_lane_mask_table<int64_t, 4>();
+alignas(64) inline constexpr auto LANE_MASK_4X32 = make_lane_mask_table<int32_t, 4>();
+alignas(64) inline constexpr auto LANE_MASK_2X64 = make_lane_mask_table<int64_t, 2>();
+
+static_assert(COMPRESS_PERMUTE_8X32[0b1010'0110] == std::array<uint32_t, 8>{1, 2, 5, 7, 0, 0, 0, 0});
+static_assert(NIBBLE_POPCOUNT[0xB] == 3 && NIBBLE_POPCOUNT[0xF] == 4);
+static_assert(LANE_MASK_8X32[0b0000'0101] == std::array<int32_t, 8>{-1, 0, -1, 0, 0, 0, 0, 0});
+
+} // namespace hpc::simd
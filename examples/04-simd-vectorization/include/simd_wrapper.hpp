@@ -12,13 +12,20 @@
  */
 
 #include "simd_utils.hpp"
-#include <cmath>
+#include "simd_tables.hpp"
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
 
 #ifdef HPC_HAS_SSE2
     #include <emmintrin.h>
 #endif
 
+#ifdef __SSE4_1__
+    #include <smmintrin.h>
+#endif
+
 #ifdef HPC_HAS_AVX
     #include <immintrin.h>
 #endif
@@ -58,6 +65,18 @@ public:
         for (size_t i = 0; i < Width; ++i) ptr[i] = data[i];
     }
     
+    /// Lanes [0, count) from ptr, the rest 0; reads nothing past ptr + count
+    static SimdVecScalar load_first(const T* ptr, size_t count) {
+        SimdVecScalar result(T{0});
+        for (size_t i = 0; i < count; ++i) result.data[i] = ptr[i];
+        return result;
+    }
+    
+    /// Store lanes [0, count); writes nothing past ptr + count
+    void store_first(T* ptr, size_t count) const {
+        for (size_t i = 0; i < count; ++i) ptr[i] = data[i];
+    }
+    
     T operator[](size_t i) const { return data[i]; }
     T& operator[](size_t i) { return data[i]; }
     
@@ -129,6 +148,19 @@ public:
         for (size_t i = 0; i < Width; ++i) result.data[i] = std::max(data[i], other.data[i]);
         return result;
     }
+    
+    SimdVecScalar floor() const {
+        SimdVecScalar result;
+        for (size_t i = 0; i < Width; ++i) result.data[i] = std::floor(data[i]);
+        return result;
+    }
+    
+    /// Lane i loads base[index[i]]; index lanes hold whole numbers >= 0
+    static SimdVecScalar gather(const T* base, const SimdVecScalar& index) {
+        SimdVecScalar result;
+        for (size_t i = 0; i < Width; ++i) result.data[i] = base[static_cast<size_t>(index.data[i])];
+        return result;
+    }
 };
 
 // ============================================================================
@@ -165,6 +197,32 @@ public:
         _mm_store_ps(ptr, data);
     }
     
+    /// Lanes [0, count) from ptr, the rest 0; reads nothing past ptr + count.
+    /// SSE has no masked move (AVX adds a 128-bit vmaskmov): without AVX the
+    /// lanes go through a stack buffer
+    static SimdVec load_first(const float* ptr, size_t count) {
+#ifdef HPC_HAS_AVX
+        const auto& mask = LANE_MASK_4X32[(1u << count) - 1];
+        return SimdVec(_mm_maskload_ps(ptr, _mm_load_si128(reinterpret_cast<const __m128i*>(mask.data()))));
+#else
+        alignas(16) float tmp[4] = {};
+        for (size_t i = 0; i < count; ++i) tmp[i] = ptr[i];
+        return load_aligned(tmp);
+#endif
+    }
+    
+    /// Store lanes [0, count); writes nothing past ptr + count
+    void store_first(float* ptr, size_t count) const {
+#ifdef HPC_HAS_AVX
+        const auto& mask = LANE_MASK_4X32[(1u << count) - 1];
+        _mm_maskstore_ps(ptr, _mm_load_si128(reinterpret_cast<const __m128i*>(mask.data())), data);
+#else
+        alignas(16) float tmp[4];
+        _mm_store_ps(tmp, data);
+        for (size_t i = 0; i < count; ++i) ptr[i] = tmp[i];
+#endif
+    }
+    
     float operator[](size_t i) const {
         alignas(16) float tmp[4];
         _mm_store_ps(tmp, data);
@@ -229,6 +287,30 @@ public:
     SimdVec max(const SimdVec& other) const {
         return SimdVec(_mm_max_ps(data, other.data));
     }
+    
+    SimdVec floor() const {
+#ifdef __SSE4_1__
+        return SimdVec(_mm_floor_ps(data));
+#else
+        alignas(16) float tmp[4];
+        _mm_store_ps(tmp, data);
+        return SimdVec(_mm_setr_ps(std::floor(tmp[0]), std::floor(tmp[1]), std::floor(tmp[2]), std::floor(tmp[3])));
+#endif
+    }
+    
+    /// Lane i loads base[index[i]]; index lanes hold whole numbers >= 0.
+    /// (Masked forms with an explicit source throughout: GCC 12 warns about
+    /// the undefined source inside the unmasked intrinsics.)
+    static SimdVec gather(const float* base, const SimdVec& index) {
+#ifdef HPC_HAS_AVX2
+        return SimdVec(_mm_mask_i32gather_ps(_mm_setzero_ps(), base, _mm_cvttps_epi32(index.data),
+                                             _mm_castsi128_ps(_mm_set1_epi32(-1)), 4));
+#else
+        alignas(16) int32_t idx[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx), _mm_cvttps_epi32(index.data));
+        return SimdVec(_mm_setr_ps(base[idx[0]], base[idx[1]], base[idx[2]], base[idx[3]]));
+#endif
+    }
 };
 
 #endif // HPC_HAS_SSE2
@@ -267,6 +349,19 @@ public:
         _mm256_store_ps(ptr, data);
     }
     
+    /// Lanes [0, count) from ptr, the rest 0; masked-off lanes of vmaskmov
+    /// never fault, so nothing past ptr + count is read
+    static SimdVec load_first(const float* ptr, size_t count) {
+        const auto& mask = LANE_MASK_8X32[(1u << count) - 1];
+        return SimdVec(_mm256_maskload_ps(ptr, _mm256_load_si256(reinterpret_cast<const __m256i*>(mask.data()))));
+    }
+    
+    /// Store lanes [0, count); writes nothing past ptr + count
+    void store_first(float* ptr, size_t count) const {
+        const auto& mask = LANE_MASK_8X32[(1u << count) - 1];
+        _mm256_maskstore_ps(ptr, _mm256_load_si256(reinterpret_cast<const __m256i*>(mask.data())), data);
+    }
+    
     float operator[](size_t i) const {
         alignas(32) float tmp[8];
         _mm256_store_ps(tmp, data);
@@ -330,6 +425,16 @@ public:
     SimdVec max(const SimdVec& other) const {
         return SimdVec(_mm256_max_ps(data, other.data));
     }
+    
+    SimdVec floor() const {
+        return SimdVec(_mm256_floor_ps(data));
+    }
+    
+    /// Lane i loads base[index[i]]; index lanes hold whole numbers >= 0
+    static SimdVec gather(const float* base, const SimdVec& index) {
+        return SimdVec(_mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, _mm256_cvttps_epi32(index.data),
+                                                _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4));
+    }
 };
 
 #endif // HPC_HAS_AVX2
@@ -368,6 +473,16 @@ public:
         _mm512_store_ps(ptr, data);
     }
     
+    /// Lanes [0, count) from ptr, the rest 0; reads nothing past ptr + count
+    static SimdVec load_first(const float* ptr, size_t count) {
+        return SimdVec(_mm512_maskz_loadu_ps(static_cast<__mmask16>((1u << count) - 1), ptr));
+    }
+    
+    /// Store lanes [0, count); writes nothing past ptr + count
+    void store_first(float* ptr, size_t count) const {
+        _mm512_mask_storeu_ps(ptr, static_cast<__mmask16>((1u << count) - 1), data);
+    }
+    
     float operator[](size_t i) const {
         alignas(64) float tmp[16];
         _mm512_store_ps(tmp, data);
@@ -405,8 +520,14 @@ public:
         return *this;
     }
     
+    /// Halves added, then the AVX2 reduction. Masked extracts: GCC 12's
+    /// _mm512_reduce_add_ps and 512-to-256 casts use an undefined source
+    /// and trip -Wmaybe-uninitialized
     float horizontal_sum() const {
-        return _mm512_reduce_add_ps(data);
+        const __m512d d = _mm512_castps_pd(data);
+        const __m256d lo = _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xFF, d, 0);
+        const __m256d hi = _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xFF, d, 1);
+        return SimdVec<float, 8>(_mm256_add_ps(_mm256_castpd_ps(lo), _mm256_castpd_ps(hi))).horizontal_sum();
     }
     
     static SimdVec fmadd(const SimdVec& a, const SimdVec& b, const SimdVec& c) {
@@ -417,12 +538,409 @@ public:
         return SimdVec(_mm512_sqrt_ps(data));
     }
     
+    /// Masked min/max: the unmasked forms pass an undefined source that
+    /// GCC 12 reports as -Wmaybe-uninitialized
+    SimdVec min(const SimdVec& other) const {
+        return SimdVec(_mm512_mask_min_ps(data, 0xFFFF, data, other.data));
+    }
+    
+    SimdVec max(const SimdVec& other) const {
+        return SimdVec(_mm512_mask_max_ps(data, 0xFFFF, data, other.data));
+    }
+    
+    SimdVec floor() const {
+        return SimdVec(_mm512_mask_roundscale_ps(data, 0xFFFF, data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    }
+    
+    /// Lane i loads base[index[i]]; index lanes hold whole numbers >= 0
+    static SimdVec gather(const float* base, const SimdVec& index) {
+        const __m512i idx = _mm512_maskz_cvttps_epi32(0xFFFF, index.data);
+        return SimdVec(_mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, idx, base, 4));
+    }
+};
+
+#endif // HPC_HAS_AVX512
+
+// ============================================================================
+// SSE2 Implementation (128-bit, 2 doubles)
+// ============================================================================
+
+#ifdef HPC_HAS_SSE2
+
+template<>
+class SimdVec<double, 2> {
+public:
+    static constexpr size_t width = 2;
+    using value_type = double;
+    
+    __m128d data;
+    
+    SimdVec() : data(_mm_setzero_pd()) {}
+    
+    explicit SimdVec(__m128d v) : data(v) {}
+    
+    explicit SimdVec(double val) : data(_mm_set1_pd(val)) {}
+    
+    SimdVec(const double* ptr) : data(_mm_loadu_pd(ptr)) {}
+    
+    static SimdVec load_aligned(const double* ptr) {
+        return SimdVec(_mm_load_pd(ptr));
+    }
+    
+    void store(double* ptr) const {
+        _mm_storeu_pd(ptr, data);
+    }
+    
+    void store_aligned(double* ptr) const {
+        _mm_store_pd(ptr, data);
+    }
+    
+    /// Lanes [0, count) from ptr, the rest 0; reads nothing past ptr + count.
+    /// SSE has no masked move (AVX adds a 128-bit vmaskmov): without AVX the
+    /// lanes go through a stack buffer
+    static SimdVec load_first(const double* ptr, size_t count) {
+#ifdef HPC_HAS_AVX
+        const auto& mask = LANE_MASK_2X64[(1u << count) - 1];
+        return SimdVec(_mm_maskload_pd(ptr, _mm_load_si128(reinterpret_cast<const __m128i*>(mask.data()))));
+#else
+        alignas(16) double tmp[2] = {};
+        for (size_t i = 0; i < count; ++i) tmp[i] = ptr[i];
+        return load_aligned(tmp);
+#endif
+    }
+    
+    /// Store lanes [0, count); writes nothing past ptr + count
+    void store_first(double* ptr, size_t count) const {
+#ifdef HPC_HAS_AVX
+        const auto& mask = LANE_MASK_2X64[(1u << count) - 1];
+        _mm_maskstore_pd(ptr, _mm_load_si128(reinterpret_cast<const __m128i*>(mask.data())), data);
+#else
+        alignas(16) double tmp[2];
+        _mm_store_pd(tmp, data);
+        for (size_t i = 0; i < count; ++i) ptr[i] = tmp[i];
+#endif
+    }
+    
+    double operator[](size_t i) const {
+        alignas(16) double tmp[2];
+        _mm_store_pd(tmp, data);
+        return tmp[i];
+    }
+    
+    SimdVec operator+(const SimdVec& other) const {
+        return SimdVec(_mm_add_pd(data, other.data));
+    }
+    
+    SimdVec operator-(const SimdVec& other) const {
+        return SimdVec(_mm_sub_pd(data, other.data));
+    }
+    
+    SimdVec operator*(const SimdVec& other) const {
+        return SimdVec(_mm_mul_pd(data, other.data));
+    }
+    
+    SimdVec operator/(const SimdVec& other) const {
+        return SimdVec(_mm_div_pd(data, other.data));
+    }
+    
+    SimdVec& operator+=(const SimdVec& other) {
+        data = _mm_add_pd(data, other.data);
+        return *this;
+    }
+    
+    SimdVec& operator-=(const SimdVec& other) {
+        data = _mm_sub_pd(data, other.data);
+        return *this;
+    }
+    
+    SimdVec& operator*=(const SimdVec& other) {
+        data = _mm_mul_pd(data, other.data);
+        return *this;
+    }
+    
+    double horizontal_sum() const {
+        __m128d hi = _mm_unpackhi_pd(data, data);
+        return _mm_cvtsd_f64(_mm_add_sd(data, hi));
+    }
+    
+    static SimdVec fmadd(const SimdVec& a, const SimdVec& b, const SimdVec& c) {
+#ifdef HPC_HAS_AVX2
+        return SimdVec(_mm_fmadd_pd(a.data, b.data, c.data));
+#else
+        return SimdVec(_mm_add_pd(_mm_mul_pd(a.data, b.data), c.data));
+#endif
+    }
+    
+    SimdVec sqrt() const {
+        return SimdVec(_mm_sqrt_pd(data));
+    }
+    
+    SimdVec min(const SimdVec& other) const {
+        return SimdVec(_mm_min_pd(data, other.data));
+    }
+    
+    SimdVec max(const SimdVec& other) const {
+        return SimdVec(_mm_max_pd(data, other.data));
+    }
+    
+    SimdVec floor() const {
+#ifdef __SSE4_1__
+        return SimdVec(_mm_floor_pd(data));
+#else
+        alignas(16) double tmp[2];
+        _mm_store_pd(tmp, data);
+        return SimdVec(_mm_setr_pd(std::floor(tmp[0]), std::floor(tmp[1])));
+#endif
+    }
+    
+    /// Lane i loads base[index[i]]; index lanes hold whole numbers >= 0
+    static SimdVec gather(const double* base, const SimdVec& index) {
+#ifdef HPC_HAS_AVX2
+        return SimdVec(_mm_mask_i32gather_pd(_mm_setzero_pd(), base, _mm_cvttpd_epi32(index.data),
+                                             _mm_castsi128_pd(_mm_set1_epi64x(-1)), 8));
+#else
+        alignas(16) int32_t idx[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx), _mm_cvttpd_epi32(index.data));
+        return SimdVec(_mm_setr_pd(base[idx[0]], base[idx[1]]));
+#endif
+    }
+};
+
+#endif // HPC_HAS_SSE2
+
+// ============================================================================
+// AVX2 Implementation (256-bit, 4 doubles)
+// ============================================================================
+
+#ifdef HPC_HAS_AVX2
+
+template<>
+class SimdVec<double, 4> {
+public:
+    static constexpr size_t width = 4;
+    using value_type = double;
+    
+    __m256d data;
+    
+    SimdVec() : data(_mm256_setzero_pd()) {}
+    
+    explicit SimdVec(__m256d v) : data(v) {}
+    
+    explicit SimdVec(double val) : data(_mm256_set1_pd(val)) {}
+    
+    SimdVec(const double* ptr) : data(_mm256_loadu_pd(ptr)) {}
+    
+    static SimdVec load_aligned(const double* ptr) {
+        return SimdVec(_mm256_load_pd(ptr));
+    }
+    
+    void store(double* ptr) const {
+        _mm256_storeu_pd(ptr, data);
+    }
+    
+    void store_aligned(double* ptr) const {
+        _mm256_store_pd(ptr, data);
+    }
+    
+    /// Lanes [0, count) from ptr, the rest 0; masked-off lanes of vmaskmov
+    /// never fault, so nothing past ptr + count is read
+    static SimdVec load_first(const double* ptr, size_t count) {
+        const auto& mask = LANE_MASK_4X64[(1u << count) - 1];
+        return SimdVec(_mm256_maskload_pd(ptr, _mm256_load_si256(reinterpret_cast<const __m256i*>(mask.data()))));
+    }
+    
+    /// Store lanes [0, count); writes nothing past ptr + count
+    void store_first(double* ptr, size_t count) const {
+        const auto& mask = LANE_MASK_4X64[(1u << count) - 1];
+        _mm256_maskstore_pd(ptr, _mm256_load_si256(reinterpret_cast<const __m256i*>(mask.data())), data);
+    }
+    
+    double operator[](size_t i) const {
+        alignas(32) double tmp[4];
+        _mm256_store_pd(tmp, data);
+        return tmp[i];
+    }
+    
+    SimdVec operator+(const SimdVec& other) const {
+        return SimdVec(_mm256_add_pd(data, other.data));
+    }
+    
+    SimdVec operator-(const SimdVec& other) const {
+        return SimdVec(_mm256_sub_pd(data, other.data));
+    }
+    
+    SimdVec operator*(const SimdVec& other) const {
+        return SimdVec(_mm256_mul_pd(data, other.data));
+    }
+    
+    SimdVec operator/(const SimdVec& other) const {
+        return SimdVec(_mm256_div_pd(data, other.data));
+    }
+    
+    SimdVec& operator+=(const SimdVec& other) {
+        data = _mm256_add_pd(data, other.data);
+        return *this;
+    }
+    
+    SimdVec& operator-=(const SimdVec& other) {
+        data = _mm256_sub_pd(data, other.data);
+        return *this;
+    }
+    
+    SimdVec& operator*=(const SimdVec& other) {
+        data = _mm256_mul_pd(data, other.data);
+        return *this;
+    }
+    
+    double horizontal_sum() const {
+        __m128d hi = _mm256_extractf128_pd(data, 1);
+        __m128d lo = _mm256_castpd256_pd128(data);
+        __m128d sum128 = _mm_add_pd(hi, lo);
+        __m128d shuf = _mm_unpackhi_pd(sum128, sum128);
+        return _mm_cvtsd_f64(_mm_add_sd(sum128, shuf));
+    }
+    
+    static SimdVec fmadd(const SimdVec& a, const SimdVec& b, const SimdVec& c) {
+        return SimdVec(_mm256_fmadd_pd(a.data, b.data, c.data));
+    }
+    
+    SimdVec sqrt() const {
+        return SimdVec(_mm256_sqrt_pd(data));
+    }
+    
     SimdVec min(const SimdVec& other) const {
-        return SimdVec(_mm512_min_ps(data, other.data));
+        return SimdVec(_mm256_min_pd(data, other.data));
     }
     
     SimdVec max(const SimdVec& other) const {
-        return SimdVec(_mm512_max_ps(data, other.data));
+        return SimdVec(_mm256_max_pd(data, other.data));
+    }
+    
+    SimdVec floor() const {
+        return SimdVec(_mm256_floor_pd(data));
+    }
+    
+    /// Lane i loads base[index[i]]; index lanes hold whole numbers >= 0
+    static SimdVec gather(const double* base, const SimdVec& index) {
+        return SimdVec(_mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, _mm256_cvttpd_epi32(index.data),
+                                                _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8));
+    }
+};
+
+#endif // HPC_HAS_AVX2
+
+// ============================================================================
+// AVX-512 Implementation (512-bit, 8 doubles)
+// ============================================================================
+
+#ifdef HPC_HAS_AVX512
+
+template<>
+class SimdVec<double, 8> {
+public:
+    static constexpr size_t width = 8;
+    using value_type = double;
+    
+    __m512d data;
+    
+    SimdVec() : data(_mm512_setzero_pd()) {}
+    
+    explicit SimdVec(__m512d v) : data(v) {}
+    
+    explicit SimdVec(double val) : data(_mm512_set1_pd(val)) {}
+    
+    SimdVec(const double* ptr) : data(_mm512_loadu_pd(ptr)) {}
+    
+    static SimdVec load_aligned(const double* ptr) {
+        return SimdVec(_mm512_load_pd(ptr));
+    }
+    
+    void store(double* ptr) const {
+        _mm512_storeu_pd(ptr, data);
+    }
+    
+    void store_aligned(double* ptr) const {
+        _mm512_store_pd(ptr, data);
+    }
+    
+    /// Lanes [0, count) from ptr, the rest 0; reads nothing past ptr + count
+    static SimdVec load_first(const double* ptr, size_t count) {
+        return SimdVec(_mm512_maskz_loadu_pd(static_cast<__mmask8>((1u << count) - 1), ptr));
+    }
+    
+    /// Store lanes [0, count); writes nothing past ptr + count
+    void store_first(double* ptr, size_t count) const {
+        _mm512_mask_storeu_pd(ptr, static_cast<__mmask8>((1u << count) - 1), data);
+    }
+    
+    double operator[](size_t i) const {
+        alignas(64) double tmp[8];
+        _mm512_store_pd(tmp, data);
+        return tmp[i];
+    }
+    
+    SimdVec operator+(const SimdVec& other) const {
+        return SimdVec(_mm512_add_pd(data, other.data));
+    }
+    
+    SimdVec operator-(const SimdVec& other) const {
+        return SimdVec(_mm512_sub_pd(data, other.data));
+    }
+    
+    SimdVec operator*(const SimdVec& other) const {
+        return SimdVec(_mm512_mul_pd(data, other.data));
+    }
+    
+    SimdVec operator/(const SimdVec& other) const {
+        return SimdVec(_mm512_div_pd(data, other.data));
+    }
+    
+    SimdVec& operator+=(const SimdVec& other) {
+        data = _mm512_add_pd(data, other.data);
+        return *this;
+    }
+    
+    SimdVec& operator-=(const SimdVec& other) {
+        data = _mm512_sub_pd(data, other.data);
+        return *this;
+    }
+    
+    SimdVec& operator*=(const SimdVec& other) {
+        data = _mm512_mul_pd(data, other.data);
+        return *this;
+    }
+    
+    /// Halves added, then the AVX2 reduction (see SimdVec<float, 16>)
+    double horizontal_sum() const {
+        const __m256d lo = _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xFF, data, 0);
+        const __m256d hi = _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xFF, data, 1);
+        return SimdVec<double, 4>(_mm256_add_pd(lo, hi)).horizontal_sum();
+    }
+    
+    static SimdVec fmadd(const SimdVec& a, const SimdVec& b, const SimdVec& c) {
+        return SimdVec(_mm512_fmadd_pd(a.data, b.data, c.data));
+    }
+    
+    SimdVec sqrt() const {
+        return SimdVec(_mm512_mask_sqrt_pd(data, 0xFF, data));
+    }
+    
+    SimdVec min(const SimdVec& other) const {
+        return SimdVec(_mm512_mask_min_pd(data, 0xFF, data, other.data));
+    }
+    
+    SimdVec max(const SimdVec& other) const {
+        return SimdVec(_mm512_mask_max_pd(data, 0xFF, data, other.data));
+    }
+    
+    SimdVec floor() const {
+        return SimdVec(_mm512_mask_roundscale_pd(data, 0xFF, data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    }
+    
+    /// Lane i loads base[index[i]]; index lanes hold whole numbers >= 0
+    static SimdVec gather(const double* base, const SimdVec& index) {
+        const __m256i idx = _mm512_maskz_cvttpd_epi32(0xFF, index.data);
+        return SimdVec(_mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, base, 8));
     }
 };
 
@@ -446,6 +964,37 @@ public:
     constexpr size_t FLOAT_VEC_WIDTH = 4;
 #endif
 
+#ifdef HPC_HAS_AVX512
+    using DoubleVec = SimdVec<double, 8>;
+    constexpr size_t DOUBLE_VEC_WIDTH = 8;
+#elif defined(HPC_HAS_AVX2)
+    using DoubleVec = SimdVec<double, 4>;
+    constexpr size_t DOUBLE_VEC_WIDTH = 4;
+#elif defined(HPC_HAS_SSE2)
+    using DoubleVec = SimdVec<double, 2>;
+    constexpr size_t DOUBLE_VEC_WIDTH = 2;
+#else
+    using DoubleVec = SimdVecScalar<double, 2>;
+    constexpr size_t DOUBLE_VEC_WIDTH = 2;
+#endif
+
+/// Widest vector type for an element type: native_vec_t<float> is FloatVec
+template<typename T>
+struct native_vec;
+
+template<>
+struct native_vec<float> {
+    using type = FloatVec;
+};
+
+template<>
+struct native_vec<double> {
+    using type = DoubleVec;
+};
+
+template<typename T>
+using native_vec_t = typename native_vec<T>::type;
+
 // ============================================================================
 // High-level operations using the wrapper
 // ============================================================================
@@ -484,6 +1033,20 @@ inline float dot_product_wrapped(const float* a, const float* b, size_t n) {
     return result;
 }
 
+/// y = alpha * x + y using SIMD wrapper
+inline void axpy_wrapped(float alpha, const float* x, float* y, size_t n) {
+    FloatVec valpha(alpha);
+    size_t i = 0;
+    
+    for (; i + FLOAT_VEC_WIDTH <= n; i += FLOAT_VEC_WIDTH) {
+        FloatVec::fmadd(valpha, FloatVec(&x[i]), FloatVec(&y[i])).store(&y[i]);
+    }
+    
+    for (; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
 /// Scale array by scalar using SIMD wrapper
 inline void scale_array_wrapped(float* arr, float scalar, size_t n) {
     FloatVec vscalar(scalar);
@@ -517,4 +1080,59 @@ inline void clamp_array_wrapped(float* arr, float min_val, float max_val, size_t
     }
 }
 
+/// Set bits in data[0, n): per byte, two vpshufb lookups of NIBBLE_POPCOUNT
+/// (low and high nibble). Byte counts accumulate over up to 31 registers
+/// (31 * 8 < 256) before one vpsadbw widens them, which keeps vpsadbw off
+/// the shuffle port in the inner loop
+inline uint64_t popcount_wrapped(const uint8_t* data, size_t n) {
+    uint64_t count = 0;
+    size_t i = 0;
+    
+#if defined(__AVX512BW__) || defined(HPC_HAS_AVX2)
+    constexpr size_t BLOCK = 31;
+#endif
+#if defined(__AVX512BW__)
+    const __m512i table = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_load_si128(reinterpret_cast<const __m128i*>(NIBBLE_POPCOUNT.data())));
+    const __m512i low = _mm512_set1_epi8(0x0F);
+    __m512i acc = _mm512_setzero_si512();
+    while (i + 64 <= n) {
+        const size_t end = std::min(n - n % 64, i + BLOCK * 64);
+        __m512i bytes = _mm512_setzero_si512();
+        for (; i < end; i += 64) {
+            const __m512i v = _mm512_loadu_si512(data + i);
+            const __m512i lo = _mm512_shuffle_epi8(table, _mm512_and_si512(v, low));
+            const __m512i hi = _mm512_shuffle_epi8(table, _mm512_and_si512(_mm512_srli_epi16(v, 4), low));
+            bytes = _mm512_add_epi8(bytes, _mm512_add_epi8(lo, hi));
+        }
+        acc = _mm512_add_epi64(acc, _mm512_sad_epu8(bytes, _mm512_setzero_si512()));
+    }
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, acc);
+    for (uint64_t lane : lanes) count += lane;
+#elif defined(HPC_HAS_AVX2)
+    const __m256i table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(NIBBLE_POPCOUNT.data())));
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i acc = _mm256_setzero_si256();
+    while (i + 32 <= n) {
+        const size_t end = std::min(n - n % 32, i + BLOCK * 32);
+        __m256i bytes = _mm256_setzero_si256();
+        for (; i < end; i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+            const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+            bytes = _mm256_add_epi8(bytes, _mm256_add_epi8(lo, hi));
+        }
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    count = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    
+    for (; i < n; ++i) {
+        count += static_cast<uint64_t>(std::popcount(data[i]));
+    }
+    return count;
+}
+
 } // namespace hpc::simd
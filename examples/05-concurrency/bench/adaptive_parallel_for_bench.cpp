@@ -0,0 +1,157 @@
+/**
+ * @file adaptive_parallel_for_bench.cpp
+ * @brief adaptive_parallel_for vs fixed OpenMP and ThreadPool schedules
+ *
+ * Three workloads over the same loop, differing only in per-iteration cost:
+ *   /0 uniform      - every iteration costs the same
+ *   /1 linear       - cost grows with the index (triangular loops)
+ *   /2 heavy-tailed - Pareto-distributed cost: most cheap, a few huge
+ *
+ * The adaptive rows are labelled with the schedule the tuner picked.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/adaptive_parallel_for.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+constexpr size_t N = 1 << 16;
+constexpr uint32_t MEAN_ROUNDS = 64;
+
+enum Workload { UNIFORM = 0, LINEAR = 1, HEAVY_TAILED = 2 };
+
+/// Per-iteration work in multiply-add rounds, mean ~MEAN_ROUNDS
+std::vector<uint32_t> make_costs(int workload) {
+    std::vector<uint32_t> rounds(N);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    for (size_t i = 0; i < N; ++i) {
+        switch (workload) {
+            case UNIFORM:
+                rounds[i] = MEAN_ROUNDS;
+                break;
+            case LINEAR:
+                rounds[i] = static_cast<uint32_t>(2 * MEAN_ROUNDS * i / N);
+                break;
+            default: {
+                // Pareto(alpha = 1.2), scale chosen for mean ~MEAN_ROUNDS, capped
+                const double x = 11.0 / std::pow(1.0 - u(rng), 1.0 / 1.2);
+                rounds[i] = static_cast<uint32_t>(std::min(x, 200000.0));
+                break;
+            }
+        }
+    }
+    return rounds;
+}
+
+inline double work(uint32_t rounds, size_t i) {
+    double x = static_cast<double>(i);
+    for (uint32_t r = 0; r < rounds; ++r) {
+        x = x * 1.0000001 + 0.5;
+    }
+    return x;
+}
+
+/// Run loop(body) per iteration; body(i) does the workload's work for index i
+template<typename Loop>
+void run_workload(benchmark::State& state, Loop loop) {
+    const auto rounds = make_costs(static_cast<int>(state.range(0)));
+    std::vector<double> out(N);
+    auto body = [&](size_t i) { out[i] = work(rounds[i], i); };
+    for (auto _ : state) {
+        loop(body);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(N));
+}
+
+// ----------------------------------------------------------------------------
+// Fixed OpenMP schedules
+// ----------------------------------------------------------------------------
+
+#ifdef _OPENMP
+static void BM_OpenMP_Static(benchmark::State& state) {
+    run_workload(state, [](auto& body) {
+        #pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < N; ++i) body(i);
+    });
+}
+
+static void BM_OpenMP_Dynamic(benchmark::State& state) {
+    run_workload(state, [](auto& body) {
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (size_t i = 0; i < N; ++i) body(i);
+    });
+}
+
+static void BM_OpenMP_Guided(benchmark::State& state) {
+    run_workload(state, [](auto& body) {
+        #pragma omp parallel for schedule(guided)
+        for (size_t i = 0; i < N; ++i) body(i);
+    });
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// Fixed schedules on the ThreadPool runtime
+// ----------------------------------------------------------------------------
+
+static void BM_Pool_Static(benchmark::State& state) {
+    run_workload(state, [](auto& body) {
+        hpc::parallel::parallel_for(0, N, body, hpc::parallel::Schedule::Static);
+    });
+}
+
+static void BM_Pool_Dynamic(benchmark::State& state) {
+    run_workload(state, [](auto& body) {
+        hpc::parallel::parallel_for(0, N, body, hpc::parallel::Schedule::Dynamic, 64);
+    });
+}
+
+static void BM_Pool_WorkStealing(benchmark::State& state) {
+    run_workload(state, [](auto& body) {
+        hpc::parallel::parallel_for(0, N, body, hpc::parallel::Schedule::WorkStealing, 64);
+    });
+}
+
+// ----------------------------------------------------------------------------
+// Adaptive (one tuner per benchmark run, so each workload is tuned afresh)
+// ----------------------------------------------------------------------------
+
+static void BM_Adaptive(benchmark::State& state) {
+    hpc::parallel::LoopTuner tuner;
+    run_workload(state, [&tuner](auto& body) { tuner.run(0, N, body); });
+
+    const auto decision = tuner.decision();
+    state.SetLabel(hpc::parallel::schedule_name(decision.schedule));
+    state.counters["cv"] = decision.cv;
+    state.counters["tail"] = decision.tail;
+    state.counters["retunes"] = tuner.retunes();
+}
+
+void workloads(benchmark::internal::Benchmark* b) {
+    b->ArgName("workload")->Arg(UNIFORM)->Arg(LINEAR)->Arg(HEAVY_TAILED);
+}
+
+#ifdef _OPENMP
+BENCHMARK(BM_OpenMP_Static)->Apply(workloads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_OpenMP_Dynamic)->Apply(workloads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_OpenMP_Guided)->Apply(workloads)->Unit(benchmark::kMillisecond)->UseRealTime();
+#endif
+BENCHMARK(BM_Pool_Static)->Apply(workloads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Pool_Dynamic)->Apply(workloads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Pool_WorkStealing)->Apply(workloads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Adaptive)->Apply(workloads)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
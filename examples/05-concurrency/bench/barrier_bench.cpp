@@ -0,0 +1,137 @@
+/**
+ * @file barrier_bench.cpp
+ * @brief Barrier latency: std::barrier vs omp barrier vs spin-then-block
+ *
+ * Each iteration starts the given number of threads, which then cross
+ * EPISODES barriers back to back with no work in between, so
+ * items_per_second is barrier episodes per second (thread start-up is
+ * amortized over the episodes). A second set adds a small SoA particle
+ * update per step, the bulk-synchronous case the barriers exist for.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/barrier.hpp"
+#include <barrier>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+using namespace hpc::concurrency;
+
+constexpr int EPISODES = 20000;
+constexpr size_t PARTICLES_PER_THREAD = 1024;
+
+/// Per-thread slice of an SoA particle set
+struct Slice {
+    std::vector<float> x, vx;
+    Slice() : x(PARTICLES_PER_THREAD, 0.0f), vx(PARTICLES_PER_THREAD, 1.0f) {}
+
+    void update() {
+        for (size_t i = 0; i < x.size(); ++i) x[i] += vx[i] * 0.001f;
+        benchmark::DoNotOptimize(x.data());
+    }
+};
+
+/// sync(thread_id) is called EPISODES times by every thread
+template<bool WithWork, typename Sync>
+void run_episodes(benchmark::State& state, Sync sync) {
+    const int num_threads = static_cast<int>(state.range(0));
+    std::vector<Slice> slices(static_cast<size_t>(num_threads));
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        threads.reserve(static_cast<size_t>(num_threads));
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int e = 0; e < EPISODES; ++e) {
+                    if constexpr (WithWork) {
+                        slices[static_cast<size_t>(t)].update();
+                    }
+                    sync(static_cast<size_t>(t));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * EPISODES);
+}
+
+template<bool WithWork>
+static void BM_Barrier_Std(benchmark::State& state) {
+    std::barrier<> barrier(state.range(0));
+    run_episodes<WithWork>(state, [&](size_t) { barrier.arrive_and_wait(); });
+}
+
+template<bool WithWork>
+static void BM_Barrier_Spin(benchmark::State& state) {
+    SpinBarrier barrier(static_cast<size_t>(state.range(0)));
+    run_episodes<WithWork>(state, [&](size_t) { barrier.arrive_and_wait(); });
+}
+
+template<bool WithWork>
+static void BM_Barrier_Dissemination(benchmark::State& state) {
+    DisseminationBarrier barrier(static_cast<size_t>(state.range(0)));
+    run_episodes<WithWork>(state, [&](size_t t) { barrier.arrive_and_wait(t); });
+}
+
+template<bool WithWork>
+static void BM_Barrier_Phaser(benchmark::State& state) {
+    Phaser phaser(static_cast<uint32_t>(state.range(0)));
+    run_episodes<WithWork>(state, [&](size_t) { phaser.arrive_and_await_advance(); });
+}
+
+/// The OpenMP team is persistent, so one parallel region per iteration
+template<bool WithWork>
+static void BM_Barrier_OpenMP(benchmark::State& state) {
+    const int num_threads = static_cast<int>(state.range(0));
+    std::vector<Slice> slices(static_cast<size_t>(num_threads));
+
+    for (auto _ : state) {
+        #pragma omp parallel num_threads(num_threads)
+        {
+#ifdef _OPENMP
+            const size_t t = static_cast<size_t>(omp_get_thread_num());
+#else
+            const size_t t = 0;
+#endif
+            for (int e = 0; e < EPISODES; ++e) {
+                if constexpr (WithWork) {
+                    slices[t].update();
+                }
+                #pragma omp barrier
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * EPISODES);
+}
+
+void thread_counts(benchmark::internal::Benchmark* b) {
+    b->ArgName("threads");
+    for (int threads : {1, 2, 4, 8, 16}) {
+        b->Arg(threads);
+    }
+    b->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_Barrier_Std, false)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(BM_Barrier_OpenMP, false)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(BM_Barrier_Spin, false)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(BM_Barrier_Dissemination, false)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(BM_Barrier_Phaser, false)->Apply(thread_counts);
+
+// Bulk-synchronous: a 1024-particle update per thread between barriers
+BENCHMARK_TEMPLATE(BM_Barrier_Std, true)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(BM_Barrier_OpenMP, true)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(BM_Barrier_Spin, true)->Apply(thread_counts);
+BENCHMARK_TEMPLATE(BM_Barrier_Dissemination, true)->Apply(thread_counts);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,126 @@
+/**
+ * @file concurrent_hash_map_bench.cpp
+ * @brief ConcurrentHashMap vs SpinLock-guarded std::unordered_map
+ *
+ * Each thread performs a mix of find / insert / erase on a shared key range
+ * that starts half full. Writes are split evenly between insert and erase,
+ * so the map size stays roughly constant.
+ *
+ * Mixes (read_pct): 95 = read-heavy, 50 = mixed, 10 = write-heavy.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/concurrent_hash_map.hpp"
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace hpc::concurrency;
+
+constexpr uint64_t KEY_RANGE = 1 << 16;
+constexpr int OPS_PER_THREAD = 200000;
+
+/// Baseline: std::unordered_map behind the example SpinLock
+class LockedUnorderedMap {
+public:
+    std::optional<uint64_t> find(uint64_t key) {
+        SpinLockGuard guard(lock_);
+        auto it = map_.find(key);
+        if (it == map_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    bool insert(uint64_t key, uint64_t value) {
+        SpinLockGuard guard(lock_);
+        return map_.emplace(key, value).second;
+    }
+
+    bool erase(uint64_t key) {
+        SpinLockGuard guard(lock_);
+        return map_.erase(key) == 1;
+    }
+
+private:
+    SpinLock lock_;
+    std::unordered_map<uint64_t, uint64_t> map_;
+};
+
+/// xorshift64: cheap per-thread key/op stream
+uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+template<typename Map>
+void run_mix(benchmark::State& state, Map& map) {
+    const int num_threads = static_cast<int>(state.range(0));
+    const auto read_pct = static_cast<uint64_t>(state.range(1));
+
+    for (uint64_t k = 0; k < KEY_RANGE; k += 2) {
+        map.insert(k, k);
+    }
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        threads.reserve(static_cast<size_t>(num_threads));
+
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&map, read_pct, t]() {
+                uint64_t rng = 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(t + 1);
+                for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                    const uint64_t r = next_random(rng);
+                    const uint64_t key = (r >> 8) % KEY_RANGE;
+                    const uint64_t op = r % 100;
+                    if (op < read_pct) {
+                        benchmark::DoNotOptimize(map.find(key));
+                    } else if (op & 1) {
+                        benchmark::DoNotOptimize(map.insert(key, r));
+                    } else {
+                        benchmark::DoNotOptimize(map.erase(key));
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_threads * OPS_PER_THREAD);
+}
+
+static void BM_HashMap_SpinLockUnordered(benchmark::State& state) {
+    LockedUnorderedMap map;
+    run_mix(state, map);
+}
+
+static void BM_HashMap_Concurrent(benchmark::State& state) {
+    auto map = std::make_unique<ConcurrentHashMap<uint64_t, uint64_t>>(KEY_RANGE);
+    run_mix(state, *map);
+}
+
+BENCHMARK(BM_HashMap_SpinLockUnordered)
+    ->ArgsProduct({{1, 2, 4, 8}, {95, 50, 10}})
+    ->ArgNames({"threads", "read_pct"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_HashMap_Concurrent)
+    ->ArgsProduct({{1, 2, 4, 8}, {95, 50, 10}})
+    ->ArgNames({"threads", "read_pct"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
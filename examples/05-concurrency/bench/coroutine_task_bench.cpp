@@ -0,0 +1,159 @@
+/**
+ * @file coroutine_task_bench.cpp
+ * @brief Coroutine context-switch cost vs std::thread handoff through SPSCQueue
+ *
+ * - ResumeSuspend: resume a suspended coroutine and let it suspend again
+ *   (the raw switch, no allocation, no queue)
+ * - AwaitTask: co_await a child task that completes immediately
+ *   (frame allocation + symmetric transfer there and back)
+ * - ExecutorHop: co_await executor.schedule() (MPMCQueue push + pop + resume)
+ * - SPSCPingPong: two threads bounce a token through two SPSCQueues; one
+ *   item is one handoff from one thread to the other
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/coroutine_task.hpp"
+#include "../include/lock_free_queue.hpp"
+#include <coroutine>
+#include <memory>
+#include <thread>
+
+namespace {
+
+using namespace hpc::concurrency;
+
+constexpr int64_t HANDOFFS = 100000;
+
+/// Minimal coroutine that suspends forever in a loop
+struct Pinger {
+    struct promise_type {
+        Pinger get_return_object() {
+            return Pinger{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+Pinger ping_forever(int64_t& counter) {
+    for (;;) {
+        ++counter;
+        co_await std::suspend_always{};
+    }
+}
+
+static void BM_Coroutine_ResumeSuspend(benchmark::State& state) {
+    int64_t counter = 0;
+    Pinger pinger = ping_forever(counter);
+    for (auto _ : state) {
+        pinger.handle.resume();
+    }
+    benchmark::DoNotOptimize(counter);
+    pinger.handle.destroy();
+    state.SetItemsProcessed(state.iterations());
+}
+
+task<int64_t> immediate(int64_t x) {
+    co_return x + 1;
+}
+
+task<int64_t> await_children(int64_t n) {
+    int64_t sum = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        sum += co_await immediate(i);
+    }
+    co_return sum;
+}
+
+static void BM_Coroutine_AwaitTask(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sync_wait(await_children(HANDOFFS)));
+    }
+    state.SetItemsProcessed(state.iterations() * HANDOFFS);
+}
+
+task<int64_t> hop(Executor& executor, int64_t n) {
+    for (int64_t i = 0; i < n; ++i) {
+        co_await executor.schedule();
+    }
+    co_return n;
+}
+
+static void BM_Coroutine_ExecutorHop(benchmark::State& state) {
+    Executor executor(static_cast<unsigned int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sync_wait(hop(executor, HANDOFFS)));
+    }
+    state.SetItemsProcessed(state.iterations() * HANDOFFS);
+}
+
+static void BM_Thread_SPSCPingPong(benchmark::State& state) {
+    auto ping = std::make_unique<SPSCQueue<int64_t, 1024>>();
+    auto pong = std::make_unique<SPSCQueue<int64_t, 1024>>();
+
+    for (auto _ : state) {
+        std::thread responder([&]() {
+            for (int64_t i = 0; i < HANDOFFS / 2; ++i) {
+                std::optional<int64_t> v;
+                while (!(v = ping->pop())) {
+                    std::this_thread::yield();
+                }
+                while (!pong->push(*v + 1)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        int64_t token = 0;
+        for (int64_t i = 0; i < HANDOFFS / 2; ++i) {
+            while (!ping->push(token)) {
+                std::this_thread::yield();
+            }
+            std::optional<int64_t> v;
+            while (!(v = pong->pop())) {
+                std::this_thread::yield();
+            }
+            token = *v;
+        }
+        responder.join();
+        benchmark::DoNotOptimize(token);
+    }
+    state.SetItemsProcessed(state.iterations() * HANDOFFS);
+}
+
+/// Uncontended async_mutex lock/unlock from inside a coroutine
+task<int64_t> lock_unlock(async_mutex& mutex, int64_t n) {
+    int64_t counter = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        auto guard = co_await mutex.scoped_lock();
+        ++counter;
+    }
+    co_return counter;
+}
+
+static void BM_Coroutine_AsyncMutexUncontended(benchmark::State& state) {
+    async_mutex mutex;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sync_wait(lock_unlock(mutex, HANDOFFS)));
+    }
+    state.SetItemsProcessed(state.iterations() * HANDOFFS);
+}
+
+BENCHMARK(BM_Coroutine_ResumeSuspend);
+BENCHMARK(BM_Coroutine_AwaitTask)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Coroutine_ExecutorHop)
+    ->Arg(1)
+    ->Arg(2)
+    ->ArgName("workers")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_Thread_SPSCPingPong)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Coroutine_AsyncMutexUncontended)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,150 @@
+/**
+ * @file deterministic_reduce_bench.cpp
+ * @brief Reproducible sum/dot vs OpenMP reduction(+:...)
+ *
+ * Baselines are the non-deterministic OpenMP reductions, both the plain
+ * `parallel for reduction` (scalar per thread without -ffast-math) and
+ * `parallel for simd reduction` (vectorized, reassociated). Sizes span
+ * L2-resident (64K), L3-resident (1M) and DRAM-bound (32M) doubles.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/deterministic_reduce.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+using hpc::parallel::Summation;
+
+template<typename T>
+std::vector<T> random_data(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T> dist(-1, 1);
+    std::vector<T> v(n);
+    for (auto& x : v) x = dist(rng);
+    return v;
+}
+
+template<typename T>
+void set_bytes(benchmark::State& state, size_t arrays) {
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<int64_t>(sizeof(T) * arrays));
+}
+
+// ----------------------------------------------------------------------------
+// Sum
+// ----------------------------------------------------------------------------
+
+static void BM_Sum_OpenMP(benchmark::State& state) {
+    const auto x = random_data<double>(static_cast<size_t>(state.range(0)), 1);
+    const double* p = x.data();
+    const auto n = static_cast<long long>(x.size());
+    for (auto _ : state) {
+        double sum = 0.0;
+        #pragma omp parallel for reduction(+:sum)
+        for (long long i = 0; i < n; ++i) {
+            sum += p[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_bytes<double>(state, 1);
+}
+
+static void BM_Sum_OpenMPSimd(benchmark::State& state) {
+    const auto x = random_data<double>(static_cast<size_t>(state.range(0)), 1);
+    const double* p = x.data();
+    const auto n = static_cast<long long>(x.size());
+    for (auto _ : state) {
+        double sum = 0.0;
+        #pragma omp parallel for simd reduction(+:sum)
+        for (long long i = 0; i < n; ++i) {
+            sum += p[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_bytes<double>(state, 1);
+}
+
+template<Summation S>
+static void BM_Sum_Deterministic(benchmark::State& state) {
+    const auto x = random_data<double>(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hpc::parallel::deterministic_sum<double, S>(x.data(), x.size()));
+    }
+    set_bytes<double>(state, 1);
+}
+
+static void BM_SumF32_OpenMPSimd(benchmark::State& state) {
+    const auto x = random_data<float>(static_cast<size_t>(state.range(0)), 1);
+    const float* p = x.data();
+    const auto n = static_cast<long long>(x.size());
+    for (auto _ : state) {
+        float sum = 0.0f;
+        #pragma omp parallel for simd reduction(+:sum)
+        for (long long i = 0; i < n; ++i) {
+            sum += p[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_bytes<float>(state, 1);
+}
+
+static void BM_SumF32_Deterministic(benchmark::State& state) {
+    const auto x = random_data<float>(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hpc::parallel::deterministic_sum(x.data(), x.size()));
+    }
+    set_bytes<float>(state, 1);
+}
+
+// ----------------------------------------------------------------------------
+// Dot product
+// ----------------------------------------------------------------------------
+
+static void BM_Dot_OpenMPSimd(benchmark::State& state) {
+    const auto a = random_data<double>(static_cast<size_t>(state.range(0)), 2);
+    const auto b = random_data<double>(static_cast<size_t>(state.range(0)), 3);
+    const double* pa = a.data();
+    const double* pb = b.data();
+    const auto n = static_cast<long long>(a.size());
+    for (auto _ : state) {
+        double dot = 0.0;
+        #pragma omp parallel for simd reduction(+:dot)
+        for (long long i = 0; i < n; ++i) {
+            dot += pa[i] * pb[i];
+        }
+        benchmark::DoNotOptimize(dot);
+    }
+    set_bytes<double>(state, 2);
+}
+
+template<Summation S>
+static void BM_Dot_Deterministic(benchmark::State& state) {
+    const auto a = random_data<double>(static_cast<size_t>(state.range(0)), 2);
+    const auto b = random_data<double>(static_cast<size_t>(state.range(0)), 3);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hpc::parallel::deterministic_dot<double, S>(a.data(), b.data(), a.size()));
+    }
+    set_bytes<double>(state, 2);
+}
+
+void sizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 25)->UseRealTime();
+}
+
+BENCHMARK(BM_Sum_OpenMP)->Apply(sizes);
+BENCHMARK(BM_Sum_OpenMPSimd)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Sum_Deterministic, Summation::Pairwise)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Sum_Deterministic, Summation::Kahan)->Apply(sizes);
+
+BENCHMARK(BM_SumF32_OpenMPSimd)->Apply(sizes);
+BENCHMARK(BM_SumF32_Deterministic)->Apply(sizes);
+
+BENCHMARK(BM_Dot_OpenMPSimd)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Dot_Deterministic, Summation::Pairwise)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Dot_Deterministic, Summation::Kahan)->Apply(sizes);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,163 @@
+/**
+ * @file disruptor_bench.cpp
+ * @brief Fan-out to three stages: one multicast RingBuffer vs three SPSCQueues
+ *
+ * The queue version copies every event into one SPSCQueue per stage; the
+ * ring buffer version writes each event once and all stages read it in
+ * place. Event size is varied to show the cost of the copies.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/disruptor.hpp"
+#include "../include/lock_free_queue.hpp"
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace hpc::concurrency;
+
+constexpr int64_t EVENTS = 200000;
+constexpr size_t RING_SIZE = 1024;
+constexpr int NUM_STAGES = 3;
+
+template<size_t Bytes>
+struct Event {
+    std::array<int64_t, Bytes / sizeof(int64_t)> payload{};
+};
+
+template<size_t Bytes>
+void run_ring_fanout(benchmark::State& state) {
+    using Ring = RingBuffer<Event<Bytes>, RING_SIZE>;
+
+    for (auto _ : state) {
+        auto ring = std::make_unique<Ring>();
+        auto barrier = ring->new_barrier();
+        auto handler = [sum = int64_t{0}](Event<Bytes>& e, int64_t, bool) mutable {
+            sum += e.payload[0];
+            benchmark::DoNotOptimize(sum);
+        };
+        BatchEventProcessor s1(*ring, barrier, handler);
+        BatchEventProcessor s2(*ring, barrier, handler);
+        BatchEventProcessor s3(*ring, barrier, handler);
+        ring->add_gating_sequences({&s1.sequence(), &s2.sequence(), &s3.sequence()});
+
+        std::thread t1([&]() { s1.run(); });
+        std::thread t2([&]() { s2.run(); });
+        std::thread t3([&]() { s3.run(); });
+
+        for (int64_t i = 0; i < EVENTS; ++i) {
+            ring->publish_event([i](Event<Bytes>& e, int64_t) { e.payload[0] = i; });
+        }
+
+        for (const Sequence* s : {&s1.sequence(), &s2.sequence(), &s3.sequence()}) {
+            while (s->get() < EVENTS - 1) {
+                std::this_thread::yield();
+            }
+        }
+        barrier.alert();
+        t1.join();
+        t2.join();
+        t3.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * EVENTS);
+    state.SetBytesProcessed(state.iterations() * EVENTS * static_cast<int64_t>(Bytes));
+}
+
+template<size_t Bytes>
+void run_queue_fanout(benchmark::State& state) {
+    using Queue = SPSCQueue<Event<Bytes>, RING_SIZE>;
+
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<Queue>> queues;
+        for (int q = 0; q < NUM_STAGES; ++q) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+
+        std::vector<std::thread> stages;
+        for (int q = 0; q < NUM_STAGES; ++q) {
+            stages.emplace_back([&queue = *queues[static_cast<size_t>(q)]]() {
+                int64_t sum = 0;
+                for (int64_t received = 0; received < EVENTS;) {
+                    if (auto e = queue.pop()) {
+                        sum += e->payload[0];
+                        ++received;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+
+        Event<Bytes> event;
+        for (int64_t i = 0; i < EVENTS; ++i) {
+            event.payload[0] = i;
+            for (auto& queue : queues) {
+                while (!queue->push(event)) {  // One copy per stage
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        for (auto& stage : stages) {
+            stage.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * EVENTS);
+    state.SetBytesProcessed(state.iterations() * EVENTS * static_cast<int64_t>(Bytes));
+}
+
+static void BM_Fanout_RingBuffer_64B(benchmark::State& state) {
+    run_ring_fanout<64>(state);
+}
+
+static void BM_Fanout_SPSCQueues_64B(benchmark::State& state) {
+    run_queue_fanout<64>(state);
+}
+
+static void BM_Fanout_RingBuffer_512B(benchmark::State& state) {
+    run_ring_fanout<512>(state);
+}
+
+static void BM_Fanout_SPSCQueues_512B(benchmark::State& state) {
+    run_queue_fanout<512>(state);
+}
+
+/// Single-threaded claim cost: one slot at a time vs batches of 16
+static void BM_Claim_Single(benchmark::State& state) {
+    auto ring = std::make_unique<RingBuffer<Event<64>, RING_SIZE>>();
+    for (auto _ : state) {
+        const int64_t s = ring->next();
+        (*ring)[s].payload[0] = s;
+        ring->publish(s);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Claim_Batch16(benchmark::State& state) {
+    auto ring = std::make_unique<RingBuffer<Event<64>, RING_SIZE>>();
+    for (auto _ : state) {
+        const int64_t hi = ring->next(16);
+        for (int64_t s = hi - 15; s <= hi; ++s) {
+            (*ring)[s].payload[0] = s;
+        }
+        ring->publish(hi - 15, hi);
+    }
+    state.SetItemsProcessed(state.iterations() * 16);
+}
+
+BENCHMARK(BM_Fanout_RingBuffer_64B)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Fanout_SPSCQueues_64B)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Fanout_RingBuffer_512B)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Fanout_SPSCQueues_512B)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Claim_Single);
+BENCHMARK(BM_Claim_Batch16);
+
+} // namespace
+
+BENCHMARK_MAIN();
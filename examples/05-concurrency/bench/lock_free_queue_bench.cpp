@@ -0,0 +1,257 @@
+/**
+ * @file lock_free_queue_bench.cpp
+ * @brief Tail latency of SPSCQueue, MPMCQueue and a std::mutex queue
+ *
+ * - PingPong: one thread sends a TSC stamp, an echo thread on another CPU
+ *   sends it back; one sample is one round trip
+ * - OneWay: the producer stamps each message at a fixed pace (so the queue
+ *   stays near-empty and the sample is transit time, not queueing delay)
+ *   and the consumer records arrival - stamp
+ *
+ * Samples go into a LatencyHistogram; p50/p99/p99.9/max are reported as
+ * user counters in nanoseconds. Pass --latency_json=<file> to also write
+ * every run (with those counters) through export_suite_to_json.
+ *
+ * Each benchmark runs once per Placement: the two threads are pinned as
+ * threads 0 and 1 of that policy, so compact puts them on SMT siblings,
+ * one_per_core on two cores sharing an L3, and scatter as far apart as the
+ * machine allows (on a single-CPU machine all policies share CPU 0 and the
+ * numbers mostly measure the scheduler).
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/latency_histogram.hpp"
+#include "../include/lock_free_queue.hpp"
+#include "benchmark_utils.hpp"
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+
+namespace {
+
+using namespace hpc::concurrency;
+
+constexpr int64_t MESSAGES = 20000;
+constexpr size_t QUEUE_CAPACITY = 1024;
+constexpr double ONE_WAY_INTERVAL_NS = 2000.0;
+constexpr int SPIN_BEFORE_YIELD = 100;
+
+/// Baseline: std::queue behind a std::mutex, same push/pop interface
+template<typename T>
+class MutexQueue {
+public:
+    bool push(const T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(value);
+        return true;
+    }
+
+    std::optional<T> pop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+        T value = queue_.front();
+        queue_.pop();
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    std::queue<T> queue_;
+};
+
+/// Spin on cpu_pause, fall back to yield so a shared CPU still makes progress
+class Backoff {
+public:
+    void wait() {
+        if (++spins_ < SPIN_BEFORE_YIELD) {
+            cpu_pause();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    void reset() {
+        spins_ = 0;
+    }
+
+private:
+    int spins_ = 0;
+};
+
+template<typename Queue>
+void blocking_push(Queue& queue, uint64_t value) {
+    Backoff backoff;
+    while (!queue.push(value)) {
+        backoff.wait();
+    }
+}
+
+template<typename Queue>
+uint64_t blocking_pop(Queue& queue) {
+    Backoff backoff;
+    for (;;) {
+        if (auto value = queue.pop()) {
+            return *value;
+        }
+        backoff.wait();
+    }
+}
+
+Placement placement_arg(const benchmark::State& state) {
+    return static_cast<Placement>(state.range(0));
+}
+
+void report_percentiles(benchmark::State& state, const LatencyHistogram<>& hist) {
+    const double ns_per_tick = 1.0 / tsc_ticks_per_ns();
+    auto ns = [ns_per_tick](uint64_t ticks) { return static_cast<double>(ticks) * ns_per_tick; };
+    state.counters["p50_ns"] = ns(hist.percentile(50.0));
+    state.counters["p99_ns"] = ns(hist.percentile(99.0));
+    state.counters["p99.9_ns"] = ns(hist.percentile(99.9));
+    state.counters["max_ns"] = ns(hist.max());
+    state.SetItemsProcessed(static_cast<int64_t>(hist.count()));
+    state.SetLabel(placement_name(placement_arg(state)));
+}
+
+template<typename Queue>
+void run_ping_pong(benchmark::State& state) {
+    const Placement placement = placement_arg(state);
+    auto ping = std::make_unique<Queue>();
+    auto pong = std::make_unique<Queue>();
+    LatencyHistogram<> hist;
+    tsc_ticks_per_ns();  // Calibrate outside the timed region
+
+    for (auto _ : state) {
+        std::thread echo([&]() {
+            pin_current_thread(placement, 1);
+            for (int64_t i = 0; i < MESSAGES; ++i) {
+                blocking_push(*pong, blocking_pop(*ping));
+            }
+        });
+        std::thread sender([&]() {
+            pin_current_thread(placement, 0);
+            for (int64_t i = 0; i < MESSAGES; ++i) {
+                blocking_push(*ping, read_tsc());
+                const uint64_t sent = blocking_pop(*pong);
+                hist.record(read_tsc() - sent);
+            }
+        });
+        sender.join();
+        echo.join();
+    }
+    report_percentiles(state, hist);
+}
+
+template<typename Queue>
+void run_one_way(benchmark::State& state) {
+    const Placement placement = placement_arg(state);
+    auto queue = std::make_unique<Queue>();
+    LatencyHistogram<> hist;
+    const auto interval = static_cast<uint64_t>(ONE_WAY_INTERVAL_NS * tsc_ticks_per_ns());
+
+    for (auto _ : state) {
+        std::thread consumer([&]() {
+            pin_current_thread(placement, 1);
+            for (int64_t i = 0; i < MESSAGES; ++i) {
+                const uint64_t sent = blocking_pop(*queue);
+                hist.record(read_tsc() - sent);
+            }
+        });
+        std::thread producer([&]() {
+            pin_current_thread(placement, 0);
+            uint64_t next = read_tsc();
+            Backoff backoff;
+            for (int64_t i = 0; i < MESSAGES; ++i) {
+                while (read_tsc() < next) {
+                    backoff.wait();
+                }
+                backoff.reset();
+                blocking_push(*queue, read_tsc());
+                next += interval;
+            }
+        });
+        producer.join();
+        consumer.join();
+    }
+    report_percentiles(state, hist);
+}
+
+/// One run per placement policy
+void placements(benchmark::internal::Benchmark* b) {
+    for (Placement p : {Placement::None, Placement::Compact, Placement::OnePerCore, Placement::Scatter}) {
+        b->Arg(static_cast<int64_t>(p));
+    }
+    b->ArgName("placement");
+}
+
+using SPSC = SPSCQueue<uint64_t, QUEUE_CAPACITY>;
+using MPMC = MPMCQueue<uint64_t, QUEUE_CAPACITY>;
+using Mutex = MutexQueue<uint64_t>;
+
+static void BM_PingPong_SPSC(benchmark::State& state) {
+    run_ping_pong<SPSC>(state);
+}
+
+static void BM_PingPong_MPMC(benchmark::State& state) {
+    run_ping_pong<MPMC>(state);
+}
+
+static void BM_PingPong_Mutex(benchmark::State& state) {
+    run_ping_pong<Mutex>(state);
+}
+
+static void BM_OneWay_SPSC(benchmark::State& state) {
+    run_one_way<SPSC>(state);
+}
+
+static void BM_OneWay_MPMC(benchmark::State& state) {
+    run_one_way<MPMC>(state);
+}
+
+static void BM_OneWay_Mutex(benchmark::State& state) {
+    run_one_way<Mutex>(state);
+}
+
+BENCHMARK(BM_PingPong_SPSC)->Apply(placements)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_PingPong_MPMC)->Apply(placements)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_PingPong_Mutex)->Apply(placements)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_OneWay_SPSC)->Apply(placements)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_OneWay_MPMC)->Apply(placements)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_OneWay_Mutex)->Apply(placements)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    // Strip our own flag before the unrecognized-argument check
+    constexpr const char* JSON_FLAG = "--latency_json=";
+    std::string json_path;
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], JSON_FLAG, std::strlen(JSON_FLAG)) == 0) {
+            json_path = argv[i] + std::strlen(JSON_FLAG);
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    hpc::bench::BenchmarkSuite suite;
+    hpc::bench::SuiteReporter reporter(suite);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    if (!json_path.empty()) {
+        hpc::bench::export_suite_to_json(json_path, suite);
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file memory_reclamation_bench.cpp
+ * @brief Treiber stack push/pop throughput: EBR vs hazard pointers vs mutex
+ *
+ * Thread counts run from 1 up to all hardware threads.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/memory_reclamation.hpp"
+#include <memory>
+#include <mutex>
+#include <stack>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace hpc::concurrency;
+
+constexpr int OPS_PER_THREAD = 100000;
+
+/// 1, 2, 4, ... up to and including hardware_concurrency()
+void thread_counts(benchmark::internal::Benchmark* b) {
+    const int max_threads = static_cast<int>(hardware_concurrency());
+    for (int t = 1; t < max_threads; t *= 2) {
+        b->Arg(t);
+    }
+    b->Arg(max_threads);
+}
+
+/// Baseline: std::stack behind a mutex
+class MutexStack {
+public:
+    void push(int value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stack_.push(value);
+    }
+
+    std::optional<int> pop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stack_.empty()) {
+            return std::nullopt;
+        }
+        int value = stack_.top();
+        stack_.pop();
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    std::stack<int> stack_;
+};
+
+template<typename Stack>
+void run_push_pop(benchmark::State& state, Stack& stack) {
+    const int num_threads = static_cast<int>(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        threads.reserve(static_cast<size_t>(num_threads));
+
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&stack]() {
+                for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                    stack.push(i);
+                    benchmark::DoNotOptimize(stack.pop());
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_threads * OPS_PER_THREAD * 2);
+}
+
+static void BM_Stack_Mutex(benchmark::State& state) {
+    MutexStack stack;
+    run_push_pop(state, stack);
+}
+
+static void BM_Stack_TreiberEBR(benchmark::State& state) {
+    auto domain = std::make_unique<EpochDomain>();
+    TreiberStack<int, EpochDomain> stack(*domain);
+    run_push_pop(state, stack);
+}
+
+static void BM_Stack_TreiberHazard(benchmark::State& state) {
+    auto domain = std::make_unique<HazardPointerDomain>();
+    TreiberStack<int, HazardPointerDomain> stack(*domain);
+    run_push_pop(state, stack);
+}
+
+/// Single-threaded cost of one read-side section
+static void BM_Guard_Epoch(benchmark::State& state) {
+    auto domain = std::make_unique<EpochDomain>();
+    std::atomic<int*> shared{nullptr};
+    for (auto _ : state) {
+        EpochDomain::Guard guard(*domain);
+        benchmark::DoNotOptimize(guard.protect(shared));
+    }
+}
+
+static void BM_Guard_Hazard(benchmark::State& state) {
+    auto domain = std::make_unique<HazardPointerDomain>();
+    std::atomic<int*> shared{nullptr};
+    for (auto _ : state) {
+        HazardPointerDomain::Guard guard(*domain);
+        benchmark::DoNotOptimize(guard.protect(shared));
+    }
+}
+
+BENCHMARK(BM_Stack_Mutex)
+    ->Apply(thread_counts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Stack_TreiberEBR)
+    ->Apply(thread_counts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Stack_TreiberHazard)
+    ->Apply(thread_counts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Guard_Epoch);
+BENCHMARK(BM_Guard_Hazard);
+
+} // namespace
+
+BENCHMARK_MAIN();
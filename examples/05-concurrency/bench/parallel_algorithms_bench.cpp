@@ -0,0 +1,213 @@
+/**
+ * @file parallel_algorithms_bench.cpp
+ * @brief hpc::parallel algorithms vs std:: sequential and std::execution::par
+ *
+ * The std::execution::par rows are only built when the standard library's
+ * parallel algorithms are usable (HPC_HAVE_PARALLEL_STL, set by CMake when
+ * TBB is found for libstdc++).
+ *
+ * Each hpc::parallel row runs on both backends: /0 = ThreadPool, /1 = OpenMP.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/parallel_algorithms.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#ifdef HPC_HAVE_PARALLEL_STL
+#include <execution>
+#endif
+
+namespace {
+
+using hpc::parallel::Backend;
+
+template<typename T>
+std::vector<T> random_keys(size_t n) {
+    std::mt19937_64 rng(12345);
+    std::vector<T> v(n);
+    if constexpr (std::is_floating_point_v<T>) {
+        std::uniform_real_distribution<T> dist(-1e6, 1e6);
+        for (auto& x : v) x = dist(rng);
+    } else {
+        std::uniform_int_distribution<T> dist;
+        for (auto& x : v) x = dist(rng);
+    }
+    return v;
+}
+
+/// Time sort(data) on a fresh copy of random keys each iteration
+template<typename T, typename Sort>
+void run_sort(benchmark::State& state, Sort sort) {
+    const auto input = random_keys<T>(static_cast<size_t>(state.range(0)));
+    std::vector<T> data(input.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::copy(input.begin(), input.end(), data.begin());
+        state.ResumeTiming();
+        sort(data);
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+Backend backend_arg(const benchmark::State& state) {
+    return static_cast<Backend>(state.range(1));
+}
+
+// ----------------------------------------------------------------------------
+// Sort uint32_t
+// ----------------------------------------------------------------------------
+
+static void BM_Sort_U32_StdSort(benchmark::State& state) {
+    run_sort<uint32_t>(state, [](auto& v) { std::sort(v.begin(), v.end()); });
+}
+
+#ifdef HPC_HAVE_PARALLEL_STL
+static void BM_Sort_U32_StdPar(benchmark::State& state) {
+    run_sort<uint32_t>(state, [](auto& v) { std::sort(std::execution::par, v.begin(), v.end()); });
+}
+#endif
+
+static void BM_Sort_U32_Radix(benchmark::State& state) {
+    const Backend backend = backend_arg(state);
+    run_sort<uint32_t>(state, [backend](auto& v) { hpc::parallel::radix_sort(v.begin(), v.end(), backend); });
+}
+
+static void BM_Sort_U32_Sample(benchmark::State& state) {
+    const Backend backend = backend_arg(state);
+    run_sort<uint32_t>(state, [backend](auto& v) {
+        hpc::parallel::sample_sort(v.begin(), v.end(), std::less<>{}, backend);
+    });
+}
+
+// ----------------------------------------------------------------------------
+// Sort double
+// ----------------------------------------------------------------------------
+
+static void BM_Sort_F64_StdSort(benchmark::State& state) {
+    run_sort<double>(state, [](auto& v) { std::sort(v.begin(), v.end()); });
+}
+
+#ifdef HPC_HAVE_PARALLEL_STL
+static void BM_Sort_F64_StdPar(benchmark::State& state) {
+    run_sort<double>(state, [](auto& v) { std::sort(std::execution::par, v.begin(), v.end()); });
+}
+#endif
+
+static void BM_Sort_F64_Radix(benchmark::State& state) {
+    const Backend backend = backend_arg(state);
+    run_sort<double>(state, [backend](auto& v) { hpc::parallel::radix_sort(v.begin(), v.end(), backend); });
+}
+
+// ----------------------------------------------------------------------------
+// Inclusive scan
+// ----------------------------------------------------------------------------
+
+static void BM_Scan_StdInclusive(benchmark::State& state) {
+    const auto input = random_keys<int64_t>(static_cast<size_t>(state.range(0)));
+    std::vector<int64_t> out(input.size());
+    for (auto _ : state) {
+        std::inclusive_scan(input.begin(), input.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#ifdef HPC_HAVE_PARALLEL_STL
+static void BM_Scan_StdPar(benchmark::State& state) {
+    const auto input = random_keys<int64_t>(static_cast<size_t>(state.range(0)));
+    std::vector<int64_t> out(input.size());
+    for (auto _ : state) {
+        std::inclusive_scan(std::execution::par, input.begin(), input.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+#endif
+
+static void BM_Scan_Parallel(benchmark::State& state) {
+    const Backend backend = backend_arg(state);
+    const auto input = random_keys<int64_t>(static_cast<size_t>(state.range(0)));
+    std::vector<int64_t> out(input.size());
+    for (auto _ : state) {
+        hpc::parallel::inclusive_scan(input.begin(), input.end(), out.begin(), std::plus<>{}, backend);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// ----------------------------------------------------------------------------
+// Stable partition (keep keys below the median)
+// ----------------------------------------------------------------------------
+
+constexpr uint32_t PARTITION_PIVOT = UINT32_MAX / 2;
+
+static void BM_Partition_StdStable(benchmark::State& state) {
+    run_sort<uint32_t>(state, [](auto& v) {
+        std::stable_partition(v.begin(), v.end(), [](uint32_t x) { return x < PARTITION_PIVOT; });
+    });
+}
+
+#ifdef HPC_HAVE_PARALLEL_STL
+static void BM_Partition_StdPar(benchmark::State& state) {
+    run_sort<uint32_t>(state, [](auto& v) {
+        std::stable_partition(std::execution::par, v.begin(), v.end(),
+                              [](uint32_t x) { return x < PARTITION_PIVOT; });
+    });
+}
+#endif
+
+static void BM_Partition_Parallel(benchmark::State& state) {
+    const Backend backend = backend_arg(state);
+    run_sort<uint32_t>(state, [backend](auto& v) {
+        hpc::parallel::stable_partition(v.begin(), v.end(),
+                                        [](uint32_t x) { return x < PARTITION_PIVOT; }, backend);
+    });
+}
+
+// Sizes 1M and 16M; hpc::parallel rows additionally take the backend
+void sizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1 << 20)->Arg(1 << 24);
+}
+
+void sizes_and_backends(benchmark::internal::Benchmark* b) {
+    for (int64_t n : {int64_t{1} << 20, int64_t{1} << 24}) {
+        b->Args({n, static_cast<int64_t>(Backend::ThreadPool)});
+#ifdef _OPENMP
+        b->Args({n, static_cast<int64_t>(Backend::OpenMP)});
+#endif
+    }
+}
+
+BENCHMARK(BM_Sort_U32_StdSort)->Apply(sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+#ifdef HPC_HAVE_PARALLEL_STL
+BENCHMARK(BM_Sort_U32_StdPar)->Apply(sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+#endif
+BENCHMARK(BM_Sort_U32_Radix)->Apply(sizes_and_backends)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Sort_U32_Sample)->Apply(sizes_and_backends)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_Sort_F64_StdSort)->Apply(sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+#ifdef HPC_HAVE_PARALLEL_STL
+BENCHMARK(BM_Sort_F64_StdPar)->Apply(sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+#endif
+BENCHMARK(BM_Sort_F64_Radix)->Apply(sizes_and_backends)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_Scan_StdInclusive)->Apply(sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+#ifdef HPC_HAVE_PARALLEL_STL
+BENCHMARK(BM_Scan_StdPar)->Apply(sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+#endif
+BENCHMARK(BM_Scan_Parallel)->Apply(sizes_and_backends)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_Partition_StdStable)->Apply(sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+#ifdef HPC_HAVE_PARALLEL_STL
+BENCHMARK(BM_Partition_StdPar)->Apply(sizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+#endif
+BENCHMARK(BM_Partition_Parallel)->Apply(sizes_and_backends)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,171 @@
+/**
+ * @file rw_lock_bench.cpp
+ * @brief Read throughput scaling of exclusive, reader-writer and seq locks
+ *
+ * Each thread performs a fixed number of operations on a shared
+ * RouteConfig; a configurable fraction of them (per mille) are writes.
+ * Arguments: {threads, writes per 1000 operations}.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/rw_lock.hpp"
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace hpc::concurrency;
+
+constexpr int64_t OPS_PER_THREAD = 200000;
+
+struct RouteConfig {
+    int64_t generation;
+    int64_t weights[3];
+};
+
+/// Exclusive lock for both reads and writes
+struct SpinLockPolicy {
+    SpinLock lock;
+    RouteConfig config{};
+
+    int64_t read() {
+        SpinLockGuard guard(lock);
+        return config.weights[0];
+    }
+
+    void write(int64_t g) {
+        SpinLockGuard guard(lock);
+        config.generation = g;
+        config.weights[0] = g;
+    }
+};
+
+/// Standard library reader-writer lock
+struct SharedMutexPolicy {
+    std::shared_mutex lock;
+    RouteConfig config{};
+
+    int64_t read() {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        return config.weights[0];
+    }
+
+    void write(int64_t g) {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        config.generation = g;
+        config.weights[0] = g;
+    }
+};
+
+/// Reader-writer spin lock with per-slot reader counters
+struct RWSpinLockPolicy {
+    RWSpinLock lock;
+    RouteConfig config{};
+
+    int64_t read() {
+        std::shared_lock<RWSpinLock> guard(lock);
+        return config.weights[0];
+    }
+
+    void write(int64_t g) {
+        std::unique_lock<RWSpinLock> guard(lock);
+        config.generation = g;
+        config.weights[0] = g;
+    }
+};
+
+/// Sequence lock: readers never write shared memory
+struct SeqLockPolicy {
+    SeqLock<RouteConfig> lock;
+
+    int64_t read() {
+        return lock.load().weights[0];
+    }
+
+    void write(int64_t g) {
+        RouteConfig config{};
+        config.generation = g;
+        config.weights[0] = g;
+        lock.store(config);
+    }
+};
+
+template<typename Policy>
+void run_mixed_workload(benchmark::State& state) {
+    const int num_threads = static_cast<int>(state.range(0));
+    const int64_t writes_per_mille = state.range(1);
+
+    Policy policy;
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        threads.reserve(static_cast<size_t>(num_threads));
+
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&policy, writes_per_mille]() {
+                int64_t sum = 0;
+                for (int64_t i = 0; i < OPS_PER_THREAD; ++i) {
+                    if (i % 1000 < writes_per_mille) {
+                        policy.write(i);
+                    } else {
+                        sum += policy.read();
+                    }
+                }
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_threads * OPS_PER_THREAD);
+}
+
+static void BM_RWLock_SpinLock(benchmark::State& state) {
+    run_mixed_workload<SpinLockPolicy>(state);
+}
+
+static void BM_RWLock_SharedMutex(benchmark::State& state) {
+    run_mixed_workload<SharedMutexPolicy>(state);
+}
+
+static void BM_RWLock_RWSpinLock(benchmark::State& state) {
+    run_mixed_workload<RWSpinLockPolicy>(state);
+}
+
+static void BM_RWLock_SeqLock(benchmark::State& state) {
+    run_mixed_workload<SeqLockPolicy>(state);
+}
+
+// Threads x {read-only, 0.1%, 1%, 10% writes}
+BENCHMARK(BM_RWLock_SpinLock)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1, 10, 100}})
+    ->ArgNames({"threads", "writes_per_mille"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_RWLock_SharedMutex)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1, 10, 100}})
+    ->ArgNames({"threads", "writes_per_mille"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_RWLock_RWSpinLock)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1, 10, 100}})
+    ->ArgNames({"threads", "writes_per_mille"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_RWLock_SeqLock)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1, 10, 100}})
+    ->ArgNames({"threads", "writes_per_mille"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
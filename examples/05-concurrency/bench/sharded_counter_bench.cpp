@@ -0,0 +1,151 @@
+/**
+ * @file sharded_counter_bench.cpp
+ * @brief Increment throughput: AlignedCounter vs sharded counters
+ *
+ * Thread counts run from 1 up to all hardware threads.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/sharded_counter.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace hpc::concurrency;
+
+constexpr int64_t INCREMENTS_PER_THREAD = 200000;
+
+/// 1, 2, 4, ... up to and including hardware_concurrency()
+void thread_counts(benchmark::internal::Benchmark* b) {
+    const int max_threads = static_cast<int>(hardware_concurrency());
+    for (int t = 1; t < max_threads; t *= 2) {
+        b->Arg(t);
+    }
+    b->Arg(max_threads);
+}
+
+template<typename Counter, typename Increment>
+void run_increments(benchmark::State& state, Counter& counter, Increment&& increment) {
+    const int num_threads = static_cast<int>(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        threads.reserve(static_cast<size_t>(num_threads));
+
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&counter, &increment]() {
+                for (int64_t i = 0; i < INCREMENTS_PER_THREAD; ++i) {
+                    increment(counter, i);
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_threads * INCREMENTS_PER_THREAD);
+}
+
+static void BM_Counter_Aligned(benchmark::State& state) {
+    AlignedCounter counter;
+    run_increments(state, counter, [](AlignedCounter& c, int64_t) {
+        c.increment(std::memory_order_relaxed);
+    });
+    benchmark::DoNotOptimize(counter.load());
+}
+
+static void BM_Counter_ShardedPerCpu(benchmark::State& state) {
+    ShardedCounter<DEFAULT_COUNTER_SHARDS, PerCpuShard> counter;
+    run_increments(state, counter, [](auto& c, int64_t) { c.increment(); });
+    benchmark::DoNotOptimize(counter.read_exact());
+}
+
+static void BM_Counter_ShardedPerThread(benchmark::State& state) {
+    ShardedCounter<DEFAULT_COUNTER_SHARDS, PerThreadShard> counter;
+    run_increments(state, counter, [](auto& c, int64_t) { c.increment(); });
+    benchmark::DoNotOptimize(counter.read_exact());
+}
+
+static void BM_Gauge_Sharded(benchmark::State& state) {
+    ShardedGauge<> gauge;
+    run_increments(state, gauge, [](auto& g, int64_t i) {
+        if (i & 1) {
+            g.decrement();
+        } else {
+            g.increment();
+        }
+    });
+    benchmark::DoNotOptimize(gauge.read());
+}
+
+static void BM_Max_Sharded(benchmark::State& state) {
+    ShardedMax<> max;
+    run_increments(state, max, [](auto& m, int64_t i) { m.update(i); });
+    benchmark::DoNotOptimize(max.read());
+}
+
+static void BM_Histogram_Sharded(benchmark::State& state) {
+    auto histogram = std::make_unique<ShardedHistogram<>>();
+    run_increments(state, *histogram, [](auto& h, int64_t i) {
+        h.record(static_cast<uint64_t>(i & 0xFFFF));
+    });
+    benchmark::DoNotOptimize(histogram->count());
+}
+
+/// Cost of reading: exact scan of all slots vs cached total
+static void BM_Counter_ReadExact(benchmark::State& state) {
+    ShardedCounter<> counter;
+    counter.increment();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(counter.read_exact());
+    }
+}
+
+static void BM_Counter_ReadApprox(benchmark::State& state) {
+    ShardedCounter<> counter;
+    counter.increment();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(counter.read_approx());
+    }
+}
+
+BENCHMARK(BM_Counter_Aligned)
+    ->Apply(thread_counts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Counter_ShardedPerCpu)
+    ->Apply(thread_counts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Counter_ShardedPerThread)
+    ->Apply(thread_counts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Gauge_Sharded)
+    ->Apply(thread_counts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Max_Sharded)
+    ->Apply(thread_counts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Histogram_Sharded)
+    ->Apply(thread_counts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Counter_ReadExact);
+BENCHMARK(BM_Counter_ReadApprox);
+
+} // namespace
+
+BENCHMARK_MAIN();
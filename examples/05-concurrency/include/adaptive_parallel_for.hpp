@@ -0,0 +1,466 @@
+#pragma once
+
+/**
+ * @file adaptive_parallel_for.hpp
+ * @brief Self-tuning parallel loop scheduler (hpc::parallel)
+ *
+ * Picking schedule(static|dynamic|guided) and a chunk size by hand (see
+ * schedule_example in openmp_basics.cpp) only works for the workload you
+ * tried. adaptive_parallel_for picks them itself:
+ *
+ * 1. Profile: the first call at a call site runs with small dynamic chunks
+ *    and times every chunk
+ * 2. Decide from the per-chunk cost distribution:
+ *    - flat (low coefficient of variation)      -> Static
+ *    - a few chunks far above the mean (tail)   -> WorkStealing
+ *    - anything else (e.g. linear skew)         -> Dynamic
+ *    Chunk size targets TARGET_CHUNK_NS of work per grab, capped so every
+ *    thread still gets several chunks.
+ * 3. Remember: the decision lives in a LoopTuner keyed by the caller's
+ *    std::source_location
+ * 4. Re-tune: every call times its chunks. If the cost per iteration
+ *    moves by more than DRIFT_RATIO, the chunk costs classify differently,
+ *    or a Static loop becomes imbalanced, for DRIFT_PATIENCE calls in a
+ *    row, the next call profiles again.
+ *
+ * Loops run on hpc::concurrency::ThreadPool; parallel_for() exposes the
+ * three fixed schedules on the same runtime.
+ */
+
+#include "concurrency_utils.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <unordered_map>
+#include <vector>
+
+namespace hpc::parallel {
+
+using hpc::concurrency::ThreadPool;
+
+enum class Schedule {
+    Static,       ///< One contiguous block per worker
+    Dynamic,      ///< Shared counter, fixed-size chunks
+    WorkStealing  ///< Per-worker blocks, idle workers steal half of a victim's rest
+};
+
+inline const char* schedule_name(Schedule schedule) {
+    switch (schedule) {
+        case Schedule::Static: return "static";
+        case Schedule::Dynamic: return "dynamic";
+        case Schedule::WorkStealing: return "work-stealing";
+    }
+    return "unknown";
+}
+
+namespace detail {
+
+/// Work per chunk grab that amortizes the grab (an atomic or a lock)
+constexpr double TARGET_CHUNK_NS = 20000.0;
+/// Chunks per worker in the profiling run; also the chunk-size cap, so
+/// later runs can be compared with the profile at the same granularity
+constexpr size_t CHUNKS_PER_WORKER = 32;
+
+/// Per-chunk cost spread below which a static split is balanced enough.
+/// Independent noise averages out over CHUNKS_PER_WORKER chunks; trends
+/// such as a linear cost ramp stay above ~0.55 at any granularity.
+constexpr double STATIC_MAX_CV = 0.3;
+/// Max/mean chunk cost above which the load is dominated by a few outliers
+constexpr double STEAL_MIN_TAIL = 4.0;
+
+/// Cost-per-iteration change that counts as drift
+constexpr double DRIFT_RATIO = 2.0;
+/// Max/mean busy time across workers that counts as drift for Static
+constexpr double DRIFT_IMBALANCE = 1.5;
+/// Consecutive drifting calls before a re-tune
+constexpr unsigned int DRIFT_PATIENCE = 3;
+
+inline double now_ns() {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct alignas(hpc::concurrency::CACHE_LINE_SIZE) StealRange {
+    hpc::concurrency::SpinLock lock;
+    size_t lo = 0;
+    size_t hi = 0;
+};
+
+// The runners hand [lo, hi) ranges to range_body(w, lo, hi), w = worker index
+
+/// Static: worker w runs the w-th of num_workers contiguous blocks
+template<typename RangeBody>
+void run_static(size_t begin, size_t n, size_t w, size_t num_workers, RangeBody& range_body) {
+    range_body(w, begin + n * w / num_workers, begin + n * (w + 1) / num_workers);
+}
+
+/// Dynamic: grab [next, next + chunk) until the range is exhausted
+template<typename RangeBody>
+void run_dynamic(size_t w, size_t end, size_t chunk, std::atomic<size_t>& next,
+                 RangeBody& range_body) {
+    for (;;) {
+        const size_t lo = next.fetch_add(chunk, std::memory_order_relaxed);
+        if (lo >= end) {
+            return;
+        }
+        range_body(w, lo, std::min(lo + chunk, end));
+    }
+}
+
+/// Work stealing: drain the own range chunk by chunk, then steal the upper
+/// half of the first non-empty victim and continue
+template<typename RangeBody>
+void run_stealing(size_t w, size_t chunk, std::vector<StealRange>& ranges, RangeBody& range_body) {
+    const size_t num_workers = ranges.size();
+    StealRange& own = ranges[w];
+    for (;;) {
+        size_t lo;
+        size_t hi;
+        {
+            hpc::concurrency::SpinLockGuard guard(own.lock);
+            lo = own.lo;
+            hi = std::min(lo + chunk, own.hi);
+            own.lo = hi;
+        }
+        if (lo < hi) {
+            range_body(w, lo, hi);
+            continue;
+        }
+
+        bool stole = false;
+        for (size_t k = 1; k < num_workers && !stole; ++k) {
+            StealRange& victim = ranges[(w + k) % num_workers];
+            size_t steal_lo;
+            size_t steal_hi;
+            {
+                hpc::concurrency::SpinLockGuard guard(victim.lock);
+                if (victim.lo >= victim.hi) {
+                    continue;
+                }
+                steal_hi = victim.hi;
+                steal_lo = victim.hi - (victim.hi - victim.lo + 1) / 2;
+                victim.hi = steal_lo;
+            }
+            hpc::concurrency::SpinLockGuard guard(own.lock);
+            own.lo = steal_lo;
+            own.hi = steal_hi;
+            stole = true;
+        }
+        if (!stole) {
+            return;  // Work still in flight belongs to whoever stole it last
+        }
+    }
+}
+
+/// Run range_body over [begin, end) with the given schedule on pool
+template<typename RangeBody>
+void run_schedule(size_t begin, size_t end, Schedule schedule, size_t chunk, size_t workers,
+                  ThreadPool& pool, RangeBody& range_body) {
+    const size_t n = end - begin;
+    switch (schedule) {
+        case Schedule::Static:
+            pool.run(workers, [&](size_t w) { run_static(begin, n, w, workers, range_body); });
+            break;
+        case Schedule::Dynamic: {
+            std::atomic<size_t> next{begin};
+            pool.run(workers, [&](size_t w) { run_dynamic(w, end, chunk, next, range_body); });
+            break;
+        }
+        case Schedule::WorkStealing: {
+            std::vector<StealRange> ranges(workers);
+            for (size_t w = 0; w < workers; ++w) {
+                ranges[w].lo = begin + n * w / workers;
+                ranges[w].hi = begin + n * (w + 1) / workers;
+            }
+            pool.run(workers, [&](size_t w) { run_stealing(w, chunk, ranges, range_body); });
+            break;
+        }
+    }
+}
+
+/// Largest chunk for n iterations: CHUNKS_PER_WORKER chunks per worker
+inline size_t max_chunk(size_t n, size_t num_workers) {
+    return std::max<size_t>(1, n / (num_workers * CHUNKS_PER_WORKER));
+}
+
+/// Chunk size for a loop of n iterations costing ns_per_iter each
+inline size_t chunk_for(double ns_per_iter, size_t n, size_t num_workers) {
+    const double ideal = TARGET_CHUNK_NS / std::max(ns_per_iter, 1e-3);
+    return std::clamp<size_t>(static_cast<size_t>(ideal), 1, max_chunk(n, num_workers));
+}
+
+} // namespace detail
+
+/**
+ * Run body(i) for i in [begin, end) with a fixed schedule
+ *
+ * @param chunk Iterations per grab for Dynamic and WorkStealing; 0 picks
+ *              n / (workers * CHUNKS_PER_WORKER). Ignored for Static.
+ */
+template<typename Body>
+void parallel_for(size_t begin, size_t end, Body&& body, Schedule schedule, size_t chunk = 0,
+                  ThreadPool& pool = ThreadPool::global()) {
+    if (end <= begin) {
+        return;
+    }
+    const size_t workers = std::min<size_t>(pool.size(), end - begin);
+    if (chunk == 0) {
+        chunk = detail::max_chunk(end - begin, workers);
+    }
+    auto range_body = [&body](size_t, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            body(i);
+        }
+    };
+    detail::run_schedule(begin, end, schedule, chunk, workers, pool, range_body);
+}
+
+// ============================================================================
+// Tuning
+// ============================================================================
+
+/// Schedule chosen from a profiling run, with the statistics behind it
+struct LoopDecision {
+    Schedule schedule = Schedule::Dynamic;
+    double ns_per_iter = 0.0;  ///< Mean work per iteration (sum over workers)
+    double cv = 0.0;           ///< Std-dev / mean of the per-chunk cost
+    double tail = 0.0;         ///< Max / mean of the per-chunk cost
+};
+
+/**
+ * Choose a schedule from per-chunk costs (nanoseconds per iteration of
+ * each profiled chunk)
+ */
+inline LoopDecision decide_schedule(const std::vector<double>& chunk_costs) {
+    LoopDecision decision;
+    if (chunk_costs.empty()) {
+        return decision;
+    }
+    double sum = 0.0;
+    double max = 0.0;
+    for (double c : chunk_costs) {
+        sum += c;
+        max = std::max(max, c);
+    }
+    const double mean = sum / static_cast<double>(chunk_costs.size());
+    double var = 0.0;
+    for (double c : chunk_costs) {
+        var += (c - mean) * (c - mean);
+    }
+    var /= static_cast<double>(chunk_costs.size());
+
+    decision.ns_per_iter = mean;
+    decision.cv = mean > 0.0 ? std::sqrt(var) / mean : 0.0;
+    decision.tail = mean > 0.0 ? max / mean : 1.0;
+
+    if (decision.cv < detail::STATIC_MAX_CV) {
+        decision.schedule = Schedule::Static;
+    } else if (decision.tail > detail::STEAL_MIN_TAIL) {
+        decision.schedule = Schedule::WorkStealing;
+    } else {
+        decision.schedule = Schedule::Dynamic;
+    }
+    return decision;
+}
+
+/**
+ * Remembered schedule for one loop (normally one call site)
+ *
+ * Thread-safe: concurrent run() calls on the same tuner are fine, the pool
+ * serializes them anyway.
+ */
+class LoopTuner {
+public:
+    template<typename Body>
+    void run(size_t begin, size_t end, Body&& body, ThreadPool& pool = ThreadPool::global()) {
+        if (end <= begin) {
+            return;
+        }
+        const size_t n = end - begin;
+        const size_t workers = std::min<size_t>(pool.size(), n);
+
+        bool tuned;
+        LoopDecision used;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tuned = tuned_;
+            used = decision_;
+        }
+
+        // Every chunk is timed: two clock reads per ~TARGET_CHUNK_NS of work
+        std::vector<std::vector<Sample>> samples(workers);
+        auto timed_range = [&](size_t w, size_t lo, size_t hi) {
+            const double start = detail::now_ns();
+            for (size_t i = lo; i < hi; ++i) {
+                body(i);
+            }
+            samples[w].push_back({lo, hi - lo, detail::now_ns() - start});
+        };
+
+        const size_t bin = detail::max_chunk(n, workers);
+        if (!tuned) {
+            // Profile: dynamic, one chunk per bin
+            detail::run_schedule(begin, end, Schedule::Dynamic, bin, workers, pool, timed_range);
+            const LoopDecision decision = decide_schedule(bin_costs(samples, begin, n, bin));
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (tuned_runs_++ > 0) {
+                ++retunes_;
+            }
+            decision_ = decision;
+            tuned_ = true;
+            drift_streak_ = 0;
+            return;
+        }
+
+        const size_t chunk = detail::chunk_for(used.ns_per_iter, n, workers);
+        detail::run_schedule(begin, end, used.schedule, chunk, workers, pool, timed_range);
+        observe(used, samples, begin, n, bin);
+    }
+
+    /// Last decision (default-constructed until the first call)
+    LoopDecision decision() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return decision_;
+    }
+
+    /// Profiling runs after the first one, triggered by drift
+    unsigned int retunes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return retunes_;
+    }
+
+    /// Forget the decision; the next call profiles again
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tuned_ = false;
+        drift_streak_ = 0;
+    }
+
+private:
+    struct Sample {
+        size_t lo;
+        size_t count;
+        double ns;
+    };
+
+    /// Per-bin cost per iteration; chunks are attributed to the bin of their start
+    static std::vector<double> bin_costs(const std::vector<std::vector<Sample>>& samples,
+                                         size_t begin, size_t n, size_t bin) {
+        const size_t num_bins = (n + bin - 1) / bin;
+        std::vector<double> ns(num_bins, 0.0);
+        std::vector<size_t> iters(num_bins, 0);
+        for (const auto& worker : samples) {
+            for (const Sample& s : worker) {
+                const size_t k = (s.lo - begin) / bin;
+                ns[k] += s.ns;
+                iters[k] += s.count;
+            }
+        }
+        std::vector<double> costs;
+        costs.reserve(num_bins);
+        for (size_t k = 0; k < num_bins; ++k) {
+            if (iters[k] > 0) {
+                costs.push_back(ns[k] / static_cast<double>(iters[k]));
+            }
+        }
+        return costs;
+    }
+
+    void observe(const LoopDecision& used, const std::vector<std::vector<Sample>>& samples,
+                 size_t begin, size_t n, size_t bin) {
+        std::vector<double> busy(samples.size(), 0.0);
+        for (size_t w = 0; w < samples.size(); ++w) {
+            for (const Sample& s : samples[w]) {
+                busy[w] += s.ns;
+            }
+        }
+        double total = 0.0;
+        double max = 0.0;
+        for (double b : busy) {
+            total += b;
+            max = std::max(max, b);
+        }
+
+        // Mean cost moved
+        const double ratio = (total / static_cast<double>(n)) / std::max(used.ns_per_iter, 1e-3);
+        bool drifted = ratio > detail::DRIFT_RATIO || ratio < 1.0 / detail::DRIFT_RATIO;
+
+        if (used.schedule == Schedule::Static) {
+            // One chunk per worker: only the imbalance is observable
+            if (busy.size() > 1 && total > 0.0) {
+                const double mean = total / static_cast<double>(busy.size());
+                drifted = drifted || max / mean > detail::DRIFT_IMBALANCE;
+            }
+        } else {
+            // Chunks are no larger than a profiling bin: classify the shape again
+            drifted = drifted || decide_schedule(bin_costs(samples, begin, n, bin)).schedule != used.schedule;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        drift_streak_ = drifted ? drift_streak_ + 1 : 0;
+        if (drift_streak_ >= detail::DRIFT_PATIENCE) {
+            tuned_ = false;
+        }
+    }
+
+    mutable std::mutex mutex_;
+    LoopDecision decision_;
+    bool tuned_ = false;
+    unsigned int tuned_runs_ = 0;
+    unsigned int retunes_ = 0;
+    unsigned int drift_streak_ = 0;
+};
+
+namespace detail {
+
+struct CallSite {
+    const char* file;
+    uint_least32_t line;
+    uint_least32_t column;
+
+    bool operator==(const CallSite&) const = default;
+};
+
+struct CallSiteHash {
+    size_t operator()(const CallSite& site) const {
+        return std::hash<const void*>{}(site.file) ^ (size_t{site.line} << 16) ^ size_t{site.column};
+    }
+};
+
+} // namespace detail
+
+/// Tuner for a call site; created on first use and kept for the process lifetime
+inline LoopTuner& tuner_for(const std::source_location& site) {
+    static std::mutex mutex;
+    static std::unordered_map<detail::CallSite, std::unique_ptr<LoopTuner>, detail::CallSiteHash> tuners;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = tuners[detail::CallSite{site.file_name(), site.line(), site.column()}];
+    if (!slot) {
+        slot = std::make_unique<LoopTuner>();
+    }
+    return *slot;
+}
+
+/**
+ * Run body(i) for i in [begin, end) in parallel with a schedule tuned for
+ * this call site
+ *
+ * @code
+ * adaptive_parallel_for(0, n, [&](size_t i) { out[i] = f(in[i]); });
+ * @endcode
+ */
+template<typename Body>
+void adaptive_parallel_for(size_t begin, size_t end, Body&& body,
+                           std::source_location site = std::source_location::current()) {
+    tuner_for(site).run(begin, end, body);
+}
+
+} // namespace hpc::parallel
@@ -0,0 +1,395 @@
+#pragma once
+
+/**
+ * @file barrier.hpp
+ * @brief Spin-then-block group synchronization: barriers, latch, phaser
+ *
+ * std::barrier and std::latch go to the kernel quickly. In a
+ * bulk-synchronous loop (update all particles, barrier, repeat) the
+ * threads arrive within a few microseconds of each other, so a futex
+ * sleep and wake-up per step can cost more than the step itself.
+ *
+ * Every primitive here waits the same way: spin on the word for about
+ * SPIN_BUDGET_NS (the pause count is calibrated once per process), then
+ * sleep in an atomic wait (futex on Linux). Wakers only pay for a
+ * notify when somebody is actually asleep.
+ *
+ *   SpinBarrier           central counter, sense-reversing: one RMW per
+ *                         arrival, everyone spins on a single phase word
+ *   DisseminationBarrier  ceil(log2 P) rounds of point-to-point flags; no
+ *                         shared hot counter, for high core counts
+ *   Latch                 count down to zero, reusable via reset()
+ *   Phaser                barrier whose parties register and deregister
+ *                         between phases; arrive() does not block
+ */
+
+#include "concurrency_utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace hpc::concurrency {
+
+namespace detail {
+
+/// Spin for about one futex sleep/wake round trip before blocking
+constexpr double SPIN_BUDGET_NS = 4000.0;
+
+inline uint32_t calibrate_spin_limit() {
+    if (hardware_concurrency() == 1) {
+        return 0;  // Whoever we wait for cannot run while we spin
+    }
+    constexpr int PROBE = 2000;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PROBE; ++i) {
+        cpu_pause();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count() / PROBE;
+    return static_cast<uint32_t>(std::clamp(SPIN_BUDGET_NS / std::max(ns, 0.1), 64.0, 1048576.0));
+}
+
+/// Pause iterations worth SPIN_BUDGET_NS, measured on first use
+inline uint32_t spin_limit() {
+    static const uint32_t limit = calibrate_spin_limit();
+    return limit;
+}
+
+/// Spinning only helps if every party can run at once
+inline uint32_t spin_limit_for(size_t parties) {
+    return parties <= hardware_concurrency() ? spin_limit() : 0;
+}
+
+/**
+ * Atomic word that waiters spin on, then sleep on
+ *
+ * Every change that a waiter might be waiting for must be made with a
+ * seq_cst RMW or store and followed by wake(): either the waker sees the
+ * sleeper's registration or the sleeper's recheck sees the change.
+ */
+template<typename T>
+struct WaitWord {
+    std::atomic<T> value{0};
+    std::atomic<uint32_t> sleepers{0};
+
+    /// Block until done(value) holds; returns the value that satisfied it
+    template<typename Done>
+    T wait_until(Done done, uint32_t spins) {
+        T v = value.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < spins && !done(v); ++i) {
+            cpu_pause();
+            v = value.load(std::memory_order_acquire);
+        }
+        while (!done(v)) {
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            v = value.load(std::memory_order_seq_cst);
+            if (!done(v)) {
+                value.wait(v, std::memory_order_seq_cst);
+                v = value.load(std::memory_order_acquire);
+            }
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return v;
+    }
+
+    void wake() {
+        if (sleepers.load(std::memory_order_seq_cst) > 0) {
+            value.notify_all();
+        }
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// Central sense-reversing barrier
+// ============================================================================
+
+/**
+ * Barrier for a fixed number of threads
+ *
+ * The sense is the low bit of a phase counter: a thread reads the phase,
+ * decrements the arrival count, and waits for the phase to move on. The
+ * last arrival resets the count and then flips the phase, so the barrier
+ * is immediately reusable. A full counter (rather than one bit) keeps a
+ * sleeper from missing a flip-and-flip-back while it is descheduled.
+ *
+ * All P arrivals hit one cache line, so the cost grows linearly with P;
+ * above a few dozen threads prefer DisseminationBarrier.
+ */
+class SpinBarrier {
+public:
+    explicit SpinBarrier(size_t parties)
+        : parties_(static_cast<uint32_t>(parties)),
+          spins_(detail::spin_limit_for(parties)) {
+        assert(parties > 0);
+        count_.store(parties_, std::memory_order_relaxed);
+    }
+
+    SpinBarrier(const SpinBarrier&) = delete;
+    SpinBarrier& operator=(const SpinBarrier&) = delete;
+
+    /// @return true for exactly one thread per phase (the last to arrive)
+    bool arrive_and_wait() {
+        // Cannot be stale: the phase only moves once we have arrived
+        const uint32_t phase = phase_.value.load(std::memory_order_acquire);
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            count_.store(parties_, std::memory_order_relaxed);
+            phase_.value.store(phase + 1, std::memory_order_seq_cst);
+            phase_.wake();
+            return true;
+        }
+        phase_.wait_until([phase](uint32_t v) { return v != phase; }, spins_);
+        return false;
+    }
+
+    /// Same interface as DisseminationBarrier; the id is not needed here
+    bool arrive_and_wait(size_t /*thread_id*/) {
+        return arrive_and_wait();
+    }
+
+    size_t parties() const {
+        return parties_;
+    }
+
+private:
+    const uint32_t parties_;
+    const uint32_t spins_;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> count_{0};
+    alignas(CACHE_LINE_SIZE) detail::WaitWord<uint32_t> phase_;
+};
+
+// ============================================================================
+// Dissemination barrier
+// ============================================================================
+
+/**
+ * Barrier for threads 0..P-1 that each pass their own id
+ *
+ * In round r thread i signals thread (i + 2^r) mod P and waits for the
+ * signal from (i - 2^r) mod P. After ceil(log2 P) rounds every thread has
+ * transitively heard from every other one. Each thread only ever waits on
+ * flags in its own cache line, and no line is written by more than one
+ * thread per round, so there is no hot spot: the critical path is log2 P
+ * cache-line transfers instead of P.
+ *
+ * Flags hold the episode number that set them. A partner can be at most
+ * one episode ahead, so "flag != episode - 1" means we were signalled.
+ */
+class DisseminationBarrier {
+public:
+    static constexpr size_t MAX_ROUNDS = 16;
+
+    explicit DisseminationBarrier(size_t parties)
+        : parties_(parties),
+          rounds_(rounds_for(parties)),
+          spins_(detail::spin_limit_for(parties)),
+          nodes_(parties) {
+        assert(parties > 0 && rounds_ <= MAX_ROUNDS);
+    }
+
+    DisseminationBarrier(const DisseminationBarrier&) = delete;
+    DisseminationBarrier& operator=(const DisseminationBarrier&) = delete;
+
+    /// @return true for exactly one thread per phase (thread 0)
+    bool arrive_and_wait(size_t thread_id) {
+        assert(thread_id < parties_);
+        Node& self = nodes_[thread_id];
+        const uint32_t episode = ++self.episode;
+        size_t distance = 1;
+        for (size_t r = 0; r < rounds_; ++r, distance *= 2) {
+            auto& partner = nodes_[(thread_id + distance) % parties_].flags[r];
+            partner.value.store(episode, std::memory_order_seq_cst);
+            partner.wake();
+            self.flags[r].wait_until([episode](uint32_t v) { return v != episode - 1; }, spins_);
+        }
+        return thread_id == 0;
+    }
+
+    size_t parties() const {
+        return parties_;
+    }
+
+    size_t rounds() const {
+        return rounds_;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Node {
+        detail::WaitWord<uint32_t> flags[MAX_ROUNDS];
+        uint32_t episode = 0;  // Touched only by the owning thread
+    };
+
+    static size_t rounds_for(size_t parties) {
+        size_t rounds = 0;
+        while ((size_t{1} << rounds) < parties) {
+            ++rounds;
+        }
+        return rounds;
+    }
+
+    const size_t parties_;
+    const size_t rounds_;
+    const uint32_t spins_;
+    std::vector<Node> nodes_;
+};
+
+// ============================================================================
+// Latch
+// ============================================================================
+
+/**
+ * Single-use countdown like std::latch, but reusable: reset() re-arms it
+ * once every waiter of the previous round has returned
+ */
+class Latch {
+public:
+    explicit Latch(uint32_t count = 0) {
+        count_.value.store(count, std::memory_order_relaxed);
+    }
+
+    Latch(const Latch&) = delete;
+    Latch& operator=(const Latch&) = delete;
+
+    void count_down(uint32_t n = 1) {
+        const uint32_t before = count_.value.fetch_sub(n, std::memory_order_seq_cst);
+        assert(before >= n);
+        if (before == n) {
+            count_.wake();
+        }
+    }
+
+    bool try_wait() const {
+        return count_.value.load(std::memory_order_acquire) == 0;
+    }
+
+    void wait() {
+        count_.wait_until([](uint32_t v) { return v == 0; }, detail::spin_limit());
+    }
+
+    void arrive_and_wait(uint32_t n = 1) {
+        count_down(n);
+        wait();
+    }
+
+    /// Re-arm; no thread may still be inside wait()
+    void reset(uint32_t count) {
+        count_.value.store(count, std::memory_order_release);
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) detail::WaitWord<uint32_t> count_;
+};
+
+// ============================================================================
+// Phaser
+// ============================================================================
+
+/**
+ * Reusable barrier with a dynamic party count (after java.util.concurrent.Phaser)
+ *
+ * Phase, registered parties and unarrived parties share one 64-bit word,
+ * so registration, arrival and the phase advance are each a single CAS
+ * and a registration is counted in exactly one phase: the current one if
+ * it lands before the last arrival, the next one otherwise.
+ *
+ * arrive() never blocks, which lets producers signal "my part of phase p
+ * is done" and move on, while consumers await_advance(p).
+ */
+class Phaser {
+public:
+    static constexpr uint32_t MAX_PARTIES = 0xffff;
+
+    explicit Phaser(uint32_t parties = 0) {
+        assert(parties <= MAX_PARTIES);
+        state_.value.store(pack(0, parties, parties), std::memory_order_relaxed);
+    }
+
+    Phaser(const Phaser&) = delete;
+    Phaser& operator=(const Phaser&) = delete;
+
+    /// Add a party; @return the phase it must first arrive at
+    uint32_t register_party() {
+        uint64_t s = state_.value.load(std::memory_order_acquire);
+        for (;;) {
+            assert(parties_of(s) < MAX_PARTIES);
+            if (state_.value.compare_exchange_weak(s, s + ONE_PARTY + 1, std::memory_order_seq_cst)) {
+                return phase_of(s);
+            }
+        }
+    }
+
+    /// Arrive without waiting; @return the phase arrived at
+    uint32_t arrive() {
+        return do_arrive(false);
+    }
+
+    /// Arrive and leave: later phases no longer wait for this party
+    uint32_t arrive_and_deregister() {
+        return do_arrive(true);
+    }
+
+    /// @return the new phase number
+    uint32_t arrive_and_await_advance() {
+        return await_advance(arrive());
+    }
+
+    /// Wait until phase @p phase has completed; @return the current phase
+    uint32_t await_advance(uint32_t phase) {
+        const uint64_t s = state_.wait_until(
+            [phase](uint64_t v) { return phase_of(v) != phase; }, detail::spin_limit());
+        return phase_of(s);
+    }
+
+    uint32_t phase() const {
+        return phase_of(state_.value.load(std::memory_order_acquire));
+    }
+
+    uint32_t registered_parties() const {
+        return parties_of(state_.value.load(std::memory_order_acquire));
+    }
+
+    uint32_t unarrived_parties() const {
+        return unarrived_of(state_.value.load(std::memory_order_acquire));
+    }
+
+private:
+    // [ phase : 32 | parties : 16 | unarrived : 16 ]
+    static constexpr uint64_t ONE_PARTY = uint64_t{1} << 16;
+
+    static constexpr uint64_t pack(uint32_t phase, uint32_t parties, uint32_t unarrived) {
+        return (uint64_t{phase} << 32) | (uint64_t{parties} << 16) | unarrived;
+    }
+    static constexpr uint32_t phase_of(uint64_t s) { return static_cast<uint32_t>(s >> 32); }
+    static constexpr uint32_t parties_of(uint64_t s) { return static_cast<uint32_t>(s >> 16) & 0xffff; }
+    static constexpr uint32_t unarrived_of(uint64_t s) { return static_cast<uint32_t>(s) & 0xffff; }
+
+    uint32_t do_arrive(bool deregister) {
+        uint64_t s = state_.value.load(std::memory_order_acquire);
+        for (;;) {
+            assert(unarrived_of(s) > 0);
+            const bool last = unarrived_of(s) == 1;
+            uint64_t next;
+            if (last) {
+                // Advance and re-arm for the parties still registered
+                const uint32_t parties = parties_of(s) - (deregister ? 1 : 0);
+                next = pack(phase_of(s) + 1, parties, parties);
+            } else {
+                next = s - 1 - (deregister ? ONE_PARTY : 0);
+            }
+            if (state_.value.compare_exchange_weak(s, next, std::memory_order_seq_cst)) {
+                if (last) {
+                    state_.wake();
+                }
+                return phase_of(s);
+            }
+        }
+    }
+
+    alignas(CACHE_LINE_SIZE) detail::WaitWord<uint64_t> state_;
+};
+
+} // namespace hpc::concurrency
@@ -1,11 +1,16 @@
 #pragma once
 
+#include "topology.hpp"
 #include <atomic>
 #include <thread>
 #include <vector>
 #include <functional>
 #include <chrono>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
 namespace hpc::concurrency {
 
 /// Get the number of hardware threads
@@ -17,6 +22,18 @@ inline unsigned int hardware_concurrency() {
 /// Cache line size for alignment
 constexpr size_t CACHE_LINE_SIZE = 64;
 
+/// Hint to the CPU that the caller is busy-waiting (reduces power and
+/// pipeline flushes on spin-loop exit, and yields to the SMT sibling)
+inline void cpu_pause() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
 /// Aligned atomic counter to avoid false sharing
 struct alignas(CACHE_LINE_SIZE) AlignedCounter {
     std::atomic<int64_t> value{0};
@@ -96,15 +113,20 @@ private:
 };
 
 /// Run a function on multiple threads and measure time
+/// @param placement Pin thread i per CpuTopology::system() before calling func(i)
 template<typename Func>
-double run_parallel(Func&& func, unsigned int num_threads) {
+double run_parallel(Func&& func, unsigned int num_threads,
+                    Placement placement = Placement::None) {
     std::vector<std::thread> threads;
     threads.reserve(num_threads);
     
     auto start = std::chrono::high_resolution_clock::now();
     
     for (unsigned int i = 0; i < num_threads; ++i) {
-        threads.emplace_back(std::forward<Func>(func), i);
+        threads.emplace_back([func, i, placement]() mutable {
+            pin_current_thread(placement, i);
+            func(i);
+        });
     }
     
     for (auto& t : threads) {
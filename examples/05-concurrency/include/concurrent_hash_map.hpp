@@ -0,0 +1,318 @@
+#pragma once
+
+/**
+ * @file concurrent_hash_map.hpp
+ * @brief Open-addressing concurrent hash map with lock-free lookups
+ *
+ * Wrapping std::unordered_map in a SpinLock serializes every lookup on one
+ * cache line. ConcurrentHashMap instead splits the key space into shards,
+ * each a linear-probing table of atomic (key, value) slots:
+ *
+ * - find() never takes a lock, never waits and never writes shared memory.
+ *   It reads the shard's sequence number, probes, and re-checks the
+ *   sequence number (the SeqLock pattern). erase() bumps the number before
+ *   each slot it overwrites or clears, so find() retries only when an entry
+ *   left a slot during its probe; an eraser preempted mid-shift leaves the
+ *   number still and blocks no reader.
+ * - insert()/erase() take the shard's SpinLock, so writers to different
+ *   shards proceed in parallel.
+ * - erase() uses backward-shift deletion: later entries of the probe
+ *   cluster are moved back into the hole, so no tombstones accumulate and
+ *   probe lengths stay short under insert/erase churn. Each entry is copied
+ *   into the hole before its old slot is reused, so every key stays
+ *   reachable at every step of the shift.
+ * - Resizing is per shard: a shard that passes the load factor is rehashed
+ *   into a table twice the size while readers keep using the old one. The
+ *   old table is retired through an EpochDomain. Each resize touches only
+ *   1/Shards of the map and blocks only that shard's writers.
+ */
+
+#include "concurrency_utils.hpp"
+#include "memory_reclamation.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+namespace hpc::concurrency {
+
+/**
+ * Concurrent hash map for integral keys and small trivially copyable values
+ *
+ * @tparam K      Integral key type; EMPTY_KEY (the maximum value) is reserved
+ * @tparam V      Trivially copyable value type with lock-free std::atomic<V>
+ * @tparam Shards Number of independently locked sub-tables (power of 2)
+ */
+template<typename K, typename V, size_t Shards = 64>
+class ConcurrentHashMap {
+    static_assert(std::is_integral_v<K>, "ConcurrentHashMap requires integral keys");
+    static_assert(std::is_trivially_copyable_v<V> && std::atomic<V>::is_always_lock_free,
+                  "ConcurrentHashMap requires values that fit a lock-free atomic");
+    static_assert((Shards & (Shards - 1)) == 0, "Shards must be power of 2");
+
+public:
+    static constexpr K EMPTY_KEY = std::numeric_limits<K>::max();
+
+    /// Maximum fill ratio before a shard doubles (linear probing degrades past ~0.7)
+    static constexpr double MAX_LOAD_FACTOR = 0.5;
+
+    explicit ConcurrentHashMap(size_t initial_capacity = 1024) {
+        size_t per_shard = std::bit_ceil(std::max<size_t>(
+            16, static_cast<size_t>(static_cast<double>(initial_capacity) / MAX_LOAD_FACTOR) / Shards));
+        for (auto& shard : shards_) {
+            shard.table.store(new Table(per_shard), std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    ~ConcurrentHashMap() {
+        for (auto& shard : shards_) {
+            delete shard.table.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Lock-free lookup
+     * @return the value, or std::nullopt if the key is absent
+     */
+    std::optional<V> find(K key) const {
+        assert(key != EMPTY_KEY);
+        const uint64_t h = hash(key);
+        const Shard& shard = shards_[shard_index(h)];
+        EpochDomain::Guard guard(domain_);
+
+        for (;;) {
+            const uint64_t seq0 = shard.seq.load(std::memory_order_acquire);
+            const Table* table = shard.table.load(std::memory_order_acquire);
+            std::optional<V> result;
+            for (size_t i = h & table->mask;; i = (i + 1) & table->mask) {
+                const K k = table->slots[i].key.load(std::memory_order_acquire);
+                if (k == key) {
+                    result = table->slots[i].value.load(std::memory_order_acquire);
+                    break;
+                }
+                if (k == EMPTY_KEY) {
+                    break;
+                }
+            }
+
+            // Pairs with the release fence in erase(): a slot read after an
+            // overwrite makes the bumped sequence number visible here
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (shard.seq.load(std::memory_order_relaxed) == seq0) {
+                return result;
+            }
+        }
+    }
+
+    bool contains(K key) const {
+        return find(key).has_value();
+    }
+
+    /**
+     * Insert if absent
+     * @return true if inserted, false if the key was already present
+     */
+    bool insert(K key, V value) {
+        return upsert(key, value, false);
+    }
+
+    /**
+     * Insert or overwrite
+     * @return true if inserted, false if an existing value was replaced
+     */
+    bool insert_or_assign(K key, V value) {
+        return upsert(key, value, true);
+    }
+
+    /**
+     * Remove a key
+     * @return true if the key was present
+     */
+    bool erase(K key) {
+        assert(key != EMPTY_KEY);
+        const uint64_t h = hash(key);
+        Shard& shard = shards_[shard_index(h)];
+        SpinLockGuard lock(shard.lock);
+
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        size_t hole = h & table->mask;
+        for (;; hole = (hole + 1) & table->mask) {
+            const K k = table->slots[hole].key.load(std::memory_order_relaxed);
+            if (k == key) {
+                break;
+            }
+            if (k == EMPTY_KEY) {
+                return false;
+            }
+        }
+
+        // The hole holds the erased key or, later, a key already copied
+        // back; readers whose probe spans this overwrite retry
+        uint64_t seq = shard.seq.load(std::memory_order_relaxed);
+        const auto vacate = [&]() {
+            shard.seq.store(++seq, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        };
+
+        // Backward shift: copy later cluster members whose home slot is not
+        // cyclically in (hole, j] into the hole. Slot j keeps its key until
+        // it becomes the hole and is overwritten in turn
+        for (size_t j = (hole + 1) & table->mask;; j = (j + 1) & table->mask) {
+            const K k = table->slots[j].key.load(std::memory_order_relaxed);
+            if (k == EMPTY_KEY) {
+                break;
+            }
+            const size_t home = hash(k) & table->mask;
+            const bool home_in_range = hole <= j ? (hole < home && home <= j)
+                                                 : (hole < home || home <= j);
+            if (!home_in_range) {
+                vacate();
+                table->slots[hole].value.store(
+                    table->slots[j].value.load(std::memory_order_relaxed),
+                    std::memory_order_release);
+                table->slots[hole].key.store(k, std::memory_order_release);
+                hole = j;
+            }
+        }
+        vacate();
+        table->slots[hole].key.store(EMPTY_KEY, std::memory_order_release);
+
+        shard.count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Number of keys (exact once writers are quiescent)
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            total += shard.count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /// Total slot count across all shards
+    size_t capacity() const {
+        EpochDomain::Guard guard(domain_);
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            total += shard.table.load(std::memory_order_acquire)->capacity;
+        }
+        return total;
+    }
+
+    static constexpr size_t shard_count() { return Shards; }
+
+private:
+    struct Slot {
+        std::atomic<K> key{EMPTY_KEY};
+        std::atomic<V> value{};
+    };
+
+    struct Table {
+        explicit Table(size_t cap)
+            : capacity(cap), mask(cap - 1), slots(std::make_unique<Slot[]>(cap)) {}
+
+        size_t capacity;
+        size_t mask;
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        SpinLock lock;
+        std::atomic<uint64_t> seq{0};   // Bumped before erase() overwrites or clears a slot
+        std::atomic<Table*> table{nullptr};
+        std::atomic<size_t> count{0};
+    };
+
+    static constexpr size_t SHARD_BITS = static_cast<size_t>(std::countr_zero(Shards));
+
+    /// 64-bit finalizer (MurmurHash3 fmix64): low bits pick the slot,
+    /// high bits pick the shard
+    static uint64_t hash(K key) {
+        uint64_t x = static_cast<uint64_t>(key);
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    static size_t shard_index(uint64_t h) {
+        if constexpr (SHARD_BITS == 0) {
+            return 0;
+        } else {
+            return static_cast<size_t>(h >> (64 - SHARD_BITS));
+        }
+    }
+
+    bool upsert(K key, V value, bool assign) {
+        assert(key != EMPTY_KEY);
+        const uint64_t h = hash(key);
+        Shard& shard = shards_[shard_index(h)];
+        SpinLockGuard lock(shard.lock);
+
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        if (static_cast<double>(shard.count.load(std::memory_order_relaxed) + 1) >
+            static_cast<double>(table->capacity) * MAX_LOAD_FACTOR) {
+            table = grow(shard, table);
+        }
+
+        for (size_t i = h & table->mask;; i = (i + 1) & table->mask) {
+            const K k = table->slots[i].key.load(std::memory_order_relaxed);
+            if (k == key) {
+                if (assign) {
+                    table->slots[i].value.store(value, std::memory_order_release);
+                }
+                return false;
+            }
+            if (k == EMPTY_KEY) {
+                // Value first: a reader that sees the key also sees the value
+                table->slots[i].value.store(value, std::memory_order_release);
+                table->slots[i].key.store(key, std::memory_order_release);
+                shard.count.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    /// Rehash one shard into a table twice the size; caller holds the lock
+    Table* grow(Shard& shard, Table* old_table) {
+        auto* new_table = new Table(old_table->capacity * 2);
+        for (size_t i = 0; i < old_table->capacity; ++i) {
+            const K k = old_table->slots[i].key.load(std::memory_order_relaxed);
+            if (k == EMPTY_KEY) {
+                continue;
+            }
+            size_t j = hash(k) & new_table->mask;
+            while (new_table->slots[j].key.load(std::memory_order_relaxed) != EMPTY_KEY) {
+                j = (j + 1) & new_table->mask;
+            }
+            new_table->slots[j].value.store(
+                old_table->slots[i].value.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+            new_table->slots[j].key.store(k, std::memory_order_relaxed);
+        }
+        shard.table.store(new_table, std::memory_order_release);
+        domain_.retire(old_table);  // Readers may still be probing it
+        return new_table;
+    }
+
+    std::array<Shard, Shards> shards_{};
+    mutable EpochDomain domain_;
+};
+
+} // namespace hpc::concurrency
@@ -0,0 +1,747 @@
+#pragma once
+
+/**
+ * @file coroutine_task.hpp
+ * @brief C++20 coroutine runtime: task<T>, executor, when_all/when_any, async_mutex
+ *
+ * A suspended coroutine is a heap frame and a resume address - suspending
+ * and resuming one costs a few nanoseconds, versus microseconds for
+ * blocking and waking an OS thread. This header provides:
+ *
+ * 1. task<T>       - lazy coroutine that starts when awaited; completion
+ *                    resumes the awaiter by symmetric transfer (no stack growth)
+ * 2. sync_wait()   - run a task from ordinary code and block for its result
+ * 3. Executor      - fixed worker set fed through MPMCQueue;
+ *                    `co_await executor.schedule()` hops onto a worker
+ * 4. when_all()    - await a vector of tasks concurrently, collect results
+ * 5. when_any()    - await the first of a vector of tasks to finish
+ * 6. async_mutex   - mutex whose lock() suspends the coroutine, not the thread
+ */
+
+#include "concurrency_utils.hpp"
+#include "lock_free_queue.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpc::concurrency {
+
+template<typename T = void>
+class task;
+
+// ============================================================================
+// task<T>
+// ============================================================================
+
+namespace detail {
+
+struct TaskPromiseBase {
+    /// Resumed by symmetric transfer when the task finishes
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+            return h.promise().continuation;
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr exception;
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    task<T> get_return_object() noexcept;
+
+    template<typename U>
+    void return_value(U&& v) {
+        value.emplace(std::forward<U>(v));
+    }
+
+    T result() {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+
+    std::optional<T> value;
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void result() {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * Lazily started coroutine producing a T
+ *
+ * The body does not run until the task is awaited (or passed to
+ * sync_wait/when_all/when_any). Exceptions propagate to the awaiter.
+ */
+template<typename T>
+class [[nodiscard]] task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    explicit task(handle_type handle) noexcept : handle_(handle) {}
+
+    task(task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+    ~task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    /// Start the task and suspend the awaiter until it completes
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            handle_type handle;
+
+            bool await_ready() noexcept { return handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+                handle.promise().continuation = awaiter;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().result(); }
+        };
+        return Awaiter{handle_};
+    }
+
+    bool done() const noexcept {
+        return handle_.done();
+    }
+
+private:
+    handle_type handle_;
+};
+
+namespace detail {
+
+template<typename T>
+task<T> TaskPromise<T>::get_return_object() noexcept {
+    return task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline task<void> TaskPromise<void>::get_return_object() noexcept {
+    return task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/// Placeholder stored in place of a void result
+struct VoidResult {};
+
+template<typename T>
+using stored_result_t = std::conditional_t<std::is_void_v<T>, VoidResult, T>;
+
+/**
+ * Fire-and-forget coroutine that reports completion to a Notifier
+ *
+ * Used to drive tasks from outside a coroutine (sync_wait) or several at
+ * once (when_all/when_any). On completion the frame destroys itself and
+ * transfers to whatever Notifier::arrive() returns.
+ */
+template<typename Notifier>
+class NotifyTask {
+public:
+    struct promise_type {
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                std::coroutine_handle<> next = h.promise().notifier->arrive();
+                h.destroy();
+                return next;
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        NotifyTask get_return_object() noexcept {
+            return NotifyTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }  // Bodies catch everything
+
+        Notifier* notifier = nullptr;
+    };
+
+    /// Run until the first suspension; the frame owns itself from here on
+    void start(Notifier& notifier) noexcept {
+        handle_.promise().notifier = &notifier;
+        std::exchange(handle_, {}).resume();
+    }
+
+private:
+    explicit NotifyTask(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/// Await @p t and store its value or exception
+template<typename Notifier, typename T>
+NotifyTask<Notifier> run_and_store(task<T> t,
+                                   std::optional<stored_result_t<T>>& value,
+                                   std::exception_ptr& error) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(t);
+            value.emplace();
+        } else {
+            value.emplace(co_await std::move(t));
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+}
+
+/// Blocks a plain thread until a NotifyTask completes
+class SyncWaitEvent {
+public:
+    std::coroutine_handle<> arrive() noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+        cv_.notify_one();  // Under the lock: wait() cannot return and destroy us first
+        return std::noop_coroutine();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return done_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool done_ = false;
+};
+
+/**
+ * Countdown shared by a suspended parent and its children
+ *
+ * Starts at (children that must arrive) + 1 for the parent. Whoever brings
+ * it to zero resumes the parent, so the parent is resumed exactly once no
+ * matter whether the children finish before or after it suspends.
+ */
+class Latch {
+public:
+    explicit Latch(size_t count) : count_(count) {}
+
+    std::coroutine_handle<> arrive() noexcept {
+        return count_.fetch_sub(1, std::memory_order_acq_rel) == 1
+            ? parent_
+            : std::noop_coroutine();
+    }
+
+    /// Called by the parent after starting all children
+    /// @return true if the parent must stay suspended
+    bool parent_arrive(std::coroutine_handle<> parent) noexcept {
+        parent_ = parent;
+        return count_.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+private:
+    std::atomic<size_t> count_;
+    std::coroutine_handle<> parent_;
+};
+
+} // namespace detail
+
+/**
+ * Run @p t on the calling thread until it first suspends, then block
+ * until it completes (typically on an executor worker)
+ */
+template<typename T>
+T sync_wait(task<T> t) {
+    std::optional<detail::stored_result_t<T>> value;
+    std::exception_ptr error;
+    detail::SyncWaitEvent event;
+
+    detail::run_and_store<detail::SyncWaitEvent>(std::move(t), value, error).start(event);
+    event.wait();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*value);
+    }
+}
+
+// ============================================================================
+// Executor
+// ============================================================================
+
+/**
+ * Fixed set of worker threads resuming coroutines from an MPMCQueue
+ *
+ * Idle workers spin briefly, then sleep on an atomic wait (futex on Linux);
+ * post() only pays for a wake-up when a worker is actually asleep. When the
+ * bounded queue is full, handles spill into a locked overflow deque.
+ */
+class Executor {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+
+    explicit Executor(unsigned int num_threads = hardware_concurrency())
+        : queue_(std::make_unique<MPMCQueue<std::coroutine_handle<>, QUEUE_CAPACITY>>()) {
+        workers_.reserve(num_threads);
+        for (unsigned int i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this]() { worker_loop(); });
+        }
+    }
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /// Finishes all queued work, then joins the workers
+    ~Executor() {
+        stop_.store(true, std::memory_order_release);
+        wake_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /// Awaitable that resumes the awaiting coroutine on a worker
+    auto schedule() noexcept {
+        struct Awaiter {
+            Executor& executor;
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { executor.post(h); }
+            void await_resume() noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    /// Queue a suspended coroutine for resumption
+    void post(std::coroutine_handle<> h) {
+        if (!queue_->push(h)) {
+            // Queue full. Spinning here could deadlock: a worker posting from
+            // inside a resumed coroutine may be the only thread that drains it
+            std::lock_guard<SpinLock> lock(overflow_lock_);
+            overflow_.push_back(h);
+            overflow_size_.fetch_add(1, std::memory_order_release);
+        }
+        // RMW rather than a load: it cannot be reordered before the push, so
+        // either we see a registering sleeper or its recheck sees our item
+        if (sleepers_.fetch_add(0, std::memory_order_seq_cst) > 0) {
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            epoch_.notify_one();
+        }
+    }
+
+    size_t thread_count() const {
+        return workers_.size();
+    }
+
+private:
+    static constexpr int SPIN_BEFORE_SLEEP = 64;
+
+    std::optional<std::coroutine_handle<>> next() {
+        if (auto h = queue_->pop()) {
+            return h;
+        }
+        if (overflow_size_.load(std::memory_order_acquire) == 0) {
+            return std::nullopt;
+        }
+        std::lock_guard<SpinLock> lock(overflow_lock_);
+        if (overflow_.empty()) {
+            return std::nullopt;
+        }
+        const std::coroutine_handle<> h = overflow_.front();
+        overflow_.pop_front();
+        overflow_size_.fetch_sub(1, std::memory_order_relaxed);
+        return h;
+    }
+
+    void worker_loop() {
+        for (;;) {
+            if (auto h = next()) {
+                h->resume();
+                continue;
+            }
+            if (!idle_wait()) {
+                return;
+            }
+        }
+    }
+
+    /// @return false once stopped and the queue is drained
+    bool idle_wait() {
+        for (int i = 0; i < SPIN_BEFORE_SLEEP; ++i) {
+            cpu_pause();
+        }
+        // Register as a sleeper *before* the final emptiness check, so a
+        // post() that races with us either is seen here or sees sleepers_ > 0
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+        if (auto h = next()) {
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            h->resume();
+            return true;
+        }
+        if (stop_.load(std::memory_order_acquire)) {
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        epoch_.wait(epoch, std::memory_order_seq_cst);
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void wake_all() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        epoch_.notify_all();
+    }
+
+    std::unique_ptr<MPMCQueue<std::coroutine_handle<>, QUEUE_CAPACITY>> queue_;
+    std::vector<std::thread> workers_;
+    SpinLock overflow_lock_;
+    std::deque<std::coroutine_handle<>> overflow_;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> overflow_size_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> epoch_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int> sleepers_{0};
+    std::atomic<bool> stop_{false};
+};
+
+// ============================================================================
+// when_all / when_any
+// ============================================================================
+
+template<typename T>
+using when_all_result_t = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+/**
+ * Start every task and resume when all have finished
+ *
+ * Tasks run concurrently only if they suspend (e.g. on
+ * `co_await executor.schedule()`); otherwise they run one after another on
+ * the awaiting thread. The first exception, if any, is rethrown after all
+ * tasks have finished.
+ *
+ * @return results in the order of @p tasks (nothing for task<void>)
+ */
+template<typename T>
+task<when_all_result_t<T>> when_all(std::vector<task<T>> tasks) {
+    const size_t n = tasks.size();
+    std::vector<std::optional<detail::stored_result_t<T>>> values(n);
+    std::vector<std::exception_ptr> errors(n);
+    detail::Latch latch(n + 1);
+
+    struct StartAll {
+        std::vector<task<T>>& tasks;
+        std::vector<std::optional<detail::stored_result_t<T>>>& values;
+        std::vector<std::exception_ptr>& errors;
+        detail::Latch& latch;
+
+        bool await_ready() noexcept { return tasks.empty(); }
+
+        bool await_suspend(std::coroutine_handle<> parent) {
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                detail::run_and_store<detail::Latch>(std::move(tasks[i]), values[i], errors[i])
+                    .start(latch);
+            }
+            return latch.parent_arrive(parent);
+        }
+
+        void await_resume() noexcept {}
+    };
+    co_await StartAll{tasks, values, errors, latch};
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    if constexpr (!std::is_void_v<T>) {
+        std::vector<T> results;
+        results.reserve(n);
+        for (auto& value : values) {
+            results.push_back(std::move(*value));
+        }
+        co_return results;
+    }
+}
+
+template<typename T>
+struct WhenAnyResult {
+    size_t index;
+    T value;
+};
+
+template<>
+struct WhenAnyResult<void> {
+    size_t index;
+};
+
+namespace detail {
+
+template<typename T>
+struct WhenAnyState {
+    static constexpr size_t NO_WINNER = std::numeric_limits<size_t>::max();
+
+    /// Completion hook for child i: only the winner arrives at the latch
+    struct Arrival {
+        WhenAnyState* state;
+        size_t index;
+
+        std::coroutine_handle<> arrive() noexcept {
+            return state->winner.load(std::memory_order_acquire) == index
+                ? state->latch.arrive()
+                : std::noop_coroutine();
+        }
+    };
+
+    Latch latch{2};  // Parent + winner
+    std::atomic<bool> decided{false};
+    std::atomic<size_t> winner{NO_WINNER};
+    std::optional<stored_result_t<T>> value;
+    std::exception_ptr error;
+    std::vector<Arrival> arrivals;
+};
+
+/// Child of when_any: keeps the shared state alive until it finishes,
+/// even if it loses and the parent has already returned
+template<typename T>
+NotifyTask<typename WhenAnyState<T>::Arrival> run_when_any_child(
+        task<T> t, std::shared_ptr<WhenAnyState<T>> state, size_t index) {
+    std::optional<stored_result_t<T>> value;
+    std::exception_ptr error;
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(t);
+            value.emplace();
+        } else {
+            value.emplace(co_await std::move(t));
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    if (!state->decided.exchange(true, std::memory_order_acq_rel)) {
+        state->value = std::move(value);
+        state->error = error;
+        state->winner.store(index, std::memory_order_release);
+    }
+}
+
+} // namespace detail
+
+/**
+ * Start every task and resume as soon as the first one finishes
+ *
+ * There is no cancellation: the remaining tasks keep running to completion
+ * and their results are discarded, so they must not reference state owned
+ * by the awaiting coroutine. If the first task to finish threw, its
+ * exception is rethrown.
+ */
+template<typename T>
+task<WhenAnyResult<T>> when_any(std::vector<task<T>> tasks) {
+    if (tasks.empty()) {
+        throw std::invalid_argument("when_any requires at least one task");
+    }
+    auto state = std::make_shared<detail::WhenAnyState<T>>();
+    state->arrivals.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        state->arrivals.push_back({state.get(), i});
+    }
+
+    struct StartAll {
+        std::vector<task<T>>& tasks;
+        std::shared_ptr<detail::WhenAnyState<T>>& state;
+
+        bool await_ready() noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> parent) {
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                detail::run_when_any_child<T>(std::move(tasks[i]), state, i)
+                    .start(state->arrivals[i]);
+            }
+            return state->latch.parent_arrive(parent);
+        }
+
+        void await_resume() noexcept {}
+    };
+    co_await StartAll{tasks, state};
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+    const size_t index = state->winner.load(std::memory_order_acquire);
+    if constexpr (std::is_void_v<T>) {
+        co_return WhenAnyResult<void>{index};
+    } else {
+        co_return WhenAnyResult<T>{index, std::move(*state->value)};
+    }
+}
+
+// ============================================================================
+// async_mutex
+// ============================================================================
+
+class async_mutex;
+
+/// RAII ownership of an async_mutex, obtained from `co_await m.scoped_lock()`
+class async_lock_guard {
+public:
+    explicit async_lock_guard(async_mutex& mutex) noexcept : mutex_(&mutex) {}
+
+    async_lock_guard(async_lock_guard&& other) noexcept
+        : mutex_(std::exchange(other.mutex_, nullptr)) {}
+
+    async_lock_guard(const async_lock_guard&) = delete;
+    async_lock_guard& operator=(const async_lock_guard&) = delete;
+    async_lock_guard& operator=(async_lock_guard&&) = delete;
+
+    inline ~async_lock_guard();
+
+private:
+    async_mutex* mutex_;
+};
+
+/**
+ * Mutex for coroutines
+ *
+ * A contended lock() suspends the coroutine and queues it (FIFO) instead
+ * of blocking the worker thread, which stays free to run other coroutines.
+ * unlock() hands ownership directly to the first waiter and resumes it on
+ * the unlocking thread. The waiter list itself is guarded by a SpinLock
+ * held for a few instructions.
+ */
+class async_mutex {
+    struct LockAwaiter {
+        async_mutex& mutex;
+        std::coroutine_handle<> handle;
+        LockAwaiter* next = nullptr;
+
+        bool await_ready() noexcept { return mutex.try_lock(); }
+
+        bool await_suspend(std::coroutine_handle<> h) noexcept {
+            handle = h;
+            SpinLockGuard guard(mutex.lock_);
+            if (!mutex.locked_) {
+                mutex.locked_ = true;
+                return false;  // Released since await_ready: take it and continue
+            }
+            if (mutex.tail_) {
+                mutex.tail_->next = this;
+            } else {
+                mutex.head_ = this;
+            }
+            mutex.tail_ = this;
+            return true;
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    struct ScopedLockAwaiter : LockAwaiter {
+        async_lock_guard await_resume() noexcept { return async_lock_guard(mutex); }
+    };
+
+public:
+    async_mutex() = default;
+    async_mutex(const async_mutex&) = delete;
+    async_mutex& operator=(const async_mutex&) = delete;
+
+    /// `co_await m.lock();` ... `m.unlock();`
+    LockAwaiter lock() noexcept {
+        return LockAwaiter{*this, {}};
+    }
+
+    /// `auto guard = co_await m.scoped_lock();`
+    ScopedLockAwaiter scoped_lock() noexcept {
+        return ScopedLockAwaiter{{*this, {}}};
+    }
+
+    bool try_lock() noexcept {
+        SpinLockGuard guard(lock_);
+        if (locked_) {
+            return false;
+        }
+        locked_ = true;
+        return true;
+    }
+
+    void unlock() {
+        LockAwaiter* waiter;
+        {
+            SpinLockGuard guard(lock_);
+            waiter = head_;
+            if (!waiter) {
+                locked_ = false;
+                return;
+            }
+            head_ = waiter->next;
+            if (!head_) {
+                tail_ = nullptr;
+            }
+        }
+        waiter->handle.resume();  // Still locked: ownership passes to the waiter
+    }
+
+private:
+    SpinLock lock_;
+    bool locked_ = false;
+    LockAwaiter* head_ = nullptr;
+    LockAwaiter* tail_ = nullptr;
+};
+
+inline async_lock_guard::~async_lock_guard() {
+    if (mutex_) {
+        mutex_->unlock();
+    }
+}
+
+} // namespace hpc::concurrency
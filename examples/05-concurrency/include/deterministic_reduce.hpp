@@ -0,0 +1,281 @@
+#pragma once
+
+/**
+ * @file deterministic_reduce.hpp
+ * @brief Reproducible parallel sum and dot product (hpc::parallel)
+ *
+ * `#pragma omp parallel for reduction(+:sum)` adds the per-thread partial
+ * sums in whatever order the threads finish, and each thread's partial
+ * covers a range that depends on the thread count, so the low bits of the
+ * result change from run to run and machine to machine.
+ *
+ * Here the shape of the computation depends only on n:
+ *
+ *   leaves   fixed REDUCE_LEAF-element blocks, independent of threads
+ *   lanes    inside a leaf, element i goes to lane i % LANES (LANES =
+ *            256 bytes of accumulators, whatever the SIMD width); each
+ *            lane adds its elements in index order
+ *   trees    lanes, then leaf results, are combined by a fixed pairwise
+ *            tree: p[i] += p[i + stride] for stride = 1, 2, 4, ...
+ *
+ * Threads only decide who computes which leaf, never what is added to
+ * what, so sum/dot return bit-identical results for any thread count and
+ * backend. The lane layout does not depend on the SIMD width either, and
+ * products are rounded before they are added, so scalar, SSE2, AVX2 and
+ * AVX-512 builds agree too. GCC's default -ffp-contract=fast would fuse a
+ * product into the lane add (or into the Kahan TwoSum) as an FMA, so each
+ * product passes through detail::rounded(), which the optimizer cannot see into.
+ *
+ * Summation::Kahan keeps a compensation term per lane (Kahan-Babuska:
+ * the exact rounding error of every addition, via TwoSum, which unlike
+ * classic Kahan also holds when a term outweighs the running sum) and
+ * combines the trees with TwoSum as well. The result is about as accurate
+ * as summing in twice the precision, even with heavy cancellation.
+ *
+ * Both modes need IEEE semantics: -ffast-math may reassociate the lanes or
+ * remove the compensation.
+ */
+
+#include "parallel_algorithms.hpp"
+#include "simd_wrapper.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#if defined(__FAST_MATH__)
+#warning "deterministic_reduce.hpp: -ffast-math breaks Kahan compensation and reproducibility"
+#endif
+
+namespace hpc::parallel {
+
+enum class Summation {
+    Pairwise,  ///< Lane accumulators + pairwise trees: O(log n) error growth
+    Kahan      ///< Compensated (Kahan-Babuska) lanes and trees: ~2x precision
+};
+
+namespace detail {
+
+/// Elements per leaf; a leaf is the unit of work handed to a thread
+constexpr size_t REDUCE_LEAF = 8192;
+/// Bytes of lane accumulators (64 floats / 32 doubles)
+constexpr size_t REDUCE_LANE_BYTES = 256;
+
+template<typename T> struct ReduceVec;
+template<> struct ReduceVec<float> { using type = hpc::simd::FloatVec; };
+template<> struct ReduceVec<double> { using type = hpc::simd::DoubleVec; };
+
+/// Value with a running error term: the represented number is sum + err
+template<typename T>
+struct Compensated {
+    T sum = T(0);
+    T err = T(0);
+};
+
+/// Knuth's TwoSum: a + b == s + e exactly
+template<typename T>
+inline Compensated<T> two_sum(T a, T b) {
+    const T s = a + b;
+    const T bb = s - a;
+    const T e = (a - (s - bb)) + (b - bb);
+    return {s, e};
+}
+
+template<typename T>
+inline Compensated<T> combine(const Compensated<T>& a, const Compensated<T>& b) {
+    Compensated<T> r = two_sum(a.sum, b.sum);
+    r.err += a.err + b.err;
+    return r;
+}
+
+/// @p v unchanged, but opaque to the optimizer: a product passed through
+/// here is rounded to T before any add sees it, so it cannot be contracted
+/// into an FMA
+template<typename Vec>
+inline Vec rounded(Vec v) {
+#if defined(__GNUC__)
+    if constexpr (std::is_same_v<Vec, hpc::simd::SimdVecScalar<typename Vec::value_type, Vec::width>>) {
+        asm("" : "+m"(v.data));
+    } else {
+        asm("" : "+v"(v.data));
+    }
+#endif
+    return v;
+}
+
+/// Fixed-shape pairwise tree over p[0..m): the result ends up in p[0]
+template<typename P, typename Combine>
+P tree_reduce(P* p, size_t m, Combine combine_fn) {
+    for (size_t stride = 1; stride < m; stride *= 2) {
+        for (size_t i = 0; i + stride < m; i += 2 * stride) {
+            p[i] = combine_fn(p[i], p[i + stride]);
+        }
+    }
+    return p[0];
+}
+
+/**
+ * Accumulates one leaf, LANES elements per step
+ *
+ * add() takes LANES values as VECS SIMD vectors: vector k holds lanes
+ * [k * width, (k + 1) * width).
+ */
+template<typename T, Summation S>
+class LeafAccumulator {
+public:
+    using Vec = typename ReduceVec<T>::type;
+    static constexpr size_t LANES = REDUCE_LANE_BYTES / sizeof(T);
+    static constexpr size_t VECS = LANES / Vec::width;
+    static_assert(LANES % Vec::width == 0 && REDUCE_LEAF % LANES == 0);
+
+    LeafAccumulator() {
+        for (size_t k = 0; k < VECS; ++k) {
+            sum_[k] = Vec(T(0));
+            comp_[k] = Vec(T(0));
+        }
+    }
+
+    void add(const Vec (&x)[VECS]) {
+        for (size_t k = 0; k < VECS; ++k) {
+            if constexpr (S == Summation::Kahan) {
+                // TwoSum, so the error is exact even when |x| > |sum|
+                const Vec t = sum_[k] + x[k];
+                const Vec bb = t - sum_[k];
+                comp_[k] += (sum_[k] - (t - bb)) + (x[k] - bb);
+                sum_[k] = t;
+            } else {
+                sum_[k] += x[k];
+            }
+        }
+    }
+
+    Compensated<T> finish() const {
+        Compensated<T> lanes[LANES];
+        for (size_t k = 0; k < VECS; ++k) {
+            T s[Vec::width];
+            T c[Vec::width];
+            sum_[k].store(s);
+            comp_[k].store(c);
+            for (size_t j = 0; j < Vec::width; ++j) {
+                lanes[k * Vec::width + j] = {s[j], c[j]};
+            }
+        }
+        if constexpr (S == Summation::Kahan) {
+            return tree_reduce(lanes, LANES, combine<T>);
+        } else {
+            return tree_reduce(lanes, LANES, [](const Compensated<T>& a, const Compensated<T>& b) {
+                return Compensated<T>{a.sum + b.sum, T(0)};
+            });
+        }
+    }
+
+private:
+    Vec sum_[VECS];
+    Vec comp_[VECS];
+};
+
+/**
+ * Reduce [0, n) where load(i, out) fills out[] with the LANES terms
+ * starting at i (i + LANES <= n) and load_tail(i, count, out) the
+ * zero-padded last count < LANES terms
+ */
+template<typename T, Summation S, typename Load, typename LoadTail>
+T deterministic_reduce(size_t n, Load load, LoadTail load_tail, Backend backend) {
+    using Acc = LeafAccumulator<T, S>;
+    using Vec = typename Acc::Vec;
+    if (n == 0) {
+        return T(0);
+    }
+
+    const size_t num_leaves = (n + REDUCE_LEAF - 1) / REDUCE_LEAF;
+    std::vector<Compensated<T>> leaves(num_leaves);
+    const size_t num_tasks = std::clamp<size_t>(n / MIN_BLOCK_SIZE, 1, num_threads(backend));
+
+    run_tasks(num_tasks, [&](size_t t) {
+        const size_t leaf_end = num_leaves * (t + 1) / num_tasks;
+        for (size_t leaf = num_leaves * t / num_tasks; leaf < leaf_end; ++leaf) {
+            const size_t lo = leaf * REDUCE_LEAF;
+            const size_t hi = std::min(lo + REDUCE_LEAF, n);
+            Acc acc;
+            Vec x[Acc::VECS];
+            size_t i = lo;
+            for (; i + Acc::LANES <= hi; i += Acc::LANES) {
+                load(i, x);
+                acc.add(x);
+            }
+            if (i < hi) {
+                load_tail(i, hi - i, x);
+                acc.add(x);
+            }
+            leaves[leaf] = acc.finish();
+        }
+    }, backend);
+
+    if constexpr (S == Summation::Kahan) {
+        const Compensated<T> total = tree_reduce(leaves.data(), num_leaves, combine<T>);
+        return total.sum + total.err;
+    } else {
+        return tree_reduce(leaves.data(), num_leaves, [](const Compensated<T>& a, const Compensated<T>& b) {
+            return Compensated<T>{a.sum + b.sum, T(0)};
+        }).sum;
+    }
+}
+
+template<typename T>
+concept ReducibleFloat = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+} // namespace detail
+
+/**
+ * Sum of x[0..n), bit-identical for any thread count, backend and SIMD width
+ */
+template<detail::ReducibleFloat T, Summation S = Summation::Pairwise>
+T deterministic_sum(const T* x, size_t n, Backend backend = default_backend()) {
+    using Acc = detail::LeafAccumulator<T, S>;
+    using Vec = typename Acc::Vec;
+    return detail::deterministic_reduce<T, S>(
+        n,
+        [x](size_t i, Vec (&out)[Acc::VECS]) {
+            for (size_t k = 0; k < Acc::VECS; ++k) {
+                out[k] = Vec(x + i + k * Vec::width);
+            }
+        },
+        [x](size_t i, size_t count, Vec (&out)[Acc::VECS]) {
+            T pad[Acc::LANES] = {};
+            std::copy(x + i, x + i + count, pad);
+            for (size_t k = 0; k < Acc::VECS; ++k) {
+                out[k] = Vec(pad + k * Vec::width);
+            }
+        },
+        backend);
+}
+
+/**
+ * Dot product of a[0..n) and b[0..n), with the same reproducibility
+ * guarantees as deterministic_sum (each product is rounded, then summed)
+ */
+template<detail::ReducibleFloat T, Summation S = Summation::Pairwise>
+T deterministic_dot(const T* a, const T* b, size_t n, Backend backend = default_backend()) {
+    using Acc = detail::LeafAccumulator<T, S>;
+    using Vec = typename Acc::Vec;
+    return detail::deterministic_reduce<T, S>(
+        n,
+        [a, b](size_t i, Vec (&out)[Acc::VECS]) {
+            for (size_t k = 0; k < Acc::VECS; ++k) {
+                const size_t j = i + k * Vec::width;
+                out[k] = detail::rounded(Vec(a + j) * Vec(b + j));
+            }
+        },
+        [a, b](size_t i, size_t count, Vec (&out)[Acc::VECS]) {
+            T pad_a[Acc::LANES] = {};
+            T pad_b[Acc::LANES] = {};
+            std::copy(a + i, a + i + count, pad_a);
+            std::copy(b + i, b + i + count, pad_b);
+            for (size_t k = 0; k < Acc::VECS; ++k) {
+                out[k] = detail::rounded(Vec(pad_a + k * Vec::width) * Vec(pad_b + k * Vec::width));
+            }
+        },
+        backend);
+}
+
+} // namespace hpc::parallel
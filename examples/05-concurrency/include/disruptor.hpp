@@ -0,0 +1,364 @@
+#pragma once
+
+/**
+ * @file disruptor.hpp
+ * @brief Disruptor-style multicast ring buffer with sequence barriers
+ *
+ * SPSCQueue and MPMCQueue hand each item to exactly one consumer. Fanning
+ * an event out to several stages with them means one queue - and one copy -
+ * per stage. Here every consumer reads the *same* pre-allocated slots:
+ *
+ * - Producers claim sequence numbers, fill the slot in place and publish.
+ * - Each consumer owns a Sequence cursor: "I am done with everything <= n".
+ * - A SequenceBarrier lets a consumer wait for the producer cursor and for
+ *   any upstream consumers (dependency graph: parse -> {log, metrics}).
+ * - The producer is gated on the slowest terminal consumer, so it never
+ *   overwrites a slot that is still being read.
+ * - Consumers process every available event as one batch and publish
+ *   their cursor once per batch; producers can claim n slots at once.
+ *
+ * @code
+ *   RingBuffer<Event, 1024> ring;
+ *   auto parse_barrier = ring.new_barrier();
+ *   BatchEventProcessor parse(ring, parse_barrier, parse_handler);
+ *   auto log_barrier = ring.new_barrier({&parse.sequence()});
+ *   BatchEventProcessor log(ring, log_barrier, log_handler);
+ *   ring.add_gating_sequences({&log.sequence()});
+ *   // threads: parse.run(), log.run(); producer: ring.publish_event(fill)
+ * @endcode
+ */
+
+#include "concurrency_utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace hpc::concurrency {
+
+/// Sequence value before anything has been published or processed
+constexpr int64_t INITIAL_SEQUENCE = -1;
+
+/**
+ * Padded monotonically increasing sequence number
+ *
+ * set() is a release store and get() an acquire load, so everything a
+ * stage wrote to the slots it processed is visible to whoever observes
+ * the new sequence value.
+ */
+class Sequence {
+public:
+    explicit Sequence(int64_t initial = INITIAL_SEQUENCE) : value_(initial) {}
+
+    Sequence(const Sequence&) = delete;
+    Sequence& operator=(const Sequence&) = delete;
+
+    int64_t get() const {
+        return value_.load(std::memory_order_acquire);
+    }
+
+    void set(int64_t value) {
+        value_.store(value, std::memory_order_release);
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> value_;  // Alone on its line
+};
+
+/// Smallest value among @p sequences, or @p fallback if there are none
+inline int64_t minimum_sequence(const std::vector<const Sequence*>& sequences,
+                                int64_t fallback) {
+    int64_t result = std::numeric_limits<int64_t>::max();
+    for (const Sequence* s : sequences) {
+        result = std::min(result, s->get());
+    }
+    return sequences.empty() ? fallback : result;
+}
+
+/**
+ * Spin briefly, then yield
+ *
+ * Pure spinning is lowest latency when every stage has its own core; the
+ * yield keeps oversubscribed runs (more stages than cores) making progress.
+ */
+class SpinThenYield {
+public:
+    void wait() {
+        if (spins_ < SPIN_LIMIT) {
+            ++spins_;
+            cpu_pause();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static constexpr int SPIN_LIMIT = 100;
+    int spins_ = 0;
+};
+
+enum class ProducerType {
+    Single,  ///< One publishing thread: claims are plain increments
+    Multi    ///< Any number of publishing threads: claims are fetch_add
+};
+
+template<typename Ring>
+class SequenceBarrier;
+
+/**
+ * Pre-allocated multicast ring buffer
+ *
+ * @tparam T        Event type, default constructed once per slot and reused
+ * @tparam Capacity Number of slots (power of 2)
+ * @tparam Producer Single or multi producer claim strategy
+ */
+template<typename T, size_t Capacity, ProducerType Producer = ProducerType::Single>
+class RingBuffer {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+    static_assert(Capacity >= 2, "Capacity must be at least 2");
+
+public:
+    using value_type = T;
+    using Barrier = SequenceBarrier<RingBuffer>;
+
+    RingBuffer() : entries_(std::make_unique<T[]>(Capacity)) {
+        if constexpr (Producer == ProducerType::Multi) {
+            available_ = std::make_unique<std::atomic<int64_t>[]>(Capacity);
+            for (size_t i = 0; i < Capacity; ++i) {
+                available_[i].store(-1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /**
+     * Register the consumers the producer must not overtake
+     *
+     * Usually the last stage(s) of the pipeline. Must be called before any
+     * producer starts.
+     */
+    void add_gating_sequences(std::initializer_list<const Sequence*> sequences) {
+        for (const Sequence* s : sequences) {
+            gating_.push_back(s);
+        }
+    }
+
+    /// Barrier on the producer cursor and the given upstream consumers
+    Barrier new_barrier(std::initializer_list<const Sequence*> dependencies = {}) const {
+        return Barrier(*this, dependencies);
+    }
+
+    /**
+     * Claim the next @p n slots, waiting while they are still being read
+     *
+     * 1 <= n <= Capacity: a larger batch would wait for consumers to pass
+     * slots it has not published yet, and never return.
+     * @return highest claimed sequence; the batch is [result - n + 1, result]
+     */
+    int64_t next(int64_t n = 1) {
+        assert(n >= 1 && n <= static_cast<int64_t>(Capacity));
+        if constexpr (Producer == ProducerType::Single) {
+            const int64_t claimed = next_value_ + n;
+            wait_for_capacity(claimed);
+            next_value_ = claimed;
+            return claimed;
+        } else {
+            const int64_t claimed = claim_.fetch_add(n, std::memory_order_relaxed) + n - 1;
+            wait_for_capacity(claimed);
+            return claimed;
+        }
+    }
+
+    T& operator[](int64_t sequence) {
+        return entries_[static_cast<size_t>(sequence) & MASK];
+    }
+
+    const T& operator[](int64_t sequence) const {
+        return entries_[static_cast<size_t>(sequence) & MASK];
+    }
+
+    /// Make [lo, hi] visible to consumers
+    void publish(int64_t lo, int64_t hi) {
+        if constexpr (Producer == ProducerType::Single) {
+            (void)lo;
+            cursor_.set(hi);
+        } else {
+            for (int64_t s = lo; s <= hi; ++s) {
+                available_[static_cast<size_t>(s) & MASK].store(s, std::memory_order_release);
+            }
+        }
+    }
+
+    void publish(int64_t sequence) {
+        publish(sequence, sequence);
+    }
+
+    /// Claim one slot, fill it in place with fill(event, sequence), publish
+    template<typename Fill>
+    void publish_event(Fill&& fill) {
+        const int64_t sequence = next();
+        fill((*this)[sequence], sequence);
+        publish(sequence);
+    }
+
+    /**
+     * Highest sequence in [lo, hi] below which everything is published
+     * @param hi upper bound already known to be claimed
+     */
+    int64_t highest_published(int64_t lo, int64_t hi) const {
+        if constexpr (Producer == ProducerType::Single) {
+            (void)lo;
+            return hi;
+        } else {
+            for (int64_t s = lo; s <= hi; ++s) {
+                if (available_[static_cast<size_t>(s) & MASK].load(std::memory_order_acquire) != s) {
+                    return s - 1;
+                }
+            }
+            return hi;
+        }
+    }
+
+    /// Highest sequence that may have been published (claimed for multi-producer)
+    int64_t cursor() const {
+        if constexpr (Producer == ProducerType::Single) {
+            return cursor_.get();
+        } else {
+            return claim_.load(std::memory_order_acquire) - 1;
+        }
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    /// Block until the slowest gating consumer has released the slot that
+    /// sequence @p claimed maps onto
+    void wait_for_capacity(int64_t claimed) {
+        const int64_t wrap_point = claimed - static_cast<int64_t>(Capacity);
+        if (wrap_point <= cached_gating_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        SpinThenYield waiter;
+        int64_t min_gating;
+        while (wrap_point > (min_gating = minimum_sequence(gating_, claimed - 1))) {
+            waiter.wait();
+        }
+        cached_gating_.store(min_gating, std::memory_order_relaxed);
+    }
+
+    std::unique_ptr<T[]> entries_;
+    std::vector<const Sequence*> gating_;
+
+    Sequence cursor_;                                    // Single: last published
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> claim_{0};  // Multi: next to claim
+    std::unique_ptr<std::atomic<int64_t>[]> available_;  // Multi: published sequence per slot
+    int64_t next_value_ = INITIAL_SEQUENCE;              // Single: producer-local
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> cached_gating_{INITIAL_SEQUENCE};
+};
+
+/**
+ * Waits until a sequence is published and processed by all dependencies
+ */
+template<typename Ring>
+class SequenceBarrier {
+public:
+    SequenceBarrier(const Ring& ring, std::initializer_list<const Sequence*> dependencies)
+        : ring_(ring), dependencies_(dependencies) {}
+
+    SequenceBarrier(const SequenceBarrier&) = delete;
+    SequenceBarrier& operator=(const SequenceBarrier&) = delete;
+
+    /**
+     * Wait until @p sequence is available
+     * @return highest available sequence (>= @p sequence, so the caller can
+     *         process a whole batch), or less than @p sequence if the
+     *         barrier was alerted while nothing was available
+     */
+    int64_t wait_for(int64_t sequence) {
+        SpinThenYield waiter;
+        for (;;) {
+            const int64_t available =
+                minimum_sequence(dependencies_, ring_.cursor());
+            if (available >= sequence) {
+                // Multi-producer: claimed slots may not all be published yet
+                const int64_t published = ring_.highest_published(sequence, available);
+                if (published >= sequence) {
+                    return published;
+                }
+            }
+            if (alerted_.load(std::memory_order_acquire)) {
+                return sequence - 1;
+            }
+            waiter.wait();
+        }
+    }
+
+    /// Wake waiting consumers; they return once caught up
+    void alert() {
+        alerted_.store(true, std::memory_order_release);
+    }
+
+private:
+    const Ring& ring_;
+    std::vector<const Sequence*> dependencies_;
+    std::atomic<bool> alerted_{false};
+};
+
+/**
+ * Consumer loop: wait for a batch, hand each event to the handler, publish
+ * the cursor once per batch
+ *
+ * The handler is called as handler(event, sequence, end_of_batch) and may
+ * modify the event in place; downstream stages see the modification.
+ */
+template<typename Ring, typename Handler>
+class BatchEventProcessor {
+public:
+    BatchEventProcessor(Ring& ring, typename Ring::Barrier& barrier, Handler handler)
+        : ring_(ring), barrier_(barrier), handler_(std::move(handler)) {}
+
+    /// Process events until halt() is called and everything published is drained
+    void run() {
+        int64_t next = sequence_.get() + 1;
+        for (;;) {
+            const int64_t available = barrier_.wait_for(next);
+            if (available < next) {
+                return;
+            }
+            for (int64_t s = next; s <= available; ++s) {
+                handler_(ring_[s], s, s == available);
+            }
+            sequence_.set(available);
+            next = available + 1;
+        }
+    }
+
+    void halt() {
+        barrier_.alert();
+    }
+
+    const Sequence& sequence() const {
+        return sequence_;
+    }
+
+    Handler& handler() {
+        return handler_;
+    }
+
+private:
+    Ring& ring_;
+    typename Ring::Barrier& barrier_;
+    Handler handler_;
+    Sequence sequence_;
+};
+
+} // namespace hpc::concurrency
@@ -0,0 +1,240 @@
+#pragma once
+
+/**
+ * @file latency_histogram.hpp
+ * @brief Cycle-counter timestamps and an HDR-style latency histogram
+ *
+ * Averages hide the stalls that matter for queues (a preempted consumer,
+ * a cache miss on the slot, a futex wake-up). Tail latency needs:
+ *
+ * - cheap timestamps: read_tsc() is ~20 cycles, steady_clock::now() ~20 ns
+ * - a histogram whose precision is relative, not absolute: p50 may be
+ *   50 ns while max is 5 ms, and both need ~1% resolution
+ *
+ * LatencyHistogram uses HDR-style log-linear buckets: values below
+ * 2^SubBucketBits are exact, above that every power of two is split into
+ * 2^(SubBucketBits-1) equal sub-buckets. Recording is one relaxed
+ * fetch_add (plus a CAS only when a new min/max is seen), so several
+ * threads can record into the same histogram without locks.
+ */
+
+#include "concurrency_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace hpc::concurrency {
+
+// ============================================================================
+// Timestamps
+// ============================================================================
+
+/**
+ * Read the CPU timestamp counter
+ *
+ * On x86 this is the invariant TSC: constant rate and synchronised across
+ * cores on every CPU of the last decade, so a stamp taken on one core can
+ * be subtracted from a stamp taken on another. The lfence keeps earlier
+ * loads from drifting past the read. Elsewhere falls back to steady_clock
+ * nanoseconds.
+ */
+inline uint64_t read_tsc() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_lfence();
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/// TSC ticks per nanosecond, calibrated once against steady_clock (~20 ms)
+inline double tsc_ticks_per_ns() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    static const double ticks_per_ns = []() {
+        const auto t0 = std::chrono::steady_clock::now();
+        const uint64_t c0 = read_tsc();
+        while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(20)) {
+            cpu_pause();
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        const uint64_t c1 = read_tsc();
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        return static_cast<double>(c1 - c0) / ns;
+    }();
+    return ticks_per_ns;
+#else
+    return 1.0;
+#endif
+}
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+/**
+ * Log-linear histogram of uint64_t values (typically TSC ticks)
+ *
+ * Relative error of a reported value is below 2^(1-SubBucketBits):
+ * <1.6% for the default of 7 bits, using ~30 KB of counters.
+ *
+ * Reads (percentile(), count(), ...) taken while other threads record
+ * see a consistent-enough snapshot for reporting, not an atomic one.
+ */
+template<unsigned SubBucketBits = 7>
+class LatencyHistogram {
+    static_assert(SubBucketBits >= 2 && SubBucketBits <= 16, "SubBucketBits out of range");
+
+public:
+    static constexpr uint64_t SUB_BUCKETS = uint64_t{1} << SubBucketBits;
+    static constexpr uint64_t HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+    static constexpr size_t NUM_BUCKETS = SUB_BUCKETS + (64 - SubBucketBits) * HALF_SUB_BUCKETS;
+
+    static constexpr size_t bucket_for(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        // Shift the value so its top SubBucketBits bits index the sub-bucket
+        const unsigned msb = 63u - static_cast<unsigned>(std::countl_zero(value));
+        const unsigned shift = msb - SubBucketBits + 1;
+        return static_cast<size_t>(SUB_BUCKETS + (shift - 1) * HALF_SUB_BUCKETS +
+                                   ((value >> shift) - HALF_SUB_BUCKETS));
+    }
+
+    /// Smallest value that lands in @p bucket
+    static constexpr uint64_t bucket_lower_bound(size_t bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        const uint64_t j = bucket - SUB_BUCKETS;
+        const uint64_t shift = j / HALF_SUB_BUCKETS + 1;
+        return ((j % HALF_SUB_BUCKETS) + HALF_SUB_BUCKETS) << shift;
+    }
+
+    /// Largest value that lands in @p bucket
+    static constexpr uint64_t bucket_upper_bound(size_t bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        const uint64_t shift = (bucket - SUB_BUCKETS) / HALF_SUB_BUCKETS + 1;
+        return bucket_lower_bound(bucket) + ((uint64_t{1} << shift) - 1);
+    }
+
+    void record(uint64_t value) {
+        counts_[bucket_for(value)].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t current = max_.load(std::memory_order_relaxed);
+        while (value > current &&
+               !max_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+        current = min_.load(std::memory_order_relaxed);
+        while (value < current &&
+               !min_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const {
+        return total_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t max() const {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    /// 0 when empty
+    uint64_t min() const {
+        return count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+    }
+
+    double mean() const {
+        const uint64_t n = count();
+        return n == 0 ? 0.0
+                      : static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+                            static_cast<double>(n);
+    }
+
+    /**
+     * Value at the given percentile (0..100)
+     *
+     * Returns the upper bound of the bucket holding that rank (HDR's
+     * "highest equivalent value"), clamped to the recorded maximum, so
+     * percentile(100) == max().
+     */
+    uint64_t percentile(double pct) const {
+        const uint64_t n = count();
+        if (n == 0) {
+            return 0;
+        }
+        const double clamped = std::clamp(pct, 0.0, 100.0);
+        const uint64_t rank = std::max<uint64_t>(
+            1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(n))));
+
+        uint64_t seen = 0;
+        for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+            seen += counts_[b].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return std::min(bucket_upper_bound(b), max());
+            }
+        }
+        return max();
+    }
+
+    /// Add another histogram's samples to this one
+    void merge(const LatencyHistogram& other) {
+        for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+            const uint64_t c = other.counts_[b].load(std::memory_order_relaxed);
+            if (c != 0) {
+                counts_[b].fetch_add(c, std::memory_order_relaxed);
+            }
+        }
+        const uint64_t n = other.count();
+        if (n == 0) {
+            return;
+        }
+        total_.fetch_add(n, std::memory_order_relaxed);
+        sum_.fetch_add(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        uint64_t current = max_.load(std::memory_order_relaxed);
+        const uint64_t other_max = other.max();
+        while (other_max > current &&
+               !max_.compare_exchange_weak(current, other_max, std::memory_order_relaxed)) {
+        }
+        current = min_.load(std::memory_order_relaxed);
+        const uint64_t other_min = other.min();
+        while (other_min < current &&
+               !min_.compare_exchange_weak(current, other_min, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// Not safe against concurrent record()
+    void reset() {
+        for (auto& c : counts_) {
+            c.store(0, std::memory_order_relaxed);
+        }
+        total_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> counts_{};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> total_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+    std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+};
+
+} // namespace hpc::concurrency
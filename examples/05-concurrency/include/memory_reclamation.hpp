@@ -0,0 +1,510 @@
+#pragma once
+
+/**
+ * @file memory_reclamation.hpp
+ * @brief Safe memory reclamation for lock-free linked data structures
+ *
+ * A lock-free structure cannot `delete` a node it has just unlinked: other
+ * threads may have loaded a pointer to it a moment earlier and still be
+ * dereferencing it. The node has to be *retired* and freed only once no
+ * thread can still hold a reference.
+ *
+ * Two domains with the same interface are provided:
+ *
+ * 1. EpochDomain (EBR) - readers announce "I am inside a critical section
+ *    that started in epoch e". Retired nodes are freed two epochs later.
+ *    Reads cost one store per critical section, but one stalled reader
+ *    blocks all reclamation.
+ * 2. HazardPointerDomain - readers publish each pointer they dereference.
+ *    Reads cost a store + reload per pointer, but garbage is bounded even
+ *    if a reader stalls forever.
+ *
+ * Common interface:
+ * @code
+ *   Domain::Guard guard(domain);          // Enter a read-side section
+ *   Node* n = guard.protect(head_);       // Safe to dereference until guard dies
+ *   domain.retire(n);                     // delete n once unreachable by readers
+ *   domain.retire(p, &custom_deleter);    // Type-erased form
+ * @endcode
+ *
+ * Retired nodes are buffered per thread and reclaimed in batches.
+ */
+
+#include "concurrency_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace hpc::concurrency {
+
+/// Maximum number of threads simultaneously using a reclamation domain
+constexpr size_t MAX_RECLAMATION_THREADS = 256;
+
+/// Number of retirements between reclamation attempts
+constexpr size_t RECLAIM_BATCH = 64;
+
+/// Type-erased deleter used by retire()
+using Deleter = void (*)(void*);
+
+namespace detail {
+
+/// A retired object waiting to be freed
+struct Retired {
+    void* ptr;
+    Deleter deleter;
+    uint64_t epoch;  // Only used by EpochDomain
+};
+
+/**
+ * Process-wide table of thread indices
+ *
+ * Each live thread owns one index in [0, MAX_RECLAMATION_THREADS) for its
+ * lifetime; domains use it to find the thread's record without hashing.
+ * The index is released when the thread exits and may be reused by a new
+ * thread, which then inherits the previous owner's leftover garbage.
+ */
+class ThreadIndexRegistry {
+public:
+    static size_t acquire() {
+        auto& used = slots();
+        for (size_t i = 0; i < MAX_RECLAMATION_THREADS; ++i) {
+            bool expected = false;
+            if (!used[i].load(std::memory_order_relaxed) &&
+                used[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                size_t hw = high_water().load(std::memory_order_relaxed);
+                while (hw < i + 1 &&
+                       !high_water().compare_exchange_weak(hw, i + 1, std::memory_order_release)) {
+                }
+                return i;
+            }
+        }
+        throw std::runtime_error("Too many threads using memory reclamation");
+    }
+
+    static void release(size_t index) {
+        slots()[index].store(false, std::memory_order_release);
+    }
+
+    /// One past the highest index ever handed out (bounds record scans)
+    static size_t active_bound() {
+        return high_water().load(std::memory_order_acquire);
+    }
+
+private:
+    static std::array<std::atomic<bool>, MAX_RECLAMATION_THREADS>& slots() {
+        static std::array<std::atomic<bool>, MAX_RECLAMATION_THREADS> used{};
+        return used;
+    }
+
+    static std::atomic<size_t>& high_water() {
+        static std::atomic<size_t> hw{0};
+        return hw;
+    }
+};
+
+inline size_t thread_index() {
+    struct Holder {
+        size_t index = ThreadIndexRegistry::acquire();
+        ~Holder() { ThreadIndexRegistry::release(index); }
+    };
+    thread_local Holder holder;
+    return holder.index;
+}
+
+template<typename T>
+void delete_object(void* ptr) {
+    delete static_cast<T*>(ptr);
+}
+
+inline void free_all(std::vector<Retired>& list) {
+    for (const Retired& r : list) {
+        r.deleter(r.ptr);
+    }
+    list.clear();
+}
+
+} // namespace detail
+
+// ============================================================================
+// Epoch-based reclamation
+// ============================================================================
+
+/**
+ * Epoch-based reclamation domain
+ *
+ * The global epoch only advances when every thread inside a critical
+ * section has observed the current epoch. An object retired in epoch e can
+ * therefore only be referenced by threads that entered in epoch <= e, and
+ * all of those have left once the global epoch reaches e + 2.
+ */
+class EpochDomain {
+public:
+    class Guard {
+    public:
+        explicit Guard(EpochDomain& domain) : domain_(domain) {
+            domain_.enter();
+        }
+
+        ~Guard() {
+            domain_.exit();
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        /// Load a shared pointer; it stays valid until the guard is destroyed
+        template<typename T>
+        T* protect(const std::atomic<T*>& src, size_t /*slot*/ = 0) {
+            return src.load(std::memory_order_acquire);
+        }
+
+        /// No-op: the whole critical section is protected
+        void clear(size_t /*slot*/ = 0) {}
+
+    private:
+        EpochDomain& domain_;
+    };
+
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /// Frees all outstanding garbage; no thread may be using the domain
+    ~EpochDomain() {
+        for (auto& record : records_) {
+            detail::free_all(record.retired);
+        }
+    }
+
+    template<typename T>
+    void retire(T* ptr) {
+        retire(ptr, &detail::delete_object<T>);
+    }
+
+    void retire(void* ptr, Deleter deleter) {
+        Record& record = records_[detail::thread_index()];
+        record.retired.push_back({ptr, deleter, global_epoch_.load(std::memory_order_seq_cst)});
+        if (record.retired.size() % RECLAIM_BATCH == 0) {
+            try_advance();
+            reclaim(record);
+        }
+    }
+
+    /**
+     * Try to advance the epoch and free this thread's eligible garbage
+     * @return number of objects still pending for this thread
+     */
+    size_t collect() {
+        Record& record = records_[detail::thread_index()];
+        try_advance();
+        try_advance();
+        reclaim(record);
+        return record.retired.size();
+    }
+
+    /// Objects retired by the calling thread that are not yet freed
+    size_t pending() const {
+        return records_[detail::thread_index()].retired.size();
+    }
+
+    uint64_t epoch() const {
+        return global_epoch_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr uint64_t ACTIVE = 1;  // Low bit of Record::epoch
+
+    struct alignas(CACHE_LINE_SIZE) Record {
+        std::atomic<uint64_t> epoch{0};  // (epoch << 1) | ACTIVE, or 0 when idle
+        uint32_t nesting = 0;
+        std::vector<detail::Retired> retired;
+    };
+
+    void enter() {
+        Record& record = records_[detail::thread_index()];
+        if (record.nesting++ > 0) {
+            return;
+        }
+        for (;;) {
+            const uint64_t e = global_epoch_.load(std::memory_order_seq_cst);
+            record.epoch.store((e << 1) | ACTIVE, std::memory_order_seq_cst);
+            // Re-check: if the epoch moved while we announced, announce again
+            if (global_epoch_.load(std::memory_order_seq_cst) == e) {
+                return;
+            }
+        }
+    }
+
+    void exit() {
+        Record& record = records_[detail::thread_index()];
+        if (--record.nesting == 0) {
+            record.epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    bool try_advance() {
+        uint64_t e = global_epoch_.load(std::memory_order_seq_cst);
+        const size_t bound = detail::ThreadIndexRegistry::active_bound();
+        for (size_t i = 0; i < bound; ++i) {
+            const uint64_t local = records_[i].epoch.load(std::memory_order_seq_cst);
+            if ((local & ACTIVE) && (local >> 1) != e) {
+                return false;  // Straggler still in an older epoch
+            }
+        }
+        return global_epoch_.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+    }
+
+    void reclaim(Record& record) {
+        const uint64_t e = global_epoch_.load(std::memory_order_acquire);
+        auto safe_end = std::partition(record.retired.begin(), record.retired.end(),
+                                       [e](const detail::Retired& r) { return r.epoch + 2 <= e; });
+        for (auto it = record.retired.begin(); it != safe_end; ++it) {
+            it->deleter(it->ptr);
+        }
+        record.retired.erase(record.retired.begin(), safe_end);
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> global_epoch_{0};
+    std::array<Record, MAX_RECLAMATION_THREADS> records_{};
+};
+
+// ============================================================================
+// Hazard pointers
+// ============================================================================
+
+/**
+ * Hazard-pointer reclamation domain
+ *
+ * Each Guard owns SLOTS hazard pointers. A thread's record holds
+ * MAX_GUARD_DEPTH groups of them, and a Guard takes the next free group,
+ * so a guard nested inside another (a TreiberStack::pop() inside a caller's
+ * guarded section) clears only its own hazards and leaves the outer ones
+ * published. Guards are scoped: a thread destroys them in reverse order.
+ *
+ * When a thread's retired list reaches the scan threshold it snapshots
+ * every published hazard and frees each retired object that is not in the
+ * snapshot. At most one hazard per slot can survive a scan, so per-thread
+ * garbage never exceeds the threshold no matter how long readers stall.
+ */
+class HazardPointerDomain {
+    struct Record;
+
+public:
+    /// Hazard pointers per Guard
+    static constexpr size_t SLOTS = 4;
+    /// Guards one thread may have alive at once
+    static constexpr size_t MAX_GUARD_DEPTH = 4;
+
+    class Guard {
+    public:
+        explicit Guard(HazardPointerDomain& domain)
+            : record_(domain.records_[detail::thread_index()]) {
+            if (record_.depth == MAX_GUARD_DEPTH) {
+                throw std::runtime_error("Too many nested hazard pointer guards");
+            }
+            hazards_ = record_.hazards.data() + record_.depth++ * SLOTS;
+        }
+
+        ~Guard() {
+            for (size_t i = 0; i < SLOTS; ++i) {
+                hazards_[i].store(nullptr, std::memory_order_release);
+            }
+            --record_.depth;
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        /**
+         * Publish and validate a pointer loaded from @p src
+         *
+         * The pointer is re-read after publishing the hazard: if it is
+         * unchanged, any retire() of it happened after the hazard was
+         * visible, so the scan will see it.
+         */
+        template<typename T>
+        T* protect(const std::atomic<T*>& src, size_t slot = 0) {
+            assert(slot < SLOTS);
+            T* ptr = src.load(std::memory_order_relaxed);
+            for (;;) {
+                hazards_[slot].store(ptr, std::memory_order_seq_cst);
+                T* again = src.load(std::memory_order_seq_cst);
+                if (again == ptr) {
+                    return ptr;
+                }
+                ptr = again;
+            }
+        }
+
+        void clear(size_t slot = 0) {
+            assert(slot < SLOTS);
+            hazards_[slot].store(nullptr, std::memory_order_release);
+        }
+
+    private:
+        Record& record_;
+        std::atomic<void*>* hazards_;
+    };
+
+    HazardPointerDomain() = default;
+    HazardPointerDomain(const HazardPointerDomain&) = delete;
+    HazardPointerDomain& operator=(const HazardPointerDomain&) = delete;
+
+    /// Frees all outstanding garbage; no thread may be using the domain
+    ~HazardPointerDomain() {
+        for (auto& record : records_) {
+            detail::free_all(record.retired);
+        }
+    }
+
+    template<typename T>
+    void retire(T* ptr) {
+        retire(ptr, &detail::delete_object<T>);
+    }
+
+    void retire(void* ptr, Deleter deleter) {
+        Record& record = records_[detail::thread_index()];
+        record.retired.push_back({ptr, deleter, 0});
+        if (record.retired.size() >= scan_threshold()) {
+            scan(record);
+        }
+    }
+
+    /**
+     * Free every retired object of this thread that is not hazardous
+     * @return number of objects still pending for this thread
+     */
+    size_t collect() {
+        Record& record = records_[detail::thread_index()];
+        scan(record);
+        return record.retired.size();
+    }
+
+    size_t pending() const {
+        return records_[detail::thread_index()].retired.size();
+    }
+
+    /// Per-thread garbage bound: retire() scans once this many are pending
+    static size_t scan_threshold() {
+        return std::max(RECLAIM_BATCH, 2 * HAZARDS_PER_THREAD * detail::ThreadIndexRegistry::active_bound());
+    }
+
+private:
+    static constexpr size_t HAZARDS_PER_THREAD = SLOTS * MAX_GUARD_DEPTH;
+
+    struct alignas(CACHE_LINE_SIZE) Record {
+        std::array<std::atomic<void*>, HAZARDS_PER_THREAD> hazards{};
+        size_t depth = 0;  // Live guards; only the owning thread touches it
+        std::vector<detail::Retired> retired;
+    };
+
+    void scan(Record& record) {
+        std::vector<void*> hazards;
+        const size_t bound = detail::ThreadIndexRegistry::active_bound();
+        hazards.reserve(bound * HAZARDS_PER_THREAD);
+        for (size_t i = 0; i < bound; ++i) {
+            for (const auto& h : records_[i].hazards) {
+                if (void* p = h.load(std::memory_order_seq_cst)) {
+                    hazards.push_back(p);
+                }
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        auto keep_end = std::partition(record.retired.begin(), record.retired.end(),
+                                       [&hazards](const detail::Retired& r) {
+                                           return std::binary_search(hazards.begin(),
+                                                                     hazards.end(), r.ptr);
+                                       });
+        for (auto it = keep_end; it != record.retired.end(); ++it) {
+            it->deleter(it->ptr);
+        }
+        record.retired.erase(keep_end, record.retired.end());
+    }
+
+    std::array<Record, MAX_RECLAMATION_THREADS> records_{};
+};
+
+// ============================================================================
+// Treiber stack
+// ============================================================================
+
+/**
+ * Lock-free LIFO stack with pluggable memory reclamation
+ *
+ * pop() unlinks the head node with a CAS; the node is retired through the
+ * domain instead of deleted, so a concurrent pop() that already loaded the
+ * old head can still safely read head->next. Because a protected node is
+ * never freed (and so never reallocated), the classic ABA problem of
+ * Treiber stacks cannot occur either.
+ *
+ * @tparam Domain EpochDomain or HazardPointerDomain
+ */
+template<typename T, typename Domain>
+class TreiberStack {
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+public:
+    explicit TreiberStack(Domain& domain) : domain_(domain) {}
+
+    TreiberStack(const TreiberStack&) = delete;
+    TreiberStack& operator=(const TreiberStack&) = delete;
+
+    /// Not thread-safe; no other thread may access the stack
+    ~TreiberStack() {
+        Node* node = head_.load(std::memory_order_relaxed);
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    void push(T value) {
+        Node* node = new Node{std::move(value), head_.load(std::memory_order_relaxed)};
+        while (!head_.compare_exchange_weak(node->next, node,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+            // node->next reloaded by compare_exchange_weak
+        }
+    }
+
+    std::optional<T> pop() {
+        typename Domain::Guard guard(domain_);
+        for (;;) {
+            Node* head = guard.protect(head_);
+            if (!head) {
+                return std::nullopt;
+            }
+            Node* next = head->next;  // Safe: head is protected
+            if (head_.compare_exchange_weak(head, next,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+                std::optional<T> value(std::move(head->value));
+                guard.clear();
+                domain_.retire(head);
+                return value;
+            }
+        }
+    }
+
+    /// Approximate (may be stale)
+    bool empty() const {
+        return head_.load(std::memory_order_relaxed) == nullptr;
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> head_{nullptr};
+    Domain& domain_;
+};
+
+} // namespace hpc::concurrency
@@ -0,0 +1,475 @@
+#pragma once
+
+/**
+ * @file parallel_algorithms.hpp
+ * @brief Reusable parallel sort, partition and scan (hpc::parallel)
+ *
+ * All algorithms follow the same block-parallel shape: split the input
+ * into one contiguous block per thread, compute per-block summaries in
+ * parallel (histograms, counts, partial sums), turn them into offsets with
+ * a tiny serial prefix pass, then let every block write its own disjoint
+ * output range in parallel. No atomics on the data path, and the output
+ * order is deterministic.
+ *
+ * - radix_sort:       LSD, 8-bit digits; integer and floating-point keys
+ * - sample_sort:      any strict weak ordering; buckets sorted with std::sort
+ * - stable_partition: order-preserving on both sides
+ * - inclusive_scan / exclusive_scan: three-pass, op must be associative
+ *
+ * Each call takes a Backend: a persistent ThreadPool or OpenMP (when the
+ * translation unit is compiled with OpenMP). Exceptions thrown by user
+ * callables propagate with the ThreadPool backend; under OpenMP they
+ * terminate, as with any exception escaping a parallel region.
+ */
+
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc::parallel {
+
+// ============================================================================
+// Execution backends
+// ============================================================================
+
+enum class Backend {
+    ThreadPool,  ///< hpc::concurrency::ThreadPool::global()
+    OpenMP       ///< #pragma omp parallel for (ThreadPool without OpenMP)
+};
+
+inline Backend default_backend() {
+#ifdef _OPENMP
+    return Backend::OpenMP;
+#else
+    return Backend::ThreadPool;
+#endif
+}
+
+/// Number of threads the backend will use
+inline unsigned int num_threads(Backend backend) {
+#ifdef _OPENMP
+    if (backend == Backend::OpenMP) {
+        return static_cast<unsigned int>(omp_get_max_threads());
+    }
+#else
+    (void)backend;
+#endif
+    return hpc::concurrency::ThreadPool::global().size();
+}
+
+/// Run fn(0) .. fn(num_tasks - 1) in parallel and wait for all of them
+template<typename Func>
+void run_tasks(size_t num_tasks, Func&& fn, Backend backend) {
+#ifdef _OPENMP
+    if (backend == Backend::OpenMP) {
+        const auto n = static_cast<long long>(num_tasks);
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long t = 0; t < n; ++t) {
+            fn(static_cast<size_t>(t));
+        }
+        return;
+    }
+#else
+    (void)backend;
+#endif
+    hpc::concurrency::ThreadPool::global().run(num_tasks, std::forward<Func>(fn));
+}
+
+namespace detail {
+
+/// Below this many elements per block, parallelism costs more than it saves
+constexpr size_t MIN_BLOCK_SIZE = 16384;
+
+/// Contiguous [begin, end) split of n elements into num_blocks blocks
+struct Blocks {
+    size_t n;
+    size_t count;
+
+    Blocks(size_t n_, Backend backend)
+        : n(n_),
+          count(std::clamp<size_t>(n_ / MIN_BLOCK_SIZE, 1, num_threads(backend))) {}
+
+    size_t begin(size_t b) const { return n * b / count; }
+    size_t end(size_t b) const { return n * (b + 1) / count; }
+};
+
+} // namespace detail
+
+// ============================================================================
+// Scan
+// ============================================================================
+
+/**
+ * Inclusive prefix combination: out[i] = in[0] op ... op in[i]
+ *
+ * @p d_first may equal @p first (in-place). @p op must be associative; it
+ * need not be commutative.
+ */
+template<std::random_access_iterator InIt, std::random_access_iterator OutIt,
+         typename BinaryOp = std::plus<>>
+OutIt inclusive_scan(InIt first, InIt last, OutIt d_first, BinaryOp op = {},
+                     Backend backend = default_backend()) {
+    using T = typename std::iterator_traits<InIt>::value_type;
+    const auto n = static_cast<size_t>(last - first);
+    if (n == 0) {
+        return d_first;
+    }
+    const detail::Blocks blocks(n, backend);
+
+    // Pass 1: reduce each block (except the last, whose total nobody needs)
+    std::vector<T> sums(blocks.count, first[0]);
+    run_tasks(blocks.count - 1, [&](size_t b) {
+        const size_t lo = blocks.begin(b);
+        T acc = first[static_cast<std::ptrdiff_t>(lo)];
+        for (size_t i = lo + 1, hi = blocks.end(b); i < hi; ++i) {
+            acc = op(acc, first[static_cast<std::ptrdiff_t>(i)]);
+        }
+        sums[b] = acc;
+    }, backend);
+
+    // Pass 2: carry into block b = combination of blocks 0..b-1
+    for (size_t b = 2; b < blocks.count; ++b) {
+        sums[b - 1] = op(sums[b - 2], sums[b - 1]);
+    }
+
+    // Pass 3: scan each block starting from its carry
+    run_tasks(blocks.count, [&](size_t b) {
+        const size_t lo = blocks.begin(b);
+        T acc = first[static_cast<std::ptrdiff_t>(lo)];
+        if (b > 0) {
+            acc = op(sums[b - 1], acc);
+        }
+        d_first[static_cast<std::ptrdiff_t>(lo)] = acc;
+        for (size_t i = lo + 1, hi = blocks.end(b); i < hi; ++i) {
+            acc = op(acc, first[static_cast<std::ptrdiff_t>(i)]);
+            d_first[static_cast<std::ptrdiff_t>(i)] = acc;
+        }
+    }, backend);
+
+    return d_first + static_cast<std::ptrdiff_t>(n);
+}
+
+/**
+ * Exclusive prefix combination: out[0] = init, out[i] = init op in[0] op ... op in[i-1]
+ */
+template<std::random_access_iterator InIt, std::random_access_iterator OutIt, typename T,
+         typename BinaryOp = std::plus<>>
+OutIt exclusive_scan(InIt first, InIt last, OutIt d_first, T init, BinaryOp op = {},
+                     Backend backend = default_backend()) {
+    const auto n = static_cast<size_t>(last - first);
+    if (n == 0) {
+        return d_first;
+    }
+    const detail::Blocks blocks(n, backend);
+
+    std::vector<T> carries(blocks.count, init);
+    run_tasks(blocks.count - 1, [&](size_t b) {
+        const size_t lo = blocks.begin(b);
+        T acc = first[static_cast<std::ptrdiff_t>(lo)];
+        for (size_t i = lo + 1, hi = blocks.end(b); i < hi; ++i) {
+            acc = op(acc, first[static_cast<std::ptrdiff_t>(i)]);
+        }
+        carries[b + 1] = acc;
+    }, backend);
+
+    for (size_t b = 1; b < blocks.count; ++b) {
+        carries[b] = op(carries[b - 1], carries[b]);
+    }
+
+    run_tasks(blocks.count, [&](size_t b) {
+        T acc = carries[b];
+        for (size_t i = blocks.begin(b), hi = blocks.end(b); i < hi; ++i) {
+            T next = op(acc, first[static_cast<std::ptrdiff_t>(i)]);  // Read before an in-place write
+            d_first[static_cast<std::ptrdiff_t>(i)] = std::move(acc);
+            acc = std::move(next);
+        }
+    }, backend);
+
+    return d_first + static_cast<std::ptrdiff_t>(n);
+}
+
+// ============================================================================
+// Radix sort
+// ============================================================================
+
+namespace detail {
+
+template<size_t Bytes> struct UnsignedOfSize;
+template<> struct UnsignedOfSize<1> { using type = uint8_t; };
+template<> struct UnsignedOfSize<2> { using type = uint16_t; };
+template<> struct UnsignedOfSize<4> { using type = uint32_t; };
+template<> struct UnsignedOfSize<8> { using type = uint64_t; };
+
+/// Map a key to an unsigned integer with the same ordering
+template<typename T>
+struct RadixKey {
+    using Bits = typename UnsignedOfSize<sizeof(T)>::type;
+    static constexpr Bits SIGN = Bits(Bits{1} << (sizeof(T) * 8 - 1));
+
+    static Bits encode(T value) {
+        const Bits bits = std::bit_cast<Bits>(value);
+        if constexpr (std::is_floating_point_v<T>) {
+            // Negative: flip everything (larger magnitude sorts lower);
+            // positive: set the sign bit so it sorts above all negatives
+            return (bits & SIGN) ? Bits(~bits) : Bits(bits | SIGN);
+        } else if constexpr (std::is_signed_v<T>) {
+            return Bits(bits ^ SIGN);
+        } else {
+            return bits;
+        }
+    }
+};
+
+template<typename T>
+concept RadixSortable = (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+                        (std::is_floating_point_v<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+
+constexpr size_t RADIX_BITS = 8;
+constexpr size_t RADIX_BUCKETS = size_t{1} << RADIX_BITS;
+constexpr size_t RADIX_SMALL = 256;
+
+} // namespace detail
+
+/**
+ * Sort integer or floating-point keys in ascending order
+ *
+ * Floats are ordered by their IEEE-754 bits: -0.0 before +0.0, and NaNs
+ * at the ends (negative NaNs first, positive NaNs last). Passes where
+ * every key has the same digit are skipped, so small-range data costs
+ * fewer passes. Uses an n-element scratch buffer.
+ */
+template<std::contiguous_iterator It>
+    requires detail::RadixSortable<std::iter_value_t<It>>
+void radix_sort(It first, It last, Backend backend = default_backend()) {
+    using T = std::iter_value_t<It>;
+    using Key = detail::RadixKey<T>;
+    const auto n = static_cast<size_t>(last - first);
+    T* data = std::to_address(first);
+
+    if (n < detail::RADIX_SMALL) {
+        std::sort(data, data + n, [](T a, T b) { return Key::encode(a) < Key::encode(b); });
+        return;
+    }
+
+    std::unique_ptr<T[]> scratch(new T[n]);
+    T* src = data;
+    T* dst = scratch.get();
+    const detail::Blocks blocks(n, backend);
+    std::vector<std::array<size_t, detail::RADIX_BUCKETS>> offsets(blocks.count);
+
+    for (size_t shift = 0; shift < sizeof(T) * 8; shift += detail::RADIX_BITS) {
+        auto digit = [shift](T v) {
+            return static_cast<size_t>((Key::encode(v) >> shift) & (detail::RADIX_BUCKETS - 1));
+        };
+
+        run_tasks(blocks.count, [&](size_t b) {
+            auto& hist = offsets[b];
+            hist.fill(0);
+            for (size_t i = blocks.begin(b), hi = blocks.end(b); i < hi; ++i) {
+                ++hist[digit(src[i])];
+            }
+        }, backend);
+
+        // Digit-major, block-minor offsets keep the pass stable
+        size_t running = 0;
+        bool trivial = false;
+        for (size_t d = 0; d < detail::RADIX_BUCKETS; ++d) {
+            size_t digit_total = 0;
+            for (size_t b = 0; b < blocks.count; ++b) {
+                const size_t count = offsets[b][d];
+                offsets[b][d] = running;
+                running += count;
+                digit_total += count;
+            }
+            trivial = trivial || digit_total == n;
+        }
+        if (trivial) {
+            continue;  // Every key has this digit; the pass would be a copy
+        }
+
+        run_tasks(blocks.count, [&](size_t b) {
+            auto& next = offsets[b];
+            for (size_t i = blocks.begin(b), hi = blocks.end(b); i < hi; ++i) {
+                dst[next[digit(src[i])]++] = src[i];
+            }
+        }, backend);
+        std::swap(src, dst);
+    }
+
+    if (src != data) {
+        run_tasks(blocks.count, [&](size_t b) {
+            std::copy(src + blocks.begin(b), src + blocks.end(b), data + blocks.begin(b));
+        }, backend);
+    }
+}
+
+// ============================================================================
+// Sample sort
+// ============================================================================
+
+namespace detail {
+
+constexpr size_t SAMPLE_SORT_CUTOFF = 1 << 15;
+constexpr size_t BUCKETS_PER_THREAD = 4;
+constexpr size_t OVERSAMPLING = 32;
+
+} // namespace detail
+
+/**
+ * Sort with an arbitrary strict weak ordering (not stable)
+ *
+ * Picks splitters from a sorted random sample, moves every element into
+ * its bucket (one scratch buffer, no per-bucket allocation), then sorts
+ * the buckets in parallel with std::sort. Requires T to be default
+ * constructible and move assignable. Inputs dominated by one repeated
+ * key put most elements in one bucket and degrade towards std::sort.
+ */
+template<std::random_access_iterator It, typename Compare = std::less<>>
+void sample_sort(It first, It last, Compare comp = {}, Backend backend = default_backend()) {
+    using T = std::iter_value_t<It>;
+    const auto n = static_cast<size_t>(last - first);
+    const unsigned int threads = num_threads(backend);
+    if (n < detail::SAMPLE_SORT_CUTOFF || threads <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    const size_t num_buckets = std::min<size_t>(threads * detail::BUCKETS_PER_THREAD, 1u << 15);
+    auto at = [first](size_t i) -> decltype(auto) { return first[static_cast<std::ptrdiff_t>(i)]; };
+
+    // Splitters point into the input, which is unchanged until the scatter
+    std::vector<size_t> sample(num_buckets * detail::OVERSAMPLING);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t& s : sample) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        s = static_cast<size_t>(state % n);
+    }
+    std::sort(sample.begin(), sample.end(),
+              [&](size_t a, size_t b) { return comp(at(a), at(b)); });
+    std::vector<size_t> splitters(num_buckets - 1);
+    for (size_t i = 0; i + 1 < num_buckets; ++i) {
+        splitters[i] = sample[(i + 1) * detail::OVERSAMPLING];
+    }
+
+    const detail::Blocks blocks(n, backend);
+    std::vector<uint16_t> bucket_of(n);
+    std::vector<std::vector<size_t>> offsets(blocks.count, std::vector<size_t>(num_buckets));
+
+    run_tasks(blocks.count, [&](size_t b) {
+        auto& count = offsets[b];
+        for (size_t i = blocks.begin(b), hi = blocks.end(b); i < hi; ++i) {
+            const auto it = std::upper_bound(splitters.begin(), splitters.end(), i,
+                                             [&](size_t x, size_t s) { return comp(at(x), at(s)); });
+            const auto bucket = static_cast<uint16_t>(it - splitters.begin());
+            bucket_of[i] = bucket;
+            ++count[bucket];
+        }
+    }, backend);
+
+    std::vector<size_t> bucket_start(num_buckets + 1);
+    size_t running = 0;
+    for (size_t k = 0; k < num_buckets; ++k) {
+        bucket_start[k] = running;
+        for (size_t b = 0; b < blocks.count; ++b) {
+            const size_t count = offsets[b][k];
+            offsets[b][k] = running;
+            running += count;
+        }
+    }
+    bucket_start[num_buckets] = n;
+
+    std::vector<T> buffer(n);
+    run_tasks(blocks.count, [&](size_t b) {
+        auto& next = offsets[b];
+        for (size_t i = blocks.begin(b), hi = blocks.end(b); i < hi; ++i) {
+            buffer[next[bucket_of[i]]++] = std::move(at(i));
+        }
+    }, backend);
+
+    run_tasks(num_buckets, [&](size_t k) {
+        std::sort(buffer.begin() + static_cast<std::ptrdiff_t>(bucket_start[k]),
+                  buffer.begin() + static_cast<std::ptrdiff_t>(bucket_start[k + 1]), comp);
+    }, backend);
+
+    run_tasks(blocks.count, [&](size_t b) {
+        std::move(buffer.begin() + static_cast<std::ptrdiff_t>(blocks.begin(b)),
+                  buffer.begin() + static_cast<std::ptrdiff_t>(blocks.end(b)),
+                  first + static_cast<std::ptrdiff_t>(blocks.begin(b)));
+    }, backend);
+}
+
+// ============================================================================
+// Stable partition
+// ============================================================================
+
+/**
+ * Move elements satisfying @p pred before the others, keeping the
+ * relative order within both groups
+ *
+ * @p pred is called exactly once per element. Requires T to be default
+ * constructible and move assignable.
+ * @return Iterator to the first element of the second group
+ */
+template<std::random_access_iterator It, typename Pred>
+It stable_partition(It first, It last, Pred pred, Backend backend = default_backend()) {
+    using T = std::iter_value_t<It>;
+    const auto n = static_cast<size_t>(last - first);
+    if (n == 0) {
+        return first;
+    }
+    const detail::Blocks blocks(n, backend);
+    auto at = [first](size_t i) -> decltype(auto) { return first[static_cast<std::ptrdiff_t>(i)]; };
+
+    std::vector<unsigned char> flags(n);
+    std::vector<size_t> true_offset(blocks.count);
+    run_tasks(blocks.count, [&](size_t b) {
+        size_t count = 0;
+        for (size_t i = blocks.begin(b), hi = blocks.end(b); i < hi; ++i) {
+            flags[i] = pred(std::as_const(at(i))) ? 1 : 0;
+            count += flags[i];
+        }
+        true_offset[b] = count;
+    }, backend);
+
+    // Trues of block b start after the trues of blocks 0..b-1; falses
+    // start after all trues plus the falses of blocks 0..b-1
+    size_t total_true = 0;
+    for (size_t b = 0; b < blocks.count; ++b) {
+        const size_t count = true_offset[b];
+        true_offset[b] = total_true;
+        total_true += count;
+    }
+
+    std::vector<T> buffer(n);
+    run_tasks(blocks.count, [&](size_t b) {
+        size_t t = true_offset[b];
+        size_t f = total_true + (blocks.begin(b) - true_offset[b]);
+        for (size_t i = blocks.begin(b), hi = blocks.end(b); i < hi; ++i) {
+            buffer[flags[i] ? t++ : f++] = std::move(at(i));
+        }
+    }, backend);
+
+    run_tasks(blocks.count, [&](size_t b) {
+        std::move(buffer.begin() + static_cast<std::ptrdiff_t>(blocks.begin(b)),
+                  buffer.begin() + static_cast<std::ptrdiff_t>(blocks.end(b)),
+                  first + static_cast<std::ptrdiff_t>(blocks.begin(b)));
+    }, backend);
+
+    return first + static_cast<std::ptrdiff_t>(total_true);
+}
+
+} // namespace hpc::parallel
@@ -0,0 +1,237 @@
+#pragma once
+
+/**
+ * @file rw_lock.hpp
+ * @brief Read-mostly synchronization: reader-writer spin lock and seqlock
+ *
+ * This header provides:
+ * 1. RWSpinLock - reader-writer lock with per-slot reader counters, so
+ *    readers on different cores never write the same cache line
+ * 2. SeqLock<T> - sequence lock for trivially copyable snapshots where
+ *    readers never write shared memory at all
+ */
+
+#include "concurrency_utils.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace hpc::concurrency {
+
+/**
+ * Reader-writer spin lock with distributed reader counters
+ *
+ * A classic reader-writer lock keeps a single reader count, so every
+ * lock_shared() is an RMW on one cache line and readers serialize on it
+ * just like they would on an exclusive lock. Here each thread is assigned
+ * one of READER_SLOTS padded counters (round-robin on first use, which
+ * approximates one counter per core), so concurrent readers touch
+ * disjoint cache lines.
+ *
+ * Writers pay for this: lock() has to scan every slot. This is the right
+ * trade-off for data that is read millions of times per write.
+ *
+ * Writers are preferred: a reader that observes a pending writer backs
+ * out and waits, so a steady stream of readers cannot starve a writer.
+ *
+ * Satisfies the SharedLockable requirements, so std::shared_lock and
+ * std::unique_lock can be used as RAII guards.
+ */
+class RWSpinLock {
+public:
+    static constexpr size_t READER_SLOTS = 64;
+
+    RWSpinLock() = default;
+    RWSpinLock(const RWSpinLock&) = delete;
+    RWSpinLock& operator=(const RWSpinLock&) = delete;
+
+    void lock_shared() {
+        std::atomic<int64_t>& slot = readers_[reader_slot()].value;
+        for (;;) {
+            // seq_cst on both sides: the reader's increment and the writer's
+            // flag store must not be reordered with the subsequent loads
+            slot.fetch_add(1, std::memory_order_seq_cst);
+            if (!writer_.load(std::memory_order_seq_cst)) {
+                return;
+            }
+            // A writer is active or pending - back out and wait
+            slot.fetch_sub(1, std::memory_order_release);
+            while (writer_.load(std::memory_order_relaxed)) {
+                cpu_pause();
+            }
+        }
+    }
+
+    bool try_lock_shared() {
+        std::atomic<int64_t>& slot = readers_[reader_slot()].value;
+        slot.fetch_add(1, std::memory_order_seq_cst);
+        if (!writer_.load(std::memory_order_seq_cst)) {
+            return true;
+        }
+        slot.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    void unlock_shared() {
+        readers_[reader_slot()].value.fetch_sub(1, std::memory_order_release);
+    }
+
+    void lock() {
+        while (writer_.exchange(true, std::memory_order_seq_cst)) {
+            while (writer_.load(std::memory_order_relaxed)) {
+                cpu_pause();
+            }
+        }
+        // Wait for readers that got in before the flag was raised
+        for (auto& slot : readers_) {
+            while (slot.value.load(std::memory_order_seq_cst) != 0) {
+                cpu_pause();
+            }
+        }
+    }
+
+    bool try_lock() {
+        if (writer_.exchange(true, std::memory_order_seq_cst)) {
+            return false;
+        }
+        for (auto& slot : readers_) {
+            if (slot.value.load(std::memory_order_seq_cst) != 0) {
+                writer_.store(false, std::memory_order_release);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void unlock() {
+        writer_.store(false, std::memory_order_release);
+    }
+
+private:
+    /// Slot index of the calling thread, stable for the thread's lifetime
+    /// so that unlock_shared() always decrements the counter lock_shared()
+    /// incremented
+    static size_t reader_slot() {
+        static std::atomic<size_t> next_slot{0};
+        thread_local const size_t slot =
+            next_slot.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+        return slot;
+    }
+
+    std::array<AlignedCounter, READER_SLOTS> readers_{};
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> writer_{false};
+};
+
+/**
+ * Sequence lock for small trivially copyable snapshots
+ *
+ * Readers never write shared memory: they read the sequence number, copy
+ * the payload and re-check the sequence number. An odd or changed sequence
+ * means a write overlapped the copy and the read is retried.
+ *
+ * - try_load() makes exactly one attempt and is wait-free
+ * - load() retries until it gets a consistent copy; it only spins while a
+ *   write is in progress, so it is wait-free whenever no writer is active
+ * - store() serializes writers with a CAS on the sequence number
+ *
+ * The payload is kept in atomic words rather than a plain T, so the racy
+ * copy performed by readers is well-defined (and TSan-clean). On x86 the
+ * acquire/release word accesses compile to plain moves.
+ */
+template<typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "SeqLock requires a trivially copyable type");
+
+public:
+    SeqLock() : SeqLock(T{}) {}
+
+    explicit SeqLock(const T& value) {
+        write_words(value);
+    }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /**
+     * Single read attempt
+     * @return true and fills @p out if no write overlapped the copy
+     */
+    bool try_load(T& out) const {
+        const uint64_t seq0 = seq_.load(std::memory_order_acquire);
+        if (seq0 & 1) {
+            return false;  // Write in progress
+        }
+
+        // Acquire loads keep the second sequence load after the copy, and
+        // pair with the writer's release stores: a reader that sees any new
+        // payload word is guaranteed to also see the changed sequence
+        std::array<uint64_t, WORDS> buffer;
+        for (size_t i = 0; i < WORDS; ++i) {
+            buffer[i] = words_[i].load(std::memory_order_acquire);
+        }
+
+        if (seq_.load(std::memory_order_relaxed) != seq0) {
+            return false;
+        }
+
+        std::memcpy(&out, buffer.data(), sizeof(T));
+        return true;
+    }
+
+    /**
+     * Read a consistent snapshot, retrying while writes overlap
+     */
+    T load() const {
+        T value;
+        while (!try_load(value)) {
+            cpu_pause();
+        }
+        return value;
+    }
+
+    /**
+     * Publish a new value (safe with multiple writers)
+     */
+    void store(const T& value) {
+        uint64_t seq = seq_.load(std::memory_order_relaxed);
+        for (;;) {
+            if (seq & 1) {
+                cpu_pause();
+                seq = seq_.load(std::memory_order_relaxed);
+            } else if (seq_.compare_exchange_weak(seq, seq + 1,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        write_words(value);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * Number of completed writes
+     */
+    uint64_t version() const {
+        return seq_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    void write_words(const T& value) {
+        std::array<uint64_t, WORDS> buffer{};
+        std::memcpy(buffer.data(), &value, sizeof(T));
+        for (size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(buffer[i], std::memory_order_release);
+        }
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> seq_{0};
+    std::array<std::atomic<uint64_t>, WORDS> words_{};
+};
+
+} // namespace hpc::concurrency
@@ -0,0 +1,330 @@
+#pragma once
+
+/**
+ * @file sharded_counter.hpp
+ * @brief Sharded statistical counters built from AlignedCounter slots
+ *
+ * AlignedCounter removes false sharing between *different* counters, but
+ * every increment of one AlignedCounter from every thread still hits the
+ * same cache line (true sharing). The counters here split one logical
+ * value across per-CPU (or per-thread) padded slots:
+ *
+ * - increments are relaxed RMWs on a line that is almost always local
+ * - reads sum the slots, so they are O(shards) - fine for statistics that
+ *   are written constantly and read rarely
+ *
+ * Provided types:
+ * 1. ShardedCounter   - monotonic/additive counter with exact and cached reads
+ * 2. ShardedGauge     - up/down value (queue depth, in-flight requests)
+ * 3. ShardedMax       - high-water mark
+ * 4. ShardedHistogram - log2-bucketed value distribution
+ */
+
+#include "concurrency_utils.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace hpc::concurrency {
+
+/// Default number of slots per sharded counter (power of 2)
+constexpr size_t DEFAULT_COUNTER_SHARDS = 64;
+
+// ============================================================================
+// Shard selection
+// ============================================================================
+
+/**
+ * One slot per thread, assigned round-robin on the thread's first use.
+ * Never migrates, so a thread keeps hitting the same line, but threads
+ * beyond the shard count share slots.
+ */
+struct PerThreadShard {
+    static size_t index() {
+        static std::atomic<size_t> next{0};
+        thread_local const size_t id = next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+};
+
+/**
+ * One slot per CPU the thread is currently running on.
+ *
+ * On Linux this uses sched_getcpu(), which recent glibc answers from the
+ * restartable-sequences (rseq) area without a syscall. Threads can migrate
+ * between reading the CPU and incrementing, so the slot update is still an
+ * atomic RMW - just one that is almost never contended. Falls back to
+ * PerThreadShard elsewhere.
+ */
+struct PerCpuShard {
+    static size_t index() {
+#if defined(__linux__)
+        const int cpu = sched_getcpu();
+        if (cpu >= 0) {
+            return static_cast<size_t>(cpu);
+        }
+#endif
+        return PerThreadShard::index();
+    }
+};
+
+// ============================================================================
+// ShardedCounter
+// ============================================================================
+
+/**
+ * Additive counter spread across padded AlignedCounter slots
+ *
+ * - read_exact() sums every slot. With concurrent writers the result lies
+ *   between the counter's value when the scan started and when it ended;
+ *   once writers are quiescent it is exact.
+ * - read_approx() returns a cached total (one shared load) and only rescans
+ *   when the cache is older than the requested staleness.
+ */
+template<size_t Shards = DEFAULT_COUNTER_SHARDS, typename Selector = PerCpuShard>
+class ShardedCounter {
+    static_assert((Shards & (Shards - 1)) == 0, "Shards must be power of 2");
+
+public:
+    ShardedCounter() = default;
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    void add(int64_t delta) {
+        slots_[Selector::index() & MASK].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void increment() {
+        add(1);
+    }
+
+    int64_t read_exact() const {
+        int64_t sum = 0;
+        for (const auto& slot : slots_) {
+            sum += slot.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    int64_t read_approx(std::chrono::nanoseconds max_staleness =
+                            std::chrono::milliseconds(1)) const {
+        const int64_t now = now_ns();
+        if (now - cached_at_ns_.load(std::memory_order_relaxed) > max_staleness.count()) {
+            cached_total_.store(read_exact(), std::memory_order_relaxed);
+            cached_at_ns_.store(now, std::memory_order_relaxed);
+        }
+        return cached_total_.load(std::memory_order_relaxed);
+    }
+
+    /// Not atomic with respect to concurrent add()
+    void reset() {
+        for (auto& slot : slots_) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+        cached_total_.store(0, std::memory_order_relaxed);
+        cached_at_ns_.store(0, std::memory_order_relaxed);
+    }
+
+    static constexpr size_t shard_count() { return Shards; }
+
+private:
+    static constexpr size_t MASK = Shards - 1;
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::array<AlignedCounter, Shards> slots_{};
+    alignas(CACHE_LINE_SIZE) mutable std::atomic<int64_t> cached_total_{0};
+    mutable std::atomic<int64_t> cached_at_ns_{0};
+};
+
+// ============================================================================
+// ShardedGauge
+// ============================================================================
+
+/**
+ * Value that moves up and down, e.g. in-flight requests
+ *
+ * Individual slots may go negative (a thread can decrement on a different
+ * CPU than it incremented on); only the sum is meaningful.
+ */
+template<size_t Shards = DEFAULT_COUNTER_SHARDS, typename Selector = PerCpuShard>
+class ShardedGauge {
+public:
+    void add(int64_t delta) { counter_.add(delta); }
+    void sub(int64_t delta) { counter_.add(-delta); }
+    void increment() { counter_.add(1); }
+    void decrement() { counter_.add(-1); }
+
+    int64_t read() const { return counter_.read_exact(); }
+
+    int64_t read_approx(std::chrono::nanoseconds max_staleness =
+                            std::chrono::milliseconds(1)) const {
+        return counter_.read_approx(max_staleness);
+    }
+
+    void reset() { counter_.reset(); }
+
+private:
+    ShardedCounter<Shards, Selector> counter_;
+};
+
+// ============================================================================
+// ShardedMax
+// ============================================================================
+
+/**
+ * High-water mark
+ *
+ * update() first does a relaxed load of its slot and only attempts a CAS
+ * when the new value is larger, so once the maximum has settled updates
+ * are read-only and never invalidate other cores' caches.
+ */
+template<size_t Shards = DEFAULT_COUNTER_SHARDS, typename Selector = PerCpuShard>
+class ShardedMax {
+    static_assert((Shards & (Shards - 1)) == 0, "Shards must be power of 2");
+
+public:
+    static constexpr int64_t EMPTY = INT64_MIN;
+
+    ShardedMax() {
+        reset();
+    }
+
+    ShardedMax(const ShardedMax&) = delete;
+    ShardedMax& operator=(const ShardedMax&) = delete;
+
+    void update(int64_t value) {
+        std::atomic<int64_t>& slot = slots_[Selector::index() & (Shards - 1)].value;
+        int64_t current = slot.load(std::memory_order_relaxed);
+        while (value > current &&
+               !slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            // current reloaded by compare_exchange_weak
+        }
+    }
+
+    /// Maximum seen so far, or EMPTY if update() was never called
+    int64_t read() const {
+        int64_t result = EMPTY;
+        for (const auto& slot : slots_) {
+            const int64_t v = slot.load(std::memory_order_relaxed);
+            result = v > result ? v : result;
+        }
+        return result;
+    }
+
+    void reset() {
+        for (auto& slot : slots_) {
+            slot.store(EMPTY, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::array<AlignedCounter, Shards> slots_{};
+};
+
+// ============================================================================
+// ShardedHistogram
+// ============================================================================
+
+/**
+ * Log2-bucketed histogram of non-negative values
+ *
+ * Bucket 0 counts zeros, bucket b (b >= 1) counts values in
+ * [2^(b-1), 2^b). Values beyond the last bucket are clamped into it.
+ * Each shard's buckets are contiguous and cache-line aligned, so a
+ * record() touches one or two lines private to the current CPU.
+ */
+template<size_t Buckets = 64, size_t Shards = DEFAULT_COUNTER_SHARDS,
+         typename Selector = PerCpuShard>
+class ShardedHistogram {
+    static_assert((Shards & (Shards - 1)) == 0, "Shards must be power of 2");
+    static_assert(Buckets >= 2 && Buckets <= 65, "Buckets must be in [2, 65]");
+
+public:
+    using Snapshot = std::array<int64_t, Buckets>;
+
+    ShardedHistogram() = default;
+    ShardedHistogram(const ShardedHistogram&) = delete;
+    ShardedHistogram& operator=(const ShardedHistogram&) = delete;
+
+    static constexpr size_t bucket_for(uint64_t value) {
+        const size_t b = static_cast<size_t>(std::bit_width(value));
+        return b < Buckets ? b : Buckets - 1;
+    }
+
+    /// Smallest value that lands in @p bucket
+    static constexpr uint64_t bucket_lower_bound(size_t bucket) {
+        return bucket == 0 ? 0 : uint64_t{1} << (bucket - 1);
+    }
+
+    void record(uint64_t value) {
+        shards_[Selector::index() & (Shards - 1)]
+            .buckets[bucket_for(value)]
+            .fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot result{};
+        for (const auto& shard : shards_) {
+            for (size_t b = 0; b < Buckets; ++b) {
+                result[b] += shard.buckets[b].load(std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
+    int64_t count() const {
+        int64_t total = 0;
+        for (int64_t c : snapshot()) {
+            total += c;
+        }
+        return total;
+    }
+
+    /**
+     * Lower bound of the bucket containing the given quantile
+     * @param q quantile in [0, 1]
+     */
+    uint64_t quantile_lower_bound(double q) const {
+        const Snapshot s = snapshot();
+        int64_t total = 0;
+        for (int64_t c : s) {
+            total += c;
+        }
+        const auto rank = static_cast<int64_t>(q * static_cast<double>(total));
+        int64_t seen = 0;
+        for (size_t b = 0; b < Buckets; ++b) {
+            seen += s[b];
+            if (seen > rank) {
+                return bucket_lower_bound(b);
+            }
+        }
+        return bucket_lower_bound(Buckets - 1);
+    }
+
+    void reset() {
+        for (auto& shard : shards_) {
+            for (auto& bucket : shard.buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::array<std::atomic<int64_t>, Buckets> buckets{};
+    };
+
+    std::array<Shard, Shards> shards_{};
+};
+
+} // namespace hpc::concurrency
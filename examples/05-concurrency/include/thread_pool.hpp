@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * @file thread_pool.hpp
+ * @brief Persistent fork-join thread pool for data-parallel loops
+ *
+ * Creating std::threads per parallel region (as run_parallel does) costs
+ * tens of microseconds per thread, which dominates short loops. ThreadPool
+ * keeps its workers parked on a condition variable; run(n, fn) wakes them,
+ * hands out task indices 0..n-1 through one atomic counter, lets the
+ * calling thread work too, and returns when every task has finished.
+ *
+ * - Nested run() calls (from inside a task) execute inline, serially
+ * - Concurrent run() calls from different threads are serialized
+ * - The first exception thrown by a task is rethrown from run()
+ */
+
+#include "concurrency_utils.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hpc::concurrency {
+
+class ThreadPool {
+public:
+    /// @param num_threads Total parallelism including the calling thread
+    explicit ThreadPool(unsigned int num_threads = hardware_concurrency()) {
+        const unsigned int workers = num_threads > 1 ? num_threads - 1 : 0;
+        workers_.reserve(workers);
+        for (unsigned int i = 0; i < workers; ++i) {
+            workers_.emplace_back([this]() { worker_loop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /// Process-wide pool sized to the machine
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    /// Threads that execute tasks, including the caller of run()
+    unsigned int size() const {
+        return static_cast<unsigned int>(workers_.size()) + 1;
+    }
+
+    /// Run fn(0) .. fn(num_tasks - 1) in parallel and wait for all of them
+    template<typename Func>
+    void run(size_t num_tasks, Func&& fn) {
+        if (num_tasks == 0) {
+            return;
+        }
+        if (num_tasks == 1 || workers_.empty() || inside_task()) {
+            for (size_t t = 0; t < num_tasks; ++t) {
+                fn(t);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> run_lock(run_mutex_);
+        const std::function<void(size_t)> job = std::ref(fn);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &job;
+            num_tasks_ = num_tasks;
+            next_task_.store(0, std::memory_order_relaxed);
+            busy_workers_ = workers_.size();
+            error_ = nullptr;
+            ++generation_;
+        }
+        start_cv_.notify_all();
+
+        execute_tasks();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this]() { return busy_workers_ == 0; });
+        job_ = nullptr;
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    static bool& inside_task() {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    void execute_tasks() {
+        inside_task() = true;
+        for (;;) {
+            const size_t t = next_task_.fetch_add(1, std::memory_order_relaxed);
+            if (t >= num_tasks_) {
+                break;
+            }
+            try {
+                (*job_)(t);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+        inside_task() = false;
+    }
+
+    void worker_loop() {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_cv_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+            }
+
+            execute_tasks();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busy_workers_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+
+    // Current job; written under mutex_ before the generation bump
+    const std::function<void(size_t)>* job_ = nullptr;
+    size_t num_tasks_ = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> next_task_{0};
+    size_t busy_workers_ = 0;
+    uint64_t generation_ = 0;
+    std::exception_ptr error_;
+    bool stop_ = false;
+};
+
+} // namespace hpc::concurrency
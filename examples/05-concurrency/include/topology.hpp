@@ -0,0 +1,419 @@
+#pragma once
+
+/**
+ * @file topology.hpp
+ * @brief CPU topology discovery and policy-based thread pinning
+ *
+ * Where two threads land decides what they share:
+ *
+ * - SMT siblings share a core: L1/L2, execution ports, and the cheapest
+ *   possible cache-line transfer
+ * - cores under one L3 hand lines over through that L3
+ * - different L3 domains or NUMA nodes go through the interconnect
+ *
+ * Left to the scheduler, a benchmark gets a different mix on every run.
+ * CpuTopology reads the layout from sysfs (/sys/devices/system/cpu and
+ * /sys/devices/system/node) and turns a Placement policy into an ordered
+ * CPU list; thread i is pinned to entry i (wrapping around):
+ *
+ * - Compact:    fill a core's SMT siblings, then the next core in the same
+ *               L3, then the next L3/node (maximum sharing)
+ * - Scatter:    round-robin over NUMA nodes, then L3 domains, then cores;
+ *               SMT siblings only once every core has a thread
+ * - OnePerCore: first hardware thread of each core, in compact order
+ *
+ * Without sysfs (non-Linux, restricted containers) every CPU is treated as
+ * its own core in one L3 and one node, and pinning is a no-op off Linux.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace hpc::concurrency {
+
+/// Pin the calling thread to one logical CPU
+/// @return false if the affinity could not be set (or on non-Linux systems)
+inline bool pin_current_thread(unsigned int cpu) {
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+enum class Placement {
+    None,        ///< Leave placement to the OS scheduler
+    Compact,     ///< Pack threads onto SMT siblings and shared caches
+    Scatter,     ///< Spread threads across nodes, L3 domains and cores
+    OnePerCore   ///< One thread per physical core, compact order
+};
+
+inline const char* placement_name(Placement placement) {
+    switch (placement) {
+        case Placement::None: return "none";
+        case Placement::Compact: return "compact";
+        case Placement::Scatter: return "scatter";
+        case Placement::OnePerCore: return "one_per_core";
+    }
+    return "unknown";
+}
+
+/// One logical CPU and the domains it belongs to (all indices are dense)
+struct CpuInfo {
+    unsigned int cpu = 0;        ///< Logical CPU id, as used for affinity
+    unsigned int core = 0;       ///< Physical core
+    unsigned int smt_index = 0;  ///< 0 for the first hardware thread of a core
+    unsigned int l3_domain = 0;  ///< CPUs sharing one L3 (the package if none)
+    unsigned int numa_node = 0;
+    unsigned int package = 0;
+};
+
+namespace detail {
+
+/// Parse a sysfs CPU list such as "0-3,8-11,16"
+inline std::vector<unsigned int> parse_cpu_list(const std::string& text) {
+    std::vector<unsigned int> cpus;
+    std::stringstream ss(text);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(),
+                                   [](char c) { return c == ' ' || c == '\n'; }),
+                    range.end());
+        if (range.empty()) {
+            continue;
+        }
+        const size_t dash = range.find('-');
+        try {
+            const unsigned long lo = std::stoul(range.substr(0, dash));
+            const unsigned long hi = dash == std::string::npos ? lo : std::stoul(range.substr(dash + 1));
+            for (unsigned long c = lo; c <= hi; ++c) {
+                cpus.push_back(static_cast<unsigned int>(c));
+            }
+        } catch (const std::exception&) {
+            return {};  // Malformed list: treat as unknown
+        }
+    }
+    return cpus;
+}
+
+inline std::optional<std::string> read_sysfs(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return std::nullopt;
+    }
+    std::string text;
+    std::getline(file, text);
+    return text;
+}
+
+inline std::optional<long> read_sysfs_long(const std::filesystem::path& path) {
+    const auto text = read_sysfs(path);
+    if (!text) {
+        return std::nullopt;
+    }
+    try {
+        return std::stol(*text);
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+/// Round-robin merge: a0 b0 c0 a1 b1 c1 ...
+inline std::vector<unsigned int> interleave(const std::vector<std::vector<unsigned int>>& lists) {
+    std::vector<unsigned int> out;
+    for (size_t i = 0;; ++i) {
+        bool any = false;
+        for (const auto& list : lists) {
+            if (i < list.size()) {
+                out.push_back(list[i]);
+                any = true;
+            }
+        }
+        if (!any) {
+            return out;
+        }
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// CpuTopology
+// ============================================================================
+
+class CpuTopology {
+public:
+    /// Topology of this machine, restricted to the CPUs the process may run on
+    static const CpuTopology& system() {
+        static const CpuTopology topology = []() {
+            CpuTopology t = from_sysfs("/sys/devices/system");
+            return t.restricted_to(allowed_cpus());
+        }();
+        return topology;
+    }
+
+    /**
+     * Read the topology from a sysfs tree
+     *
+     * @param root Directory containing cpu/ and node/ (normally
+     *             /sys/devices/system); falls back to a flat layout of
+     *             hardware_concurrency() CPUs if cpu/online is missing
+     */
+    static CpuTopology from_sysfs(const std::filesystem::path& root) {
+        const auto online = detail::read_sysfs(root / "cpu" / "online");
+        const std::vector<unsigned int> ids = online ? detail::parse_cpu_list(*online)
+                                                     : std::vector<unsigned int>{};
+        if (ids.empty()) {
+            return flat(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        std::map<unsigned int, unsigned int> node_of;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(root / "node", ec)) {
+            const std::string name = entry.path().filename().string();
+            if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+                !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                continue;
+            }
+            const auto list = detail::read_sysfs(entry.path() / "cpulist");
+            if (list) {
+                const auto node = static_cast<unsigned int>(std::stoul(name.substr(4)));
+                for (unsigned int c : detail::parse_cpu_list(*list)) {
+                    node_of[c] = node;
+                }
+            }
+        }
+
+        std::map<std::pair<long, long>, unsigned int> core_ids;  // (package, core_id)
+        std::map<std::pair<long, unsigned int>, unsigned int> l3_ids;  // (package, first cpu)
+        std::map<long, unsigned int> package_ids;
+        std::map<unsigned int, unsigned int> node_ids;
+
+        std::vector<CpuInfo> cpus;
+        cpus.reserve(ids.size());
+        for (unsigned int id : ids) {
+            const auto dir = root / "cpu" / ("cpu" + std::to_string(id));
+            const auto topo = dir / "topology";
+            const long package = std::max(0L, detail::read_sysfs_long(topo / "physical_package_id").value_or(0));
+            const long core_id = detail::read_sysfs_long(topo / "core_id").value_or(static_cast<long>(id));
+
+            CpuInfo info;
+            info.cpu = id;
+            info.package = package_ids.try_emplace(package, static_cast<unsigned int>(package_ids.size()))
+                               .first->second;
+            info.core = core_ids.try_emplace({package, core_id}, static_cast<unsigned int>(core_ids.size()))
+                            .first->second;
+
+            if (const auto siblings = detail::read_sysfs(topo / "thread_siblings_list")) {
+                auto list = detail::parse_cpu_list(*siblings);
+                std::sort(list.begin(), list.end());
+                const auto it = std::find(list.begin(), list.end(), id);
+                info.smt_index = it == list.end() ? 0u : static_cast<unsigned int>(it - list.begin());
+            }
+
+            // Identify an L3 by its lowest CPU; no L3 means the package is the domain
+            std::pair<long, unsigned int> l3_key{package, std::numeric_limits<unsigned int>::max()};
+            for (const auto& index : std::filesystem::directory_iterator(dir / "cache", ec)) {
+                if (detail::read_sysfs_long(index.path() / "level").value_or(0) != 3) {
+                    continue;
+                }
+                if (const auto shared = detail::read_sysfs(index.path() / "shared_cpu_list")) {
+                    const auto list = detail::parse_cpu_list(*shared);
+                    if (!list.empty()) {
+                        l3_key.second = *std::min_element(list.begin(), list.end());
+                    }
+                }
+            }
+            info.l3_domain = l3_ids.try_emplace(l3_key, static_cast<unsigned int>(l3_ids.size()))
+                                 .first->second;
+
+            const auto node = node_of.find(id);
+            const unsigned int raw_node = node == node_of.end() ? 0u : node->second;
+            info.numa_node = node_ids.try_emplace(raw_node, static_cast<unsigned int>(node_ids.size()))
+                                 .first->second;
+            cpus.push_back(info);
+        }
+        return CpuTopology(std::move(cpus));
+    }
+
+    /// Every CPU its own core, one L3, one node
+    static CpuTopology flat(unsigned int num_cpus) {
+        std::vector<CpuInfo> cpus(num_cpus);
+        for (unsigned int i = 0; i < num_cpus; ++i) {
+            cpus[i].cpu = i;
+            cpus[i].core = i;
+        }
+        return CpuTopology(std::move(cpus));
+    }
+
+    /// Copy keeping only the listed CPUs (all of them if none would remain)
+    CpuTopology restricted_to(const std::vector<unsigned int>& allowed) const {
+        const std::set<unsigned int> keep(allowed.begin(), allowed.end());
+        std::vector<CpuInfo> cpus;
+        for (const CpuInfo& info : cpus_) {
+            if (keep.count(info.cpu) != 0) {
+                cpus.push_back(info);
+            }
+        }
+        return cpus.empty() ? *this : CpuTopology(std::move(cpus));
+    }
+
+    const std::vector<CpuInfo>& cpus() const { return cpus_; }
+    size_t num_cpus() const { return cpus_.size(); }
+    size_t num_cores() const { return count_distinct(&CpuInfo::core); }
+    size_t num_l3_domains() const { return count_distinct(&CpuInfo::l3_domain); }
+    size_t num_numa_nodes() const { return count_distinct(&CpuInfo::numa_node); }
+    size_t num_packages() const { return count_distinct(&CpuInfo::package); }
+
+    /// CPUs sharing a core with @p cpu (including itself)
+    std::vector<unsigned int> smt_siblings(unsigned int cpu) const {
+        std::vector<unsigned int> siblings;
+        const CpuInfo* self = find(cpu);
+        if (self == nullptr) {
+            return siblings;
+        }
+        for (const CpuInfo& info : cpus_) {
+            if (info.core == self->core) {
+                siblings.push_back(info.cpu);
+            }
+        }
+        return siblings;
+    }
+
+    /// CPUs in the order threads are assigned to them (empty for None)
+    const std::vector<unsigned int>& placement_order(Placement placement) const {
+        return orders_[static_cast<size_t>(placement)];
+    }
+
+    /// CPU for thread @p thread_index under @p placement (nullopt for None)
+    std::optional<unsigned int> cpu_for(Placement placement, unsigned int thread_index) const {
+        const auto& order = placement_order(placement);
+        if (order.empty()) {
+            return std::nullopt;
+        }
+        return order[thread_index % order.size()];
+    }
+
+    /// Pin the calling thread according to @p placement; true for None
+    bool pin_current_thread(Placement placement, unsigned int thread_index) const {
+        const auto cpu = cpu_for(placement, thread_index);
+        return !cpu || hpc::concurrency::pin_current_thread(*cpu);
+    }
+
+private:
+    explicit CpuTopology(std::vector<CpuInfo> cpus) : cpus_(std::move(cpus)) {
+        std::vector<CpuInfo> compact = cpus_;
+        std::sort(compact.begin(), compact.end(), [](const CpuInfo& a, const CpuInfo& b) {
+            return std::tie(a.numa_node, a.l3_domain, a.core, a.smt_index, a.cpu) <
+                   std::tie(b.numa_node, b.l3_domain, b.core, b.smt_index, b.cpu);
+        });
+
+        auto& compact_order = orders_[static_cast<size_t>(Placement::Compact)];
+        auto& per_core_order = orders_[static_cast<size_t>(Placement::OnePerCore)];
+        for (const CpuInfo& info : compact) {
+            compact_order.push_back(info.cpu);
+            if (info.smt_index == 0) {
+                per_core_order.push_back(info.cpu);
+            }
+        }
+        if (per_core_order.empty()) {
+            per_core_order = compact_order;
+        }
+
+        // Scatter: per SMT level, interleave nodes; within a node interleave L3s
+        unsigned int max_smt = 0;
+        for (const CpuInfo& info : compact) {
+            max_smt = std::max(max_smt, info.smt_index);
+        }
+        auto& scatter_order = orders_[static_cast<size_t>(Placement::Scatter)];
+        for (unsigned int smt = 0; smt <= max_smt; ++smt) {
+            std::map<unsigned int, std::map<unsigned int, std::vector<unsigned int>>> by_node;
+            for (const CpuInfo& info : compact) {
+                if (info.smt_index == smt) {
+                    by_node[info.numa_node][info.l3_domain].push_back(info.cpu);
+                }
+            }
+            std::vector<std::vector<unsigned int>> per_node;
+            for (const auto& [node, l3s] : by_node) {
+                std::vector<std::vector<unsigned int>> per_l3;
+                for (const auto& [l3, list] : l3s) {
+                    per_l3.push_back(list);
+                }
+                per_node.push_back(detail::interleave(per_l3));
+            }
+            const auto level = detail::interleave(per_node);
+            scatter_order.insert(scatter_order.end(), level.begin(), level.end());
+        }
+    }
+
+    static std::vector<unsigned int> allowed_cpus() {
+        std::vector<unsigned int> allowed;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (unsigned int c = 0; c < CPU_SETSIZE; ++c) {
+                if (CPU_ISSET(c, &set)) {
+                    allowed.push_back(c);
+                }
+            }
+        }
+#endif
+        return allowed;
+    }
+
+    const CpuInfo* find(unsigned int cpu) const {
+        for (const CpuInfo& info : cpus_) {
+            if (info.cpu == cpu) {
+                return &info;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t count_distinct(unsigned int CpuInfo::*field) const {
+        std::set<unsigned int> values;
+        for (const CpuInfo& info : cpus_) {
+            values.insert(info.*field);
+        }
+        return values.size();
+    }
+
+    std::vector<CpuInfo> cpus_;
+    std::array<std::vector<unsigned int>, 4> orders_;  // Indexed by Placement
+};
+
+/// Pin the calling thread as thread @p thread_index of a group placed by policy
+inline bool pin_current_thread(Placement placement, unsigned int thread_index) {
+    if (placement == Placement::None) {
+        return true;  // Don't pay for topology discovery
+    }
+    return CpuTopology::system().pin_current_thread(placement, thread_index);
+}
+
+} // namespace hpc::concurrency
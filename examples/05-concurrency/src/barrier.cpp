@@ -0,0 +1,162 @@
+/**
+ * @file barrier.cpp
+ * @brief Spin-then-block barriers, latch and phaser
+ *
+ * This example demonstrates:
+ * 1. A bulk-synchronous particle loop with std::barrier vs SpinBarrier vs
+ *    DisseminationBarrier between steps
+ * 2. A Latch reused as a start gate for several rounds
+ * 3. A Phaser whose parties join and leave between phases
+ */
+
+#include "../include/barrier.hpp"
+#include <barrier>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace hpc::concurrency {
+
+namespace {
+
+/// Structure-of-arrays particles, as in 02-memory-cache/aos_vs_soa.cpp
+struct Particles {
+    std::vector<float> x, y, z, vx, vy, vz;
+
+    explicit Particles(size_t n) : x(n, 0.0f), y(n, 0.0f), z(n, 0.0f), vx(n, 1.0f), vy(n, 2.0f), vz(n, 3.0f) {}
+};
+
+void update_slice(Particles& p, size_t lo, size_t hi, float dt) {
+    for (size_t i = lo; i < hi; ++i) p.x[i] += p.vx[i] * dt;
+    for (size_t i = lo; i < hi; ++i) p.y[i] += p.vy[i] * dt;
+    for (size_t i = lo; i < hi; ++i) p.z[i] += p.vz[i] * dt;
+}
+
+/// Run STEPS update steps on num_threads threads, calling sync(t) after each
+template<typename Sync>
+double time_steps(Particles& particles, unsigned num_threads, int steps, Sync sync) {
+    const size_t n = particles.x.size();
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            const size_t lo = n * t / num_threads;
+            const size_t hi = n * (t + 1) / num_threads;
+            for (int s = 0; s < steps; ++s) {
+                update_slice(particles, lo, hi, 0.001f);
+                sync(t);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / steps;
+}
+
+} // namespace
+
+void demonstrate_bulk_synchronous() {
+    std::cout << "=== Bulk-synchronous particle steps (4096 particles) ===" << std::endl;
+
+    constexpr int STEPS = 20000;
+    const unsigned num_threads = std::max(2u, std::min(8u, hardware_concurrency()));
+    Particles particles(4096);
+
+    std::barrier<> std_barrier(num_threads);
+    SpinBarrier spin_barrier(num_threads);
+    DisseminationBarrier dissemination(num_threads);
+
+    const double us_std = time_steps(particles, num_threads, STEPS,
+                                     [&](unsigned) { std_barrier.arrive_and_wait(); });
+    const double us_spin = time_steps(particles, num_threads, STEPS,
+                                      [&](unsigned) { spin_barrier.arrive_and_wait(); });
+    const double us_diss = time_steps(particles, num_threads, STEPS,
+                                      [&](unsigned t) { dissemination.arrive_and_wait(t); });
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Threads: " << num_threads << " (spin limit " << detail::spin_limit_for(num_threads)
+              << " pauses)" << std::endl;
+    std::cout << "std::barrier:          " << us_std << " us/step" << std::endl;
+    std::cout << "SpinBarrier:           " << us_spin << " us/step" << std::endl;
+    std::cout << "DisseminationBarrier:  " << us_diss << " us/step ("
+              << dissemination.rounds() << " rounds)" << std::endl;
+    std::cout << "x[0] after " << 3 * STEPS << " steps: " << particles.x[0] << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+}
+
+void demonstrate_latch() {
+    std::cout << "=== Latch reused as a start gate ===" << std::endl;
+
+    constexpr unsigned WORKERS = 4;
+    constexpr int ROUNDS = 3;
+    Latch start(1);
+    SpinBarrier done(WORKERS + 1);
+    std::atomic<int> ran{0};
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < WORKERS; ++w) {
+        workers.emplace_back([&]() {
+            for (int r = 0; r < ROUNDS; ++r) {
+                start.wait();
+                ran.fetch_add(1, std::memory_order_relaxed);
+                done.arrive_and_wait();  // Round finished
+                done.arrive_and_wait();  // Latch re-armed
+            }
+        });
+    }
+    for (int r = 0; r < ROUNDS; ++r) {
+        start.count_down();
+        done.arrive_and_wait();
+        std::cout << "Round " << r << ": " << ran.load() << " worker runs so far" << std::endl;
+        start.reset(1);
+        done.arrive_and_wait();
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::cout << std::endl;
+}
+
+void demonstrate_phaser() {
+    std::cout << "=== Phaser with parties joining and leaving ===" << std::endl;
+
+    Phaser phaser(1);  // The main thread
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 3; ++w) {
+        // Worker w joins before phase w and stays for two phases
+        phaser.register_party();
+        workers.emplace_back([&phaser]() {
+            phaser.arrive_and_await_advance();
+            phaser.arrive_and_deregister();
+        });
+        std::cout << "Phase " << phaser.phase() << ": " << phaser.registered_parties()
+                  << " parties registered" << std::endl;
+        phaser.arrive_and_await_advance();
+    }
+    while (phaser.registered_parties() > 1) {
+        phaser.arrive_and_await_advance();
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::cout << "Final phase " << phaser.phase() << ", " << phaser.registered_parties()
+              << " party left" << std::endl << std::endl;
+}
+
+void demonstrate_barrier() {
+    demonstrate_bulk_synchronous();
+    demonstrate_latch();
+    demonstrate_phaser();
+}
+
+} // namespace hpc::concurrency
+
+#ifndef HPC_BENCHMARK_MODE
+int main() {
+    hpc::concurrency::demonstrate_barrier();
+    return 0;
+}
+#endif
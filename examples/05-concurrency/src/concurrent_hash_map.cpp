@@ -0,0 +1,96 @@
+/**
+ * @file concurrent_hash_map.cpp
+ * @brief Lock-free lookups in an open-addressing concurrent hash map
+ *
+ * This example demonstrates:
+ * 1. A SpinLock around std::unordered_map serializes every lookup
+ * 2. Sharded linear probing with lock-free find() scales with readers
+ * 3. Backward-shift deletion keeps the table tombstone-free under churn
+ */
+
+#include "../include/concurrent_hash_map.hpp"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+
+namespace hpc::concurrency {
+
+void demonstrate_lookup_scaling() {
+    std::cout << "=== Read-Heavy Lookup Scaling ===" << std::endl;
+
+    constexpr uint64_t KEYS = 100000;
+    constexpr int LOOKUPS = 1000000;
+    const unsigned int num_threads = std::min(8u, hardware_concurrency());
+
+    SpinLock lock;
+    std::unordered_map<uint64_t, uint64_t> locked_map;
+    auto map = std::make_unique<ConcurrentHashMap<uint64_t, uint64_t>>(KEYS);
+    for (uint64_t k = 0; k < KEYS; ++k) {
+        locked_map.emplace(k, k);
+        map->insert(k, k);
+    }
+
+    std::atomic<uint64_t> hits{0};
+    double locked_ms = run_parallel([&](unsigned int tid) {
+        uint64_t local = 0;
+        for (int i = 0; i < LOOKUPS; ++i) {
+            const uint64_t key = (static_cast<uint64_t>(i) * 7919 + tid) % KEYS;
+            SpinLockGuard guard(lock);
+            local += locked_map.count(key);
+        }
+        hits.fetch_add(local, std::memory_order_relaxed);
+    }, num_threads);
+
+    double concurrent_ms = run_parallel([&](unsigned int tid) {
+        uint64_t local = 0;
+        for (int i = 0; i < LOOKUPS; ++i) {
+            const uint64_t key = (static_cast<uint64_t>(i) * 7919 + tid) % KEYS;
+            local += map->contains(key) ? 1 : 0;
+        }
+        hits.fetch_add(local, std::memory_order_relaxed);
+    }, num_threads);
+
+    std::cout << "Threads: " << num_threads << ", lookups per thread: " << LOOKUPS << std::endl;
+    std::cout << "SpinLock + unordered_map: " << locked_ms << " ms" << std::endl;
+    std::cout << "ConcurrentHashMap:        " << concurrent_ms << " ms" << std::endl;
+    std::cout << "Speedup: " << locked_ms / concurrent_ms << "x" << std::endl;
+    std::cout << "(hits: " << hits.load() << ")" << std::endl;
+    std::cout << std::endl;
+}
+
+void demonstrate_churn() {
+    std::cout << "=== Insert/Erase Churn Without Tombstones ===" << std::endl;
+
+    auto map = std::make_unique<ConcurrentHashMap<uint64_t, uint64_t>>(1024);
+    const size_t initial_capacity = map->capacity();
+
+    for (int round = 0; round < 100; ++round) {
+        for (uint64_t k = 0; k < 1000; ++k) {
+            map->insert(static_cast<uint64_t>(round) * 1000 + k, k);
+        }
+        for (uint64_t k = 0; k < 1000; ++k) {
+            map->erase(static_cast<uint64_t>(round) * 1000 + k);
+        }
+    }
+
+    std::cout << "100 rounds of 1000 inserts + 1000 erases" << std::endl;
+    std::cout << "Size: " << map->size() << std::endl;
+    std::cout << "Capacity: " << initial_capacity << " -> " << map->capacity()
+              << " (sized for the ~1000 live keys, not the 100000 ever inserted)" << std::endl;
+    std::cout << std::endl;
+}
+
+void demonstrate_concurrent_hash_map() {
+    demonstrate_lookup_scaling();
+    demonstrate_churn();
+}
+
+} // namespace hpc::concurrency
+
+#ifndef HPC_BENCHMARK_MODE
+int main() {
+    hpc::concurrency::demonstrate_concurrent_hash_map();
+    return 0;
+}
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file deterministic_reduce.cpp
+ * @brief Reproducible parallel reductions vs OpenMP reduction(+:sum)
+ *
+ * This example demonstrates:
+ * 1. OpenMP reduction results changing with the thread count
+ * 2. deterministic_sum returning the same bits for every thread count
+ * 3. Kahan-Babuska compensation on an ill-conditioned sum
+ */
+
+#include "../include/deterministic_reduce.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace hpc::parallel {
+
+namespace {
+
+uint64_t bits_of(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+void demonstrate_thread_count_dependence() {
+    std::cout << "=== Sum of 10M doubles for different thread counts ===" << std::endl;
+
+    constexpr size_t N = 10000000;
+    std::vector<double> data(N);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (auto& x : data) x = dist(rng) * 1e6;
+    const double* p = data.data();
+
+#ifdef _OPENMP
+    const int saved = omp_get_max_threads();
+    for (int threads : {1, 2, 3, 4, 8}) {
+        omp_set_num_threads(threads);
+        double sum = 0.0;
+        #pragma omp parallel for reduction(+:sum)
+        for (long long i = 0; i < static_cast<long long>(N); ++i) {
+            sum += p[i];
+        }
+        const double det = deterministic_sum(p, N, Backend::OpenMP);
+        std::cout << "threads=" << threads << std::setprecision(17)
+                  << "  omp reduction=" << sum << " (bits " << std::hex << bits_of(sum) << std::dec << ")"
+                  << "  deterministic=" << det << " (bits " << std::hex << bits_of(det) << std::dec << ")"
+                  << std::endl;
+    }
+    omp_set_num_threads(saved);
+#else
+    const double det = deterministic_sum(p, N);
+    std::cout << "OpenMP not available; deterministic=" << std::setprecision(17) << det << std::endl;
+#endif
+    std::cout << std::setprecision(6) << std::endl;
+}
+
+void demonstrate_compensation() {
+    std::cout << "=== Ill-conditioned sum (exact answer: 1) ===" << std::endl;
+
+    // Pairs of large values that cancel exactly, plus a single 1.0
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> dist(-1e12, 1e12);
+    std::vector<double> data;
+    for (int i = 0; i < 1000000; ++i) {
+        const double v = dist(rng);
+        data.push_back(v);
+        data.push_back(-v);
+    }
+    data.push_back(1.0);
+    std::shuffle(data.begin(), data.end(), rng);
+
+    double naive = 0.0;
+    for (double x : data) naive += x;
+
+    std::cout << std::setprecision(17);
+    std::cout << "Naive loop:          " << naive << std::endl;
+    std::cout << "Pairwise (default):  " << deterministic_sum(data.data(), data.size()) << std::endl;
+    std::cout << "Kahan-Babuska:       "
+              << deterministic_sum<double, Summation::Kahan>(data.data(), data.size()) << std::endl;
+    std::cout << std::setprecision(6) << std::endl;
+}
+
+void demonstrate_deterministic_reduce() {
+    demonstrate_thread_count_dependence();
+    demonstrate_compensation();
+}
+
+} // namespace hpc::parallel
+
+#ifndef HPC_BENCHMARK_MODE
+int main() {
+    hpc::parallel::demonstrate_deterministic_reduce();
+    return 0;
+}
+#endif
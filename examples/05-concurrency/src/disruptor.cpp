@@ -0,0 +1,105 @@
+/**
+ * @file disruptor.cpp
+ * @brief Multicast event pipeline on a Disruptor-style ring buffer
+ *
+ * This example demonstrates:
+ * 1. One pre-allocated ring read in place by several consumers
+ * 2. Dependency barriers: log and metrics run after parse, in parallel
+ * 3. Batching: consumers publish their cursor once per available batch
+ */
+
+#include "../include/disruptor.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+namespace hpc::concurrency {
+
+struct LogEvent {
+    int64_t raw = 0;        // Written by the producer
+    int64_t level = 0;      // Written by the parse stage
+    int64_t latency_us = 0; // Written by the parse stage
+};
+
+void demonstrate_pipeline() {
+    std::cout << "=== Parse -> {Log, Metrics} Pipeline ===" << std::endl;
+
+    using Ring = RingBuffer<LogEvent, 1024>;
+    constexpr int64_t EVENTS = 1000000;
+    auto ring = std::make_unique<Ring>();
+
+    // Stage 1: parse annotates each event in place
+    auto parse_barrier = ring->new_barrier();
+    BatchEventProcessor parse(*ring, parse_barrier, [](LogEvent& e, int64_t, bool) {
+        e.level = e.raw % 4;
+        e.latency_us = (e.raw * 37) % 1000;
+    });
+
+    // Stage 2: log and metrics both depend on parse, not on each other
+    struct LogStage {
+        int64_t errors = 0;
+        void operator()(LogEvent& e, int64_t, bool) { errors += e.level == 3 ? 1 : 0; }
+    };
+    struct MetricsStage {
+        int64_t total_latency = 0;
+        int64_t batches = 0;
+        void operator()(LogEvent& e, int64_t, bool end_of_batch) {
+            total_latency += e.latency_us;
+            batches += end_of_batch ? 1 : 0;
+        }
+    };
+    auto downstream_barrier = ring->new_barrier({&parse.sequence()});
+    BatchEventProcessor log(*ring, downstream_barrier, LogStage{});
+    BatchEventProcessor metrics(*ring, downstream_barrier, MetricsStage{});
+
+    // The producer must not lap the slowest terminal stage
+    ring->add_gating_sequences({&log.sequence(), &metrics.sequence()});
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::thread parse_thread([&]() { parse.run(); });
+    std::thread log_thread([&]() { log.run(); });
+    std::thread metrics_thread([&]() { metrics.run(); });
+
+    for (int64_t i = 0; i < EVENTS; ++i) {
+        ring->publish_event([i](LogEvent& e, int64_t) { e.raw = i; });
+    }
+
+    while (log.sequence().get() < EVENTS - 1 || metrics.sequence().get() < EVENTS - 1) {
+        std::this_thread::yield();
+    }
+    parse.halt();
+    log.halt();
+    parse_thread.join();
+    log_thread.join();
+    metrics_thread.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << "Events: " << EVENTS << " through 3 stages, 0 copies" << std::endl;
+    std::cout << "Time: " << ms << " ms (" << static_cast<double>(EVENTS) / ms / 1000.0
+              << " M events/s)" << std::endl;
+    std::cout << "Errors logged: " << log.handler().errors << std::endl;
+    std::cout << "Mean latency: "
+              << static_cast<double>(metrics.handler().total_latency) / static_cast<double>(EVENTS)
+              << " us" << std::endl;
+    std::cout << "Metrics batches: " << metrics.handler().batches << " (avg "
+              << static_cast<double>(EVENTS) / static_cast<double>(metrics.handler().batches)
+              << " events per cursor update)" << std::endl;
+    std::cout << std::endl;
+}
+
+void demonstrate_disruptor() {
+    demonstrate_pipeline();
+}
+
+} // namespace hpc::concurrency
+
+#ifndef HPC_BENCHMARK_MODE
+int main() {
+    hpc::concurrency::demonstrate_disruptor();
+    return 0;
+}
+#endif
@@ -8,7 +8,7 @@
  * 3. Cache-friendly queue design
  */
 
-#include "../include/concurrency_utils.hpp"
+#include "../include/lock_free_queue.hpp"
 #include <iostream>
 #include <vector>
 #include <optional>
@@ -17,203 +17,6 @@
 
 namespace hpc::concurrency {
 
-/**
- * Lock-free SPSC (Single-Producer Single-Consumer) Queue
- * 
- * This is a bounded, lock-free queue that supports exactly one producer
- * and one consumer thread. It uses a ring buffer with atomic head and tail
- * pointers.
- * 
- * Key design decisions:
- * 1. Power-of-2 capacity for fast modulo (bitwise AND)
- * 2. Separate cache lines for head and tail to avoid false sharing
- * 3. Acquire-release ordering for synchronization
- */
-template<typename T, size_t Capacity>
-class SPSCQueue {
-    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
-    static_assert(Capacity >= 2, "Capacity must be at least 2");
-    
-public:
-    SPSCQueue() : head_(0), tail_(0) {
-        // Initialize buffer
-        for (size_t i = 0; i < Capacity; ++i) {
-            buffer_[i] = T{};
-        }
-    }
-    
-    /**
-     * Push an element to the queue (producer only)
-     * @return true if successful, false if queue is full
-     */
-    bool push(const T& value) {
-        const size_t current_tail = tail_.load(std::memory_order_relaxed);
-        const size_t next_tail = (current_tail + 1) & MASK;
-        
-        // Check if queue is full
-        if (next_tail == head_.load(std::memory_order_acquire)) {
-            return false;  // Queue is full
-        }
-        
-        buffer_[current_tail] = value;
-        tail_.store(next_tail, std::memory_order_release);
-        return true;
-    }
-    
-    /**
-     * Push with move semantics
-     */
-    bool push(T&& value) {
-        const size_t current_tail = tail_.load(std::memory_order_relaxed);
-        const size_t next_tail = (current_tail + 1) & MASK;
-        
-        if (next_tail == head_.load(std::memory_order_acquire)) {
-            return false;
-        }
-        
-        buffer_[current_tail] = std::move(value);
-        tail_.store(next_tail, std::memory_order_release);
-        return true;
-    }
-    
-    /**
-     * Pop an element from the queue (consumer only)
-     * @return optional containing the value, or empty if queue is empty
-     */
-    std::optional<T> pop() {
-        const size_t current_head = head_.load(std::memory_order_relaxed);
-        
-        // Check if queue is empty
-        if (current_head == tail_.load(std::memory_order_acquire)) {
-            return std::nullopt;  // Queue is empty
-        }
-        
-        T value = std::move(buffer_[current_head]);
-        head_.store((current_head + 1) & MASK, std::memory_order_release);
-        return value;
-    }
-    
-    /**
-     * Check if queue is empty (approximate, may be stale)
-     */
-    bool empty() const {
-        return head_.load(std::memory_order_relaxed) == 
-               tail_.load(std::memory_order_relaxed);
-    }
-    
-    /**
-     * Get approximate size (may be stale)
-     */
-    size_t size() const {
-        const size_t head = head_.load(std::memory_order_relaxed);
-        const size_t tail = tail_.load(std::memory_order_relaxed);
-        return (tail - head) & MASK;
-    }
-    
-    /**
-     * Get capacity
-     */
-    constexpr size_t capacity() const {
-        return Capacity - 1;  // One slot is always empty
-    }
-
-private:
-    static constexpr size_t MASK = Capacity - 1;
-    
-    // Align head and tail to separate cache lines to avoid false sharing
-    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
-    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
-    alignas(CACHE_LINE_SIZE) T buffer_[Capacity];
-};
-
-/**
- * Lock-free MPMC (Multi-Producer Multi-Consumer) Queue
- * 
- * A more complex queue that supports multiple producers and consumers.
- * Uses sequence numbers for coordination.
- */
-template<typename T, size_t Capacity>
-class MPMCQueue {
-    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
-    
-    struct Cell {
-        std::atomic<size_t> sequence;
-        T data;
-    };
-    
-public:
-    MPMCQueue() : enqueue_pos_(0), dequeue_pos_(0) {
-        for (size_t i = 0; i < Capacity; ++i) {
-            cells_[i].sequence.store(i, std::memory_order_relaxed);
-        }
-    }
-    
-    bool push(const T& value) {
-        Cell* cell;
-        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
-        
-        for (;;) {
-            cell = &cells_[pos & MASK];
-            size_t seq = cell->sequence.load(std::memory_order_acquire);
-            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
-            
-            if (diff == 0) {
-                // Cell is ready for writing
-                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
-                                                        std::memory_order_relaxed)) {
-                    break;
-                }
-            } else if (diff < 0) {
-                // Queue is full
-                return false;
-            } else {
-                // Another producer got here first, retry
-                pos = enqueue_pos_.load(std::memory_order_relaxed);
-            }
-        }
-        
-        cell->data = value;
-        cell->sequence.store(pos + 1, std::memory_order_release);
-        return true;
-    }
-    
-    std::optional<T> pop() {
-        Cell* cell;
-        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
-        
-        for (;;) {
-            cell = &cells_[pos & MASK];
-            size_t seq = cell->sequence.load(std::memory_order_acquire);
-            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
-            
-            if (diff == 0) {
-                // Cell is ready for reading
-                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
-                                                        std::memory_order_relaxed)) {
-                    break;
-                }
-            } else if (diff < 0) {
-                // Queue is empty
-                return std::nullopt;
-            } else {
-                // Another consumer got here first, retry
-                pos = dequeue_pos_.load(std::memory_order_relaxed);
-            }
-        }
-        
-        T value = std::move(cell->data);
-        cell->sequence.store(pos + Capacity, std::memory_order_release);
-        return value;
-    }
-
-private:
-    static constexpr size_t MASK = Capacity - 1;
-    
-    alignas(CACHE_LINE_SIZE) Cell cells_[Capacity];
-    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_;
-    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_;
-};
-
 // ============================================================================
 // Demo and verification
 // ============================================================================
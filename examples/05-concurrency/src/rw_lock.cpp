@@ -0,0 +1,154 @@
+/**
+ * @file rw_lock.cpp
+ * @brief Reader-writer locks and seqlocks for read-mostly data
+ *
+ * This example demonstrates:
+ * 1. Why an exclusive lock serializes readers of read-mostly data
+ * 2. RWSpinLock - per-slot reader counters, readers scale with cores
+ * 3. SeqLock - readers never write shared memory, writers never wait
+ */
+
+#include "../include/rw_lock.hpp"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+
+namespace hpc::concurrency {
+
+/// A routing-table-like record: read constantly, rewritten rarely
+struct RouteConfig {
+    int64_t generation;
+    int64_t checksum;  // Always -generation, lets readers detect torn reads
+    int32_t weights[4];
+};
+
+RouteConfig make_config(int64_t generation) {
+    RouteConfig config{};
+    config.generation = generation;
+    config.checksum = -generation;
+    for (int i = 0; i < 4; ++i) {
+        config.weights[i] = static_cast<int32_t>(generation + i);
+    }
+    return config;
+}
+
+bool is_consistent(const RouteConfig& config) {
+    return config.checksum == -config.generation &&
+           config.weights[3] == static_cast<int32_t>(config.generation + 3);
+}
+
+// ============================================================================
+// Shared read throughput: exclusive vs reader-writer lock
+// ============================================================================
+
+template<typename ReadFunc>
+double time_readers(ReadFunc&& read, unsigned int num_threads, int reads_per_thread) {
+    return run_parallel([&](unsigned int) {
+        for (int i = 0; i < reads_per_thread; ++i) {
+            read();
+        }
+    }, num_threads);
+}
+
+void demonstrate_read_scaling() {
+    std::cout << "=== Read Scaling (no writers) ===" << std::endl;
+
+    constexpr int READS_PER_THREAD = 1000000;
+    const unsigned int num_threads = std::min(8u, hardware_concurrency());
+
+    RouteConfig config = make_config(1);
+    std::atomic<int64_t> sink{0};
+
+    SpinLock spin;
+    double spin_ms = time_readers([&]() {
+        SpinLockGuard guard(spin);
+        sink.fetch_add(config.weights[0], std::memory_order_relaxed);
+    }, num_threads, READS_PER_THREAD);
+
+    RWSpinLock rw;
+    double rw_ms = time_readers([&]() {
+        std::shared_lock<RWSpinLock> guard(rw);
+        sink.fetch_add(config.weights[0], std::memory_order_relaxed);
+    }, num_threads, READS_PER_THREAD);
+
+    SeqLock<RouteConfig> seq(config);
+    double seq_ms = time_readers([&]() {
+        sink.fetch_add(seq.load().weights[0], std::memory_order_relaxed);
+    }, num_threads, READS_PER_THREAD);
+
+    std::cout << "Threads: " << num_threads << std::endl;
+    std::cout << "SpinLock:   " << spin_ms << " ms" << std::endl;
+    std::cout << "RWSpinLock: " << rw_ms << " ms" << std::endl;
+    std::cout << "SeqLock:    " << seq_ms << " ms" << std::endl;
+    std::cout << std::endl;
+}
+
+// ============================================================================
+// Snapshot consistency under concurrent writes
+// ============================================================================
+
+void demonstrate_consistency() {
+    std::cout << "=== Snapshot Consistency Under Writes ===" << std::endl;
+
+    constexpr int NUM_WRITES = 10000;
+    constexpr unsigned int NUM_READERS = 3;
+
+    RWSpinLock rw;
+    RouteConfig guarded = make_config(0);
+    SeqLock<RouteConfig> seq(make_config(0));
+
+    std::atomic<bool> done{false};
+    std::atomic<int64_t> torn_reads{0};
+    std::atomic<int64_t> total_reads{0};
+
+    std::thread writer([&]() {
+        for (int64_t g = 1; g <= NUM_WRITES; ++g) {
+            {
+                std::unique_lock<RWSpinLock> guard(rw);
+                guarded = make_config(g);
+            }
+            seq.store(make_config(g));
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    run_parallel([&](unsigned int) {
+        int64_t reads = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            RouteConfig a;
+            {
+                std::shared_lock<RWSpinLock> guard(rw);
+                a = guarded;
+            }
+            RouteConfig b = seq.load();
+            if (!is_consistent(a) || !is_consistent(b)) {
+                torn_reads.fetch_add(1, std::memory_order_relaxed);
+            }
+            reads += 2;
+        }
+        total_reads.fetch_add(reads, std::memory_order_relaxed);
+    }, NUM_READERS);
+
+    writer.join();
+
+    std::cout << "Writes: " << NUM_WRITES << " (x2)" << std::endl;
+    std::cout << "Reads: " << total_reads.load() << std::endl;
+    std::cout << "Torn reads: " << torn_reads.load() << std::endl;
+    std::cout << "SeqLock version: " << seq.version() << std::endl;
+    std::cout << std::endl;
+}
+
+void demonstrate_rw_lock() {
+    demonstrate_read_scaling();
+    demonstrate_consistency();
+}
+
+} // namespace hpc::concurrency
+
+#ifndef HPC_BENCHMARK_MODE
+int main() {
+    hpc::concurrency::demonstrate_rw_lock();
+    return 0;
+}
+#endif
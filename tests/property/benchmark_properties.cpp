@@ -268,6 +268,30 @@ TEST(BenchmarkUtilsTests, EmptyResultsExport) {
     std::filesystem::remove(temp_file);
 }
 
+TEST(BenchmarkUtilsTests, SuiteExportIncludesCounters) {
+    hpc::bench::BenchmarkSuite suite;
+    hpc::bench::BenchmarkResult with_counters("BM_Latency", 10, 1000.0, 900.0);
+    with_counters.counters["p99_ns"] = 250.0;
+    with_counters.counters["max_ns"] = 4000.0;
+    suite.results.push_back(with_counters);
+    suite.results.emplace_back("BM_Plain", 10, 1000.0, 900.0);
+    std::string temp_file = "/tmp/benchmark_suite_counters_test.json";
+
+    EXPECT_NO_THROW(hpc::bench::export_suite_to_json(temp_file, suite));
+
+    std::ifstream file(temp_file);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string json = buffer.str();
+
+    EXPECT_TRUE(is_valid_json_structure(json));
+    EXPECT_NE(json.find("\"p99_ns\": 250"), std::string::npos);
+    EXPECT_NE(json.find("\"max_ns\": 4000"), std::string::npos);
+    EXPECT_NE(json.find("\"BM_Plain\""), std::string::npos);
+
+    std::filesystem::remove(temp_file);
+}
+
 TEST(BenchmarkUtilsTests, SpeedupCalculation) {
     EXPECT_DOUBLE_EQ(hpc::bench::calculate_speedup(100.0, 50.0), 2.0);
     EXPECT_DOUBLE_EQ(hpc::bench::calculate_speedup(100.0, 100.0), 1.0);
@@ -0,0 +1,103 @@
+/**
+ * @file alloc_tracer_test.cpp
+ * @brief Unit tests for the global allocation tracer
+ *
+ * Allocations go through a volatile pointer so the compiler cannot elide
+ * the new/delete pairs being counted.
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alloc_tracer.hpp"
+
+namespace {
+
+namespace tracer = hpc::bench::alloc_tracer;
+
+void* volatile g_sink = nullptr;
+
+void allocate_and_free(size_t bytes) {
+    g_sink = ::operator new(bytes);
+    ::operator delete(g_sink);
+}
+
+} // anonymous namespace
+
+TEST(AllocTracerTests, SizeClasses) {
+    EXPECT_EQ(tracer::size_class(0), 0u);
+    EXPECT_EQ(tracer::size_class(1), 0u);
+    EXPECT_EQ(tracer::size_class(2), 1u);
+    EXPECT_EQ(tracer::size_class(3), 2u);
+    EXPECT_EQ(tracer::size_class(64), 6u);
+    EXPECT_EQ(tracer::size_class(65), 7u);
+    EXPECT_EQ(tracer::size_class(size_t{1} << 40), tracer::SIZE_CLASSES - 1);
+}
+
+TEST(AllocTracerTests, CountsCallingThread) {
+    const tracer::Stats before = tracer::thread_stats();
+    allocate_and_free(100);
+    allocate_and_free(100);
+    g_sink = new int[4];
+    delete[] static_cast<int*>(g_sink);
+    const tracer::Stats delta = tracer::thread_stats() - before;
+    EXPECT_EQ(delta.allocations, 3u);
+    EXPECT_EQ(delta.deallocations, 3u);
+    EXPECT_EQ(delta.bytes_allocated, 2 * 100 + 4 * sizeof(int));
+    EXPECT_EQ(delta.size_classes[tracer::size_class(100)], 2u);
+    EXPECT_EQ(delta.size_classes[tracer::size_class(4 * sizeof(int))], 1u);
+
+    tracer::set_enabled(false);
+    allocate_and_free(100);
+    tracer::set_enabled(true);
+    EXPECT_EQ((tracer::thread_stats() - before).allocations, 3u);
+}
+
+TEST(AllocTracerTests, ExitedThreadsKeepTheirCounts) {
+    const tracer::Stats before = tracer::total_stats();
+    std::thread worker([] {
+        for (int i = 0; i < 10; ++i) {
+            allocate_and_free(32);
+        }
+        const tracer::Stats own = tracer::thread_stats();
+        EXPECT_GE(own.allocations, 10u);
+        EXPECT_GE(own.size_classes[tracer::size_class(32)], 10u);
+    });
+    worker.join();
+    const tracer::Stats delta = tracer::total_stats() - before;
+    EXPECT_GE(delta.allocations, 10u);
+    EXPECT_GE(delta.deallocations, 10u);
+
+    const auto threads = tracer::per_thread_stats();
+    ASSERT_FALSE(threads.empty());
+    EXPECT_EQ(threads.back().thread_index, tracer::SHARED_THREAD_INDEX);
+    EXPECT_GE(threads.back().stats.allocations, 10u);
+}
+
+TEST(AllocTracerTests, SamplesLargeAllocations) {
+    tracer::clear_large_allocations();
+    tracer::set_large_allocation_sampling(64 * 1024, 2);
+    for (int i = 0; i < 4; ++i) {
+        allocate_and_free(128 * 1024);
+    }
+    allocate_and_free(1024);
+    tracer::set_large_allocation_sampling(size_t{1} << 20, 1);
+
+    const auto samples = tracer::large_allocations();
+    ASSERT_EQ(samples.size(), 2u);  // Every second of four
+    for (const auto& sample : samples) {
+        EXPECT_EQ(sample.bytes, 128u * 1024);
+        EXPECT_GT(sample.depth, 0u);
+    }
+
+    std::ostringstream report;
+    tracer::print_report(report);
+    EXPECT_NE(report.str().find("Allocation report"), std::string::npos);
+    EXPECT_NE(report.str().find("Sampled large allocations"), std::string::npos);
+
+    tracer::clear_large_allocations();
+    EXPECT_TRUE(tracer::large_allocations().empty());
+}
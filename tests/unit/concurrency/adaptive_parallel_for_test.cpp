@@ -0,0 +1,127 @@
+/**
+ * @file adaptive_parallel_for_test.cpp
+ * @brief Unit tests for the fixed and adaptive parallel loop schedulers
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <source_location>
+#include <vector>
+
+#include "adaptive_parallel_for.hpp"
+
+namespace {
+
+using hpc::concurrency::ThreadPool;
+using hpc::parallel::LoopTuner;
+using hpc::parallel::Schedule;
+
+/// Roughly `rounds` dependent multiply-adds of work
+double spin(size_t rounds) {
+    volatile double x = 1.0;
+    for (size_t r = 0; r < rounds; ++r) {
+        x = x * 1.0000001 + 0.5;
+    }
+    return x;
+}
+
+void expect_each_index_once(const std::vector<std::atomic<int>>& hits, size_t begin, size_t end) {
+    for (size_t i = 0; i < hits.size(); ++i) {
+        EXPECT_EQ(hits[i].load(), (i >= begin && i < end) ? 1 : 0) << "index " << i;
+    }
+}
+
+} // anonymous namespace
+
+TEST(ParallelForTests, EveryScheduleVisitsEachIndexOnce) {
+    ThreadPool pool(4);
+    for (Schedule schedule : {Schedule::Static, Schedule::Dynamic, Schedule::WorkStealing}) {
+        for (size_t chunk : {size_t{0}, size_t{1}, size_t{7}}) {
+            std::vector<std::atomic<int>> hits(10007);
+            hpc::parallel::parallel_for(3, 10003, [&](size_t i) { hits[i].fetch_add(1); },
+                                        schedule, chunk, pool);
+            expect_each_index_once(hits, 3, 10003);
+        }
+
+        // Fewer iterations than workers, and an empty range
+        std::vector<std::atomic<int>> few(3);
+        hpc::parallel::parallel_for(0, 3, [&](size_t i) { few[i].fetch_add(1); }, schedule, 0, pool);
+        hpc::parallel::parallel_for(2, 2, [&](size_t i) { few[i].fetch_add(1); }, schedule, 0, pool);
+        expect_each_index_once(few, 0, 3);
+    }
+}
+
+TEST(ParallelForTests, DecideScheduleFromChunkCosts) {
+    std::vector<double> flat(64, 100.0);
+    EXPECT_EQ(hpc::parallel::decide_schedule(flat).schedule, Schedule::Static);
+
+    std::vector<double> linear(64);
+    for (size_t k = 0; k < linear.size(); ++k) {
+        linear[k] = 10.0 + 10.0 * static_cast<double>(k);
+    }
+    const auto linear_decision = hpc::parallel::decide_schedule(linear);
+    EXPECT_EQ(linear_decision.schedule, Schedule::Dynamic);
+    EXPECT_NEAR(linear_decision.cv, 0.55, 0.05);
+
+    std::vector<double> spiky(64, 100.0);
+    spiky[5] = 5000.0;
+    spiky[40] = 3000.0;
+    const auto spiky_decision = hpc::parallel::decide_schedule(spiky);
+    EXPECT_EQ(spiky_decision.schedule, Schedule::WorkStealing);
+    EXPECT_GT(spiky_decision.tail, 4.0);
+}
+
+TEST(LoopTunerTests, ProfilesOnFirstCallAndCoversTheRange) {
+    ThreadPool pool(4);
+    LoopTuner tuner;
+    EXPECT_EQ(tuner.decision().ns_per_iter, 0.0);
+
+    for (int call = 0; call < 3; ++call) {
+        std::vector<std::atomic<int>> hits(5000);
+        tuner.run(0, hits.size(), [&](size_t i) {
+            spin(50);
+            hits[i].fetch_add(1);
+        }, pool);
+        expect_each_index_once(hits, 0, hits.size());
+        EXPECT_GT(tuner.decision().ns_per_iter, 0.0);
+    }
+}
+
+TEST(LoopTunerTests, RetunesWhenCostDrifts) {
+    ThreadPool pool(2);
+    LoopTuner tuner;
+    std::vector<double> out(2000);
+
+    for (int call = 0; call < 3; ++call) {
+        tuner.run(0, out.size(), [&](size_t i) { out[i] = spin(10); }, pool);
+    }
+    const double cheap = tuner.decision().ns_per_iter;
+    const unsigned int retunes_before = tuner.retunes();
+
+    // 100x more work per iteration: drift on every call until re-profiled
+    for (int call = 0; call < 6; ++call) {
+        tuner.run(0, out.size(), [&](size_t i) { out[i] = spin(1000); }, pool);
+    }
+    EXPECT_GT(tuner.retunes(), retunes_before);
+    EXPECT_GT(tuner.decision().ns_per_iter, 10.0 * cheap);
+
+    tuner.reset();
+    tuner.run(0, out.size(), [&](size_t i) { out[i] = spin(10); }, pool);
+    EXPECT_LT(tuner.decision().ns_per_iter, 10.0 * cheap);
+}
+
+TEST(LoopTunerTests, TunerIsRememberedPerCallSite) {
+    const auto here = std::source_location::current();
+    const auto there = std::source_location::current();
+    EXPECT_EQ(&hpc::parallel::tuner_for(here), &hpc::parallel::tuner_for(here));
+    EXPECT_NE(&hpc::parallel::tuner_for(here), &hpc::parallel::tuner_for(there));
+
+    std::vector<std::atomic<int>> hits(1000);
+    for (int call = 0; call < 2; ++call) {
+        hpc::parallel::adaptive_parallel_for(0, hits.size(), [&](size_t i) { hits[i].fetch_add(1); });
+    }
+    for (const auto& h : hits) {
+        EXPECT_EQ(h.load(), 2);
+    }
+}
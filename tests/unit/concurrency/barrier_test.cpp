@@ -0,0 +1,152 @@
+/**
+ * @file barrier_test.cpp
+ * @brief Unit tests for the spin-then-block barriers, latch and phaser
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "barrier.hpp"
+
+namespace {
+
+using namespace hpc::concurrency;
+
+/// Run fn(thread_id) on num_threads threads and join them
+template<typename Func>
+void run_threads(size_t num_threads, Func fn) {
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&fn, t]() { fn(t); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+template<typename Barrier>
+class BarrierTests : public ::testing::Test {};
+
+using BarrierTypes = ::testing::Types<SpinBarrier, DisseminationBarrier>;
+TYPED_TEST_SUITE(BarrierTests, BarrierTypes);
+
+} // anonymous namespace
+
+TYPED_TEST(BarrierTests, NoThreadLeavesAPhaseEarly) {
+    constexpr int PHASES = 500;
+    for (size_t num_threads : {1, 2, 3, 5, 8}) {
+        TypeParam barrier(num_threads);
+        std::vector<std::atomic<int>> slots(num_threads);
+        std::atomic<int> serial{0};
+        std::atomic<int> errors{0};
+
+        run_threads(num_threads, [&](size_t t) {
+            for (int phase = 1; phase <= PHASES; ++phase) {
+                slots[t].store(phase, std::memory_order_relaxed);
+                if (barrier.arrive_and_wait(t)) {
+                    serial.fetch_add(1, std::memory_order_relaxed);
+                }
+                // Everyone has written this phase, nobody the next one yet
+                for (const auto& slot : slots) {
+                    if (slot.load(std::memory_order_relaxed) != phase) {
+                        errors.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                barrier.arrive_and_wait(t);
+            }
+        });
+
+        EXPECT_EQ(errors.load(), 0) << num_threads << " threads";
+        EXPECT_EQ(serial.load(), PHASES) << num_threads << " threads";
+    }
+}
+
+TYPED_TEST(BarrierTests, LateArrivalWakesSleepingThreads) {
+    // Far longer than the spin budget, so the early threads go to sleep
+    constexpr size_t THREADS = 4;
+    TypeParam barrier(THREADS);
+    std::atomic<int> passed{0};
+
+    run_threads(THREADS, [&](size_t t) {
+        for (int phase = 0; phase < 3; ++phase) {
+            if (t == THREADS - 1) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+            barrier.arrive_and_wait(t);
+            passed.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    EXPECT_EQ(passed.load(), 3 * static_cast<int>(THREADS));
+}
+
+TEST(LatchTests, ReleasesWaitersAndCanBeReset) {
+    Latch latch(3);
+    EXPECT_FALSE(latch.try_wait());
+
+    for (int round = 0; round < 3; ++round) {
+        std::atomic<int> released{0};
+        std::thread waiter([&]() {
+            latch.wait();
+            released.store(1, std::memory_order_relaxed);
+        });
+        run_threads(3, [&](size_t) { latch.count_down(); });
+        waiter.join();
+        EXPECT_EQ(released.load(), 1);
+        EXPECT_TRUE(latch.try_wait());
+        latch.reset(3);
+    }
+
+    latch.reset(2);
+    run_threads(2, [&](size_t) { latch.arrive_and_wait(); });
+    EXPECT_TRUE(latch.try_wait());
+}
+
+TEST(PhaserTests, AdvancesOncePerPhase) {
+    constexpr uint32_t PARTIES = 4;
+    constexpr int PHASES = 300;
+    Phaser phaser(PARTIES);
+    std::vector<std::atomic<int>> slots(PARTIES);
+    std::atomic<int> errors{0};
+
+    run_threads(PARTIES, [&](size_t t) {
+        for (int phase = 0; phase < PHASES; ++phase) {
+            slots[t].store(phase, std::memory_order_relaxed);
+            if (phaser.arrive_and_await_advance() != static_cast<uint32_t>(phase + 1)) {
+                errors.fetch_add(1, std::memory_order_relaxed);
+            }
+            for (const auto& slot : slots) {
+                if (slot.load(std::memory_order_relaxed) < phase) {
+                    errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(phaser.phase(), static_cast<uint32_t>(PHASES));
+}
+
+TEST(PhaserTests, RegistrationAndNonBlockingArrival) {
+    Phaser phaser(1);
+    EXPECT_EQ(phaser.register_party(), 0u);
+    EXPECT_EQ(phaser.registered_parties(), 2u);
+
+    // arrive() returns the phase arrived at without waiting
+    EXPECT_EQ(phaser.arrive(), 0u);
+    EXPECT_EQ(phaser.unarrived_parties(), 1u);
+    EXPECT_EQ(phaser.phase(), 0u);
+
+    std::thread worker([&]() {
+        EXPECT_EQ(phaser.arrive_and_await_advance(), 1u);
+        phaser.arrive_and_deregister();  // Leaves during phase 1
+    });
+    EXPECT_EQ(phaser.await_advance(0), 1u);
+    EXPECT_EQ(phaser.arrive_and_await_advance(), 2u);
+    worker.join();
+
+    EXPECT_EQ(phaser.registered_parties(), 1u);
+    EXPECT_EQ(phaser.arrive_and_await_advance(), 3u);  // Alone now
+    EXPECT_EQ(phaser.await_advance(1), 3u);            // Past phases return at once
+}
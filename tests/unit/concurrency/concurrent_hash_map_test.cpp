@@ -0,0 +1,155 @@
+/**
+ * @file concurrent_hash_map_test.cpp
+ * @brief Unit and stress tests for ConcurrentHashMap
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "concurrent_hash_map.hpp"
+
+namespace {
+
+using hpc::concurrency::ConcurrentHashMap;
+
+} // anonymous namespace
+
+TEST(ConcurrentHashMapTests, InsertFindErase) {
+    auto map = std::make_unique<ConcurrentHashMap<uint64_t, uint64_t>>();
+    EXPECT_TRUE(map->empty());
+    EXPECT_FALSE(map->find(1).has_value());
+
+    EXPECT_TRUE(map->insert(1, 10));
+    EXPECT_FALSE(map->insert(1, 11));  // Already present, not overwritten
+    EXPECT_EQ(map->find(1), 10u);
+
+    EXPECT_FALSE(map->insert_or_assign(1, 12));
+    EXPECT_EQ(map->find(1), 12u);
+
+    EXPECT_TRUE(map->erase(1));
+    EXPECT_FALSE(map->erase(1));
+    EXPECT_FALSE(map->contains(1));
+    EXPECT_EQ(map->size(), 0u);
+}
+
+TEST(ConcurrentHashMapTests, GrowsAndKeepsAllKeys) {
+    auto map = std::make_unique<ConcurrentHashMap<uint32_t, uint32_t, 4>>(16);
+    const size_t initial_capacity = map->capacity();
+    constexpr uint32_t COUNT = 10000;
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        ASSERT_TRUE(map->insert(i, i * 2));
+    }
+    EXPECT_GT(map->capacity(), initial_capacity);
+    EXPECT_EQ(map->size(), COUNT);
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        ASSERT_EQ(map->find(i), i * 2);
+    }
+}
+
+/// Backward-shift deletion must keep every remaining key reachable
+TEST(ConcurrentHashMapTests, MatchesReferenceUnderChurn) {
+    auto map = std::make_unique<ConcurrentHashMap<int64_t, int64_t, 1>>(64);
+    std::unordered_map<int64_t, int64_t> reference;
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> key_dist(0, 255);  // Small range: long clusters
+
+    for (int op = 0; op < 100000; ++op) {
+        const int64_t key = key_dist(rng);
+        switch (rng() % 3) {
+        case 0:
+            EXPECT_EQ(map->insert_or_assign(key, op), reference.count(key) == 0);
+            reference[key] = op;
+            break;
+        case 1:
+            EXPECT_EQ(map->erase(key), reference.erase(key) == 1);
+            break;
+        default: {
+            auto it = reference.find(key);
+            auto found = map->find(key);
+            ASSERT_EQ(found.has_value(), it != reference.end());
+            if (found) {
+                EXPECT_EQ(*found, it->second);
+            }
+        }
+        }
+    }
+    EXPECT_EQ(map->size(), reference.size());
+}
+
+/// Keys that are never erased must always be visible to lock-free readers,
+/// even while writers shift neighbouring entries and resize the shard
+TEST(ConcurrentHashMapTests, ConcurrentReadersNeverMissStableKeys) {
+    auto map = std::make_unique<ConcurrentHashMap<uint64_t, uint64_t, 4>>(64);
+    constexpr uint64_t STABLE = 1000;
+    for (uint64_t k = 0; k < STABLE; ++k) {
+        map->insert(k, k + 1);
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> misses{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([&, t]() {
+            uint64_t k = static_cast<uint64_t>(t);
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto v = map->find(k % STABLE);
+                if (!v || *v != k % STABLE + 1) {
+                    misses.fetch_add(1);
+                }
+                k += 7;
+            }
+        });
+    }
+
+    std::thread writer([&]() {
+        for (uint64_t round = 0; round < 20; ++round) {
+            for (uint64_t k = STABLE; k < STABLE + 2000; ++k) {
+                map->insert(k, k);
+            }
+            for (uint64_t k = STABLE; k < STABLE + 2000; ++k) {
+                map->erase(k);
+            }
+        }
+        stop.store(true);
+    });
+
+    writer.join();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(misses.load(), 0);
+    EXPECT_EQ(map->size(), STABLE);
+}
+
+TEST(ConcurrentHashMapTests, ConcurrentWritersDisjointKeys) {
+    auto map = std::make_unique<ConcurrentHashMap<uint64_t, uint64_t>>(16);
+    constexpr int NUM_THREADS = 4;
+    constexpr uint64_t PER_THREAD = 5000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            const uint64_t base = static_cast<uint64_t>(t) * PER_THREAD;
+            for (uint64_t i = 0; i < PER_THREAD; ++i) {
+                map->insert(base + i, i);
+            }
+            for (uint64_t i = 0; i < PER_THREAD; i += 2) {
+                map->erase(base + i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(map->size(), NUM_THREADS * PER_THREAD / 2);
+    for (uint64_t k = 0; k < NUM_THREADS * PER_THREAD; ++k) {
+        ASSERT_EQ(map->contains(k), (k % PER_THREAD) % 2 == 1);
+    }
+}
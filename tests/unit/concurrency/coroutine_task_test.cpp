@@ -0,0 +1,143 @@
+/**
+ * @file coroutine_task_test.cpp
+ * @brief Unit tests for task<T>, Executor, when_all/when_any and async_mutex
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "coroutine_task.hpp"
+
+namespace {
+
+using hpc::concurrency::async_mutex;
+using hpc::concurrency::Executor;
+using hpc::concurrency::sync_wait;
+using hpc::concurrency::task;
+using hpc::concurrency::when_all;
+using hpc::concurrency::when_any;
+
+task<int> answer() {
+    co_return 42;
+}
+
+task<int> add_answers() {
+    const int a = co_await answer();
+    const int b = co_await answer();
+    co_return a + b;
+}
+
+task<void> throw_error() {
+    throw std::runtime_error("boom");
+    co_return;
+}
+
+task<std::thread::id> thread_id_on(Executor& executor) {
+    co_await executor.schedule();
+    co_return std::this_thread::get_id();
+}
+
+task<int> square_on(Executor& executor, int x) {
+    co_await executor.schedule();
+    co_return x * x;
+}
+
+/// Finishes after @p hops trips through the executor queue
+task<int> slow_value(Executor& executor, int hops, int value) {
+    for (int i = 0; i < hops; ++i) {
+        co_await executor.schedule();
+    }
+    co_return value;
+}
+
+task<void> locked_increments(Executor& executor, async_mutex& mutex, int64_t& counter, int n) {
+    co_await executor.schedule();
+    for (int i = 0; i < n; ++i) {
+        auto guard = co_await mutex.scoped_lock();
+        const int64_t v = counter;  // Non-atomic, protected by the mutex
+        co_await executor.schedule();  // Suspend while holding the lock
+        counter = v + 1;
+    }
+}
+
+} // anonymous namespace
+
+TEST(CoroutineTaskTests, NestedTasksReturnValues) {
+    EXPECT_EQ(sync_wait(answer()), 42);
+    EXPECT_EQ(sync_wait(add_answers()), 84);
+}
+
+TEST(CoroutineTaskTests, ExceptionsPropagateToAwaiter) {
+    EXPECT_THROW(sync_wait(throw_error()), std::runtime_error);
+}
+
+TEST(CoroutineTaskTests, ScheduleResumesOnWorker) {
+    Executor executor(2);
+    const std::thread::id worker = sync_wait(thread_id_on(executor));
+    EXPECT_NE(worker, std::this_thread::get_id());
+}
+
+TEST(CoroutineTaskTests, WhenAllCollectsResultsInOrder) {
+    Executor executor(4);
+    std::vector<task<int>> tasks;
+    for (int i = 0; i < 100; ++i) {
+        tasks.push_back(square_on(executor, i));
+    }
+    const std::vector<int> results = sync_wait(when_all(std::move(tasks)));
+    ASSERT_EQ(results.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(results[static_cast<size_t>(i)], i * i);
+    }
+}
+
+TEST(CoroutineTaskTests, ExecutorSurvivesQueueOverflow) {
+    // More self-rescheduling coroutines than queue slots on one worker
+    Executor executor(1);
+    const int n = static_cast<int>(Executor::QUEUE_CAPACITY) * 3;
+    std::vector<task<int>> tasks;
+    for (int i = 0; i < n; ++i) {
+        tasks.push_back(slow_value(executor, 3, i));
+    }
+    const std::vector<int> results = sync_wait(when_all(std::move(tasks)));
+    ASSERT_EQ(results.size(), static_cast<size_t>(n));
+    EXPECT_EQ(results.back(), n - 1);
+}
+
+TEST(CoroutineTaskTests, WhenAllVoidRethrows) {
+    std::vector<task<void>> tasks;
+    tasks.push_back(throw_error());
+    EXPECT_THROW(sync_wait(when_all(std::move(tasks))), std::runtime_error);
+}
+
+TEST(CoroutineTaskTests, WhenAnyReturnsFirstFinished) {
+    Executor executor(1);  // One worker: hop count decides the order
+    std::vector<task<int>> tasks;
+    tasks.push_back(slow_value(executor, 50, 1));
+    tasks.push_back(slow_value(executor, 1, 2));
+    tasks.push_back(slow_value(executor, 50, 3));
+    const auto result = sync_wait(when_any(std::move(tasks)));
+    EXPECT_EQ(result.index, 1u);
+    EXPECT_EQ(result.value, 2);
+}
+
+TEST(CoroutineTaskTests, AsyncMutexIsMutuallyExclusive) {
+    Executor executor(4);
+    async_mutex mutex;
+    int64_t counter = 0;
+    constexpr int COROUTINES = 8;
+    constexpr int INCREMENTS = 500;
+
+    std::vector<task<void>> tasks;
+    for (int c = 0; c < COROUTINES; ++c) {
+        tasks.push_back(locked_increments(executor, mutex, counter, INCREMENTS));
+    }
+    sync_wait(when_all(std::move(tasks)));
+
+    EXPECT_EQ(counter, COROUTINES * INCREMENTS);
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
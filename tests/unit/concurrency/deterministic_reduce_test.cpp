@@ -0,0 +1,171 @@
+/**
+ * @file deterministic_reduce_test.cpp
+ * @brief Unit tests for the reproducible parallel sum and dot product
+ *
+ * Results must be bit-identical across thread counts and backends, and
+ * equal to a scalar implementation of the documented reduction shape.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "deterministic_reduce.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+using hpc::parallel::Backend;
+using hpc::parallel::Summation;
+
+constexpr size_t N = 1000003;  // Not a multiple of a leaf or a lane group
+
+template<typename T>
+std::vector<T> random_values(size_t n, uint32_t seed = 1) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<T> mantissa(-1, 1);
+    std::uniform_int_distribution<int> exponent(-10, 10);
+    std::vector<T> v(n);
+    for (auto& x : v) {
+        x = std::ldexp(mantissa(rng), exponent(rng));
+    }
+    return v;
+}
+
+/// Scalar model of the documented shape: leaves, lanes, pairwise trees
+template<typename T>
+T reference_sum(const std::vector<T>& x) {
+    constexpr size_t LEAF = hpc::parallel::detail::REDUCE_LEAF;
+    constexpr size_t LANES = hpc::parallel::detail::REDUCE_LANE_BYTES / sizeof(T);
+    auto tree = [](std::vector<T>& p) {
+        for (size_t stride = 1; stride < p.size(); stride *= 2) {
+            for (size_t i = 0; i + stride < p.size(); i += 2 * stride) {
+                p[i] += p[i + stride];
+            }
+        }
+        return p.empty() ? T(0) : p[0];
+    };
+
+    std::vector<T> leaves;
+    for (size_t lo = 0; lo < x.size(); lo += LEAF) {
+        std::vector<T> lanes(LANES, T(0));
+        for (size_t i = lo; i < std::min(lo + LEAF, x.size()); ++i) {
+            lanes[(i - lo) % LANES] += x[i];
+        }
+        leaves.push_back(tree(lanes));
+    }
+    return tree(leaves);
+}
+
+bool same_bits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+bool same_bits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+/// Run fn(backend) for every backend and (with OpenMP) several thread counts
+template<typename Func>
+void for_each_configuration(Func fn) {
+    fn(Backend::ThreadPool);
+#ifdef _OPENMP
+    const int saved = omp_get_max_threads();
+    for (int threads : {1, 2, 3, 4, 7, 16}) {
+        omp_set_num_threads(threads);
+        fn(Backend::OpenMP);
+    }
+    omp_set_num_threads(saved);
+#endif
+}
+
+} // anonymous namespace
+
+TEST(DeterministicReduceTests, SumMatchesReferenceShapeForAnyThreadCount) {
+    const auto d = random_values<double>(N);
+    const double expected_d = reference_sum(d);
+    const auto f = random_values<float>(N, 2);
+    const float expected_f = reference_sum(f);
+
+    for_each_configuration([&](Backend backend) {
+        EXPECT_TRUE(same_bits(hpc::parallel::deterministic_sum(d.data(), d.size(), backend), expected_d));
+        EXPECT_TRUE(same_bits(hpc::parallel::deterministic_sum(f.data(), f.size(), backend), expected_f));
+    });
+}
+
+TEST(DeterministicReduceTests, DotMatchesSumOfRoundedProducts) {
+    const auto a = random_values<double>(N, 3);
+    const auto b = random_values<double>(N, 4);
+    std::vector<double> products(N);
+    for (size_t i = 0; i < N; ++i) {
+        products[i] = a[i] * b[i];
+    }
+    const double expected = reference_sum(products);
+
+    for_each_configuration([&](Backend backend) {
+        EXPECT_TRUE(same_bits(hpc::parallel::deterministic_dot(a.data(), b.data(), N, backend), expected));
+    });
+}
+
+/// -ffp-contract=fast must not fuse a product into the lane add (FMA) or
+/// into the Kahan TwoSum: the products are rounded to float first
+TEST(DeterministicReduceTests, FloatDotMatchesRoundedProductsBitwise) {
+    const auto a = random_values<float>(N, 6);
+    const auto b = random_values<float>(N, 7);
+    std::vector<float> products(N);
+    for (size_t i = 0; i < N; ++i) {
+        products[i] = a[i] * b[i];
+    }
+    const float expected = reference_sum(products);
+    const float expected_kahan = hpc::parallel::deterministic_sum<float, Summation::Kahan>(
+        products.data(), N, Backend::ThreadPool);
+
+    for_each_configuration([&](Backend backend) {
+        EXPECT_TRUE(same_bits(hpc::parallel::deterministic_dot(a.data(), b.data(), N, backend), expected));
+        EXPECT_TRUE(same_bits(hpc::parallel::deterministic_dot<float, Summation::Kahan>(
+                                  a.data(), b.data(), N, backend),
+                              expected_kahan));
+    });
+}
+
+TEST(DeterministicReduceTests, KahanIsReproducibleAndAccurate) {
+    // Large terms that cancel exactly, plus 1.0: the exact sum is 1.0
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> dist(-1e10, 1e10);
+    std::vector<double> x;
+    for (size_t i = 0; i < N / 2; ++i) {
+        const double v = dist(rng);
+        x.push_back(v);
+        x.push_back(-v);
+    }
+    x.push_back(1.0);
+    std::shuffle(x.begin(), x.end(), rng);
+
+    const double kahan = hpc::parallel::deterministic_sum<double, Summation::Kahan>(
+        x.data(), x.size(), Backend::ThreadPool);
+    const double pairwise = hpc::parallel::deterministic_sum(x.data(), x.size(), Backend::ThreadPool);
+    EXPECT_NEAR(kahan, 1.0, 1e-6);
+    EXPECT_LE(std::abs(kahan - 1.0), std::abs(pairwise - 1.0));
+
+    for_each_configuration([&](Backend backend) {
+        EXPECT_TRUE(same_bits(
+            hpc::parallel::deterministic_sum<double, Summation::Kahan>(x.data(), x.size(), backend), kahan));
+    });
+}
+
+TEST(DeterministicReduceTests, EmptyAndTinyInputs) {
+    std::vector<float> empty;
+    EXPECT_EQ(hpc::parallel::deterministic_sum(empty.data(), 0), 0.0f);
+
+    std::vector<double> three{1.5, -2.25, 4.0};
+    EXPECT_EQ(hpc::parallel::deterministic_sum(three.data(), three.size()), 3.25);
+    EXPECT_EQ((hpc::parallel::deterministic_sum<double, Summation::Kahan>(three.data(), three.size())), 3.25);
+    EXPECT_EQ(hpc::parallel::deterministic_dot(three.data(), three.data(), three.size()),
+              1.5 * 1.5 + 2.25 * 2.25 + 16.0);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file disruptor_test.cpp
+ * @brief Unit tests for the Disruptor-style RingBuffer, barriers and processors
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "disruptor.hpp"
+
+namespace {
+
+using hpc::concurrency::BatchEventProcessor;
+using hpc::concurrency::ProducerType;
+using hpc::concurrency::RingBuffer;
+using hpc::concurrency::Sequence;
+
+struct Event {
+    int64_t value = 0;
+    int64_t doubled = 0;   // Written by stage A
+    int64_t negated = 0;   // Written by stage B
+};
+
+/// Handler that sums values and checks every sequence arrives in order
+struct SumHandler {
+    int64_t sum = 0;
+    int64_t expected_sequence = 0;
+    bool in_order = true;
+
+    void operator()(Event& event, int64_t sequence, bool /*end_of_batch*/) {
+        in_order = in_order && sequence == expected_sequence++;
+        sum += event.value;
+    }
+};
+
+void wait_until_processed(const Sequence& sequence, int64_t last) {
+    while (sequence.get() < last) {
+        std::this_thread::yield();
+    }
+}
+
+} // anonymous namespace
+
+TEST(DisruptorTests, EveryConsumerSeesEveryEvent) {
+    using Ring = RingBuffer<Event, 64>;
+    auto ring = std::make_unique<Ring>();
+    constexpr int64_t EVENTS = 20000;
+
+    auto barrier = ring->new_barrier();
+    BatchEventProcessor c1(*ring, barrier, SumHandler{});
+    BatchEventProcessor c2(*ring, barrier, SumHandler{});
+    BatchEventProcessor c3(*ring, barrier, SumHandler{});
+    ring->add_gating_sequences({&c1.sequence(), &c2.sequence(), &c3.sequence()});
+
+    std::thread t1([&]() { c1.run(); });
+    std::thread t2([&]() { c2.run(); });
+    std::thread t3([&]() { c3.run(); });
+
+    for (int64_t i = 0; i < EVENTS; ++i) {
+        ring->publish_event([i](Event& e, int64_t) { e.value = i; });
+    }
+
+    wait_until_processed(c1.sequence(), EVENTS - 1);
+    wait_until_processed(c2.sequence(), EVENTS - 1);
+    wait_until_processed(c3.sequence(), EVENTS - 1);
+    barrier.alert();
+    t1.join();
+    t2.join();
+    t3.join();
+
+    const int64_t expected = EVENTS * (EVENTS - 1) / 2;
+    for (auto* c : {&c1.handler(), &c2.handler(), &c3.handler()}) {
+        EXPECT_EQ(c->sum, expected);
+        EXPECT_TRUE(c->in_order);
+    }
+}
+
+/// Diamond: A and B annotate the event in place, C depends on both
+TEST(DisruptorTests, DependentStageSeesUpstreamWrites) {
+    using Ring = RingBuffer<Event, 32>;
+    auto ring = std::make_unique<Ring>();
+    constexpr int64_t EVENTS = 10000;
+
+    auto first = ring->new_barrier();
+    auto stage_a = [](Event& e, int64_t, bool) { e.doubled = e.value * 2; };
+    auto stage_b = [](Event& e, int64_t, bool) { e.negated = -e.value; };
+    BatchEventProcessor a(*ring, first, stage_a);
+    BatchEventProcessor b(*ring, first, stage_b);
+
+    auto second = ring->new_barrier({&a.sequence(), &b.sequence()});
+    int64_t mismatches = 0;
+    auto stage_c = [&mismatches](Event& e, int64_t, bool) {
+        if (e.doubled != e.value * 2 || e.negated != -e.value) {
+            ++mismatches;
+        }
+    };
+    BatchEventProcessor c(*ring, second, stage_c);
+    ring->add_gating_sequences({&c.sequence()});
+
+    std::thread ta([&]() { a.run(); });
+    std::thread tb([&]() { b.run(); });
+    std::thread tc([&]() { c.run(); });
+
+    for (int64_t i = 0; i < EVENTS; ++i) {
+        ring->publish_event([i](Event& e, int64_t) { e.value = i + 1; });
+    }
+
+    wait_until_processed(c.sequence(), EVENTS - 1);
+    first.alert();
+    second.alert();
+    ta.join();
+    tb.join();
+    tc.join();
+
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST(DisruptorTests, BatchClaimPublishesRange) {
+    using Ring = RingBuffer<Event, 16>;
+    auto ring = std::make_unique<Ring>();
+    auto barrier = ring->new_barrier();
+
+    const int64_t hi = ring->next(4);
+    EXPECT_EQ(hi, 3);
+    for (int64_t s = hi - 3; s <= hi; ++s) {
+        (*ring)[s].value = s * 10;
+    }
+    ring->publish(hi - 3, hi);
+
+    EXPECT_EQ(barrier.wait_for(0), 3);  // Whole batch available at once
+    EXPECT_EQ((*ring)[2].value, 20);
+}
+
+TEST(DisruptorTests, MultiProducerDeliversAllEvents) {
+    using Ring = RingBuffer<Event, 64, ProducerType::Multi>;
+    auto ring = std::make_unique<Ring>();
+    constexpr int NUM_PRODUCERS = 3;
+    constexpr int64_t PER_PRODUCER = 5000;
+    constexpr int64_t EVENTS = NUM_PRODUCERS * PER_PRODUCER;
+
+    auto barrier = ring->new_barrier();
+    BatchEventProcessor c1(*ring, barrier, SumHandler{});
+    BatchEventProcessor c2(*ring, barrier, SumHandler{});
+    ring->add_gating_sequences({&c1.sequence(), &c2.sequence()});
+
+    std::thread t1([&]() { c1.run(); });
+    std::thread t2([&]() { c2.run(); });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int64_t i = 0; i < PER_PRODUCER; i += 2) {
+                // Batch claim of two slots
+                const int64_t hi = ring->next(2);
+                (*ring)[hi - 1].value = p * PER_PRODUCER + i;
+                (*ring)[hi].value = p * PER_PRODUCER + i + 1;
+                ring->publish(hi - 1, hi);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    wait_until_processed(c1.sequence(), EVENTS - 1);
+    wait_until_processed(c2.sequence(), EVENTS - 1);
+    barrier.alert();
+    t1.join();
+    t2.join();
+
+    const int64_t expected = EVENTS * (EVENTS - 1) / 2;
+    EXPECT_EQ(c1.handler().sum, expected);
+    EXPECT_EQ(c2.handler().sum, expected);
+    EXPECT_TRUE(c1.handler().in_order);
+}
@@ -0,0 +1,99 @@
+/**
+ * @file latency_histogram_test.cpp
+ * @brief Unit tests for LatencyHistogram and the TSC helpers
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "latency_histogram.hpp"
+
+using hpc::concurrency::LatencyHistogram;
+
+TEST(LatencyHistogramTests, BucketBoundsCoverEveryValue) {
+    using H = LatencyHistogram<5>;
+    for (uint64_t v : {uint64_t{0}, uint64_t{31}, uint64_t{32}, uint64_t{33}, uint64_t{1000},
+                       uint64_t{1} << 40, UINT64_MAX}) {
+        const size_t b = H::bucket_for(v);
+        ASSERT_LT(b, H::NUM_BUCKETS);
+        EXPECT_LE(H::bucket_lower_bound(b), v);
+        EXPECT_GE(H::bucket_upper_bound(b), v);
+    }
+    EXPECT_EQ(H::bucket_for(UINT64_MAX), H::NUM_BUCKETS - 1);
+    // Consecutive buckets tile the value range without gaps
+    for (size_t b = 0; b + 1 < H::NUM_BUCKETS; ++b) {
+        ASSERT_EQ(H::bucket_upper_bound(b) + 1, H::bucket_lower_bound(b + 1)) << b;
+    }
+}
+
+TEST(LatencyHistogramTests, PercentilesWithinRelativeError) {
+    LatencyHistogram<> hist;
+    for (uint64_t v = 1; v <= 100000; ++v) {
+        hist.record(v);
+    }
+    EXPECT_EQ(hist.count(), 100000u);
+    EXPECT_EQ(hist.min(), 1u);
+    EXPECT_EQ(hist.max(), 100000u);
+    EXPECT_DOUBLE_EQ(hist.mean(), 50000.5);
+
+    for (double pct : {50.0, 90.0, 99.0, 99.9}) {
+        const double exact = pct * 1000.0;
+        const double reported = static_cast<double>(hist.percentile(pct));
+        EXPECT_GE(reported, exact) << pct;
+        EXPECT_LE(reported, exact * 1.016) << pct;
+    }
+    EXPECT_EQ(hist.percentile(100.0), hist.max());
+}
+
+TEST(LatencyHistogramTests, TailOutlierShowsUpInMaxNotMedian) {
+    LatencyHistogram<> hist;
+    for (int i = 0; i < 9999; ++i) {
+        hist.record(100);
+    }
+    hist.record(5000000);
+    EXPECT_EQ(hist.percentile(50.0), 100u);
+    EXPECT_EQ(hist.percentile(99.9), 100u);
+    EXPECT_EQ(hist.max(), 5000000u);
+}
+
+TEST(LatencyHistogramTests, ConcurrentRecordAndMerge) {
+    LatencyHistogram<> shared;
+    constexpr int THREADS = 4;
+    constexpr uint64_t PER_THREAD = 50000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&shared, t]() {
+            for (uint64_t i = 0; i < PER_THREAD; ++i) {
+                shared.record(i + static_cast<uint64_t>(t));
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(shared.count(), THREADS * PER_THREAD);
+    EXPECT_EQ(shared.max(), PER_THREAD - 1 + THREADS - 1);
+
+    LatencyHistogram<> merged;
+    merged.record(1);
+    merged.merge(shared);
+    EXPECT_EQ(merged.count(), THREADS * PER_THREAD + 1);
+    EXPECT_EQ(merged.min(), 0u);
+    EXPECT_EQ(merged.max(), shared.max());
+
+    merged.reset();
+    EXPECT_EQ(merged.count(), 0u);
+    EXPECT_EQ(merged.percentile(99.0), 0u);
+}
+
+TEST(LatencyHistogramTests, TscAdvancesAndIsCalibrated) {
+    const uint64_t a = hpc::concurrency::read_tsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const uint64_t b = hpc::concurrency::read_tsc();
+    EXPECT_GT(b, a);
+    EXPECT_GT(hpc::concurrency::tsc_ticks_per_ns(), 0.0);
+}
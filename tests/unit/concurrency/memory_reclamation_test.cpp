@@ -0,0 +1,230 @@
+/**
+ * @file memory_reclamation_test.cpp
+ * @brief Unit and stress tests for EpochDomain, HazardPointerDomain and TreiberStack
+ *
+ * The stress tests are meant to be run under the tsan preset: a node freed
+ * while another thread still reads it shows up as a data race (TSan) or
+ * heap-use-after-free (ASan).
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "memory_reclamation.hpp"
+
+namespace {
+
+using hpc::concurrency::EpochDomain;
+using hpc::concurrency::HazardPointerDomain;
+using hpc::concurrency::RECLAIM_BATCH;
+using hpc::concurrency::TreiberStack;
+
+std::atomic<int> g_freed{0};
+
+void counting_deleter(void* ptr) {
+    delete static_cast<int*>(ptr);
+    g_freed.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename Domain>
+class ReclamationTest : public ::testing::Test {};
+
+using Domains = ::testing::Types<EpochDomain, HazardPointerDomain>;
+TYPED_TEST_SUITE(ReclamationTest, Domains);
+
+} // anonymous namespace
+
+TYPED_TEST(ReclamationTest, UnprotectedObjectsAreReclaimed) {
+    g_freed = 0;
+    auto domain = std::make_unique<TypeParam>();
+    constexpr int COUNT = 1000;
+    for (int i = 0; i < COUNT; ++i) {
+        domain->retire(new int(i), &counting_deleter);
+    }
+    EXPECT_EQ(domain->collect(), 0u);
+    EXPECT_EQ(g_freed.load(), COUNT);
+}
+
+TYPED_TEST(ReclamationTest, DestructorFreesPendingGarbage) {
+    g_freed = 0;
+    {
+        auto domain = std::make_unique<TypeParam>();
+        for (int i = 0; i < 10; ++i) {
+            domain->retire(new int(i), &counting_deleter);
+        }
+    }
+    EXPECT_EQ(g_freed.load(), 10);
+}
+
+TYPED_TEST(ReclamationTest, ProtectedObjectSurvivesCollect) {
+    g_freed = 0;
+    auto domain = std::make_unique<TypeParam>();
+    std::atomic<int*> shared{new int(42)};
+
+    std::atomic<bool> protected_flag{false};
+    std::atomic<bool> release{false};
+    std::thread reader([&]() {
+        typename TypeParam::Guard guard(*domain);
+        int* p = guard.protect(shared);
+        protected_flag.store(true, std::memory_order_release);
+        while (!release.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        EXPECT_EQ(*p, 42);
+    });
+
+    while (!protected_flag.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    int* old = shared.exchange(nullptr);
+    domain->retire(old, &counting_deleter);
+    EXPECT_EQ(domain->collect(), 1u);
+    EXPECT_EQ(g_freed.load(), 0);
+
+    release.store(true, std::memory_order_release);
+    reader.join();
+    EXPECT_EQ(domain->collect(), 0u);
+    EXPECT_EQ(g_freed.load(), 1);
+}
+
+TYPED_TEST(ReclamationTest, InnerGuardKeepsOuterProtection) {
+    g_freed = 0;
+    auto domain = std::make_unique<TypeParam>();
+    TreiberStack<int, TypeParam> stack(*domain);
+    std::atomic<int*> shared{new int(7)};
+    {
+        typename TypeParam::Guard outer(*domain);
+        int* p = outer.protect(shared);
+
+        // The stack pop opens and closes its own guard on this thread
+        stack.push(1);
+        EXPECT_EQ(stack.pop(), 1);
+
+        shared.store(nullptr);
+        domain->retire(p, &counting_deleter);
+        domain->collect();
+        EXPECT_EQ(g_freed.load(), 0);
+        EXPECT_EQ(*p, 7);
+    }
+    domain->collect();
+    domain->collect();
+    EXPECT_EQ(g_freed.load(), 1);
+}
+
+TEST(HazardPointerTests, GuardsNestUpToMaxDepth) {
+    auto domain = std::make_unique<HazardPointerDomain>();
+    std::vector<std::unique_ptr<HazardPointerDomain::Guard>> guards;
+    for (size_t i = 0; i < HazardPointerDomain::MAX_GUARD_DEPTH; ++i) {
+        guards.push_back(std::make_unique<HazardPointerDomain::Guard>(*domain));
+    }
+    EXPECT_THROW(HazardPointerDomain::Guard extra(*domain), std::runtime_error);
+    while (!guards.empty()) {
+        guards.pop_back();
+    }
+    // All levels were released, so a full stack of guards fits again
+    for (size_t i = 0; i < HazardPointerDomain::MAX_GUARD_DEPTH; ++i) {
+        guards.push_back(std::make_unique<HazardPointerDomain::Guard>(*domain));
+    }
+    while (!guards.empty()) {
+        guards.pop_back();
+    }
+}
+
+TEST(HazardPointerTests, GarbageBoundedWhileReaderStalls) {
+    auto domain = std::make_unique<HazardPointerDomain>();
+    std::atomic<int*> shared{new int(0)};
+
+    std::atomic<bool> protected_flag{false};
+    std::atomic<bool> release{false};
+    std::thread reader([&]() {
+        HazardPointerDomain::Guard guard(*domain);
+        guard.protect(shared);
+        protected_flag.store(true, std::memory_order_release);
+        while (!release.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    });
+
+    while (!protected_flag.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    for (int i = 1; i <= 10000; ++i) {
+        int* old = shared.exchange(new int(i));
+        domain->retire(old);
+        ASSERT_LE(domain->pending(), HazardPointerDomain::scan_threshold());
+    }
+
+    release.store(true, std::memory_order_release);
+    reader.join();
+    delete shared.load();
+}
+
+TEST(EpochDomainTests, EpochAdvancesOnlyWhenReadersCatchUp) {
+    auto domain = std::make_unique<EpochDomain>();
+    const uint64_t start = domain->epoch();
+    {
+        EpochDomain::Guard guard(*domain);
+        domain->collect();
+        // We are in epoch `start`, so at most one advance can happen
+        EXPECT_LE(domain->epoch(), start + 1);
+    }
+    domain->collect();
+    EXPECT_GE(domain->epoch(), start + 2);
+}
+
+TYPED_TEST(ReclamationTest, TreiberStackIsLifo) {
+    auto domain = std::make_unique<TypeParam>();
+    TreiberStack<int, TypeParam> stack(*domain);
+    EXPECT_TRUE(stack.empty());
+    EXPECT_FALSE(stack.pop().has_value());
+
+    for (int i = 0; i < 5; ++i) {
+        stack.push(i);
+    }
+    for (int i = 4; i >= 0; --i) {
+        auto value = stack.pop();
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(*value, i);
+    }
+    EXPECT_TRUE(stack.empty());
+}
+
+TYPED_TEST(ReclamationTest, TreiberStackStress) {
+    auto domain = std::make_unique<TypeParam>();
+    TreiberStack<int64_t, TypeParam> stack(*domain);
+    constexpr int NUM_THREADS = 4;
+    constexpr int OPS = 20000;
+
+    std::atomic<int64_t> pushed_sum{0};
+    std::atomic<int64_t> popped_sum{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            int64_t local_pushed = 0;
+            int64_t local_popped = 0;
+            for (int i = 0; i < OPS; ++i) {
+                const int64_t v = static_cast<int64_t>(t) * OPS + i + 1;
+                stack.push(v);
+                local_pushed += v;
+                if (auto popped = stack.pop()) {
+                    local_popped += *popped;
+                }
+            }
+            pushed_sum.fetch_add(local_pushed);
+            popped_sum.fetch_add(local_popped);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    while (auto popped = stack.pop()) {
+        popped_sum.fetch_add(*popped);
+    }
+    EXPECT_EQ(pushed_sum.load(), popped_sum.load());
+    EXPECT_LE(domain->collect(), static_cast<size_t>(RECLAIM_BATCH) * NUM_THREADS);
+}
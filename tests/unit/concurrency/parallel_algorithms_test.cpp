@@ -0,0 +1,198 @@
+/**
+ * @file parallel_algorithms_test.cpp
+ * @brief Unit tests for ThreadPool and the hpc::parallel algorithms
+ *
+ * Every algorithm is checked against its std:: counterpart on both
+ * backends. Sizes are chosen to span several blocks.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "parallel_algorithms.hpp"
+#include "thread_pool.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+using hpc::concurrency::ThreadPool;
+using hpc::parallel::Backend;
+
+constexpr size_t N = 200003;  // Not a multiple of anything
+
+std::vector<Backend> backends() {
+#ifdef _OPENMP
+    omp_set_num_threads(4);  // Several blocks even on a single-CPU machine
+    return {Backend::ThreadPool, Backend::OpenMP};
+#else
+    return {Backend::ThreadPool};
+#endif
+}
+
+template<typename T>
+std::vector<T> random_values(size_t n, T lo, T hi, uint32_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> v(n);
+    if constexpr (std::is_floating_point_v<T>) {
+        std::uniform_real_distribution<T> dist(lo, hi);
+        for (auto& x : v) x = dist(rng);
+    } else {
+        std::uniform_int_distribution<T> dist(lo, hi);
+        for (auto& x : v) x = dist(rng);
+    }
+    return v;
+}
+
+} // anonymous namespace
+
+TEST(ThreadPoolTests, RunsEveryTaskExactlyOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+    for (int round = 0; round < 20; ++round) {
+        pool.run(hits.size(), [&](size_t t) { hits[t].fetch_add(1); });
+    }
+    for (const auto& h : hits) {
+        EXPECT_EQ(h.load(), 20);
+    }
+}
+
+TEST(ThreadPoolTests, PropagatesExceptionsAndStaysUsable) {
+    ThreadPool pool(3);
+    EXPECT_THROW(pool.run(100, [](size_t t) {
+        if (t == 42) throw std::runtime_error("task failed");
+    }), std::runtime_error);
+
+    std::atomic<size_t> sum{0};
+    pool.run(100, [&](size_t t) { sum.fetch_add(t); });
+    EXPECT_EQ(sum.load(), 4950u);
+}
+
+TEST(ThreadPoolTests, NestedRunExecutesInline) {
+    ThreadPool pool(4);
+    std::atomic<int> inner{0};
+    pool.run(8, [&](size_t) {
+        pool.run(8, [&](size_t) { inner.fetch_add(1); });
+    });
+    EXPECT_EQ(inner.load(), 64);
+}
+
+TEST(ParallelScanTests, MatchesStdScans) {
+    const auto input = random_values<int64_t>(N, -1000, 1000);
+    std::vector<int64_t> expected(N);
+    std::vector<int64_t> actual(N);
+
+    for (Backend backend : backends()) {
+        std::inclusive_scan(input.begin(), input.end(), expected.begin());
+        hpc::parallel::inclusive_scan(input.begin(), input.end(), actual.begin(), std::plus<>{}, backend);
+        EXPECT_EQ(actual, expected);
+
+        std::exclusive_scan(input.begin(), input.end(), expected.begin(), int64_t{7});
+        hpc::parallel::exclusive_scan(input.begin(), input.end(), actual.begin(), int64_t{7},
+                                      std::plus<>{}, backend);
+        EXPECT_EQ(actual, expected);
+
+        auto max_op = [](int64_t a, int64_t b) { return std::max(a, b); };
+        std::inclusive_scan(input.begin(), input.end(), expected.begin(), max_op);
+        std::vector<int64_t> in_place = input;
+        hpc::parallel::inclusive_scan(in_place.begin(), in_place.end(), in_place.begin(), max_op, backend);
+        EXPECT_EQ(in_place, expected);
+    }
+}
+
+TEST(ParallelScanTests, EmptyAndSingleElement) {
+    std::vector<int> empty;
+    std::vector<int> one{5};
+    std::vector<int> out(1);
+    EXPECT_EQ(hpc::parallel::inclusive_scan(empty.begin(), empty.end(), out.begin()), out.begin());
+    hpc::parallel::exclusive_scan(one.begin(), one.end(), out.begin(), 3);
+    EXPECT_EQ(out[0], 3);
+}
+
+TEST(RadixSortTests, SortsIntegerKeys) {
+    for (Backend backend : backends()) {
+        auto u32 = random_values<uint32_t>(N, 0, UINT32_MAX);
+        auto expected_u32 = u32;
+        std::sort(expected_u32.begin(), expected_u32.end());
+        hpc::parallel::radix_sort(u32.begin(), u32.end(), backend);
+        EXPECT_EQ(u32, expected_u32);
+
+        auto i64 = random_values<int64_t>(N, INT64_MIN, INT64_MAX);
+        auto expected_i64 = i64;
+        std::sort(expected_i64.begin(), expected_i64.end());
+        hpc::parallel::radix_sort(i64.begin(), i64.end(), backend);
+        EXPECT_EQ(i64, expected_i64);
+
+        // Small range: most digit passes are skipped
+        auto small = random_values<int32_t>(N, -50, 50);
+        auto expected_small = small;
+        std::sort(expected_small.begin(), expected_small.end());
+        hpc::parallel::radix_sort(small.begin(), small.end(), backend);
+        EXPECT_EQ(small, expected_small);
+    }
+}
+
+TEST(RadixSortTests, SortsFloatingPointKeys) {
+    for (Backend backend : backends()) {
+        auto f = random_values<float>(N, -1e6f, 1e6f);
+        auto expected_f = f;
+        std::sort(expected_f.begin(), expected_f.end());
+        hpc::parallel::radix_sort(f.begin(), f.end(), backend);
+        EXPECT_EQ(f, expected_f);
+
+        auto d = random_values<double>(1000, -1.0, 1.0);
+        auto expected_d = d;
+        std::sort(expected_d.begin(), expected_d.end());
+        hpc::parallel::radix_sort(d.begin(), d.end(), backend);
+        EXPECT_EQ(d, expected_d);
+    }
+
+    std::vector<double> tiny{3.5, -0.0, -2.0, 0.0, -1e300, 1e300};
+    hpc::parallel::radix_sort(tiny.begin(), tiny.end());
+    EXPECT_TRUE(std::is_sorted(tiny.begin(), tiny.end()));
+    EXPECT_TRUE(std::signbit(tiny[2]));  // -0.0 orders before +0.0
+}
+
+TEST(SampleSortTests, SortsWithCustomComparator) {
+    for (Backend backend : backends()) {
+        auto v = random_values<int64_t>(N, -1000000, 1000000);
+        auto expected = v;
+        std::sort(expected.begin(), expected.end(), std::greater<>{});
+        hpc::parallel::sample_sort(v.begin(), v.end(), std::greater<>{}, backend);
+        EXPECT_EQ(v, expected);
+
+        // Many duplicates
+        auto dup = random_values<int>(N, 0, 3);
+        auto expected_dup = dup;
+        std::sort(expected_dup.begin(), expected_dup.end());
+        hpc::parallel::sample_sort(dup.begin(), dup.end(), std::less<>{}, backend);
+        EXPECT_EQ(dup, expected_dup);
+    }
+}
+
+TEST(StablePartitionTests, MatchesStdStablePartition) {
+    for (Backend backend : backends()) {
+        const auto values = random_values<int>(N, 0, 1000);
+        std::vector<std::pair<int, size_t>> v(N);
+        for (size_t i = 0; i < N; ++i) {
+            v[i] = {values[i], i};
+        }
+        auto expected = v;
+        auto is_even = [](const std::pair<int, size_t>& p) { return p.first % 2 == 0; };
+
+        const auto expected_mid = std::stable_partition(expected.begin(), expected.end(), is_even);
+        const auto mid = hpc::parallel::stable_partition(v.begin(), v.end(), is_even, backend);
+        EXPECT_EQ(mid - v.begin(), expected_mid - expected.begin());
+        EXPECT_EQ(v, expected);
+    }
+}
@@ -0,0 +1,154 @@
+/**
+ * @file rw_lock_test.cpp
+ * @brief Unit tests for RWSpinLock and SeqLock
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "rw_lock.hpp"
+
+namespace {
+
+using hpc::concurrency::RWSpinLock;
+using hpc::concurrency::SeqLock;
+
+struct Snapshot {
+    int64_t a;
+    int64_t b;  // Always -a
+    int32_t c[3];
+};
+
+Snapshot make_snapshot(int64_t v) {
+    return Snapshot{v, -v, {static_cast<int32_t>(v), 1, 2}};
+}
+
+} // anonymous namespace
+
+TEST(RWSpinLockTests, WritersAreMutuallyExclusive) {
+    RWSpinLock lock;
+    int64_t counter = 0;  // Non-atomic, protected by lock
+    constexpr int NUM_THREADS = 4;
+    constexpr int INCREMENTS = 20000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < INCREMENTS; ++i) {
+                std::unique_lock<RWSpinLock> guard(lock);
+                ++counter;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(counter, int64_t{NUM_THREADS} * INCREMENTS);
+}
+
+TEST(RWSpinLockTests, ReadersShareWritersExclude) {
+    RWSpinLock lock;
+
+    lock.lock_shared();
+    EXPECT_TRUE(lock.try_lock_shared());  // Second reader gets in
+    EXPECT_FALSE(lock.try_lock());        // Writer does not
+    lock.unlock_shared();
+    lock.unlock_shared();
+
+    EXPECT_TRUE(lock.try_lock());
+    std::thread reader([&]() {
+        EXPECT_FALSE(lock.try_lock_shared());
+    });
+    reader.join();
+    lock.unlock();
+
+    EXPECT_TRUE(lock.try_lock_shared());
+    lock.unlock_shared();
+}
+
+TEST(RWSpinLockTests, ReadersNeverSeePartialWrites) {
+    RWSpinLock lock;
+    Snapshot shared = make_snapshot(0);
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    std::thread writer([&]() {
+        for (int64_t v = 1; v <= 5000; ++v) {
+            std::unique_lock<RWSpinLock> guard(lock);
+            shared = make_snapshot(v);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load(std::memory_order_acquire)) {
+                std::shared_lock<RWSpinLock> guard(lock);
+                if (shared.b != -shared.a) {
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+}
+
+TEST(SeqLockTests, LoadReturnsLastStore) {
+    SeqLock<Snapshot> lock(make_snapshot(7));
+    EXPECT_EQ(lock.load().a, 7);
+    EXPECT_EQ(lock.version(), 0u);
+
+    lock.store(make_snapshot(42));
+    Snapshot s{};
+    ASSERT_TRUE(lock.try_load(s));
+    EXPECT_EQ(s.a, 42);
+    EXPECT_EQ(s.b, -42);
+    EXPECT_EQ(s.c[0], 42);
+    EXPECT_EQ(lock.version(), 1u);
+}
+
+TEST(SeqLockTests, ConcurrentWritersAndReadersStayConsistent) {
+    SeqLock<Snapshot> lock(make_snapshot(0));
+    constexpr int NUM_WRITERS = 2;
+    constexpr int WRITES_PER_WRITER = 5000;
+    std::atomic<int> writers_done{0};
+    std::atomic<int> torn{0};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < NUM_WRITERS; ++w) {
+        threads.emplace_back([&, w]() {
+            for (int i = 1; i <= WRITES_PER_WRITER; ++i) {
+                lock.store(make_snapshot(w * WRITES_PER_WRITER + i));
+            }
+            writers_done.fetch_add(1, std::memory_order_release);
+        });
+    }
+    for (int r = 0; r < 2; ++r) {
+        threads.emplace_back([&]() {
+            while (writers_done.load(std::memory_order_acquire) < NUM_WRITERS) {
+                Snapshot s = lock.load();
+                if (s.b != -s.a || s.c[0] != static_cast<int32_t>(s.a)) {
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(lock.version(), uint64_t{NUM_WRITERS} * WRITES_PER_WRITER);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file sharded_counter_test.cpp
+ * @brief Unit tests for sharded counters, gauges, maxima and histograms
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "sharded_counter.hpp"
+
+namespace {
+
+using namespace hpc::concurrency;
+
+template<typename Func>
+void run_threads(Func&& func, int num_threads) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back(func, i);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+} // anonymous namespace
+
+TEST(ShardedCounterTests, ConcurrentIncrementsAreExact) {
+    ShardedCounter<> per_cpu;
+    ShardedCounter<16, PerThreadShard> per_thread;
+    constexpr int NUM_THREADS = 8;
+    constexpr int INCREMENTS = 20000;
+
+    run_threads([&](int) {
+        for (int i = 0; i < INCREMENTS; ++i) {
+            per_cpu.increment();
+            per_thread.add(2);
+        }
+    }, NUM_THREADS);
+
+    EXPECT_EQ(per_cpu.read_exact(), int64_t{NUM_THREADS} * INCREMENTS);
+    EXPECT_EQ(per_thread.read_exact(), int64_t{2} * NUM_THREADS * INCREMENTS);
+}
+
+TEST(ShardedCounterTests, ApproxReadRefreshesWhenStale) {
+    ShardedCounter<> counter;
+    counter.add(5);
+    EXPECT_EQ(counter.read_approx(std::chrono::nanoseconds(0)), 5);
+
+    counter.add(5);
+    // A long staleness bound may serve the cached value...
+    EXPECT_EQ(counter.read_approx(std::chrono::hours(1)), 5);
+    // ...a zero bound always rescans
+    EXPECT_EQ(counter.read_approx(std::chrono::nanoseconds(0)), 10);
+
+    counter.reset();
+    EXPECT_EQ(counter.read_exact(), 0);
+}
+
+TEST(ShardedGaugeTests, BalancedUpdatesReturnToZero) {
+    ShardedGauge<> gauge;
+
+    run_threads([&](int) {
+        for (int i = 0; i < 10000; ++i) {
+            gauge.increment();
+            gauge.decrement();
+        }
+        gauge.add(3);
+    }, 4);
+
+    EXPECT_EQ(gauge.read(), 12);
+    gauge.sub(12);
+    EXPECT_EQ(gauge.read(), 0);
+}
+
+TEST(ShardedMaxTests, TracksGlobalMaximum) {
+    ShardedMax<> max;
+    EXPECT_EQ(max.read(), ShardedMax<>::EMPTY);
+
+    run_threads([&](int tid) {
+        for (int i = 0; i < 10000; ++i) {
+            max.update(tid * 10000 + i);
+        }
+    }, 4);
+
+    EXPECT_EQ(max.read(), 39999);
+    max.update(-5);
+    EXPECT_EQ(max.read(), 39999);
+}
+
+TEST(ShardedHistogramTests, BucketsFollowPowersOfTwo) {
+    using Histogram = ShardedHistogram<16>;
+    EXPECT_EQ(Histogram::bucket_for(0), 0u);
+    EXPECT_EQ(Histogram::bucket_for(1), 1u);
+    EXPECT_EQ(Histogram::bucket_for(2), 2u);
+    EXPECT_EQ(Histogram::bucket_for(3), 2u);
+    EXPECT_EQ(Histogram::bucket_for(1024), 11u);
+    EXPECT_EQ(Histogram::bucket_for(uint64_t{1} << 40), 15u);  // Clamped
+    EXPECT_EQ(Histogram::bucket_lower_bound(11), 1024u);
+
+    auto histogram = std::make_unique<Histogram>();
+    run_threads([&](int) {
+        for (uint64_t v = 0; v < 1000; ++v) {
+            histogram->record(v);
+        }
+    }, 4);
+
+    EXPECT_EQ(histogram->count(), 4000);
+    auto snapshot = histogram->snapshot();
+    EXPECT_EQ(snapshot[0], 4);          // Value 0
+    EXPECT_EQ(snapshot[10], 4 * 488);   // [512, 1000)
+    EXPECT_EQ(histogram->quantile_lower_bound(0.5), 256u);
+    EXPECT_EQ(histogram->quantile_lower_bound(0.99), 512u);
+}
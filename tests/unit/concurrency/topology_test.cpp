@@ -0,0 +1,123 @@
+/**
+ * @file topology_test.cpp
+ * @brief Unit tests for CpuTopology parsing and placement policies
+ *
+ * The parser is pointed at a synthetic sysfs tree: 2 NUMA nodes, one
+ * package and one L3 each, 2 cores per package, 2 SMT threads per core.
+ * CPUs are numbered the way Linux usually does it: cpu0-3 are the first
+ * hardware thread of cores 0-3, cpu4-7 their siblings.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "concurrency_utils.hpp"
+#include "topology.hpp"
+
+namespace {
+
+namespace fs = std::filesystem;
+using hpc::concurrency::CpuTopology;
+using hpc::concurrency::Placement;
+
+void write_file(const fs::path& path, const std::string& text) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << text << "\n";
+}
+
+class FakeSysfs : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = fs::temp_directory_path() /
+                (std::string("hpc_topology_test_") +
+                 ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(root_);
+        write_file(root_ / "cpu" / "online", "0-7");
+        for (unsigned int cpu = 0; cpu < 8; ++cpu) {
+            const unsigned int core = cpu % 4;
+            const unsigned int package = core / 2;
+            const fs::path dir = root_ / "cpu" / ("cpu" + std::to_string(cpu));
+            write_file(dir / "topology" / "core_id", std::to_string(core % 2));
+            write_file(dir / "topology" / "physical_package_id", std::to_string(package));
+            write_file(dir / "topology" / "thread_siblings_list",
+                       std::to_string(core) + "," + std::to_string(core + 4));
+            write_file(dir / "cache" / "index0" / "level", "1");
+            write_file(dir / "cache" / "index0" / "shared_cpu_list",
+                       std::to_string(core) + "," + std::to_string(core + 4));
+            write_file(dir / "cache" / "index3" / "level", "3");
+            write_file(dir / "cache" / "index3" / "shared_cpu_list",
+                       package == 0 ? "0-1,4-5" : "2-3,6-7");
+        }
+        write_file(root_ / "node" / "node0" / "cpulist", "0-1,4-5");
+        write_file(root_ / "node" / "node1" / "cpulist", "2-3,6-7");
+        write_file(root_ / "node" / "online", "0-1");  // Not a node directory
+    }
+
+    void TearDown() override {
+        fs::remove_all(root_);
+    }
+
+    fs::path root_;
+};
+
+} // anonymous namespace
+
+TEST(TopologyTests, ParsesCpuLists) {
+    using hpc::concurrency::detail::parse_cpu_list;
+    EXPECT_EQ(parse_cpu_list("0-3,8,10-11\n"), (std::vector<unsigned int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(parse_cpu_list("5"), (std::vector<unsigned int>{5}));
+    EXPECT_TRUE(parse_cpu_list("").empty());
+    EXPECT_TRUE(parse_cpu_list("x-y").empty());
+}
+
+TEST_F(FakeSysfs, CountsDomains) {
+    const CpuTopology topo = CpuTopology::from_sysfs(root_);
+    EXPECT_EQ(topo.num_cpus(), 8u);
+    EXPECT_EQ(topo.num_cores(), 4u);
+    EXPECT_EQ(topo.num_l3_domains(), 2u);
+    EXPECT_EQ(topo.num_numa_nodes(), 2u);
+    EXPECT_EQ(topo.num_packages(), 2u);
+    EXPECT_EQ(topo.smt_siblings(5), (std::vector<unsigned int>{1, 5}));
+}
+
+TEST_F(FakeSysfs, PlacementOrders) {
+    const CpuTopology topo = CpuTopology::from_sysfs(root_);
+    EXPECT_EQ(topo.placement_order(Placement::Compact),
+              (std::vector<unsigned int>{0, 4, 1, 5, 2, 6, 3, 7}));
+    EXPECT_EQ(topo.placement_order(Placement::OnePerCore),
+              (std::vector<unsigned int>{0, 1, 2, 3}));
+    EXPECT_EQ(topo.placement_order(Placement::Scatter),
+              (std::vector<unsigned int>{0, 2, 1, 3, 4, 6, 5, 7}));
+    EXPECT_TRUE(topo.placement_order(Placement::None).empty());
+
+    EXPECT_EQ(topo.cpu_for(Placement::OnePerCore, 5), 1u);  // Wraps around
+    EXPECT_FALSE(topo.cpu_for(Placement::None, 0).has_value());
+}
+
+TEST_F(FakeSysfs, RestrictedToAllowedCpus) {
+    const CpuTopology topo = CpuTopology::from_sysfs(root_).restricted_to({2, 3, 6});
+    EXPECT_EQ(topo.num_cpus(), 3u);
+    EXPECT_EQ(topo.num_numa_nodes(), 1u);
+    EXPECT_EQ(topo.placement_order(Placement::Compact), (std::vector<unsigned int>{2, 6, 3}));
+    EXPECT_EQ(topo.placement_order(Placement::OnePerCore), (std::vector<unsigned int>{2, 3}));
+}
+
+TEST(TopologyTests, MissingSysfsFallsBackToFlatLayout) {
+    const CpuTopology topo = CpuTopology::from_sysfs("/nonexistent/sysfs");
+    EXPECT_GE(topo.num_cpus(), 1u);
+    EXPECT_EQ(topo.num_cores(), topo.num_cpus());
+    EXPECT_EQ(topo.num_l3_domains(), 1u);
+}
+
+TEST(TopologyTests, RunParallelWithPlacement) {
+    const auto& topo = CpuTopology::system();
+    ASSERT_GE(topo.num_cpus(), 1u);
+
+    std::atomic<unsigned int> ran{0};
+    hpc::concurrency::run_parallel([&](unsigned int) { ran.fetch_add(1); }, 4, Placement::Compact);
+    EXPECT_EQ(ran.load(), 4u);
+}
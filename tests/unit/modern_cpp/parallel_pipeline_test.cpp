@@ -0,0 +1,110 @@
+/**
+ * @file parallel_pipeline_test.cpp
+ * @brief Unit tests for the parallel simd_ranges executor
+ *
+ * Every sink is compared with the sequential pipeline, on a small pool and
+ * with small chunks so that many tasks run concurrently.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "parallel_pipeline.hpp"
+
+namespace {
+
+using namespace hpc::ranges;
+
+std::vector<int> random_input(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<int> v(n);
+    for (auto& x : v) {
+        x = static_cast<int>(rng() % 2001) - 1000;
+    }
+    return v;
+}
+
+class ParallelPipelineTest : public ::testing::Test {
+protected:
+    mutable ThreadPool pool{4};
+
+    ParallelOptions options(bool ordered = true) const {
+        return {.chunk_bytes = 4096, .ordered = ordered, .pool = &pool};
+    }
+
+    static std::vector<size_t> sizes() { return {0, 1, 1000, 1024, 1025, 100'000}; }
+};
+
+auto is_even = [](int x) { return x % 2 == 0; };
+auto affine = [](int x) { return x * 2 + 1; };
+
+TEST_F(ParallelPipelineTest, ReduceMatchesSequential) {
+    for (size_t n : sizes()) {
+        const auto input = random_input(n, static_cast<uint32_t>(n));
+        const int64_t expected = input | simd_filter(is_even) | simd_transform(affine) | simd_reduce(int64_t{5});
+        const int64_t sum = input | in_parallel(options()) | simd_filter(is_even) | simd_transform(affine)
+                                  | simd_reduce(int64_t{5});
+        EXPECT_EQ(sum, expected) << "n = " << n;
+    }
+}
+
+TEST_F(ParallelPipelineTest, OrderedToVectorMatchesSequential) {
+    for (size_t n : sizes()) {
+        const auto input = random_input(n, static_cast<uint32_t>(n) + 1);
+        const auto expected = input | simd_filter(is_even) | simd_transform(affine) | simd_to_vector();
+        const auto result = input | simd_filter(is_even) | simd_transform(affine) | in_parallel(options())
+                                  | simd_to_vector();
+        EXPECT_EQ(result, expected) << "n = " << n;
+    }
+}
+
+TEST_F(ParallelPipelineTest, UnorderedToVectorIsAPermutation) {
+    for (size_t n : sizes()) {
+        const auto input = random_input(n, static_cast<uint32_t>(n) + 2);
+        auto expected = input | simd_filter(is_even) | simd_to_vector();
+        auto result = input | in_parallel(options(false)) | simd_filter(is_even) | simd_to_vector();
+        std::sort(expected.begin(), expected.end());
+        std::sort(result.begin(), result.end());
+        EXPECT_EQ(result, expected) << "n = " << n;
+    }
+}
+
+TEST_F(ParallelPipelineTest, TransformOnlyWritesInPlace) {
+    const auto input = random_input(50'000, 3);
+    auto widen = [](int x) { return static_cast<double>(x) * 0.5; };
+    const auto expected = input | simd_transform(widen) | simd_to_vector();
+    for (bool ordered : {true, false}) {
+        const auto result = input | in_parallel(options(ordered)) | simd_transform(widen) | simd_to_vector();
+        EXPECT_EQ(result, expected);
+    }
+}
+
+TEST_F(ParallelPipelineTest, FloatReduceIsIndependentOfThreadCount) {
+    std::vector<float> input(200'000);
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (auto& x : input) {
+        x = dist(rng);
+    }
+    ThreadPool single(1);
+    ParallelOptions one = options();
+    one.pool = &single;
+    const float a = input | in_parallel(options()) | simd_reduce(0.0f);
+    const float b = input | in_parallel(one) | simd_reduce(0.0f);
+    EXPECT_EQ(a, b);
+}
+
+TEST_F(ParallelPipelineTest, ChunksAreWholeSimdChunks) {
+    const std::vector<int> input(10'000);
+    const auto pp = input | in_parallel({.chunk_bytes = 1});
+    EXPECT_EQ(pp.chunk_elements(), simd_chunk<int>);
+    const auto big = input | in_parallel({.chunk_bytes = 5000});
+    EXPECT_EQ(big.chunk_elements() % simd_chunk<int>, 0u);
+    EXPECT_GE(big.chunk_elements() * sizeof(int), 5000u);
+}
+
+} // namespace
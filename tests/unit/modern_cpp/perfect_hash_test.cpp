@@ -0,0 +1,100 @@
+/**
+ * @file perfect_hash_test.cpp
+ * @brief Unit tests for the compile-time perfect hash table
+ *
+ * Tables are built in constant expressions; lookups are checked both at
+ * compile time (static_assert) and at run time, for every key of the set
+ * and for strings that are not in it.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "perfect_hash.hpp"
+
+namespace {
+
+using hpc::compile_time::fnv1a_hash;
+using hpc::compile_time::make_perfect_hash;
+using hpc::compile_time::make_perfect_hash_map;
+using hpc::compile_time::PerfectHashTable;
+using hpc::compile_time::operator""_hash;
+
+constexpr auto COMMANDS = make_perfect_hash({"get", "set", "del", "incr", "decr", "expire", "ttl"});
+constexpr size_t NPOS = PerfectHashTable<7>::npos;
+
+static_assert(COMMANDS.index_of("get") == 0);
+static_assert(COMMANDS.index_of("ttl") == 6);
+static_assert(COMMANDS.index_of("flush") == NPOS);
+static_assert("expire"_hash == fnv1a_hash("expire"));
+
+/// "k0" .. "k<N-1>": enough keys to fill several buckets per slot count
+template<size_t N>
+constexpr std::array<std::array<char, 8>, N> numbered_key_chars() {
+    std::array<std::array<char, 8>, N> chars{};
+    for (size_t i = 0; i < N; ++i) {
+        chars[i][0] = 'k';
+        size_t len = 1;
+        for (size_t div = 1000; div > 0; div /= 10) {
+            if (i >= div || div == 1) {
+                chars[i][len++] = static_cast<char>('0' + i / div % 10);
+            }
+        }
+    }
+    return chars;
+}
+
+constexpr auto KEY_CHARS = numbered_key_chars<500>();
+
+constexpr std::array<std::string_view, 500> numbered_keys() {
+    std::array<std::string_view, 500> keys{};
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = std::string_view(KEY_CHARS[i].data());
+    }
+    return keys;
+}
+
+constexpr auto KEYS = numbered_keys();
+
+TEST(PerfectHashTest, EveryKeyFindsItsPosition) {
+    constexpr auto table = make_perfect_hash(KEYS);
+    for (size_t i = 0; i < KEYS.size(); ++i) {
+        // Runtime copies, so the lookup cannot be folded
+        const std::string key(KEYS[i]);
+        EXPECT_EQ(table.index_of(key), i) << key;
+    }
+}
+
+TEST(PerfectHashTest, OtherStringsAreNotFound) {
+    constexpr auto table = make_perfect_hash(KEYS);
+    for (const char* key : {"", "k", "k500", "k0000", "K1", "k1 ", "k12x", "get"}) {
+        EXPECT_FALSE(table.contains(key)) << key;
+    }
+}
+
+TEST(PerfectHashTest, EmptyStringCanBeAKey) {
+    constexpr auto table = make_perfect_hash({"", "a", "ab"});
+    static_assert(table.index_of("") == 0);
+    EXPECT_EQ(table.index_of(std::string()), 0u);
+    EXPECT_EQ(table.index_of(std::string("ab")), 2u);
+    EXPECT_FALSE(table.contains(std::string("b")));
+}
+
+TEST(PerfectHashTest, SingleKey) {
+    constexpr auto table = make_perfect_hash({"only"});
+    EXPECT_EQ(table.index_of(std::string("only")), 0u);
+    EXPECT_FALSE(table.contains(std::string("other")));
+}
+
+TEST(PerfectHashTest, MapReturnsValues) {
+    constexpr auto ports = make_perfect_hash_map<int>({{"http", 80}, {"https", 443}, {"ssh", 22}});
+    static_assert(*ports.find("https") == 443);
+    const int* ssh = ports.find(std::string("ssh"));
+    ASSERT_NE(ssh, nullptr);
+    EXPECT_EQ(*ssh, 22);
+    EXPECT_EQ(ports.find(std::string("ftp")), nullptr);
+}
+
+} // namespace
@@ -0,0 +1,175 @@
+/**
+ * @file relocating_vector_test.cpp
+ * @brief Unit tests for is_trivially_relocatable and relocating_vector
+ *
+ * Tracked counts live instances and moves, so the tests can check that
+ * relocation neither leaks nor double-destroys, and that growth of a
+ * tagged type never calls the move constructor.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "relocating_vector.hpp"
+
+namespace {
+
+using hpc::vector_reserve::is_trivially_relocatable_v;
+using hpc::vector_reserve::relocating_vector;
+
+struct Counters {
+    static inline int live = 0;
+    static inline int moves = 0;
+};
+
+/// Heap-owning element; Relocatable selects the opt-in tag
+template<bool Relocatable>
+class Tracked {
+public:
+    using trivially_relocatable = std::bool_constant<Relocatable>;
+
+    Tracked(int value = 0) : value_(new int(value)) { ++Counters::live; }
+    Tracked(const Tracked& other) : value_(new int(*other.value_)) { ++Counters::live; }
+    Tracked(Tracked&& other) noexcept : value_(std::exchange(other.value_, nullptr)) {
+        ++Counters::live;
+        ++Counters::moves;
+    }
+    ~Tracked() {
+        delete value_;
+        --Counters::live;
+    }
+
+    Tracked& operator=(Tracked other) noexcept {
+        std::swap(value_, other.value_);
+        return *this;
+    }
+
+    friend bool operator==(const Tracked& a, const Tracked& b) { return *a.value_ == *b.value_; }
+
+private:
+    int* value_;
+};
+
+struct SelfPointer {
+    SelfPointer* self = this;
+    SelfPointer() = default;
+    SelfPointer(const SelfPointer&) {}
+};
+
+static_assert(is_trivially_relocatable_v<int>);
+static_assert(is_trivially_relocatable_v<Tracked<true>>);
+static_assert(!is_trivially_relocatable_v<Tracked<false>>);
+static_assert(is_trivially_relocatable_v<std::unique_ptr<std::string>>);
+static_assert(!is_trivially_relocatable_v<std::string>);
+static_assert(!is_trivially_relocatable_v<SelfPointer>);
+
+/// Apply the same random operations to a relocating_vector and a std::vector
+template<typename T>
+void random_operations(uint32_t seed) {
+    {
+        relocating_vector<T> v;
+        std::vector<T> ref;
+        std::mt19937 rng(seed);
+        for (int step = 0; step < 2000; ++step) {
+            const int value = static_cast<int>(rng() % 1000);
+            const size_t pos = ref.empty() ? 0 : rng() % (ref.size() + 1);
+            switch (rng() % 6) {
+            case 0:
+            case 1:
+                v.emplace_back(value);
+                ref.emplace_back(value);
+                break;
+            case 2:
+                v.emplace(v.begin() + pos, value);
+                ref.emplace(ref.begin() + static_cast<long>(pos), value);
+                break;
+            case 3: {
+                const size_t count = rng() % 4;
+                v.insert(v.begin() + pos, count, T(value));
+                ref.insert(ref.begin() + static_cast<long>(pos), count, T(value));
+                break;
+            }
+            case 4:
+                if (!ref.empty()) {
+                    const size_t at = rng() % ref.size();
+                    const size_t last = std::min(ref.size(), at + rng() % 3);
+                    v.erase(v.begin() + at, v.begin() + last);
+                    ref.erase(ref.begin() + static_cast<long>(at), ref.begin() + static_cast<long>(last));
+                }
+                break;
+            case 5:
+                if (rng() % 4 == 0) {
+                    v.resize(rng() % 40);
+                    ref.resize(v.size());
+                    v.shrink_to_fit();
+                }
+                break;
+            }
+            ASSERT_EQ(v.size(), ref.size());
+            ASSERT_TRUE(std::equal(v.begin(), v.end(), ref.begin()));
+        }
+    }
+    EXPECT_EQ(Counters::live, 0);
+}
+
+} // anonymous namespace
+
+TEST(RelocatingVectorTests, MatchesStdVectorRelocatable) {
+    random_operations<Tracked<true>>(1);
+}
+
+TEST(RelocatingVectorTests, MatchesStdVectorNonRelocatable) {
+    random_operations<Tracked<false>>(2);
+}
+
+TEST(RelocatingVectorTests, GrowthDoesNotMoveTaggedElements) {
+    Counters::moves = 0;
+    {
+        relocating_vector<Tracked<true>> v;
+        for (int i = 0; i < 10000; ++i) {
+            v.emplace_back(i);
+        }
+        v.erase(v.begin(), v.begin() + 100);
+        v.emplace(v.begin(), -1);
+        v.shrink_to_fit();
+        EXPECT_EQ(v.size(), 9901u);
+        EXPECT_EQ(v.capacity(), 9901u);
+        EXPECT_EQ(v[1], Tracked<true>(100));
+    }
+    // Only the element being appended is moved, once per reallocation
+    EXPECT_LT(Counters::moves, 100);
+    EXPECT_EQ(Counters::live, 0);
+
+    Counters::moves = 0;
+    {
+        relocating_vector<Tracked<false>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.emplace_back(i);
+        }
+    }
+    EXPECT_GT(Counters::moves, 1000);
+    EXPECT_EQ(Counters::live, 0);
+}
+
+TEST(RelocatingVectorTests, CopyMoveAndSwap) {
+    relocating_vector<std::string> a{"alpha", "beta", "gamma-long-enough-to-defeat-sso"};
+    relocating_vector<std::string> b = a;
+    EXPECT_EQ(a, b);
+
+    const std::string* block = a.data();
+    relocating_vector<std::string> c(std::move(a));
+    EXPECT_EQ(c.data(), block);
+    EXPECT_TRUE(a.empty());
+
+    relocating_vector<std::string> d{"x"};
+    swap(c, d);
+    EXPECT_EQ(d, b);
+    EXPECT_EQ(c.size(), 1u);
+
+    c = std::move(d);
+    EXPECT_EQ(c, b);
+    EXPECT_THROW(c.at(3), std::out_of_range);
+}
@@ -0,0 +1,141 @@
+/**
+ * @file sbo_buffer_test.cpp
+ * @brief Unit tests for the small-buffer-optimized SboBuffer
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "sbo_buffer.hpp"
+
+namespace {
+
+using hpc::move_semantics::SboBuffer;
+using hpc::move_semantics::uninitialized;
+
+/// Allocator with an identity that counts live blocks; optionally propagates on move
+template<typename T, bool Propagate = true>
+struct TrackingAllocator {
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_swap = std::bool_constant<Propagate>;
+    using is_always_equal = std::false_type;
+
+    int id = 0;
+    int* live = nullptr;
+
+    TrackingAllocator(int id_, int* live_) : id(id_), live(live_) {}
+    template<typename U>
+    TrackingAllocator(const TrackingAllocator<U, Propagate>& other) : id(other.id), live(other.live) {}
+
+    template<typename U>
+    struct rebind { using other = TrackingAllocator<U, Propagate>; };
+
+    T* allocate(size_t n) {
+        ++*live;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        --*live;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    friend bool operator==(const TrackingAllocator& a, const TrackingAllocator& b) { return a.id == b.id; }
+    friend bool operator!=(const TrackingAllocator& a, const TrackingAllocator& b) { return a.id != b.id; }
+};
+
+template<size_t N, typename A>
+std::string contents(const SboBuffer<N, A>& buf) {
+    return std::string(buf.data(), buf.size());
+}
+
+} // anonymous namespace
+
+TEST(SboBufferTests, SmallPayloadsStayInline) {
+    int live = 0;
+    using Alloc = TrackingAllocator<char>;
+    SboBuffer<32, Alloc> small(32, 'a', Alloc(1, &live));
+    EXPECT_TRUE(small.is_inline());
+    EXPECT_EQ(live, 0);
+
+    SboBuffer<32, Alloc> large(33, 'b', Alloc(1, &live));
+    EXPECT_FALSE(large.is_inline());
+    EXPECT_EQ(live, 1);
+    EXPECT_EQ(contents(large), std::string(33, 'b'));
+
+    SboBuffer<32, Alloc> copy(small);
+    EXPECT_TRUE(copy.is_inline());
+    EXPECT_EQ(contents(copy), std::string(32, 'a'));
+    EXPECT_EQ(live, 1);
+}
+
+TEST(SboBufferTests, MovesStealHeapAndCopyInlineBytes) {
+    SboBuffer<16> inline_buf(5, uninitialized);
+    std::memcpy(inline_buf.data(), "hello", 5);
+    SboBuffer<16> heap_buf(1000, 'z');
+    const char* heap_ptr = heap_buf.data();
+
+    SboBuffer<16> a(std::move(inline_buf));
+    SboBuffer<16> b(std::move(heap_buf));
+    EXPECT_EQ(contents(a), "hello");
+    EXPECT_TRUE(a.is_inline());
+    EXPECT_EQ(b.data(), heap_ptr);  // Pointer stolen, no copy
+    EXPECT_TRUE(inline_buf.empty() && inline_buf.is_inline());
+    EXPECT_TRUE(heap_buf.empty() && heap_buf.is_inline());
+
+    a = std::move(b);
+    EXPECT_EQ(a.data(), heap_ptr);
+    EXPECT_EQ(a.size(), 1000u);
+
+    SboBuffer<16> c(3, 'q');
+    swap(a, c);
+    EXPECT_EQ(contents(a), "qqq");
+    EXPECT_TRUE(a.is_inline());
+    EXPECT_EQ(c.data(), heap_ptr);
+}
+
+TEST(SboBufferTests, ResizeAndAssignPreserveContents) {
+    SboBuffer<8> buf(4, 'x');
+    buf.resize(6, 'y');
+    EXPECT_EQ(contents(buf), "xxxxyy");
+    buf.resize(20, 'z');
+    EXPECT_FALSE(buf.is_inline());
+    EXPECT_EQ(contents(buf), "xxxxyy" + std::string(14, 'z'));
+    buf.resize(2, uninitialized);
+    EXPECT_EQ(contents(buf), "xx");
+    EXPECT_GE(buf.capacity(), 20u);
+
+    buf.assign("copied", 6);
+    EXPECT_EQ(contents(buf), "copied");
+    SboBuffer<8> other;
+    other = buf;
+    EXPECT_EQ(contents(other), "copied");
+    EXPECT_TRUE(other.is_inline());
+}
+
+TEST(SboBufferTests, AllocatorPropagation) {
+    int live = 0;
+    {
+        using Alloc = TrackingAllocator<char, false>;
+        SboBuffer<8, Alloc> a(100, 'a', Alloc(1, &live));
+        SboBuffer<8, Alloc> b(Alloc(2, &live));
+        b = std::move(a);  // Unequal, non-propagating: must copy into b's allocator
+        EXPECT_EQ(b.get_allocator().id, 2);
+        EXPECT_EQ(contents(b), std::string(100, 'a'));
+        EXPECT_EQ(live, 2);
+    }
+    EXPECT_EQ(live, 0);
+    {
+        using Alloc = TrackingAllocator<char, true>;
+        SboBuffer<8, Alloc> a(100, 'a', Alloc(1, &live));
+        const char* p = a.data();
+        SboBuffer<8, Alloc> b(Alloc(2, &live));
+        b = std::move(a);  // Propagating: the block and its allocator move over
+        EXPECT_EQ(b.get_allocator().id, 1);
+        EXPECT_EQ(b.data(), p);
+        EXPECT_EQ(live, 1);
+    }
+    EXPECT_EQ(live, 0);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file simd_filter_test.cpp
+ * @brief Unit tests for the branchless SIMD filter
+ *
+ * Results are checked against std::copy_if at sizes around the register
+ * width and the flag block, with a guard region after the output to catch
+ * stores past the input size.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "simd_filter.hpp"
+
+namespace {
+
+using hpc::ranges::FILTER_BLOCK;
+using hpc::ranges::filter_indices;
+using hpc::ranges::filter_into;
+
+constexpr size_t GUARD = 32;
+
+std::vector<size_t> sizes() {
+    return {0, 1, 7, 8, 9, 15, 16, 17, 100, FILTER_BLOCK - 1, FILTER_BLOCK, FILTER_BLOCK + 1, 5000};
+}
+
+template<typename T>
+std::vector<T> percent_values(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<T> v(n);
+    for (auto& x : v) {
+        x = static_cast<T>(rng() % 100);
+    }
+    return v;
+}
+
+template<typename T>
+void check_filter(size_t n, int percent) {
+    const auto input = percent_values<T>(n, static_cast<uint32_t>(n * 100 + static_cast<size_t>(percent)));
+    const auto p = static_cast<T>(percent);
+    auto pred = [p](T x) { return x < p; };
+
+    std::vector<T> expected;
+    std::copy_if(input.begin(), input.end(), std::back_inserter(expected), pred);
+
+    std::vector<T> output(n + GUARD, T{-1});
+    const size_t kept = filter_into(std::span<const T>(input), std::span<T>(output), pred);
+    ASSERT_EQ(kept, expected.size()) << "n = " << n << ", p = " << percent;
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), output.begin()));
+    for (size_t i = n; i < output.size(); ++i) {
+        ASSERT_EQ(output[i], T{-1}) << "store past the input size at " << i;
+    }
+}
+
+TEST(SimdFilterTest, Int32MatchesCopyIf) {
+    for (size_t n : sizes()) {
+        for (int p : {0, 1, 50, 99, 100}) {
+            check_filter<int32_t>(n, p);
+        }
+    }
+}
+
+TEST(SimdFilterTest, FloatMatchesCopyIf) {
+    for (size_t n : sizes()) {
+        for (int p : {0, 10, 50, 90, 100}) {
+            check_filter<float>(n, p);
+        }
+    }
+}
+
+TEST(SimdFilterTest, WideElementsMatchCopyIf) {
+    for (size_t n : sizes()) {
+        check_filter<int64_t>(n, 50);
+        check_filter<int16_t>(n, 50);
+    }
+}
+
+TEST(SimdFilterTest, FloatNanIsNeverKept) {
+    std::vector<float> input(100);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = i % 3 == 0 ? NAN : static_cast<float>(i);
+    }
+    std::vector<float> output(input.size());
+    const size_t kept = filter_into(input, output, [](float x) { return x < 1000.0f; });
+    EXPECT_EQ(kept, 66u);
+    for (size_t i = 0; i < kept; ++i) {
+        EXPECT_FALSE(std::isnan(output[i]));
+    }
+}
+
+TEST(SimdFilterTest, IndicesMatchReference) {
+    for (size_t n : sizes()) {
+        for (int p : {0, 25, 50, 100}) {
+            const auto input = percent_values<int32_t>(n, static_cast<uint32_t>(n + 7));
+            auto pred = [p](int32_t x) { return x < p; };
+            std::vector<uint32_t> expected;
+            for (size_t i = 0; i < n; ++i) {
+                if (pred(input[i])) {
+                    expected.push_back(static_cast<uint32_t>(i));
+                }
+            }
+            std::vector<uint32_t> output(n + GUARD, UINT32_MAX);
+            const size_t kept = filter_indices(std::span<const int32_t>(input), std::span<uint32_t>(output), pred);
+            ASSERT_EQ(kept, expected.size()) << "n = " << n << ", p = " << p;
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), output.begin()));
+            for (size_t i = n; i < output.size(); ++i) {
+                ASSERT_EQ(output[i], UINT32_MAX) << "store past the input size at " << i;
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,129 @@
+/**
+ * @file simd_ranges_test.cpp
+ * @brief Unit tests for the chunked SIMD range adaptors
+ *
+ * Every pipeline is checked against the same std::views pipeline, at sizes
+ * around the chunk width so full chunks, partial tails and empty inputs
+ * are all covered.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <vector>
+
+#include "simd_ranges.hpp"
+
+namespace {
+
+using namespace hpc::ranges;
+
+template<typename T>
+std::vector<T> random_input(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<T> v(n);
+    for (auto& x : v) {
+        x = static_cast<T>(static_cast<int>(rng() % 2001) - 1000);
+    }
+    return v;
+}
+
+std::vector<size_t> sizes() {
+    constexpr size_t W = simd_lanes<int>;
+    return {0, 1, W - 1, W, W + 1, 3 * W + 5, 1000, 4096};
+}
+
+/// simd_reduce(init, op) without an identity: only allowed for std::plus
+template<typename Op>
+concept reducible_without_identity = requires(Op op) { simd_reduce(1, op); };
+
+TEST(SimdRangesTest, FilterMatchesViews) {
+    for (size_t n : sizes()) {
+        const auto input = random_input<int>(n, static_cast<uint32_t>(n));
+        auto even = [](int x) { return x % 2 == 0; };
+        const auto result = input | simd_filter(even) | simd_to_vector();
+        std::vector<int> expected;
+        std::ranges::copy(input | std::views::filter(even), std::back_inserter(expected));
+        EXPECT_EQ(result, expected) << "n = " << n;
+    }
+}
+
+TEST(SimdRangesTest, TransformChangesElementType) {
+    for (size_t n : sizes()) {
+        const auto input = random_input<int>(n, static_cast<uint32_t>(n) + 1);
+        auto widen = [](int x) { return static_cast<int64_t>(x) * int64_t{3'000'000'000}; };
+        const std::vector<int64_t> result = input | simd_transform(widen) | simd_to_vector();
+        std::vector<int64_t> expected;
+        std::ranges::copy(input | std::views::transform(widen), std::back_inserter(expected));
+        EXPECT_EQ(result, expected) << "n = " << n;
+    }
+}
+
+TEST(SimdRangesTest, ChainedReduceMatchesViews) {
+    for (size_t n : sizes()) {
+        const auto input = random_input<int>(n, static_cast<uint32_t>(n) + 2);
+        auto positive = [](int x) { return x > 0; };
+        auto affine = [](int x) { return x * 2 + 1; };
+        auto small = [](int x) { return x < 1500; };
+
+        const int64_t sum = input | simd_filter(positive) | simd_transform(affine)
+                                  | simd_filter(small) | simd_reduce(int64_t{7});
+        int64_t expected = 7;
+        for (int x : input | std::views::filter(positive) | std::views::transform(affine)
+                           | std::views::filter(small)) {
+            expected += x;
+        }
+        EXPECT_EQ(sum, expected) << "n = " << n;
+    }
+}
+
+TEST(SimdRangesTest, ReduceWithCustomOperation) {
+    const auto input = random_input<int>(777, 3);
+    const int max = input | simd_reduce(INT32_MIN, [](int a, int b) { return a > b ? a : b; }, INT32_MIN);
+    EXPECT_EQ(max, *std::ranges::max_element(input));
+
+    const std::vector<int> empty;
+    EXPECT_EQ(empty | simd_reduce(42), 42);
+
+    // Lanes start from 1, not Acc{}: a product must not collapse to 0
+    std::vector<int64_t> factors(100, 1);
+    for (size_t i = 0; i < factors.size(); i += 7) {
+        factors[i] = 2;
+    }
+    EXPECT_EQ(factors | simd_reduce(int64_t{3}, std::multiplies<>{}, int64_t{1}), int64_t{3} << 15);
+    static_assert(reducible_without_identity<std::plus<>>);
+    static_assert(!reducible_without_identity<std::multiplies<>>);
+}
+
+TEST(SimdRangesTest, FloatAndDoubleSources) {
+    const auto floats = random_input<float>(1001, 4);
+    const auto kept = floats | simd_filter([](float x) { return x >= 0.0f; }) | simd_to_vector();
+    std::vector<float> expected;
+    std::ranges::copy(floats | std::views::filter([](float x) { return x >= 0.0f; }),
+                      std::back_inserter(expected));
+    EXPECT_EQ(kept, expected);
+
+    // Integral values: the reassociated sum is exact
+    const auto doubles = random_input<double>(1001, 5);
+    const double sum = doubles | simd_transform([](double x) { return x * 0.5; }) | simd_reduce(0.0);
+    EXPECT_DOUBLE_EQ(sum, std::accumulate(doubles.begin(), doubles.end(), 0.0) * 0.5);
+}
+
+TEST(SimdRangesTest, IntoWritesPrefixAndReturnsCount) {
+    std::vector<int> input(100);
+    std::iota(input.begin(), input.end(), 0);
+    std::vector<int> output(100, -1);
+    const size_t written = input | simd_filter([](int x) { return x % 3 == 0; })
+                                 | simd_transform([](int x) { return x * 10; })
+                                 | simd_into(output);
+    ASSERT_EQ(written, 34u);
+    for (size_t i = 0; i < written; ++i) {
+        EXPECT_EQ(output[i], static_cast<int>(i) * 30);
+    }
+    EXPECT_EQ(output[written], -1);
+}
+
+} // namespace
@@ -0,0 +1,191 @@
+/**
+ * @file small_vector_test.cpp
+ * @brief Unit tests for small_vector and static_vector
+ *
+ * Random operation sequences are checked against std::vector, for a
+ * trivially copyable element type (memmove paths) and std::string
+ * (element-wise paths).
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "counting_allocator.hpp"
+#include "small_vector.hpp"
+
+namespace {
+
+using hpc::vector_reserve::CountingAllocator;
+using hpc::vector_reserve::small_vector;
+using hpc::vector_reserve::static_vector;
+
+template<typename T>
+T make_value(int i) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return "value-" + std::to_string(i) + "-long-enough-to-defeat-sso";
+    } else {
+        return static_cast<T>(i);
+    }
+}
+
+template<typename Vec, typename T>
+void expect_same(const Vec& v, const std::vector<T>& ref) {
+    ASSERT_EQ(v.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ASSERT_EQ(v[i], ref[i]) << "index " << i;
+    }
+}
+
+/// Apply the same random operations to v and a std::vector
+template<typename Vec>
+void random_operations(Vec& v, size_t max_size, uint32_t seed) {
+    using T = typename Vec::value_type;
+    std::vector<T> ref;
+    std::mt19937 rng(seed);
+    for (int step = 0; step < 2000; ++step) {
+        const int value = static_cast<int>(rng() % 1000);
+        const size_t pos = ref.empty() ? 0 : rng() % (ref.size() + 1);
+        const size_t room = max_size - ref.size();
+        switch (rng() % 8) {
+        case 0:
+        case 1:
+            if (room > 0) {
+                v.push_back(make_value<T>(value));
+                ref.push_back(make_value<T>(value));
+            }
+            break;
+        case 2:
+            if (room > 0) {
+                v.emplace(v.begin() + pos, make_value<T>(value));
+                ref.emplace(ref.begin() + static_cast<long>(pos), make_value<T>(value));
+            }
+            break;
+        case 3: {
+            const size_t count = std::min<size_t>(room, rng() % 4);
+            v.insert(v.begin() + pos, count, make_value<T>(value));
+            ref.insert(ref.begin() + static_cast<long>(pos), count, make_value<T>(value));
+            break;
+        }
+        case 4:
+            if (room >= 2) {
+                const T range[] = {make_value<T>(value), make_value<T>(value + 1)};
+                v.insert(v.begin() + pos, std::begin(range), std::end(range));
+                ref.insert(ref.begin() + static_cast<long>(pos), std::begin(range), std::end(range));
+            }
+            break;
+        case 5:
+            if (!ref.empty()) {
+                const size_t at = rng() % ref.size();
+                const size_t last = std::min(ref.size(), at + rng() % 3);
+                v.erase(v.begin() + at, v.begin() + last);
+                ref.erase(ref.begin() + static_cast<long>(at), ref.begin() + static_cast<long>(last));
+            }
+            break;
+        case 6:
+            if (!ref.empty()) {
+                v.pop_back();
+                ref.pop_back();
+            }
+            break;
+        case 7: {
+            const size_t size = std::min(max_size, static_cast<size_t>(rng() % 40));
+            v.resize(size, make_value<T>(value));
+            ref.resize(size, make_value<T>(value));
+            break;
+        }
+        }
+        expect_same(v, ref);
+    }
+}
+
+} // anonymous namespace
+
+TEST(SmallVectorTests, NoAllocationWhileInline) {
+    using Vec = small_vector<int, 8, CountingAllocator<int>>;
+    CountingAllocator<int>::reset_counts();
+    {
+        Vec v;
+        for (int i = 0; i < 8; ++i) {
+            v.push_back(i);
+        }
+        v.insert(v.begin(), 42);
+        EXPECT_EQ(CountingAllocator<int>::allocation_count_, 1u);  // The 9th element spills
+        EXPECT_FALSE(v.is_inline());
+        v.erase(v.begin(), v.begin() + 5);
+        v.shrink_to_fit();
+        EXPECT_TRUE(v.is_inline());
+        EXPECT_EQ(v, (Vec{4, 5, 6, 7}));
+    }
+    CountingAllocator<int>::reset_counts();
+    {
+        Vec a{1, 2, 3};
+        Vec b = a;
+        Vec c = std::move(b);
+        c.insert(c.begin() + 1, {7, 8});
+        EXPECT_EQ(c, (Vec{1, 7, 8, 2, 3}));
+    }
+    EXPECT_EQ(CountingAllocator<int>::allocation_count_, 0u);
+    EXPECT_EQ(CountingAllocator<int>::deallocation_count_, 0u);
+}
+
+TEST(SmallVectorTests, MatchesStdVectorTrivialType) {
+    small_vector<int, 16> v;
+    random_operations(v, 200, 1);
+}
+
+TEST(SmallVectorTests, MatchesStdVectorNonTrivialType) {
+    small_vector<std::string, 4> v;
+    random_operations(v, 200, 2);
+}
+
+TEST(SmallVectorTests, MovesStealHeapOrRelocateInline) {
+    small_vector<std::string, 2> heap{"a", "b", "c"};
+    const std::string* block = heap.data();
+    small_vector<std::string, 2> moved(std::move(heap));
+    EXPECT_EQ(moved.data(), block);
+    EXPECT_TRUE(heap.empty() && heap.is_inline());
+
+    small_vector<std::string, 2> inline_vec{"x"};
+    moved = std::move(inline_vec);
+    EXPECT_TRUE(moved.is_inline());
+    EXPECT_EQ(moved.size(), 1u);
+    EXPECT_EQ(moved[0], "x");
+    EXPECT_TRUE(inline_vec.empty());
+
+    small_vector<std::string, 2> other{"p", "q", "r", "s"};
+    swap(moved, other);
+    EXPECT_EQ(moved.size(), 4u);
+    EXPECT_EQ(other[0], "x");
+    EXPECT_GT(other, moved);  // "x" > "p"
+}
+
+TEST(SmallVectorTests, ElementAccessAndSelfReferencingInsert) {
+    small_vector<std::string, 2> v{"first", "second"};
+    v.push_back(v[0]);  // Reallocates while the argument lives in the old block
+    v.insert(v.begin(), 2, v.back());
+    EXPECT_EQ(v.size(), 5u);
+    EXPECT_EQ(v.front(), "first");
+    EXPECT_EQ(v.at(4), "first");
+    EXPECT_THROW(v.at(5), std::out_of_range);
+    EXPECT_EQ(*v.rbegin(), "first");
+}
+
+TEST(StaticVectorTests, FixedCapacity) {
+    static_vector<std::string, 4> v;
+    random_operations(v, 4, 3);
+
+    static_vector<int, 3> full{1, 2, 3};
+    EXPECT_THROW(full.push_back(4), std::bad_alloc);
+    EXPECT_EQ(full.try_emplace_back(4), nullptr);
+    full.pop_back();
+    ASSERT_NE(full.try_emplace_back(9), nullptr);
+    EXPECT_EQ(full, (static_vector<int, 3>{1, 2, 9}));
+    EXPECT_EQ(full.capacity(), 3u);
+
+    static_vector<int, 3> moved = std::move(full);
+    EXPECT_EQ(moved.back(), 9);
+    EXPECT_TRUE(full.empty());
+}
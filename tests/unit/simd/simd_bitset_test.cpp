@@ -0,0 +1,166 @@
+/**
+ * @file simd_bitset_test.cpp
+ * @brief Unit tests for the SIMD bitset (simd_bitset.hpp)
+ *
+ * Every operation is checked against std::vector<bool> on random bitsets
+ * whose sizes straddle word and 512-bit block boundaries, and on one large
+ * enough for several full Harley-Seal rounds. Densities range from empty
+ * to full, so the zero-block skipping and the decoder's zero-word path run.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "simd_bitset.hpp"
+
+namespace {
+
+using hpc::simd::Bitset;
+using hpc::simd::RankSelect;
+
+constexpr size_t SIZES[] = {1, 63, 64, 65, 511, 512, 513, 1000, 70000};
+
+struct Pair {
+    Bitset bits;
+    std::vector<bool> ref;
+};
+
+/// Bit i set with probability @p density
+Pair random_bits(size_t n, double density, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution coin(density);
+    Pair p{Bitset(n), std::vector<bool>(n)};
+    for (size_t i = 0; i < n; ++i) {
+        if (coin(rng)) {
+            p.bits.set(i);
+            p.ref[i] = true;
+        }
+    }
+    return p;
+}
+
+std::vector<size_t> set_positions(const std::vector<bool>& ref) {
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < ref.size(); ++i) {
+        if (ref[i]) positions.push_back(i);
+    }
+    return positions;
+}
+
+void expect_equal(const Bitset& bits, const std::vector<bool>& ref) {
+    ASSERT_EQ(bits.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ASSERT_EQ(bits.test(i), ref[i]) << "bit " << i;
+    }
+}
+
+} // anonymous namespace
+
+TEST(SimdBitsetTests, SetOperationsMatchVectorBool) {
+    for (size_t n : SIZES) {
+        const auto a = random_bits(n, 0.5, 1);
+        const auto b = random_bits(n, 0.3, 2);
+        std::vector<bool> and_ref(n), or_ref(n), xor_ref(n), andnot_ref(n);
+        for (size_t i = 0; i < n; ++i) {
+            and_ref[i] = a.ref[i] && b.ref[i];
+            or_ref[i] = a.ref[i] || b.ref[i];
+            xor_ref[i] = a.ref[i] != b.ref[i];
+            andnot_ref[i] = a.ref[i] && !b.ref[i];
+        }
+        expect_equal(a.bits & b.bits, and_ref);
+        expect_equal(a.bits | b.bits, or_ref);
+        expect_equal(a.bits ^ b.bits, xor_ref);
+        Bitset andnot = a.bits;
+        andnot.and_not(b.bits);
+        expect_equal(andnot, andnot_ref);
+    }
+}
+
+TEST(SimdBitsetTests, CountMatchesAtAllDensities) {
+    for (size_t n : SIZES) {
+        for (double density : {0.0, 0.01, 0.5, 1.0}) {
+            const auto p = random_bits(n, density, 3);
+            EXPECT_EQ(p.bits.count(), set_positions(p.ref).size()) << "n=" << n << " density=" << density;
+        }
+    }
+    // Several full 16-register Harley-Seal rounds plus leftovers
+    const auto big = random_bits(1'000'000, 0.5, 4);
+    EXPECT_EQ(big.bits.count(), set_positions(big.ref).size());
+}
+
+TEST(SimdBitsetTests, IterationVisitsSetBitsInOrder) {
+    for (size_t n : SIZES) {
+        for (double density : {0.0, 0.001, 0.5, 1.0}) {
+            const auto p = random_bits(n, density, 5);
+            const auto expected = set_positions(p.ref);
+
+            std::vector<size_t> visited;
+            p.bits.for_each_set([&](size_t i) { visited.push_back(i); });
+            EXPECT_EQ(visited, expected) << "n=" << n << " density=" << density;
+
+            std::vector<size_t> found;
+            for (size_t i = p.bits.find_first(); i != Bitset::npos; i = p.bits.find_next(i + 1)) {
+                found.push_back(i);
+            }
+            EXPECT_EQ(found, expected) << "n=" << n << " density=" << density;
+        }
+    }
+    EXPECT_EQ(Bitset().find_first(), Bitset::npos);
+}
+
+TEST(SimdBitsetTests, DecoderMatchesSetPositions) {
+    for (size_t n : SIZES) {
+        for (double density : {0.0, 0.02, 0.5, 1.0}) {
+            const auto p = random_bits(n, density, 6);
+            const auto expected = set_positions(p.ref);
+            const auto indices = p.bits.to_indices();
+            ASSERT_EQ(indices.size(), expected.size()) << "n=" << n << " density=" << density;
+            for (size_t k = 0; k < expected.size(); ++k) {
+                ASSERT_EQ(indices[k], expected[k]) << "n=" << n << " k=" << k;
+            }
+        }
+    }
+}
+
+TEST(SimdBitsetTests, RankAndSelectAreInverse) {
+    for (size_t n : SIZES) {
+        const auto p = random_bits(n, 0.3, 7);
+        const RankSelect rs(p.bits);
+        const auto positions = set_positions(p.ref);
+        ASSERT_EQ(rs.count(), positions.size());
+
+        size_t ones = 0;
+        for (size_t i = 0; i <= n; ++i) {
+            ASSERT_EQ(rs.rank(i), ones) << "n=" << n << " i=" << i;
+            if (i < n && p.ref[i]) ++ones;
+        }
+        for (size_t k = 0; k < positions.size(); ++k) {
+            ASSERT_EQ(rs.select(k), positions[k]) << "n=" << n << " k=" << k;
+        }
+        EXPECT_EQ(rs.select(positions.size()), RankSelect::npos);
+    }
+}
+
+TEST(SimdBitsetTests, SelectAcrossSparseAndDenseRegions) {
+    // Dense runs with long gaps: select samples land many blocks apart
+    const size_t n = 1'000'000;
+    Bitset bits(n);
+    std::vector<size_t> positions;
+    for (size_t start = 0; start + 20000 <= n; start += 150000) {
+        for (size_t i = start; i < start + 20000; i += 1 + (i % 3)) {
+            bits.set(i);
+            positions.push_back(i);
+        }
+    }
+    bits.set(n - 1);
+    positions.push_back(n - 1);
+
+    const RankSelect rs(bits);
+    ASSERT_EQ(rs.count(), positions.size());
+    for (size_t k = 0; k < positions.size(); ++k) {
+        ASSERT_EQ(rs.select(k), positions[k]) << "k=" << k;
+        ASSERT_EQ(rs.rank(positions[k]), k) << "k=" << k;
+    }
+}
@@ -0,0 +1,157 @@
+/**
+ * @file simd_fixed_test.cpp
+ * @brief Unit tests for the fixed-size kernels (simd_fixed.hpp)
+ *
+ * Every kernel is compared with a plain scalar loop for sizes that fill
+ * one register exactly (4, 8, 16), leave a partial register (3, 5, 13) or
+ * span several (16 doubles, 20), in float and double. Outputs are
+ * compared up to FMA rounding; axpy must not write past the array.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include <type_traits>
+
+#include "simd_fixed.hpp"
+
+namespace {
+
+using hpc::simd::FixedMat;
+using hpc::simd::fixed_vec_t;
+
+template<typename T, size_t N>
+std::array<T, N> random_array(unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-2.0, 2.0);
+    std::array<T, N> a{};
+    for (T& v : a) {
+        v = static_cast<T>(dist(rng));
+    }
+    return a;
+}
+
+template<typename T, size_t R, size_t C>
+FixedMat<T, R, C> random_mat(unsigned seed) {
+    FixedMat<T, R, C> m;
+    for (size_t c = 0; c < C; ++c) {
+        m.cols[c] = random_array<T, R>(seed + static_cast<unsigned>(c));
+    }
+    return m;
+}
+
+template<typename T>
+constexpr T TOLERANCE = std::is_same_v<T, float> ? T{1e-5f} : T{1e-12};
+
+template<typename T, size_t N>
+void check_vector_kernels() {
+    const auto a = random_array<T, N>(1);
+    const auto b = random_array<T, N>(2);
+
+    T expected_dot = 0;
+    for (size_t i = 0; i < N; ++i) {
+        expected_dot += a[i] * b[i];
+    }
+    EXPECT_NEAR(hpc::simd::dot(a, b), expected_dot, TOLERANCE<T> * N) << "N=" << N;
+    EXPECT_NEAR(hpc::simd::norm(a), std::sqrt(hpc::simd::dot(a, a)), TOLERANCE<T>) << "N=" << N;
+
+    // One element of guard on each side of y
+    std::array<T, N + 2> guarded{};
+    guarded.front() = guarded.back() = T{99};
+    auto& y = *reinterpret_cast<std::array<T, N>*>(guarded.data() + 1);
+    y = b;
+    hpc::simd::axpy(T{3}, a, y);
+    for (size_t i = 0; i < N; ++i) {
+        EXPECT_NEAR(y[i], T{3} * a[i] + b[i], TOLERANCE<T>) << "N=" << N << " i=" << i;
+    }
+    EXPECT_EQ(guarded.front(), T{99});
+    EXPECT_EQ(guarded.back(), T{99});
+}
+
+template<typename T, size_t R, size_t K, size_t C>
+void check_matrix_kernels() {
+    const auto a = random_mat<T, R, K>(10);
+    const auto b = random_mat<T, K, C>(20);
+    const auto x = random_array<T, K>(30);
+
+    const auto y = hpc::simd::matvec(a, x);
+    for (size_t r = 0; r < R; ++r) {
+        T expected = 0;
+        for (size_t k = 0; k < K; ++k) {
+            expected += a(r, k) * x[k];
+        }
+        EXPECT_NEAR(y[r], expected, TOLERANCE<T> * K) << R << "x" << K << " r=" << r;
+    }
+
+    const auto p = hpc::simd::matmul(a, b);
+    for (size_t r = 0; r < R; ++r) {
+        for (size_t c = 0; c < C; ++c) {
+            T expected = 0;
+            for (size_t k = 0; k < K; ++k) {
+                expected += a(r, k) * b(k, c);
+            }
+            EXPECT_NEAR(p(r, c), expected, TOLERANCE<T> * K) << R << "x" << K << "x" << C;
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(SimdFixedTests, SizesMapOntoNarrowestRegister) {
+#ifdef HPC_HAS_SSE2
+    static_assert(fixed_vec_t<float, 3>::width == 4);
+    static_assert(fixed_vec_t<float, 4>::width == 4);
+    static_assert(fixed_vec_t<double, 2>::width == 2);
+#endif
+#ifdef HPC_HAS_AVX2
+    static_assert(fixed_vec_t<float, 8>::width == 8);
+    static_assert(fixed_vec_t<double, 4>::width == 4);
+#endif
+#ifdef HPC_HAS_AVX512
+    static_assert(fixed_vec_t<float, 16>::width == 16);
+    static_assert(fixed_vec_t<float, 13>::width == 16);
+#endif
+    // Wider than any register: the native one, several times
+    static_assert(fixed_vec_t<float, 64>::width == hpc::simd::FLOAT_VEC_WIDTH);
+    SUCCEED();
+}
+
+TEST(SimdFixedTests, VectorKernelsMatchScalar) {
+    check_vector_kernels<float, 3>();
+    check_vector_kernels<float, 4>();
+    check_vector_kernels<float, 5>();
+    check_vector_kernels<float, 8>();
+    check_vector_kernels<float, 13>();
+    check_vector_kernels<float, 16>();
+    check_vector_kernels<float, 20>();
+    check_vector_kernels<double, 3>();
+    check_vector_kernels<double, 4>();
+    check_vector_kernels<double, 8>();
+    check_vector_kernels<double, 16>();
+}
+
+TEST(SimdFixedTests, MatrixKernelsMatchScalar) {
+    check_matrix_kernels<float, 4, 4, 4>();
+    check_matrix_kernels<float, 3, 3, 3>();
+    check_matrix_kernels<float, 3, 5, 2>();
+    check_matrix_kernels<float, 8, 8, 8>();
+    check_matrix_kernels<double, 4, 4, 4>();
+    check_matrix_kernels<double, 5, 4, 3>();
+}
+
+TEST(SimdFixedTests, IdentityAndKnownValues) {
+    hpc::simd::Mat4f identity;
+    for (size_t i = 0; i < 4; ++i) {
+        identity(i, i) = 1.0f;
+    }
+    const std::array<float, 4> v = {1.0f, -2.0f, 3.0f, 0.5f};
+    EXPECT_EQ(hpc::simd::matvec(identity, v), v);
+
+    const auto m = random_mat<float, 4, 4>(5);
+    const auto p = hpc::simd::matmul(m, identity);
+    EXPECT_EQ(p.cols, m.cols);
+
+    const std::array<float, 3> pythagoras = {3.0f, 4.0f, 12.0f};
+    EXPECT_FLOAT_EQ(hpc::simd::norm(pythagoras), 13.0f);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file simd_tables_test.cpp
+ * @brief Unit tests for the compile-time SIMD lookup tables (simd_tables.hpp)
+ *
+ * Every row of the generated tables is checked against its definition,
+ * and the kernels built on them against scalar code: the nibble popcount
+ * at lengths around the register width, and load_first/store_first on
+ * every vector type for each partial count.
+ */
+
+#include <gtest/gtest.h>
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "simd_tables.hpp"
+#include "simd_wrapper.hpp"
+
+namespace {
+
+using hpc::simd::COMPRESS_PERMUTE_8X32;
+using hpc::simd::LANE_MASK_4X64;
+using hpc::simd::LANE_MASK_8X32;
+using hpc::simd::NIBBLE_POPCOUNT;
+using hpc::simd::make_compress_permute_table;
+using hpc::simd::make_nibble_table;
+
+/// load_first must zero lanes [count, W); store_first must leave out[count, W) alone
+template<typename Vec>
+void check_partial_moves() {
+    using T = typename Vec::value_type;
+    constexpr size_t W = Vec::width;
+    for (size_t count = 0; count <= W; ++count) {
+        // Exactly count elements, so a read or write past them trips ASan
+        std::vector<T> in(count);
+        for (size_t i = 0; i < count; ++i) {
+            in[i] = static_cast<T>(i + 1);
+        }
+        const Vec v = Vec::load_first(in.data(), count);
+        for (size_t i = 0; i < W; ++i) {
+            EXPECT_EQ(v[i], i < count ? static_cast<T>(i + 1) : T{0}) << "count=" << count << " lane=" << i;
+        }
+
+        std::vector<T> out(W, T{-1});
+        Vec(T{7}).store_first(out.data(), count);
+        for (size_t i = 0; i < W; ++i) {
+            EXPECT_EQ(out[i], i < count ? T{7} : T{-1}) << "count=" << count << " lane=" << i;
+        }
+    }
+}
+
+uint64_t popcount_scalar(const uint8_t* data, size_t n) {
+    uint64_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += static_cast<uint64_t>(std::popcount(data[i]));
+    }
+    return count;
+}
+
+} // anonymous namespace
+
+TEST(SimdTablesTests, CompressPermuteRowsListSetBits) {
+    for (size_t mask = 0; mask < 256; ++mask) {
+        const auto& row = COMPRESS_PERMUTE_8X32[mask];
+        size_t out = 0;
+        for (uint32_t lane = 0; lane < 8; ++lane) {
+            if ((mask >> lane) & 1) {
+                EXPECT_EQ(row[out++], lane) << "mask=" << mask;
+            }
+        }
+        for (; out < 8; ++out) {
+            EXPECT_EQ(row[out], 0u) << "mask=" << mask;
+        }
+    }
+
+    // Other widths and index types come from the same generator
+    constexpr auto BYTE_POSITIONS = make_compress_permute_table<4, uint8_t>();
+    static_assert(BYTE_POSITIONS.size() == 16);
+    static_assert(BYTE_POSITIONS[0b1101] == std::array<uint8_t, 4>{0, 2, 3, 0});
+}
+
+TEST(SimdTablesTests, LaneMaskRowsMatchBits) {
+    for (size_t mask = 0; mask < 256; ++mask) {
+        for (size_t lane = 0; lane < 8; ++lane) {
+            EXPECT_EQ(LANE_MASK_8X32[mask][lane], ((mask >> lane) & 1) ? -1 : 0) << "mask=" << mask;
+        }
+    }
+    for (size_t mask = 0; mask < 16; ++mask) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            EXPECT_EQ(LANE_MASK_4X64[mask][lane], ((mask >> lane) & 1) ? int64_t{-1} : int64_t{0});
+        }
+    }
+}
+
+TEST(SimdTablesTests, NibbleTablesApplyTheirFunction) {
+    for (uint8_t n = 0; n < 16; ++n) {
+        EXPECT_EQ(NIBBLE_POPCOUNT[n], std::popcount(n));
+    }
+    constexpr auto HEX = make_nibble_table([](uint8_t n) { return n < 10 ? '0' + n : 'a' + n - 10; });
+    static_assert(HEX[0] == '0' && HEX[9] == '9' && HEX[10] == 'a' && HEX[15] == 'f');
+    SUCCEED();
+}
+
+TEST(SimdTablesTests, PopcountMatchesScalar) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<uint8_t> data(4096 + 3);
+    for (uint8_t& b : data) {
+        b = static_cast<uint8_t>(byte(rng));
+    }
+    // Lengths around both register widths, from an unaligned start
+    for (size_t n : {0u, 1u, 31u, 32u, 33u, 63u, 64u, 65u, 127u, 1000u, 4096u}) {
+        EXPECT_EQ(hpc::simd::popcount_wrapped(data.data() + 3, n), popcount_scalar(data.data() + 3, n)) << n;
+    }
+
+    const std::vector<uint8_t> ones(1000, 0xFF);
+    EXPECT_EQ(hpc::simd::popcount_wrapped(ones.data(), ones.size()), 8000u);
+}
+
+TEST(SimdTablesTests, PartialLoadStoreStayInBounds) {
+    check_partial_moves<hpc::simd::FloatVec>();
+    check_partial_moves<hpc::simd::DoubleVec>();
+    check_partial_moves<hpc::simd::SimdVecScalar<float, 4>>();
+#ifdef HPC_HAS_SSE2
+    check_partial_moves<hpc::simd::SimdVec<float, 4>>();
+    check_partial_moves<hpc::simd::SimdVec<double, 2>>();
+#endif
+#ifdef HPC_HAS_AVX2
+    check_partial_moves<hpc::simd::SimdVec<float, 8>>();
+    check_partial_moves<hpc::simd::SimdVec<double, 4>>();
+#endif
+}